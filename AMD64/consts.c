@@ -1,40 +1,113 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: constants for the x64 assembly implementation
-*
-*****************************************************************************************/
-
-#include "../LatticeCrypto_priv.h"
-#include <stdint.h>
-
-
-uint32_t PRIME8x[8]      = {PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q};
-uint8_t ONE32x[32]       = {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1};
-uint32_t MASK12x8[8]     = {0xfff,0xfff,0xfff,0xfff,0xfff,0xfff,0xfff,0xfff};
-uint32_t PERM0246[4]     = {0,2,4,6};
-uint32_t PERM00224466[8] = {0,0,2,2,4,4,6,6};
-uint32_t PERM02134657[8] = {0,2,1,3,4,6,5,7};
-uint64_t PERM0145[4]     = {0,1,4,5};
-uint64_t PERM2367[4]     = {2,3,6,7};
-uint64_t MASK32[4]       = {0xffffffff,0,0xffffffff,0};
-uint64_t MASK42[4]       = {0x3fff0000000,0,0x3fff0000000,0};
-
-uint64_t MASK14_1[4]     = {0x3fff,0,0x3fff,0};
-uint64_t MASK14_2[4]     = {0xFFFC000,0,0xFFFC000,0};
-uint64_t MASK14_3[4]     = {0x3FFF0000000,0,0x3FFF0000000,0};
-uint64_t MASK14_4[4]     = {0xFFFC0000000000,0,0xFFFC0000000000,0};
-
-uint32_t ONE8x[8]        = {1,1,1,1,1,1,1,1};
-uint32_t THREE8x[8]      = {3,3,3,3,3,3,3,3};
-uint32_t FOUR8x[8]       = {4,4,4,4,4,4,4,4};
-uint32_t PARAM_Q4x8[8]   = {3073,3073,3073,3073,3073,3073,3073,3073};
-uint32_t PARAM_3Q4x8[8]  = {9217,9217,9217,9217,9217,9217,9217,9217};
-uint32_t PARAM_5Q4x8[8]  = {15362,15362,15362,15362,15362,15362,15362,15362};
-uint32_t PARAM_7Q4x8[8]  = {21506,21506,21506,21506,21506,21506,21506,21506};
-uint32_t PARAM_Q2x8[8]   = {6145,6145,6145,6145,6145,6145,6145,6145};
-uint32_t PARAM_3Q2x8[8]  = {18434,18434,18434,18434,18434,18434,18434,18434};
-
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: constants for the x64 assembly implementation
+*
+*****************************************************************************************/
+
+#include "../LatticeCrypto_priv.h"
+#include <stdint.h>
+
+
+uint32_t PRIME8x[8]      = {PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q, PARAMETER_Q};
+uint32_t MASK12x8[8]     = {0xfff,0xfff,0xfff,0xfff,0xfff,0xfff,0xfff,0xfff};
+uint32_t PERM0246[4]     = {0,2,4,6};
+uint32_t PERM00224466[8] = {0,0,2,2,4,4,6,6};
+uint32_t PERM02134657[8] = {0,2,1,3,4,6,5,7};
+uint64_t PERM0145[4]     = {0,1,4,5};
+uint64_t PERM2367[4]     = {2,3,6,7};
+uint64_t MASK32[4]       = {0xffffffff,0,0xffffffff,0};
+uint64_t MASK42[4]       = {0x3fff0000000,0,0x3fff0000000,0};
+
+uint64_t MASK14_1[4]     = {0x3fff,0,0x3fff,0};
+uint64_t MASK14_2[4]     = {0xFFFC000,0,0xFFFC000,0};
+uint64_t MASK14_3[4]     = {0x3FFF0000000,0,0x3FFF0000000,0};
+uint64_t MASK14_4[4]     = {0xFFFC0000000000,0,0xFFFC0000000000,0};
+
+uint32_t ONE8x[8]        = {1,1,1,1,1,1,1,1};
+uint32_t THREE8x[8]      = {3,3,3,3,3,3,3,3};
+uint32_t FOUR8x[8]       = {4,4,4,4,4,4,4,4};
+uint32_t PARAM_Q4x8[8]   = {3073,3073,3073,3073,3073,3073,3073,3073};
+uint32_t PARAM_3Q4x8[8]  = {9217,9217,9217,9217,9217,9217,9217,9217};
+uint32_t PARAM_5Q4x8[8]  = {15362,15362,15362,15362,15362,15362,15362,15362};
+uint32_t PARAM_7Q4x8[8]  = {21506,21506,21506,21506,21506,21506,21506,21506};
+uint32_t PARAM_Q2x8[8]   = {6145,6145,6145,6145,6145,6145,6145,6145};
+uint32_t PARAM_3Q2x8[8]  = {18434,18434,18434,18434,18434,18434,18434,18434};
+
+// Constants for the AVX-512 implementation
+uint32_t PERM_U2x16[16]   = {0,0,1,1,4,4,5,5,8,8,9,9,12,12,13,13};
+uint32_t PERM_V2x16[16]   = {2,2,3,3,6,6,7,7,10,10,11,11,14,14,15,15};
+uint32_t PERM_S2x16[16]   = {0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3};
+uint32_t PERM_OUT2x16[16] = {0,2,16,18,4,6,20,22,8,10,24,26,12,14,28,30};
+uint32_t PERM_U4x16[16]   = {0,0,1,1,2,2,3,3,8,8,9,9,10,10,11,11};
+uint32_t PERM_V4x16[16]   = {4,4,5,5,6,6,7,7,12,12,13,13,14,14,15,15};
+uint32_t PERM_S4x16[16]   = {0,0,0,0,0,0,0,0,1,1,1,1,1,1,1,1};
+uint32_t PERM_OUT4x16[16] = {0,2,4,6,16,18,20,22,8,10,12,14,24,26,28,30};
+uint64_t SHIFT0_28x8[8]   = {0,28,0,28,0,28,0,28};
+uint8_t POPCNT4x16[16]    = {0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4};
+
+
+// Constants for the 16-bit implementation
+int16_t PRIME16x[16]      = {PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q,PARAMETER_Q};
+int16_t QINV16x[16]       = {PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV,PARAMETER_QINV};
+int16_t BARRETT16x[16]    = {PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT,PARAMETER_BARRETT};
+int16_t ROUND16x[16]      = {32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32};    // vpmulhrsw by 32 rounds a shift by 10
+int16_t MONT3x16[16]      = {PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3,PARAMETER_MONT3};
+int16_t MONT9x16[16]      = {PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9,PARAMETER_MONT9};
+int16_t MONT9_2x16[16]    = {PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2,PARAMETER_MONT9_2};
+uint8_t SHUF_K8x16[32]    = {0,1,0,1,0,1,0,1,0,1,0,1,0,1,0,1, 2,3,2,3,2,3,2,3,2,3,2,3,2,3,2,3};
+uint8_t SHUF_K4x16[32]    = {0,1,0,1,0,1,0,1,4,5,4,5,4,5,4,5, 2,3,2,3,2,3,2,3,6,7,6,7,6,7,6,7};
+uint8_t SHUF_K2x16[32]    = {0,1,0,1,8,9,8,9,2,3,2,3,10,11,10,11, 4,5,4,5,12,13,12,13,6,7,6,7,14,15,14,15};
+uint8_t SHUF_K1x16[32]    = {0,1,8,9,2,3,10,11,4,5,12,13,6,7,14,15, 0,1,8,9,2,3,10,11,4,5,12,13,6,7,14,15};
+int16_t ENC_MUL16x[16]    = {1,1<<14,1,1<<14,1,1<<14,1,1<<14,1,1<<14,1,1<<14,1,1<<14,1,1<<14};
+uint8_t ENC_SHUF16x[32]   = {0,1,2,3,4,5,6,8,9,10,11,12,13,14,0x80,0x80, 0,1,2,3,4,5,6,8,9,10,11,12,13,14,0x80,0x80};
+uint8_t DEC_SHUF_LO16x[32] = {0,1,2,3,1,2,3,4,3,4,5,6,5,6,7,8, 0,1,2,3,1,2,3,4,3,4,5,6,5,6,7,8};
+uint8_t DEC_SHUF_HI16x[32] = {7,8,9,10,8,9,10,11,10,11,12,13,12,13,14,15, 7,8,9,10,8,9,10,11,10,11,12,13,12,13,14,15};
+uint32_t DEC_SHIFT8x[8]   = {0,6,4,2,0,6,4,2};
+uint32_t MASK14x8[8]      = {0x3fff,0x3fff,0x3fff,0x3fff,0x3fff,0x3fff,0x3fff,0x3fff};
+
+
+// Constants for the ChaCha20 implementation
+uint32_t CHACHA_INC8x[8]  = {0,1,2,3,4,5,6,7};
+uint8_t ROT16x16[16]      = {2,3,0,1,6,7,4,5,10,11,8,9,14,15,12,13};
+uint8_t ROT8x16[16]       = {3,0,1,2,7,4,5,6,11,8,9,10,15,12,13,14};
+
+
+// Constants for the rejection sampling: row m lists the positions of the set bits of m, for vpermd after vpmovzxbd
+uint8_t REJ_PERM8x[256][8] = {
+    {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {1,0,0,0,0,0,0,0}, {0,1,0,0,0,0,0,0}, {2,0,0,0,0,0,0,0}, {0,2,0,0,0,0,0,0}, {1,2,0,0,0,0,0,0}, {0,1,2,0,0,0,0,0},
+    {3,0,0,0,0,0,0,0}, {0,3,0,0,0,0,0,0}, {1,3,0,0,0,0,0,0}, {0,1,3,0,0,0,0,0}, {2,3,0,0,0,0,0,0}, {0,2,3,0,0,0,0,0}, {1,2,3,0,0,0,0,0}, {0,1,2,3,0,0,0,0},
+    {4,0,0,0,0,0,0,0}, {0,4,0,0,0,0,0,0}, {1,4,0,0,0,0,0,0}, {0,1,4,0,0,0,0,0}, {2,4,0,0,0,0,0,0}, {0,2,4,0,0,0,0,0}, {1,2,4,0,0,0,0,0}, {0,1,2,4,0,0,0,0},
+    {3,4,0,0,0,0,0,0}, {0,3,4,0,0,0,0,0}, {1,3,4,0,0,0,0,0}, {0,1,3,4,0,0,0,0}, {2,3,4,0,0,0,0,0}, {0,2,3,4,0,0,0,0}, {1,2,3,4,0,0,0,0}, {0,1,2,3,4,0,0,0},
+    {5,0,0,0,0,0,0,0}, {0,5,0,0,0,0,0,0}, {1,5,0,0,0,0,0,0}, {0,1,5,0,0,0,0,0}, {2,5,0,0,0,0,0,0}, {0,2,5,0,0,0,0,0}, {1,2,5,0,0,0,0,0}, {0,1,2,5,0,0,0,0},
+    {3,5,0,0,0,0,0,0}, {0,3,5,0,0,0,0,0}, {1,3,5,0,0,0,0,0}, {0,1,3,5,0,0,0,0}, {2,3,5,0,0,0,0,0}, {0,2,3,5,0,0,0,0}, {1,2,3,5,0,0,0,0}, {0,1,2,3,5,0,0,0},
+    {4,5,0,0,0,0,0,0}, {0,4,5,0,0,0,0,0}, {1,4,5,0,0,0,0,0}, {0,1,4,5,0,0,0,0}, {2,4,5,0,0,0,0,0}, {0,2,4,5,0,0,0,0}, {1,2,4,5,0,0,0,0}, {0,1,2,4,5,0,0,0},
+    {3,4,5,0,0,0,0,0}, {0,3,4,5,0,0,0,0}, {1,3,4,5,0,0,0,0}, {0,1,3,4,5,0,0,0}, {2,3,4,5,0,0,0,0}, {0,2,3,4,5,0,0,0}, {1,2,3,4,5,0,0,0}, {0,1,2,3,4,5,0,0},
+    {6,0,0,0,0,0,0,0}, {0,6,0,0,0,0,0,0}, {1,6,0,0,0,0,0,0}, {0,1,6,0,0,0,0,0}, {2,6,0,0,0,0,0,0}, {0,2,6,0,0,0,0,0}, {1,2,6,0,0,0,0,0}, {0,1,2,6,0,0,0,0},
+    {3,6,0,0,0,0,0,0}, {0,3,6,0,0,0,0,0}, {1,3,6,0,0,0,0,0}, {0,1,3,6,0,0,0,0}, {2,3,6,0,0,0,0,0}, {0,2,3,6,0,0,0,0}, {1,2,3,6,0,0,0,0}, {0,1,2,3,6,0,0,0},
+    {4,6,0,0,0,0,0,0}, {0,4,6,0,0,0,0,0}, {1,4,6,0,0,0,0,0}, {0,1,4,6,0,0,0,0}, {2,4,6,0,0,0,0,0}, {0,2,4,6,0,0,0,0}, {1,2,4,6,0,0,0,0}, {0,1,2,4,6,0,0,0},
+    {3,4,6,0,0,0,0,0}, {0,3,4,6,0,0,0,0}, {1,3,4,6,0,0,0,0}, {0,1,3,4,6,0,0,0}, {2,3,4,6,0,0,0,0}, {0,2,3,4,6,0,0,0}, {1,2,3,4,6,0,0,0}, {0,1,2,3,4,6,0,0},
+    {5,6,0,0,0,0,0,0}, {0,5,6,0,0,0,0,0}, {1,5,6,0,0,0,0,0}, {0,1,5,6,0,0,0,0}, {2,5,6,0,0,0,0,0}, {0,2,5,6,0,0,0,0}, {1,2,5,6,0,0,0,0}, {0,1,2,5,6,0,0,0},
+    {3,5,6,0,0,0,0,0}, {0,3,5,6,0,0,0,0}, {1,3,5,6,0,0,0,0}, {0,1,3,5,6,0,0,0}, {2,3,5,6,0,0,0,0}, {0,2,3,5,6,0,0,0}, {1,2,3,5,6,0,0,0}, {0,1,2,3,5,6,0,0},
+    {4,5,6,0,0,0,0,0}, {0,4,5,6,0,0,0,0}, {1,4,5,6,0,0,0,0}, {0,1,4,5,6,0,0,0}, {2,4,5,6,0,0,0,0}, {0,2,4,5,6,0,0,0}, {1,2,4,5,6,0,0,0}, {0,1,2,4,5,6,0,0},
+    {3,4,5,6,0,0,0,0}, {0,3,4,5,6,0,0,0}, {1,3,4,5,6,0,0,0}, {0,1,3,4,5,6,0,0}, {2,3,4,5,6,0,0,0}, {0,2,3,4,5,6,0,0}, {1,2,3,4,5,6,0,0}, {0,1,2,3,4,5,6,0},
+    {7,0,0,0,0,0,0,0}, {0,7,0,0,0,0,0,0}, {1,7,0,0,0,0,0,0}, {0,1,7,0,0,0,0,0}, {2,7,0,0,0,0,0,0}, {0,2,7,0,0,0,0,0}, {1,2,7,0,0,0,0,0}, {0,1,2,7,0,0,0,0},
+    {3,7,0,0,0,0,0,0}, {0,3,7,0,0,0,0,0}, {1,3,7,0,0,0,0,0}, {0,1,3,7,0,0,0,0}, {2,3,7,0,0,0,0,0}, {0,2,3,7,0,0,0,0}, {1,2,3,7,0,0,0,0}, {0,1,2,3,7,0,0,0},
+    {4,7,0,0,0,0,0,0}, {0,4,7,0,0,0,0,0}, {1,4,7,0,0,0,0,0}, {0,1,4,7,0,0,0,0}, {2,4,7,0,0,0,0,0}, {0,2,4,7,0,0,0,0}, {1,2,4,7,0,0,0,0}, {0,1,2,4,7,0,0,0},
+    {3,4,7,0,0,0,0,0}, {0,3,4,7,0,0,0,0}, {1,3,4,7,0,0,0,0}, {0,1,3,4,7,0,0,0}, {2,3,4,7,0,0,0,0}, {0,2,3,4,7,0,0,0}, {1,2,3,4,7,0,0,0}, {0,1,2,3,4,7,0,0},
+    {5,7,0,0,0,0,0,0}, {0,5,7,0,0,0,0,0}, {1,5,7,0,0,0,0,0}, {0,1,5,7,0,0,0,0}, {2,5,7,0,0,0,0,0}, {0,2,5,7,0,0,0,0}, {1,2,5,7,0,0,0,0}, {0,1,2,5,7,0,0,0},
+    {3,5,7,0,0,0,0,0}, {0,3,5,7,0,0,0,0}, {1,3,5,7,0,0,0,0}, {0,1,3,5,7,0,0,0}, {2,3,5,7,0,0,0,0}, {0,2,3,5,7,0,0,0}, {1,2,3,5,7,0,0,0}, {0,1,2,3,5,7,0,0},
+    {4,5,7,0,0,0,0,0}, {0,4,5,7,0,0,0,0}, {1,4,5,7,0,0,0,0}, {0,1,4,5,7,0,0,0}, {2,4,5,7,0,0,0,0}, {0,2,4,5,7,0,0,0}, {1,2,4,5,7,0,0,0}, {0,1,2,4,5,7,0,0},
+    {3,4,5,7,0,0,0,0}, {0,3,4,5,7,0,0,0}, {1,3,4,5,7,0,0,0}, {0,1,3,4,5,7,0,0}, {2,3,4,5,7,0,0,0}, {0,2,3,4,5,7,0,0}, {1,2,3,4,5,7,0,0}, {0,1,2,3,4,5,7,0},
+    {6,7,0,0,0,0,0,0}, {0,6,7,0,0,0,0,0}, {1,6,7,0,0,0,0,0}, {0,1,6,7,0,0,0,0}, {2,6,7,0,0,0,0,0}, {0,2,6,7,0,0,0,0}, {1,2,6,7,0,0,0,0}, {0,1,2,6,7,0,0,0},
+    {3,6,7,0,0,0,0,0}, {0,3,6,7,0,0,0,0}, {1,3,6,7,0,0,0,0}, {0,1,3,6,7,0,0,0}, {2,3,6,7,0,0,0,0}, {0,2,3,6,7,0,0,0}, {1,2,3,6,7,0,0,0}, {0,1,2,3,6,7,0,0},
+    {4,6,7,0,0,0,0,0}, {0,4,6,7,0,0,0,0}, {1,4,6,7,0,0,0,0}, {0,1,4,6,7,0,0,0}, {2,4,6,7,0,0,0,0}, {0,2,4,6,7,0,0,0}, {1,2,4,6,7,0,0,0}, {0,1,2,4,6,7,0,0},
+    {3,4,6,7,0,0,0,0}, {0,3,4,6,7,0,0,0}, {1,3,4,6,7,0,0,0}, {0,1,3,4,6,7,0,0}, {2,3,4,6,7,0,0,0}, {0,2,3,4,6,7,0,0}, {1,2,3,4,6,7,0,0}, {0,1,2,3,4,6,7,0},
+    {5,6,7,0,0,0,0,0}, {0,5,6,7,0,0,0,0}, {1,5,6,7,0,0,0,0}, {0,1,5,6,7,0,0,0}, {2,5,6,7,0,0,0,0}, {0,2,5,6,7,0,0,0}, {1,2,5,6,7,0,0,0}, {0,1,2,5,6,7,0,0},
+    {3,5,6,7,0,0,0,0}, {0,3,5,6,7,0,0,0}, {1,3,5,6,7,0,0,0}, {0,1,3,5,6,7,0,0}, {2,3,5,6,7,0,0,0}, {0,2,3,5,6,7,0,0}, {1,2,3,5,6,7,0,0}, {0,1,2,3,5,6,7,0},
+    {4,5,6,7,0,0,0,0}, {0,4,5,6,7,0,0,0}, {1,4,5,6,7,0,0,0}, {0,1,4,5,6,7,0,0}, {2,4,5,6,7,0,0,0}, {0,2,4,5,6,7,0,0}, {1,2,4,5,6,7,0,0}, {0,1,2,4,5,6,7,0},
+    {3,4,5,6,7,0,0,0}, {0,3,4,5,6,7,0,0}, {1,3,4,5,6,7,0,0}, {0,1,3,4,5,6,7,0}, {2,3,4,5,6,7,0,0}, {0,2,3,4,5,6,7,0}, {1,2,3,4,5,6,7,0}, {0,1,2,3,4,5,6,7}
+};
@@ -1,65 +1,225 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: NTT functions and other low-level operations
-*
-*****************************************************************************************/
-
-#include "../LatticeCrypto_priv.h"
-    
-
-void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N)
-{
-    NTT_CT_std2rev_12289_asm(a, psi_rev, N);
-}
-
-
-void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
-{
-    INTT_GS_rev2std_12289_asm(a, omegainv_rev, omegainv1N_rev, Ninv, N);
-}
-
-
-void two_reduce12289(int32_t* a, unsigned int N)
-{
-    two_reduce12289_asm(a, N);
-}
-
-
-void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
-{
-    pmul_asm(a, b, c, N);
-}
-
-
-void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
-{
-    pmuladd_asm(a, b, c, d, N);
-}
-
-
-void smul(int32_t* a, int32_t scalar, unsigned int N)
-{
-    unsigned int i; 
-
-    for (i = 0; i < N; i++) {
-        a[i] = a[i]*scalar;
-    }
-}
-
-
-void correction(int32_t* a, int32_t p, unsigned int N)
-{  
-    unsigned int i; 
-    int32_t mask;
-
-    for (i = 0; i < N; i++) {
-        mask = a[i] >> (4*sizeof(int32_t) - 1);
-        a[i] += (p & mask) - p;
-        mask = a[i] >> (4*sizeof(int32_t) - 1);
-        a[i] += (p & mask);
-    }
-}
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: NTT functions and other low-level operations
+*
+*****************************************************************************************/
+
+#include "../LatticeCrypto_priv.h"
+    
+
+void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N)
+{
+    if (N != PARAMETER_N) { // The assembly transforms are unrolled for N = 1024
+        NTT_CT_std2rev_12289_generic(a, psi_rev, N);
+        return;
+    }
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    NTT_CT_std2rev_12289_avx512_asm(a, psi_rev, N);
+#else
+    NTT_CT_std2rev_12289_asm(a, psi_rev, N);
+#endif
+}
+
+
+void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{
+    if (N != PARAMETER_N) {
+        INTT_GS_rev2std_12289_generic(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+        return;
+    }
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    INTT_GS_rev2std_12289_avx512_asm(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+#else
+    INTT_GS_rev2std_12289_asm(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+#endif
+}
+
+
+void NTT_CT_std2rev_12289_xN(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N)
+{ // One call per polynomial: each stage of the forward NTT already loads a twiddle once for a long run of butterflies, and the 
+  // interleaved AVX2 kernel was about 5% slower per polynomial
+    unsigned int p;
+
+    if (N != PARAMETER_N) {
+        NTT_CT_std2rev_12289_xN_generic(a, npolys, psi_rev, N);
+        return;
+    }
+    for (p = 0; p < npolys; p++) {
+        NTT_CT_std2rev_12289(a[p], psi_rev, N);
+    }
+}
+
+
+void INTT_GS_rev2std_12289_xN(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    unsigned int p;
+#endif
+
+    if (N != PARAMETER_N) {
+        INTT_GS_rev2std_12289_xN_generic(a, npolys, omegainv_rev, omegainv1N_rev, Ninv, N);
+        return;
+    }
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    for (p = 0; p < npolys; p++) {
+        INTT_GS_rev2std_12289_avx512_asm(a[p], omegainv_rev, omegainv1N_rev, Ninv, N);
+    }
+#else
+    if (npolys > 0) {
+        INTT_GS_rev2std_12289_xN_asm(a, omegainv_rev, omegainv1N_rev, Ninv, N, npolys);
+    }
+#endif
+}
+
+
+bool NTT_xN_faster(void)
+{ // See NTT_CT_std2rev_12289_xN
+    return false;
+}
+
+
+bool INTT_xN_faster(void)
+{ // The interleaved AVX2 inverse kernel saves about 10% per polynomial
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    return false;
+#else
+    return true;
+#endif
+}
+
+
+void two_reduce12289(int32_t* a, unsigned int N)
+{
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    two_reduce12289_avx512_asm(a, N);
+#else
+    two_reduce12289_asm(a, N);
+#endif
+}
+
+
+void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
+{
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    pmul_avx512_asm(a, b, c, N);
+#else
+    pmul_asm(a, b, c, N);
+#endif
+}
+
+
+void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
+{
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    pmuladd_avx512_asm(a, b, c, d, N);
+#else
+    pmuladd_asm(a, b, c, d, N);
+#endif
+}
+
+
+void smul(int32_t* a, int32_t scalar, unsigned int N)
+{
+    unsigned int i; 
+
+    for (i = 0; i < N; i++) {
+        a[i] = a[i]*scalar;
+    }
+}
+
+
+void correction(int32_t* a, int32_t p, unsigned int N)
+{  
+    unsigned int i; 
+    int32_t mask;
+
+    for (i = 0; i < N; i++) {
+        mask = a[i] >> (4*sizeof(int32_t) - 1);
+        a[i] += (p & mask) - p;
+        mask = a[i] >> (4*sizeof(int32_t) - 1);
+        a[i] += (p & mask);
+    }
+}
+
+
+int16_t montgomery_reduce12289(int32_t a)
+{ // Montgomery reduction modulo q, outputs a*2^-16 mod q in (-q, q) for |a| < q*2^15
+    int16_t u;
+
+    u = (int16_t)((int16_t)a*PARAMETER_QINV);
+    return (int16_t)((a - (int32_t)u*PARAMETER_Q) >> 16);
+}
+
+
+int16_t barrett_reduce12289(int16_t a)
+{ // Barrett reduction modulo q, the quotient is rounded in two steps exactly as vpmulhw/vpmulhrsw do it
+    int32_t t;
+
+    t = ((int32_t)a*PARAMETER_BARRETT) >> 16;
+    t = (t + 512) >> 10;
+    return (int16_t)(a - t*PARAMETER_Q);
+}
+
+
+// The 16-bit kernels only exist for AVX2, the AVX-512 build uses them as well
+
+void NTT_CT_std2rev_12289_int16(int16_t* a, const int16_t* psi_rev, unsigned int N)
+{
+    NTT_CT_std2rev_12289_int16_asm(a, psi_rev, N);
+}
+
+
+void INTT_GS_rev2std_12289_int16(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N)
+{
+    INTT_GS_rev2std_12289_int16_asm(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+}
+
+
+void two_reduce12289_int16(int16_t* a, unsigned int N)
+{
+    two_reduce12289_int16_asm(a, N);
+}
+
+
+void pmul_int16(int16_t* a, int16_t* b, int16_t* c, unsigned int N)
+{
+    pmul_int16_asm(a, b, c, N);
+}
+
+
+void pmuladd_int16(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N)
+{
+    pmuladd_int16_asm(a, b, c, d, N);
+}
+
+
+void smul_int16(int16_t* a, int32_t scalar, unsigned int N)
+{
+    unsigned int i;
+    int32_t s = (scalar*PARAMETER_MONT) % PARAMETER_Q;        // Montgomery representation of the scalar, centered in [-q/2, q/2]
+
+    if (s > PARAMETER_Q/2) {
+        s -= PARAMETER_Q;
+    } else if (s < -PARAMETER_Q/2) {
+        s += PARAMETER_Q;
+    }
+
+    for (i = 0; i < N; i++) {
+        a[i] = montgomery_reduce12289((int32_t)a[i]*s);
+    }
+}
+
+
+void correction_int16(int16_t* a, unsigned int N)
+{
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        a[i] = barrett_reduce12289(a[i]);
+        a[i] += (a[i] >> 15) & PARAMETER_Q;
+    }
+}
@@ -1,248 +1,506 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: main header file
-*
-*****************************************************************************************/  
-
-#ifndef __LatticeCrypto_H__
-#define __LatticeCrypto_H__
-
-
-// For C++
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-
-#include <stdint.h>
-#include <stdbool.h>
-#include <stddef.h>
-
-
-// Definition of operating system
-
-#define OS_WIN       1
-#define OS_LINUX     2
-
-#if defined(__WINDOWS__)        // Microsoft Windows OS
-    #define OS_TARGET OS_WIN
-#elif defined(__LINUX__)        // Linux OS
-    #define OS_TARGET OS_LINUX 
-#else
-    #error -- "Unsupported OS"
-#endif
-
-
-// Definition of compiler
-
-#define COMPILER_VC      1
-#define COMPILER_GCC     2
-#define COMPILER_CLANG   3
-
-#if defined(_MSC_VER)           // Microsoft Visual C compiler
-    #define COMPILER COMPILER_VC
-#elif defined(__GNUC__)         // GNU GCC compiler
-    #define COMPILER COMPILER_GCC   
-#elif defined(__clang__)        // Clang compiler
-    #define COMPILER COMPILER_CLANG   
-#else
-    #error -- "Unsupported COMPILER"
-#endif
-
-
-// Definition of the targeted architecture and basic data types
-    
-#define TARGET_AMD64        1
-#define TARGET_x86          2
-#define TARGET_ARM          3
-
-#if defined(_AMD64_)
-    #define TARGET TARGET_AMD64
-    #define RADIX           64
-    typedef uint64_t        digit_t;        // Unsigned 64-bit digit
-    typedef int64_t         sdigit_t;       // Signed 64-bit digit   
-#elif defined(_X86_)
-    #define TARGET TARGET_x86
-    #define RADIX           32
-    typedef uint32_t        digit_t;        // Unsigned 32-bit digit
-    typedef int32_t         sdigit_t;       // Signed 32-bit digit
-#elif defined(_ARM_)
-    #define TARGET TARGET_ARM
-    #define RADIX           32
-    typedef uint32_t        digit_t;        // Unsigned 32-bit digit
-    typedef int32_t         sdigit_t;       // Signed 32-bit digit
-#else
-    #error -- "Unsupported ARCHITECTURE"
-#endif
-
-
-// Instruction support
-
-#define NO_SIMD_SUPPORT 0
-#define AVX_SUPPORT     1
-#define AVX2_SUPPORT    2
-
-#if defined(_AVX2_)
-    #define SIMD_SUPPORT AVX2_SUPPORT       // AVX2 support selection 
-#elif defined(_AVX_)
-    #define SIMD_SUPPORT AVX_SUPPORT        // AVX support selection 
-#else
-    #define SIMD_SUPPORT NO_SIMD_SUPPORT
-#endif
-
-#if defined(_ASM_)                          // Assembly support selection
-    #define ASM_SUPPORT
-#endif
-
-#if defined(_GENERIC_)                      // Selection of generic, portable implementation
-    #define GENERIC_IMPLEMENTATION
-#endif
-
-
-// Unsupported configurations
-                         
-#if defined(ASM_SUPPORT) && (OS_TARGET == OS_WIN)
-    #error -- "Assembly is not supported on this platform"
-#endif        
-
-#if defined(ASM_SUPPORT) && defined(GENERIC_IMPLEMENTATION)
-    #error -- "Unsupported configuration"
-#endif        
-
-#if (SIMD_SUPPORT != NO_SIMD_SUPPORT) && defined(GENERIC_IMPLEMENTATION)
-    #error -- "Unsupported configuration"
-#endif
-
-#if (TARGET != TARGET_AMD64) && !defined(GENERIC_IMPLEMENTATION)
-    #error -- "Unsupported configuration"
-#endif
-
-#if (OS_TARGET == OS_LINUX) && defined(ASM_SUPPORT) && (SIMD_SUPPORT != AVX2_SUPPORT)
-    #error -- "Unsupported configuration"
-#endif
-
-
-// Definitions of the error-handling type and error codes
-
-typedef enum {
-    CRYPTO_SUCCESS,                          // 0x00
-    CRYPTO_ERROR,                            // 0x01
-    CRYPTO_ERROR_DURING_TEST,                // 0x02
-    CRYPTO_ERROR_UNKNOWN,                    // 0x03
-    CRYPTO_ERROR_NOT_IMPLEMENTED,            // 0x04
-    CRYPTO_ERROR_NO_MEMORY,                  // 0x05
-    CRYPTO_ERROR_INVALID_PARAMETER,          // 0x06
-    CRYPTO_ERROR_SHARED_KEY,                 // 0x07
-    CRYPTO_ERROR_TOO_MANY_ITERATIONS,        // 0x08
-    CRYPTO_ERROR_END_OF_LIST
-} CRYPTO_STATUS;
-
-#define CRYPTO_STATUS_TYPE_SIZE (CRYPTO_ERROR_END_OF_LIST)       
-
-
-// Definitions of the error messages
-// NOTE: they must match the error codes above
-
-#define CRYPTO_MSG_SUCCESS                                "CRYPTO_SUCCESS"
-#define CRYPTO_MSG_ERROR                                  "CRYPTO_ERROR"
-#define CRYPTO_MSG_ERROR_DURING_TEST                      "CRYPTO_ERROR_DURING_TEST"
-#define CRYPTO_MSG_ERROR_UNKNOWN                          "CRYPTO_ERROR_UNKNOWN"
-#define CRYPTO_MSG_ERROR_NOT_IMPLEMENTED                  "CRYPTO_ERROR_NOT_IMPLEMENTED"
-#define CRYPTO_MSG_ERROR_NO_MEMORY                        "CRYPTO_ERROR_NO_MEMORY"
-#define CRYPTO_MSG_ERROR_INVALID_PARAMETER                "CRYPTO_ERROR_INVALID_PARAMETER"
-#define CRYPTO_MSG_ERROR_SHARED_KEY                       "CRYPTO_ERROR_SHARED_KEY"
-#define CRYPTO_MSG_ERROR_TOO_MANY_ITERATIONS              "CRYPTO_ERROR_TOO_MANY_ITERATIONS"                                                            
-
-
-// Definition of type "RandomBytes" to implement callback function outputting "nbytes" of random values to "random_array"
-typedef CRYPTO_STATUS (*RandomBytes)(unsigned int nbytes, unsigned char* random_array);                                                   
-
-// Definition of type "ExtendableOutput" to implement callback function outputting 32-bit "array_ndigits" of values to "extended_array"
-typedef CRYPTO_STATUS (*ExtendableOutput)(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array);                                                  
-
-// Definition of type "StreamOutput" to implement callback function outputting 32-bit "array_ndigits" of values to "stream_array"
-typedef CRYPTO_STATUS (*StreamOutput)(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
-
-
-// Basic key-exchange constants  
-#define PKA_BYTES           1824      // Alice's public key size 
-#define PKB_BYTES           2048      // Bob's public key size 
-#define SHAREDKEY_BYTES     32        // Shared key size 
-
-
-// This data struct is initialized during setup with user-provided functions
-typedef struct
-{
-    RandomBytes      RandomBytesFunction;               // Function providing random bytes
-    ExtendableOutput ExtendableOutputFunction;          // Extendable output function
-    StreamOutput     StreamOutputFunction;              // Stream cipher function
-} LatticeCryptoStruct, *PLatticeCryptoStruct;
-
-
-/******************** Function prototypes *******************/
-/*********************** Auxiliary API **********************/ 
-
-// Clear digits from memory. "nwords" indicates the number of digits to be zeroed.
-extern void clear_words(void* mem, digit_t nwords);
-
-// Output "nbytes" of random values.
-// It makes requests of random values to RandomBytesFunction. If successful, the output is given in "random_array".
-// The caller is responsible for providing the "RandomBytesFunction" function passing random value as octets.
-CRYPTO_STATUS random_bytes(unsigned int nbytes, unsigned char* random_array, RandomBytes RandomBytesFunction);
-
-// Output "array_ndigits" of values in [0, q-1] using an extendable-output function and a seed of size "seed_nbytes".   
-// It makes requests of values to ExtendableOutputFunction. If successful, the output is given in "extended_array".
-// The caller is responsible for providing the "ExtendableOutputFunction" function passing values as 32-bit digits. 
-CRYPTO_STATUS extended_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array, ExtendableOutput ExtendableOutputFunction);
-
-// Output "array_nbytes" of values using a stream cipher, a seed of size "seed_nbytes" and a nonce of size "nonce_nbytes".  
-// It makes requests of values to StreamOutputFunction. If successful, the output is given in "stream_array".
-// The caller is responsible for providing the "StreamOutputFunction" function passing values as octets.  
-CRYPTO_STATUS stream_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array, StreamOutput StreamOutputFunction);
-
-// Dynamic allocation of memory for LatticeCrypto structure. It should be called before initialization with LatticeCrypto_initialize(). Returns NULL on error.
-PLatticeCryptoStruct LatticeCrypto_allocate(void); 
-
-// Initialize structure pLatticeCrypto with user-provided functions: RandomBytesFunction, ExtendableOutputFunction and StreamOutputFunction.
-CRYPTO_STATUS LatticeCrypto_initialize(PLatticeCryptoStruct pLatticeCrypto, RandomBytes RandomBytesFunction, ExtendableOutput ExtendableOutputFunction, StreamOutput StreamOutputFunction);
-
-// Output error/success message for a given CRYPTO_STATUS
-const char* LatticeCrypto_get_error_message(CRYPTO_STATUS Status);
-
-/*********************** Key exchange API ***********************/ 
-
-// Alice's key generation 
-// It produces a private key SecretKeyA and computes the public key PublicKeyA.
-// Outputs: the private key SecretKeyA that consists of a 32-bit signed 1024-element array (4096 bytes in total)
-//          the public key PublicKeyA that occupies 1824 bytes
-// pLatticeCrypto must be set up in advance using LatticeCrypto_initialize().
-CRYPTO_STATUS KeyGeneration_A(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
-
-// Bob's key generation and shared secret computation
-// It produces a private key and computes the public key PublicKeyB. In combination with Alice's public key PublicKeyA, it computes 
-// the shared secret SharedSecretB.
-// Input:   Alice's public key PublicKeyA that consists of 1824 bytes
-// Outputs: the public key PublicKeyB that occupies 2048 bytes.
-//          the 256-bit shared secret SharedSecretB.
-// pLatticeCrypto must be set up in advance using LatticeCrypto_initialize().
-CRYPTO_STATUS SecretAgreement_B(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
-
-// Alice's shared secret computation 
-// It computes the shared secret SharedSecretA using Bob's public key PublicKeyB and Alice's private key SecretKeyA.
-// Inputs: Bob's public key PublicKeyB that consists of 2048 bytes
-//         the private key SecretKeyA that consists of a 32-bit signed 1024-element array (4096 bytes in total)
-// Output: the 256-bit shared secret SharedSecretA.
-// pLatticeCrypto must be set up in advance using LatticeCrypto_initialize().
-CRYPTO_STATUS SecretAgreement_A(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
-
-
-#ifdef __cplusplus
-}
-#endif
-
-
-#endif
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: main header file
+*
+*****************************************************************************************/  
+
+#ifndef __LatticeCrypto_H__
+#define __LatticeCrypto_H__
+
+
+// For C++
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+
+// Definition of operating system
+
+#define OS_WIN       1
+#define OS_LINUX     2
+
+#if defined(__WINDOWS__)        // Microsoft Windows OS
+    #define OS_TARGET OS_WIN
+#elif defined(__LINUX__)        // Linux OS
+    #define OS_TARGET OS_LINUX 
+#else
+    #error -- "Unsupported OS"
+#endif
+
+
+// Definition of compiler
+
+#define COMPILER_VC      1
+#define COMPILER_GCC     2
+#define COMPILER_CLANG   3
+
+#if defined(_MSC_VER)           // Microsoft Visual C compiler
+    #define COMPILER COMPILER_VC
+#elif defined(__GNUC__)         // GNU GCC compiler
+    #define COMPILER COMPILER_GCC   
+#elif defined(__clang__)        // Clang compiler
+    #define COMPILER COMPILER_CLANG   
+#else
+    #error -- "Unsupported COMPILER"
+#endif
+
+
+// Definition of the targeted architecture and basic data types
+    
+#define TARGET_AMD64        1
+#define TARGET_x86          2
+#define TARGET_ARM          3
+
+#if defined(_AMD64_)
+    #define TARGET TARGET_AMD64
+    #define RADIX           64
+    typedef uint64_t        digit_t;        // Unsigned 64-bit digit
+    typedef int64_t         sdigit_t;       // Signed 64-bit digit   
+#elif defined(_X86_)
+    #define TARGET TARGET_x86
+    #define RADIX           32
+    typedef uint32_t        digit_t;        // Unsigned 32-bit digit
+    typedef int32_t         sdigit_t;       // Signed 32-bit digit
+#elif defined(_ARM_)
+    #define TARGET TARGET_ARM
+    #define RADIX           32
+    typedef uint32_t        digit_t;        // Unsigned 32-bit digit
+    typedef int32_t         sdigit_t;       // Signed 32-bit digit
+#else
+    #error -- "Unsupported ARCHITECTURE"
+#endif
+
+
+// Instruction support
+
+#define NO_SIMD_SUPPORT 0
+#define AVX_SUPPORT     1
+#define AVX2_SUPPORT    2
+#define AVX512_SUPPORT  3
+
+#if defined(_AVX512_)
+    #define SIMD_SUPPORT AVX512_SUPPORT     // AVX-512 support selection 
+#elif defined(_AVX2_)
+    #define SIMD_SUPPORT AVX2_SUPPORT       // AVX2 support selection 
+#elif defined(_AVX_)
+    #define SIMD_SUPPORT AVX_SUPPORT        // AVX support selection 
+#else
+    #define SIMD_SUPPORT NO_SIMD_SUPPORT
+#endif
+
+#if defined(_ASM_)                          // Assembly support selection
+    #define ASM_SUPPORT
+#endif
+
+#if defined(_GENERIC_)                      // Selection of generic, portable implementation
+    #define GENERIC_IMPLEMENTATION
+#endif
+
+#if defined(_VECTOR_)                       // Generic implementation vectorized with GCC/Clang vector extensions
+    #define VECTOR_SUPPORT
+#endif
+
+#if defined(_DISPATCH_)                     // Runtime selection among the generic, AVX2 and AVX-512 implementations
+    #define DISPATCH_SUPPORT
+#endif
+
+#if defined(_INT16_)                        // Key exchange on 16-bit coefficients (the 32-bit API is kept)
+    #define INT16_SUPPORT
+#endif
+
+#if defined(_BOUNDS_)                       // Coefficient range tracking in the key exchange, for testing the reduction schedule
+    #define BOUND_TRACKING
+#endif
+
+
+// Unsupported configurations
+                         
+#if defined(ASM_SUPPORT) && (OS_TARGET == OS_WIN)
+    #error -- "Assembly is not supported on this platform"
+#endif        
+
+#if defined(ASM_SUPPORT) && defined(GENERIC_IMPLEMENTATION)
+    #error -- "Unsupported configuration"
+#endif        
+
+#if (SIMD_SUPPORT != NO_SIMD_SUPPORT) && defined(GENERIC_IMPLEMENTATION)
+    #error -- "Unsupported configuration"
+#endif
+
+#if (TARGET != TARGET_AMD64) && !defined(GENERIC_IMPLEMENTATION)
+    #error -- "Unsupported configuration"
+#endif
+
+#if (OS_TARGET == OS_LINUX) && defined(ASM_SUPPORT) && (SIMD_SUPPORT < AVX2_SUPPORT)
+    #error -- "Unsupported configuration"
+#endif
+
+#if defined(DISPATCH_SUPPORT) && (defined(ASM_SUPPORT) || defined(GENERIC_IMPLEMENTATION) || (SIMD_SUPPORT != NO_SIMD_SUPPORT))
+    #error -- "Unsupported configuration"
+#endif
+
+#if defined(VECTOR_SUPPORT) && (!defined(GENERIC_IMPLEMENTATION) || (COMPILER == COMPILER_VC))
+    #error -- "Vector extensions require the generic implementation and GCC or clang"
+#endif
+
+#if defined(BOUND_TRACKING) && !defined(GENERIC_IMPLEMENTATION)
+    #error -- "Bound tracking requires the generic implementation"
+#endif
+
+#if defined(DISPATCH_SUPPORT) && (OS_TARGET != OS_LINUX)
+    #error -- "Runtime dispatch is not supported on this platform"
+#endif
+
+
+// Definitions of the error-handling type and error codes
+
+typedef enum {
+    CRYPTO_SUCCESS,                          // 0x00
+    CRYPTO_ERROR,                            // 0x01
+    CRYPTO_ERROR_DURING_TEST,                // 0x02
+    CRYPTO_ERROR_UNKNOWN,                    // 0x03
+    CRYPTO_ERROR_NOT_IMPLEMENTED,            // 0x04
+    CRYPTO_ERROR_NO_MEMORY,                  // 0x05
+    CRYPTO_ERROR_INVALID_PARAMETER,          // 0x06
+    CRYPTO_ERROR_SHARED_KEY,                 // 0x07
+    CRYPTO_ERROR_TOO_MANY_ITERATIONS,        // 0x08
+    CRYPTO_ERROR_END_OF_LIST
+} CRYPTO_STATUS;
+
+#define CRYPTO_STATUS_TYPE_SIZE (CRYPTO_ERROR_END_OF_LIST)       
+
+
+// Definitions of the error messages
+// NOTE: they must match the error codes above
+
+#define CRYPTO_MSG_SUCCESS                                "CRYPTO_SUCCESS"
+#define CRYPTO_MSG_ERROR                                  "CRYPTO_ERROR"
+#define CRYPTO_MSG_ERROR_DURING_TEST                      "CRYPTO_ERROR_DURING_TEST"
+#define CRYPTO_MSG_ERROR_UNKNOWN                          "CRYPTO_ERROR_UNKNOWN"
+#define CRYPTO_MSG_ERROR_NOT_IMPLEMENTED                  "CRYPTO_ERROR_NOT_IMPLEMENTED"
+#define CRYPTO_MSG_ERROR_NO_MEMORY                        "CRYPTO_ERROR_NO_MEMORY"
+#define CRYPTO_MSG_ERROR_INVALID_PARAMETER                "CRYPTO_ERROR_INVALID_PARAMETER"
+#define CRYPTO_MSG_ERROR_SHARED_KEY                       "CRYPTO_ERROR_SHARED_KEY"
+#define CRYPTO_MSG_ERROR_TOO_MANY_ITERATIONS              "CRYPTO_ERROR_TOO_MANY_ITERATIONS"                                                            
+
+
+// Definition of the implementation backends
+
+typedef enum {
+    CRYPTO_BACKEND_AUTO,                     // Best backend supported by the running CPU
+    CRYPTO_BACKEND_GENERIC,                  // Portable C
+    CRYPTO_BACKEND_AVX2,                     // AVX2 assembly
+    CRYPTO_BACKEND_AVX512,                   // AVX-512 assembly
+    CRYPTO_BACKEND_END_OF_LIST
+} CRYPTO_BACKEND;
+
+
+// Definition of type "RandomBytes" to implement callback function outputting "nbytes" of random values to "random_array"
+typedef CRYPTO_STATUS (*RandomBytes)(unsigned int nbytes, unsigned char* random_array);                                                   
+
+// Definition of type "ExtendableOutput" to implement callback function outputting 32-bit "array_ndigits" of values to "extended_array"
+typedef CRYPTO_STATUS (*ExtendableOutput)(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array);                                                  
+
+// Definition of type "StreamOutput" to implement callback function outputting 32-bit "array_ndigits" of values to "stream_array"
+typedef CRYPTO_STATUS (*StreamOutput)(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
+
+// Definition of type "StreamOutputMulti" to implement callback function outputting the streams for "nnonces" nonces, with array_nbytes[i] octets for the i-th one, 
+// one after the other to "stream_array". The output must be the same as from one StreamOutput call per nonce
+typedef CRYPTO_STATUS (*StreamOutputMulti)(const unsigned char* seed, unsigned int seed_nbytes, const unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array);
+
+
+// Basic key-exchange constants  
+#define PKA_BYTES           1824      // Alice's public key size 
+#define PKB_BYTES           2048      // Bob's public key size 
+#define SHAREDKEY_BYTES     32        // Shared key size 
+#define SKA_PACKED_BYTES    1792      // Alice's packed secret key size 
+
+// Key-exchange constants of the parameter sets with ring dimension N = 512 and N = 2048 (the default one above has N = 1024)
+#define PKA_BYTES_512           928       // Alice's public key size 
+#define PKB_BYTES_512           1024      // Bob's public key size 
+#define SHAREDKEY_BYTES_512     16        // Shared key size, only 128 bits: see KeyGeneration_A_512() 
+#define PKA_BYTES_2048          3616      // Alice's public key size 
+#define PKB_BYTES_2048          4096      // Bob's public key size 
+#define SHAREDKEY_BYTES_2048    64        // Shared key size 
+
+#define A_CACHE_MAX_ENTRIES     256       // Largest number of entries of the cache of the expanded parameter a
+#define NOISE_POOL_MAX_SLOTS    1024      // Largest number of slots of the noise pool
+#define KEYPAIR_POOL_MAX_KEYPAIRS 1024    // Largest number of key pairs of the key pair pool
+#define HANDSHAKE_WORKERS_MAX   256       // Largest number of threads of the worker pool
+
+
+// This data struct is initialized during setup with user-provided functions
+typedef struct
+{
+    RandomBytes      RandomBytesFunction;               // Function providing random bytes
+    ExtendableOutput ExtendableOutputFunction;          // Extendable output function
+    StreamOutput     StreamOutputFunction;              // Stream cipher function
+    StreamOutputMulti StreamOutputMultiFunction;        // Optional stream cipher function for several nonces in one call, NULL if not available
+    struct LatticeCryptoACache* ACache;                 // Optional cache of the expanded parameter a, see LatticeCrypto_enable_a_cache()
+    struct LatticeCryptoNoisePool* NoisePool;           // Optional pool of noise in NTT form, see LatticeCrypto_enable_noise_pool()
+    struct LatticeCryptoKeypairPool* KeypairPool;       // Optional pool of Alice's key pairs, see LatticeCrypto_enable_keypair_pool()
+    struct LatticeCryptoWorkers* Workers;               // Optional pool of threads running handshake jobs, see LatticeCrypto_enable_workers()
+} LatticeCryptoStruct, *PLatticeCryptoStruct;
+
+// Workspace of the key exchange functions with suffix _ws, see LatticeCrypto_allocate_workspace()
+typedef struct LatticeCryptoWorkspace* PLatticeCryptoWorkspace;
+
+// Steps of a handshake that the worker pool runs, see LatticeCrypto_submit_handshake()
+typedef enum {
+    HANDSHAKE_KEYGENERATION_A,               // KeyGeneration_A(SecretKeyA, PublicKeyA)
+    HANDSHAKE_AGREEMENT_B,                   // SecretAgreement_B(PublicKeyA, SharedSecret, PublicKeyB)
+    HANDSHAKE_AGREEMENT_A                    // SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecret)
+} HANDSHAKE_STEP;
+
+// Handshake job of the worker pool. The caller owns it and the buffers it points to, which must stay valid until its completion
+typedef struct LatticeCryptoHandshakeJob
+{
+    HANDSHAKE_STEP   Step;
+    int32_t*         SecretKeyA;                        // 1024 coefficients
+    unsigned char*   PublicKeyA;                        // PKA_BYTES
+    unsigned char*   PublicKeyB;                        // PKB_BYTES
+    unsigned char*   SharedSecret;                      // SHAREDKEY_BYTES
+    CRYPTO_STATUS    Status;                            // Result of the step, set before the completion
+    void (*Completion)(struct LatticeCryptoHandshakeJob* job);   // Called by the worker thread when the step is done, may be NULL
+    void*            Context;                           // Free for the caller
+    struct LatticeCryptoHandshakeJob* Next;             // Used by the pool
+} LatticeCryptoHandshakeJob, *PLatticeCryptoHandshakeJob;
+
+// Function called by each thread of the worker pool when it starts, with its index, e.g. to seed thread-local random number generators
+typedef void (*WorkerStart)(unsigned int index);
+
+
+/******************** Function prototypes *******************/
+/*********************** Auxiliary API **********************/ 
+
+// Clear digits from memory. "nwords" indicates the number of digits to be zeroed.
+extern void clear_words(void* mem, digit_t nwords);
+
+// Output "nbytes" of random values.
+// It makes requests of random values to RandomBytesFunction. If successful, the output is given in "random_array".
+// The caller is responsible for providing the "RandomBytesFunction" function passing random value as octets.
+CRYPTO_STATUS random_bytes(unsigned int nbytes, unsigned char* random_array, RandomBytes RandomBytesFunction);
+
+// Output "array_ndigits" of values in [0, q-1] using an extendable-output function and a seed of size "seed_nbytes".   
+// It makes requests of values to ExtendableOutputFunction. If successful, the output is given in "extended_array".
+// The caller is responsible for providing the "ExtendableOutputFunction" function passing values as 32-bit digits. 
+CRYPTO_STATUS extended_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array, ExtendableOutput ExtendableOutputFunction);
+
+// Output "array_nbytes" of values using a stream cipher, a seed of size "seed_nbytes" and a nonce of size "nonce_nbytes".  
+// It makes requests of values to StreamOutputFunction. If successful, the output is given in "stream_array".
+// The caller is responsible for providing the "StreamOutputFunction" function passing values as octets.  
+CRYPTO_STATUS stream_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array, StreamOutput StreamOutputFunction);
+
+// Output the streams for "nnonces" nonces of size "nonce_nbytes", with array_nbytes[i] values for nonces[nonce_nbytes*i], one after the other in "stream_array".
+// It makes one request to StreamOutputMultiFunction if it is not NULL, else one request per nonce to StreamOutputFunction.
+CRYPTO_STATUS stream_output_multi(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array, StreamOutputMulti StreamOutputMultiFunction, StreamOutput StreamOutputFunction);
+
+// Dynamic allocation of memory for LatticeCrypto structure. It should be called before initialization with LatticeCrypto_initialize(). Returns NULL on error.
+PLatticeCryptoStruct LatticeCrypto_allocate(void); 
+
+// Release a structure from LatticeCrypto_allocate(), with its cache of a, its pools and its workers if any.
+void LatticeCrypto_free(PLatticeCryptoStruct pLatticeCrypto);
+
+// Dynamic allocation of a workspace that holds the buffers of one key exchange call or batch (about 106 KB), 64-byte aligned, for KeyGeneration_A_ws, 
+// SecretAgreement_B_ws, SecretAgreement_A_ws and the batched functions. Returns NULL on error. A workspace may be reused by any number of calls, but by one thread at a time.
+PLatticeCryptoWorkspace LatticeCrypto_allocate_workspace(void);
+
+// Wipe and release a workspace from LatticeCrypto_allocate_workspace().
+void LatticeCrypto_free_workspace(PLatticeCryptoWorkspace workspace);
+
+// Initialize structure pLatticeCrypto with user-provided functions: RandomBytesFunction, ExtendableOutputFunction and StreamOutputFunction.
+// ExtendableOutputFunction = NULL selects the built-in LatticeCrypto_shake128(), and StreamOutputFunction = NULL the built-in LatticeCrypto_chacha20().
+// With LatticeCrypto_aes256ctr() it also sets StreamOutputMultiFunction to LatticeCrypto_aes256ctr_multi(), so that the key exchange gets all the 
+// noise of a party in one call that expands the key once; with another StreamOutputFunction it is set to NULL, and the key exchange makes one 
+// request per nonce, sampling each error as soon as its stream is output. It may be set afterwards to a matching StreamOutputMulti function.
+// In builds with runtime dispatch (DISPATCH=TRUE) the first call in the process also selects the backend, unless one was forced before with 
+// LatticeCrypto_set_backend(): the one named by the LATTICECRYPTO_BACKEND environment variable ("generic", "avx2" or "avx512") if the CPU supports 
+// it, else the best one the CPU supports. Later calls keep the backend in use.
+CRYPTO_STATUS LatticeCrypto_initialize(PLatticeCryptoStruct pLatticeCrypto, RandomBytes RandomBytesFunction, ExtendableOutput ExtendableOutputFunction, StreamOutput StreamOutputFunction);
+
+// Built-in extendable-output function, for use as ExtendableOutputFunction. It runs 4 SHAKE128 instances on seed||0, ..., seed||3 (the index 
+// as one byte), and instance j fills the j-th quarter of extended_array with the 14 low bits of its 16-bit little-endian output words that are 
+// in [0, q-1]. The 4 instances run in parallel with AVX2 in the assembly builds.
+CRYPTO_STATUS LatticeCrypto_shake128(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array);
+
+// Rejection sampling helper for ExtendableOutputFunction callbacks. It outputs to a, in order, the 14 low bits of the 16-bit little-endian words 
+// of buf that are in [0, q-1], up to "ndigits" values, and returns their number; if it is less than ndigits, all of buf was used and the 
+// caller can continue at a[count] with more output. 8 candidates are processed at a time with AVX2 in the assembly builds.
+unsigned int LatticeCrypto_rejection_sample(uint32_t* a, unsigned int ndigits, const unsigned char* buf, unsigned int buf_nbytes);
+
+// Built-in stream cipher, for use as StreamOutputFunction. It outputs the ChaCha20 keystream for the 32-byte key seed and the nonce of up to 
+// 8 bytes (zero-padded), with a 64-bit block counter starting at 0. 8 blocks are computed in parallel with AVX2 in the assembly builds.
+// LatticeCrypto_chacha20_multi() is its StreamOutputMulti version.
+CRYPTO_STATUS LatticeCrypto_chacha20(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
+CRYPTO_STATUS LatticeCrypto_chacha20_multi(const unsigned char* seed, unsigned int seed_nbytes, const unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array);
+
+// Alternative built-in stream cipher, for use as StreamOutputFunction. It outputs the AES-256-CTR keystream for the 32-byte key seed, with counter 
+// block i = nonce||i for the nonce of up to 8 bytes (zero-padded) and i as a 64-bit big-endian integer starting at 0. 8 blocks are pipelined with 
+// AES-NI. Returns CRYPTO_ERROR_NOT_IMPLEMENTED in the generic builds and on CPUs without AES-NI.
+// LatticeCrypto_aes256ctr_multi() is its StreamOutputMulti version, which expands the key once for all the nonces.
+CRYPTO_STATUS LatticeCrypto_aes256ctr(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
+CRYPTO_STATUS LatticeCrypto_aes256ctr_multi(const unsigned char* seed, unsigned int seed_nbytes, const unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array);
+
+// Set up a bounded, thread-safe cache of the expanded parameter a in pLatticeCrypto, replacing any previous one; nentries = 0 removes it.
+// KeyGeneration_A and SecretAgreement_B look a up by its seed (and ring dimension and ExtendableOutputFunction), so a hit skips the extendable output 
+// and its rejection sampling. It keeps the "nentries" (up to A_CACHE_MAX_ENTRIES) most recently used values. pLatticeCrypto must come from 
+// LatticeCrypto_allocate() and be released with LatticeCrypto_free(). The cache must not be enabled or removed while other threads use pLatticeCrypto.
+CRYPTO_STATUS LatticeCrypto_enable_a_cache(PLatticeCryptoStruct pLatticeCrypto, unsigned int nentries);
+
+// Remove the cache of the expanded parameter a from pLatticeCrypto, if any.
+void LatticeCrypto_disable_a_cache(PLatticeCryptoStruct pLatticeCrypto);
+
+// Output the number of lookups of a that hit and missed the cache of pLatticeCrypto since it was enabled.
+void LatticeCrypto_get_a_cache_stats(PLatticeCryptoStruct pLatticeCrypto, uint64_t* hits, uint64_t* misses);
+
+// Set up a pool of "nslots" (up to NOISE_POOL_MAX_SLOTS) noise slots in pLatticeCrypto, replacing any previous one; nslots = 0 removes it.
+// A background thread fills the slots with the noise of a party in NTT form (s, e, v and the random bits of HelpRec), sampled from fresh error seeds, 
+// and the 32-bit KeyGeneration_A and SecretAgreement_B with N = 1024 take a ready slot without locking instead of sampling and transforming their 
+// noise, or sample it as usual when the pool is empty. Each slot is used once and cleared when taken. The thread calls RandomBytesFunction and 
+// StreamOutputFunction concurrently with the caller's threads, so they must be thread-safe. pLatticeCrypto must come from LatticeCrypto_allocate() 
+// and be released with LatticeCrypto_free(), and must not be initialized again, nor the pool enabled or removed, while other threads use it.
+CRYPTO_STATUS LatticeCrypto_enable_noise_pool(PLatticeCryptoStruct pLatticeCrypto, unsigned int nslots);
+
+// Stop the producer thread and remove the noise pool from pLatticeCrypto, if any.
+void LatticeCrypto_disable_noise_pool(PLatticeCryptoStruct pLatticeCrypto);
+
+// Output the number of ready slots of the noise pool of pLatticeCrypto, and the number of requests that took a slot and that found it empty since it was enabled.
+void LatticeCrypto_get_noise_pool_stats(PLatticeCryptoStruct pLatticeCrypto, unsigned int* nready, uint64_t* hits, uint64_t* misses);
+
+// Set up a pool of "nkeypairs" (up to KEYPAIR_POOL_MAX_KEYPAIRS) ephemeral key pairs of Alice in pLatticeCrypto, replacing any previous one; nkeypairs = 0 
+// removes it. A background thread runs KeyGeneration_A to refill the pool whenever a key pair is taken, so that a client only pays for SecretAgreement_A 
+// at connection setup. The same conditions as for LatticeCrypto_enable_noise_pool() apply: RandomBytesFunction, ExtendableOutputFunction and 
+// StreamOutputFunction must be thread-safe, and pLatticeCrypto must be released with LatticeCrypto_free() and not be changed while other threads use it.
+CRYPTO_STATUS LatticeCrypto_enable_keypair_pool(PLatticeCryptoStruct pLatticeCrypto, unsigned int nkeypairs);
+
+// Stop the refill thread and remove the key pair pool from pLatticeCrypto, if any, wiping the key pairs it still holds.
+void LatticeCrypto_disable_keypair_pool(PLatticeCryptoStruct pLatticeCrypto);
+
+// Output a key pair of Alice, as from KeyGeneration_A: a ready one from the pool of pLatticeCrypto, which is then wiped from the pool, or a new one 
+// if the pool is empty or disabled. Each key pair is output once. It can be called from several threads without locking.
+CRYPTO_STATUS LatticeCrypto_take_keypair(PLatticeCryptoStruct pLatticeCrypto, int32_t* SecretKeyA, unsigned char* PublicKeyA);
+
+// Start a pool of "nthreads" (up to HANDSHAKE_WORKERS_MAX) threads that run the handshake jobs of pLatticeCrypto, replacing any previous one; 
+// nthreads = 0 removes it. Each thread has its own workspace (see LatticeCrypto_allocate_workspace()) and its own queue of jobs, and takes jobs 
+// from the other queues when its own is empty. start, if not NULL, is called by each thread before it runs any job, so that it can set up 
+// per-thread state such as the random number generator behind RandomBytesFunction. The jobs call RandomBytesFunction, ExtendableOutputFunction 
+// and StreamOutputFunction concurrently, so they must be thread-safe, and pLatticeCrypto must not be changed while the pool is enabled.
+CRYPTO_STATUS LatticeCrypto_enable_workers(PLatticeCryptoStruct pLatticeCrypto, unsigned int nthreads, WorkerStart start);
+
+// Wait for the pending jobs, including those submitted by completion callbacks in the meantime, stop the threads and remove the worker pool 
+// from pLatticeCrypto, if any, wiping the workspaces.
+void LatticeCrypto_disable_workers(PLatticeCryptoStruct pLatticeCrypto);
+
+// Queue a handshake job to the worker pool of pLatticeCrypto and return. A worker runs job->Step on 32-bit coefficients (as KeyGeneration_A_ws, 
+// SecretAgreement_B_ws or SecretAgreement_A_ws), sets job->Status and calls job->Completion(job), from which the job may be submitted again, 
+// e.g. for the next step. It can be called from any thread, including completion callbacks. Returns CRYPTO_ERROR_INVALID_PARAMETER without a pool.
+CRYPTO_STATUS LatticeCrypto_submit_handshake(PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoHandshakeJob job);
+
+// Output the number of threads of the worker pool of pLatticeCrypto, and the number of jobs they completed and took from the queues of other threads.
+void LatticeCrypto_get_worker_stats(PLatticeCryptoStruct pLatticeCrypto, unsigned int* nthreads, uint64_t* completed, uint64_t* stolen);
+
+// Output the metrics of the key pair pool of pLatticeCrypto: its depth (ready key pairs), and the number of key pairs generated by the refill thread 
+// (its rate over an interval is the refill rate), taken from the pool, and generated on request because the pool was empty, since it was enabled.
+void LatticeCrypto_get_keypair_pool_stats(PLatticeCryptoStruct pLatticeCrypto, unsigned int* nready, uint64_t* produced, uint64_t* hits, uint64_t* misses);
+
+// Output error/success message for a given CRYPTO_STATUS
+const char* LatticeCrypto_get_error_message(CRYPTO_STATUS Status);
+
+// Force the backend used by all subsequent operations; CRYPTO_BACKEND_AUTO returns to the selection done by LatticeCrypto_initialize().
+// Returns CRYPTO_ERROR_NOT_IMPLEMENTED if the backend is not built in or not supported by the running CPU.
+// The backend is process-wide: it must not be changed while other threads run LatticeCrypto functions.
+CRYPTO_STATUS LatticeCrypto_set_backend(CRYPTO_BACKEND Backend);
+
+// Output the name of the backend in use
+const char* LatticeCrypto_get_backend_name(void);
+
+/*********************** Key exchange API ***********************/ 
+
+// Alice's key generation 
+// It produces a private key SecretKeyA and computes the public key PublicKeyA.
+// Outputs: the private key SecretKeyA that consists of a 32-bit signed 1024-element array (4096 bytes in total)
+//          the public key PublicKeyA that occupies 1824 bytes
+// pLatticeCrypto must be set up in advance using LatticeCrypto_initialize().
+// With INT16_SUPPORT the computation runs on 16-bit coefficients and SecretKeyA is stored reduced to [0, q-1]; the messages and 
+// the private key remain compatible with the 32-bit computation.
+CRYPTO_STATUS KeyGeneration_A(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+
+// Bob's key generation and shared secret computation
+// It produces a private key and computes the public key PublicKeyB. In combination with Alice's public key PublicKeyA, it computes 
+// the shared secret SharedSecretB.
+// Input:   Alice's public key PublicKeyA that consists of 1824 bytes
+// Outputs: the public key PublicKeyB that occupies 2048 bytes.
+//          the 256-bit shared secret SharedSecretB.
+// pLatticeCrypto must be set up in advance using LatticeCrypto_initialize().
+CRYPTO_STATUS SecretAgreement_B(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+
+// Alice's shared secret computation 
+// It computes the shared secret SharedSecretA using Bob's public key PublicKeyB and Alice's private key SecretKeyA.
+// Inputs: Bob's public key PublicKeyB that consists of 2048 bytes
+//         the private key SecretKeyA that consists of a 32-bit signed 1024-element array (4096 bytes in total)
+// Output: the 256-bit shared secret SharedSecretA.
+// pLatticeCrypto must be set up in advance using LatticeCrypto_initialize().
+CRYPTO_STATUS SecretAgreement_A(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
+
+// Batched key generation of Alice and shared secret computation of Bob for servers that handle many handshakes at once
+// The same as "count" calls to KeyGeneration_A or SecretAgreement_B, on arrays of "count" consecutive keys (SecretKeyA[1024*i], PublicKeyA[1824*i], 
+// PublicKeyB[2048*i] and SharedSecretB[32*i] for client i), with their buffers in workspace. The clients are processed in groups of 4 whose NTTs are 
+// interleaved where that is faster than one call per client, which is only the case of the inverse NTT of SecretAgreement_B_batch with AVX2 and in the 
+// generic build without VECTOR. They always run on 32-bit coefficients. On error, the outputs of the clients not yet processed are undefined.
+CRYPTO_STATUS KeyGeneration_A_batch(unsigned int count, int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace);
+CRYPTO_STATUS SecretAgreement_B_batch(unsigned int count, unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace);
+
+// The same as KeyGeneration_A, SecretAgreement_B and SecretAgreement_A on 32-bit coefficients, with their buffers in workspace instead of the stack, 
+// for callers with many threads or coroutines on small stacks. The secret intermediate values are wiped from workspace before returning.
+CRYPTO_STATUS KeyGeneration_A_ws(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace);
+CRYPTO_STATUS SecretAgreement_B_ws(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace);
+CRYPTO_STATUS SecretAgreement_A_ws(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA, PLatticeCryptoWorkspace workspace);
+
+// Alice's secret key packed into SKA_PACKED_BYTES (1792) bytes instead of 4096, for servers that keep many pending handshakes. KeyGeneration_A_packed 
+// outputs it, LatticeCrypto_pack_secret_key packs a SecretKeyA from the other functions, and SecretAgreement_A_packed unpacks it on the fly by blocks 
+// of coefficients, fused with the component-wise multiplication. They compute the same keys as the functions on 32-bit coefficients.
+CRYPTO_STATUS LatticeCrypto_pack_secret_key(const int32_t* SecretKeyA, unsigned char* PackedSecretKeyA);
+CRYPTO_STATUS KeyGeneration_A_packed(unsigned char* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_A_packed(unsigned char* PublicKeyB, const unsigned char* SecretKeyA, unsigned char* SharedSecretA);
+
+// Key exchange with ring dimension N = 512, for latency-sensitive links
+// Same as above, with a 512-element SecretKeyA (2048 bytes), a 928-byte PublicKeyA, a 1024-byte PublicKeyB and a 128-bit shared secret.
+// It always runs on 32-bit coefficients and uses the portable NTT, even in assembly builds.
+// NON-STANDARD: the reconciliation of the default set extracts one key bit from 4 coefficients, so with N = 512 the shared secret has 128 bits only, 
+// half the strength of the 256-bit key of the other sets against quantum key search. This is not NewHope-512, which encodes a 256-bit key into 
+// pairs of coefficients, and it does not interoperate with it. Use it only between peers that both run this library, where a 128-bit key is acceptable.
+CRYPTO_STATUS KeyGeneration_A_512(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_B_512(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_A_512(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
+
+// Key exchange with ring dimension N = 2048, for long-term secrets
+// Same as above, with a 2048-element SecretKeyA (8192 bytes), a 3616-byte PublicKeyA, a 4096-byte PublicKeyB and a 512-bit shared secret.
+// It always runs on 32-bit coefficients and uses the portable NTT, even in assembly builds.
+CRYPTO_STATUS KeyGeneration_A_2048(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_B_2048(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_A_2048(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
+
+// Key exchange with N = 1024 and narrower noise, psi_8 or psi_4 instead of psi_12, for internal links that accept a lower security margin in exchange 
+// for 2/3 or 1/3 of the error stream (the failure rate only drops). The keys have the same sizes as above, and Alice's shared secret is computed with 
+// SecretAgreement_A(). Both parties must use the same width.
+CRYPTO_STATUS KeyGeneration_A_psi8(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_B_psi8(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS KeyGeneration_A_psi4(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_B_psi4(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
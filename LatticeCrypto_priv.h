@@ -1,125 +1,398 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: internal header file
-*
-*****************************************************************************************/  
-
-#ifndef __LatticeCrypto_priv_H__
-#define __LatticeCrypto_priv_H__
-
-
-// For C++
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-
-#include "LatticeCrypto.h"
-
-
-// Basic constants            
-#define PARAMETER_N         1024 
-#define PARAMETER_Q         12289 
-#define SEED_BYTES          256/8
-#define ERROR_SEED_BYTES    256/8
-#define NONCE_SEED_BYTES    256/8
-#define PARAMETER_Q4        3073 
-#define PARAMETER_3Q4       9217 
-#define PARAMETER_5Q4       15362 
-#define PARAMETER_7Q4       21506 
-#define PARAMETER_Q2        6145 
-#define PARAMETER_3Q2       18434
-    
-
-// Macro definitions
-
-#define NBITS_TO_NWORDS(nbits)      (((nbits)+(sizeof(digit_t)*8)-1)/(sizeof(digit_t)*8))    // Conversion macro from number of bits to number of computer words
-#define NBYTES_TO_NWORDS(nbytes)    (((nbytes)+sizeof(digit_t)-1)/sizeof(digit_t))           // Conversion macro from number of bytes to number of computer words
-
-// Macro to avoid compiler warnings when detecting unreferenced parameters
-#define UNREFERENCED_PARAMETER(PAR) (PAR)
-
-
-/******************** Function prototypes *******************/
-/******************* Polynomial functions *******************/
-
-// Forward NTT
-void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N);
-void NTT_CT_std2rev_12289_asm(int32_t* a, const int32_t* psi_rev, unsigned int N);
-
-// Inverse NTT
-void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
-void INTT_GS_rev2std_12289_asm(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
-
-// Reduction modulo q
-int32_t reduce12289(int64_t a);
-
-// Two merged reductions modulo q
-int32_t reduce12289_2x(int64_t a);
-
-// Two consecutive reductions modulo q
-void two_reduce12289(int32_t* a, unsigned int N);
-void two_reduce12289_asm(int32_t* a, unsigned int N);
-
-// Correction modulo q
-void correction(int32_t* a, int32_t p, unsigned int N);
-
-// Component-wise multiplication
-void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
-void pmul_asm(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
-
-// Component-wise multiplication and addition
-void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
-void pmuladd_asm(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
-
-// Component-wise multiplication with scalar
-void smul(int32_t* a, int32_t scalar, unsigned int N);
-
-/******************* Key exchange functions *******************/
-
-// Alice's message encoding
-void encode_A(const uint32_t* pk, const unsigned char* seed, unsigned char* m);
-
-// Alice's message decoding
-void decode_A(const unsigned char* m, uint32_t *pk, unsigned char* seed); 
-    
-// Bob's message encoding
-void encode_B(const uint32_t* pk, const uint32_t* rvec, unsigned char* m);
-    
-// Bob's message decoding
-void decode_B(unsigned char* m, uint32_t* pk, uint32_t* rvec);
-
-// Partial message encoding/decoding (assembly optimized) 
-void encode_asm(const uint32_t* pk, unsigned char* m);
-void decode_asm(const unsigned char* m, uint32_t *pk);
-
-// Reconciliation helper
-CRYPTO_STATUS HelpRec(const uint32_t* x, uint32_t* rvec, const unsigned char* seed, unsigned int nonce, StreamOutput StreamOutputFunction);
-
-// Partial reconciliation helper (assembly optimized)        
-void helprec_asm(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits);
-
-// Reconciliation
-void Rec(const uint32_t *x, const uint32_t* rvec, unsigned char *key);
-void rec_asm(const uint32_t *x, const uint32_t* rvec, unsigned char *key);
-
-// Error sampling
-CRYPTO_STATUS get_error(int32_t* e, unsigned char* seed, unsigned int nonce, StreamOutput StreamOutputFunction);
-
-// Partial error sampling (assembly optimized)        
-void error_sampling_asm(unsigned char* stream, int32_t* e);
-
-// Generation of parameter a
-CRYPTO_STATUS generate_a(uint32_t* a, const unsigned char* seed, ExtendableOutput ExtendableOutputFunction);
-
-
-#ifdef __cplusplus
-}
-#endif
-
-
-#endif
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: internal header file
+*
+*****************************************************************************************/  
+
+#ifndef __LatticeCrypto_priv_H__
+#define __LatticeCrypto_priv_H__
+
+
+// For C++
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include "LatticeCrypto.h"
+
+
+// Basic constants            
+#define PARAMETER_N         1024        // Ring dimension of the default parameter set
+#define PARAMETER_N_MAX     2048        // Largest ring dimension among the parameter sets
+#define PARAMETER_Q         12289 
+#define SEED_BYTES          256/8
+#define ERROR_SEED_BYTES    256/8
+#define NONCE_SEED_BYTES    64/8
+#define NOISE_MAX_POLYS     3           // Largest number of error polynomials sampled from one stream request
+#define NOISE_K             12          // Noise width of the default parameter sets (psi_12), also the widest one
+#define KEX_BATCH_LANES     4           // Number of clients whose NTTs KeyGeneration_A_batch and SecretAgreement_B_batch interleave
+#define NOISE_STREAM_BYTES_N(N) (NOISE_MAX_POLYS*3*(N) + (N)/32)   // Largest error stream of one party with ring dimension N, with the bits of HelpRec
+#define NOISE_STREAM_BYTES  NOISE_STREAM_BYTES_N(PARAMETER_N_MAX)
+#define WORKSPACE_N         ((KEX_BATCH_LANES*PARAMETER_N > PARAMETER_N_MAX) ? KEX_BATCH_LANES*PARAMETER_N : PARAMETER_N_MAX)   // Coefficients of the polynomials of a workspace
+#define WORKSPACE_ALIGN     64          // Alignment of the workspaces of the key exchange, one cache line
+#define PARAMETER_Q4        3073 
+#define PARAMETER_3Q4       9217 
+#define PARAMETER_5Q4       15362 
+#define PARAMETER_7Q4       21506 
+#define PARAMETER_Q2        6145 
+#define PARAMETER_3Q2       18434
+#define PARAMETER_QINV      -12287      // q^-1 mod 2^16, for the 16-bit Montgomery reduction
+#define PARAMETER_MONT      4091        // 2^16 mod q
+#define PARAMETER_BARRETT   5461        // round(2^26/q), for the 16-bit Barrett reduction
+#define PARAMETER_BARRETT32 349496      // floor(2^32/q), for the 32-bit Barrett reduction
+#define PARAMETER_MONT3     -16         // 3*2^16 mod q
+#define PARAMETER_MONT9     -48         // 9*2^16 mod q
+#define PARAMETER_MONT9_2   256         // 9*2^32 mod q
+    
+
+// Macro definitions
+
+#define NBITS_TO_NWORDS(nbits)      (((nbits)+(sizeof(digit_t)*8)-1)/(sizeof(digit_t)*8))    // Conversion macro from number of bits to number of computer words
+#define NBYTES_TO_NWORDS(nbytes)    (((nbytes)+sizeof(digit_t)-1)/sizeof(digit_t))           // Conversion macro from number of bytes to number of computer words
+#define POLY_BYTES(N)               (7*(N)/4)                                                  // Size of N packed 14-bit coefficients
+#define PACKED_BLOCK                64                                                         // Coefficients unpacked at a time by the functions fused with the unpacking
+
+// Macro to avoid compiler warnings when detecting unreferenced parameters
+#define UNREFERENCED_PARAMETER(PAR) (PAR)
+
+
+/******************** Function prototypes *******************/
+/******************* Polynomial functions *******************/
+
+// Forward NTT, the assembly versions are for N = 1024 and the dispatching functions fall back to the portable one for the other N
+void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_generic(int32_t* a, const int32_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_asm(int32_t* a, const int32_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_avx512_asm(int32_t* a, const int32_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_vector(int32_t* a, const int32_t* psi_rev, unsigned int N);
+
+// Inverse NTT, same as above
+void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_generic(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_asm(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_avx512_asm(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_vector(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+
+// Forward NTT of "npolys" independent polynomials a[0],...,a[npolys-1], sharing each twiddle load in the generic code and one call per polynomial in the assembly
+void NTT_CT_std2rev_12289_xN(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_xN_generic(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N);
+
+// Inverse NTT of "npolys" independent polynomials a[0],...,a[npolys-1] sharing each twiddle load
+void INTT_GS_rev2std_12289_xN(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_xN_generic(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_xN_asm(int32_t** a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N, unsigned int npolys);
+
+// Whether the batched NTTs above, for N = PARAMETER_N, are faster than one call per polynomial. The batched key exchange makes one call per client 
+// when they are not
+bool NTT_xN_faster(void);
+bool INTT_xN_faster(void);
+
+// Reduction modulo q
+int32_t reduce12289(int64_t a);
+
+// Two merged reductions modulo q
+int32_t reduce12289_2x(int64_t a);
+
+// Two consecutive reductions modulo q
+void two_reduce12289(int32_t* a, unsigned int N);
+void two_reduce12289_generic(int32_t* a, unsigned int N);
+void two_reduce12289_asm(int32_t* a, unsigned int N);
+void two_reduce12289_avx512_asm(int32_t* a, unsigned int N);
+void two_reduce12289_vector(int32_t* a, unsigned int N);
+
+// Correction modulo q
+void correction(int32_t* a, int32_t p, unsigned int N);
+
+// Component-wise multiplication
+void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
+void pmul_generic(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
+void pmul_asm(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
+void pmul_avx512_asm(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
+void pmul_vector(int32_t* a, int32_t* b, int32_t* c, unsigned int N);
+
+// Component-wise multiplication and addition
+void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
+void pmuladd_generic(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
+void pmuladd_asm(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
+void pmuladd_avx512_asm(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
+void pmuladd_vector(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);
+
+// Component-wise multiplication with scalar
+void smul(int32_t* a, int32_t scalar, unsigned int N);
+
+/******************* 16-bit polynomial functions *******************/
+// These functions work on 16-bit coefficients with Montgomery and Barrett reductions. Each one outputs values
+// congruent modulo q to those of its 32-bit counterpart, so both representations can be mixed in a key exchange.
+
+// Montgomery reduction modulo q, outputs a*2^-16 mod q in (-q, q) for |a| < q*2^15
+int16_t montgomery_reduce12289(int32_t a);
+
+// Barrett reduction modulo q, outputs a value in [-q/2, q/2] up to a small rounding error
+int16_t barrett_reduce12289(int16_t a);
+
+// Forward NTT, N = 1024 only
+void NTT_CT_std2rev_12289_int16(int16_t* a, const int16_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_int16_generic(int16_t* a, const int16_t* psi_rev, unsigned int N);
+void NTT_CT_std2rev_12289_int16_asm(int16_t* a, const int16_t* psi_rev, unsigned int N);
+
+// Inverse NTT, N = 1024 only
+void INTT_GS_rev2std_12289_int16(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_int16_generic(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N);
+void INTT_GS_rev2std_12289_int16_asm(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N);
+
+// Two consecutive reductions modulo q, outputs values in [0, q-1]
+void two_reduce12289_int16(int16_t* a, unsigned int N);
+void two_reduce12289_int16_generic(int16_t* a, unsigned int N);
+void two_reduce12289_int16_asm(int16_t* a, unsigned int N);
+
+// Correction modulo q, outputs values in [0, q-1]
+void correction_int16(int16_t* a, unsigned int N);
+
+// Component-wise multiplication
+void pmul_int16(int16_t* a, int16_t* b, int16_t* c, unsigned int N);
+void pmul_int16_generic(int16_t* a, int16_t* b, int16_t* c, unsigned int N);
+void pmul_int16_asm(int16_t* a, int16_t* b, int16_t* c, unsigned int N);
+
+// Component-wise multiplication and addition
+void pmuladd_int16(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N);
+void pmuladd_int16_generic(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N);
+void pmuladd_int16_asm(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N);
+
+// Component-wise multiplication with scalar
+void smul_int16(int16_t* a, int32_t scalar, unsigned int N);
+
+/******************* Key exchange functions *******************/
+
+// Parameter set of the key exchange
+typedef struct
+{
+    unsigned int N;                     // Ring dimension
+    unsigned int noise_k;               // Noise width: each error is the difference of the bit counts of two noise_k-bit strings (centered binomial psi_k), 4, 8 or 12
+    const int32_t* psi_rev;             // Powers of psi for the forward NTT
+    const int32_t* psi_rev3;            // Powers of psi for the forward NTT scaled by 3
+    const int32_t* psi_rev81;           // Powers of psi for the forward NTT scaled by 81
+    const int32_t* omegainv_rev;        // Inverse powers of omega for the inverse NTT
+    int32_t omegainv1N_rev;             // Scaled inverse power of omega of the last inverse NTT stage
+    int32_t Ninv;                       // Scaled N^-1 of the last inverse NTT stage
+    unsigned int pka_bytes;             // Size of Alice's public key
+    unsigned int pkb_bytes;             // Size of Bob's public key
+    unsigned int sharedkey_bytes;       // Size of the shared key
+} LatticeCryptoParams;
+
+// Buffers of the key exchange, see LatticeCrypto_allocate_workspace(). The arrays have sizes multiple of WORKSPACE_ALIGN, so each starts aligned. 
+// The batched functions keep client i at offset i*PARAMETER_N of the polynomials, i*PARAMETER_N/32 of random_bits and i*SEED_BYTES of seed
+struct LatticeCryptoWorkspace
+{
+    uint32_t pk[WORKSPACE_N];                           // Decoded public key of the other party
+    uint32_t a[WORKSPACE_N];                            // Parameter a, then the public key of the party
+    uint32_t v[WORKSPACE_N];                            // Bob's noise v, then his shared polynomial
+    uint32_t r[PARAMETER_N_MAX];                        // Reconciliation vector
+    int32_t s[WORKSPACE_N];                             // Bob's secret key
+    int32_t e[WORKSPACE_N];                             // Noise e
+    unsigned char stream[NOISE_STREAM_BYTES];           // Error stream
+    unsigned char random_bits[WORKSPACE_N/32];          // Random bits of HelpRec
+    unsigned char seed[KEX_BATCH_LANES*SEED_BYTES];
+    unsigned char error_seed[ERROR_SEED_BYTES];
+};
+
+// Parameter sets for N = 512, 1024 (default) and 2048 with noise of width NOISE_K, and for N = 1024 with noise of width 8 and 4, see ntt_constants.c
+extern const LatticeCryptoParams params_ntt512_12289;
+extern const LatticeCryptoParams params_ntt1024_12289;
+extern const LatticeCryptoParams params_ntt2048_12289;
+extern const LatticeCryptoParams params_ntt1024_12289_psi8;
+extern const LatticeCryptoParams params_ntt1024_12289_psi4;
+
+// The functions below take the ring dimension N. The message encoding, the reconciliation and the error sampling work on blocks 
+// of 1024 coefficients, using the selected implementation, when N is a multiple of 1024, and use the portable code otherwise.
+
+// Alice's message encoding
+void encode_A(const uint32_t* pk, const unsigned char* seed, unsigned char* m, unsigned int N);
+
+// Alice's message decoding
+void decode_A(const unsigned char* m, uint32_t *pk, unsigned char* seed, unsigned int N); 
+    
+// Bob's message encoding
+void encode_B(const uint32_t* pk, const uint32_t* rvec, unsigned char* m, unsigned int N);
+    
+// Bob's message decoding
+void decode_B(unsigned char* m, uint32_t* pk, uint32_t* rvec, unsigned int N);
+
+// Partial message encoding/decoding of 1024 coefficients (portable, assembly optimized and vectorized) 
+void encode_generic(const uint32_t* pk, unsigned char* m);
+void decode_generic(const unsigned char* m, uint32_t *pk);
+void encode_asm(const uint32_t* pk, unsigned char* m);
+void decode_asm(const unsigned char* m, uint32_t *pk);
+void encode_avx512_asm(const uint32_t* pk, unsigned char* m);
+void decode_avx512_asm(const unsigned char* m, uint32_t *pk);
+void encode_vector(const uint32_t* pk, unsigned char* m);
+void decode_vector(const unsigned char* m, uint32_t *pk);
+
+// Partial 16-bit message encoding/decoding (portable and assembly optimized) 
+void encode_int16_generic(const int16_t* pk, unsigned char* m);
+void decode_int16_generic(const unsigned char* m, int16_t *pk);
+void encode_int16_asm(const int16_t* pk, unsigned char* m);
+void decode_int16_asm(const unsigned char* m, int16_t *pk);
+
+// Reconciliation helper
+CRYPTO_STATUS HelpRec(const uint32_t* x, uint32_t* rvec, const unsigned char* seed, unsigned int nonce, unsigned int N, StreamOutput StreamOutputFunction);
+
+// Partial reconciliation helper of 1024 coefficients (portable, assembly optimized and vectorized)        
+void helprec_generic(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits);
+void helprec_asm(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits);
+void helprec_avx512_asm(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits);
+void helprec_vector(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits);
+
+// Reconciliation, outputs an N/4-bit key
+void Rec(const uint32_t *x, const uint32_t* rvec, unsigned char *key, unsigned int N);
+void rec_generic(const uint32_t *x, const uint32_t* rvec, unsigned char *key);
+void rec_asm(const uint32_t *x, const uint32_t* rvec, unsigned char *key);
+void rec_avx512_asm(const uint32_t *x, const uint32_t* rvec, unsigned char *key);
+void rec_vector(const uint32_t *x, const uint32_t* rvec, unsigned char *key);
+
+// Error sampling
+CRYPTO_STATUS get_error(int32_t* e, unsigned char* seed, unsigned int nonce, unsigned int N, StreamOutput StreamOutputFunction);
+
+// Error sampling of e[0], ..., e[npolys-1] of width noise_k with nonces 0, ..., npolys-1 and, if random_bits is not NULL, of the N/32 random bytes of HelpRec 
+// with nonce npolys, from one stream request and one sampling pass. With noise_k = NOISE_K the output is the same as from get_error and HelpRec
+CRYPTO_STATUS get_noise(int32_t** e, unsigned int npolys, unsigned char* random_bits, unsigned char* seed, unsigned int N, unsigned int noise_k, PLatticeCryptoStruct pLatticeCrypto);
+
+// Sampling of N errors of width noise_k (4, 8 or 12) from noise_k*N/4 stream bytes, with the kernel of the backend in use for width 12 and portable kernels otherwise
+void error_sampling_poly(unsigned char* stream, int32_t* e, unsigned int N, unsigned int noise_k);
+
+// Partial error sampling of 1024 coefficients (portable, assembly optimized and vectorized)        
+void error_sampling_generic(unsigned char* stream, int32_t* e);
+void error_sampling_asm(unsigned char* stream, int32_t* e);
+void error_sampling_avx512_asm(unsigned char* stream, int32_t* e);
+void error_sampling_vector(unsigned char* stream, int32_t* e);
+
+// Error sampling into 16-bit coefficients
+CRYPTO_STATUS get_error_int16(int16_t* e, unsigned char* seed, unsigned int nonce, StreamOutput StreamOutputFunction);
+CRYPTO_STATUS get_noise_int16(int16_t** e, unsigned int npolys, unsigned char* random_bits, unsigned char* seed, PLatticeCryptoStruct pLatticeCrypto);
+void error_sampling_int16_generic(unsigned char* stream, int16_t* e);
+void error_sampling_int16_asm(unsigned char* stream, int16_t* e);
+
+// Generation of parameter a
+CRYPTO_STATUS generate_a(uint32_t* a, const unsigned char* seed, unsigned int N, ExtendableOutput ExtendableOutputFunction);
+
+// Generation of parameter a through the cache of pLatticeCrypto, see LatticeCrypto_enable_a_cache()
+CRYPTO_STATUS generate_a_cached(uint32_t* a, const unsigned char* seed, unsigned int N, PLatticeCryptoStruct pLatticeCrypto);
+
+// Noise of a party in NTT form from error_seed: NTT(s), NTT(e) scaled by 3 and, if v is not NULL, NTT(v) scaled by 81 and the random bits of HelpRec
+// The error stream goes to the NOISE_STREAM_BYTES_N(N) bytes at stream, or 2*3*N bytes if v is NULL, or to the stack if stream is NULL
+CRYPTO_STATUS get_noise_ntt(const LatticeCryptoParams* params, int32_t* s, int32_t* e, int32_t* v, unsigned char* random_bits, unsigned char* error_seed, unsigned char* stream, PLatticeCryptoStruct pLatticeCrypto);
+
+// The same from the noise pool of pLatticeCrypto, see LatticeCrypto_enable_noise_pool(). Returns false if there is no pool for params or it is empty
+bool noise_pool_take(PLatticeCryptoStruct pLatticeCrypto, const LatticeCryptoParams* params, int32_t* s, int32_t* e, int32_t* v, unsigned char* random_bits);
+
+// Keccak-f[1600] permutation of one state, and of 4 interleaved states with lane i of state j at state[4*i+j] (portable and assembly optimized)
+void KeccakF1600_StatePermute(uint64_t* A);
+void KeccakF1600_StatePermute4x_generic(uint64_t* state);
+void KeccakF1600_StatePermute4x_asm(uint64_t* state);
+
+// SHAKE128 of one message
+void shake128(unsigned char* output, unsigned int output_nbytes, const unsigned char* input, unsigned int input_nbytes);
+
+// Rejection sampling of the 14 low bits of the 16-bit little-endian words of "nblocks" 16-byte blocks that are in [0, q-1] (portable and assembly optimized)
+unsigned int rejection_sampling_generic(uint32_t* a, const unsigned char* buf, unsigned int nblocks);
+unsigned int rejection_sampling_asm(uint32_t* a, const unsigned char* buf, unsigned int nblocks);
+
+// 8 consecutive ChaCha20 blocks with block counters input[12], ..., input[12]+7 (portable and assembly optimized)
+void chacha20_8blocks_generic(unsigned char* output, const uint32_t* input);
+void chacha20_8blocks_asm(unsigned char* output, const uint32_t* input);
+
+// AES-256 key expansion into 15 round keys, and 8 consecutive AES-256 counter blocks nonce||counter, ..., nonce||counter+7 (assembly with AES-NI)
+void aes256_key_expansion_asm(const unsigned char* key, unsigned char* round_keys);
+void aes256_ctr_8blocks_asm(unsigned char* output, const unsigned char* round_keys, const unsigned char* nonce, uint64_t counter);
+
+// Check with cpuid that the running CPU supports the AES-NI instructions
+bool cpu_supports_aesni(void);
+
+// Key exchange on 32-bit and on 16-bit coefficients, the public functions use the latter when INT16_SUPPORT is defined
+CRYPTO_STATUS KeyGeneration_A_int32(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_B_int32(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_A_int32(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
+CRYPTO_STATUS KeyGeneration_A_int16(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_B_int16(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+CRYPTO_STATUS SecretAgreement_A_int16(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
+
+/******************* Bound tracking *******************/
+
+// Kernel outputs observed by the key exchange when BOUND_TRACKING is defined
+typedef enum {
+    BOUND_NTT,                      // Forward NTT
+    BOUND_NTT_X3,                   // Forward NTT scaled by 3
+    BOUND_NTT_X81,                  // Forward NTT scaled by 81
+    BOUND_PMULADD,                  // Component-wise multiplication and addition
+    BOUND_PMUL,                     // Component-wise multiplication
+    BOUND_INTT_B,                   // Inverse NTT of Bob's pmuladd output
+    BOUND_INTT_A,                   // Inverse NTT of Alice's pmul output
+    BOUND_TWO_REDUCE,               // Two consecutive reductions after the inverse NTT
+    BOUND_END_OF_LIST
+} BOUND_STAGE;
+
+#if defined(BOUND_TRACKING)
+// Smallest and largest coefficient seen at each stage since the last reset_bounds()
+extern int32_t bound_min[BOUND_END_OF_LIST], bound_max[BOUND_END_OF_LIST];
+
+void reset_bounds(void);
+void track_bound(BOUND_STAGE stage, const int32_t* a, unsigned int N);
+    #define TRACK_BOUND(stage, a, N)    track_bound((stage), (const int32_t*)(a), (N))
+#else
+    #define TRACK_BOUND(stage, a, N)
+#endif
+
+/******************* Runtime dispatch *******************/
+
+// Table of the kernels that make up one implementation backend
+typedef struct
+{
+    const char* name;                                                                   // Name accepted by LATTICECRYPTO_BACKEND
+    void (*NTT)(int32_t* a, const int32_t* psi_rev, unsigned int N);                    // Forward NTT
+    void (*INTT)(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);   // Inverse NTT
+    void (*NTT_xN)(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N);                                  // Batched forward NTT
+    void (*INTT_xN)(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N);   // Batched inverse NTT
+    bool NTT_xN_faster;                                                                 // Whether NTT_xN is faster than one NTT per polynomial, see NTT_xN_faster()
+    bool INTT_xN_faster;                                                                // Whether INTT_xN is faster than one INTT per polynomial
+    void (*two_reduce)(int32_t* a, unsigned int N);                                     // Two consecutive reductions modulo q
+    void (*pmul)(int32_t* a, int32_t* b, int32_t* c, unsigned int N);                   // Component-wise multiplication
+    void (*pmuladd)(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N);    // Component-wise multiplication and addition
+    void (*encode)(const uint32_t* pk, unsigned char* m);                               // Partial message encoding
+    void (*decode)(const unsigned char* m, uint32_t *pk);                               // Partial message decoding
+    void (*helprec)(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits);     // Partial reconciliation helper
+    void (*rec)(const uint32_t *x, const uint32_t* rvec, unsigned char *key);           // Reconciliation
+    void (*error_sampling)(unsigned char* stream, int32_t* e);                          // Partial error sampling
+    void (*NTT_int16)(int16_t* a, const int16_t* psi_rev, unsigned int N);              // Forward NTT on 16-bit coefficients
+    void (*INTT_int16)(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N);   // Inverse NTT on 16-bit coefficients
+    void (*two_reduce_int16)(int16_t* a, unsigned int N);                               // Two consecutive reductions on 16-bit coefficients
+    void (*pmul_int16)(int16_t* a, int16_t* b, int16_t* c, unsigned int N);             // Component-wise multiplication on 16-bit coefficients
+    void (*pmuladd_int16)(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N);   // Component-wise multiplication and addition on 16-bit coefficients
+    void (*encode_int16)(const int16_t* pk, unsigned char* m);                          // Partial message encoding of 16-bit coefficients
+    void (*decode_int16)(const unsigned char* m, int16_t *pk);                          // Partial message decoding into 16-bit coefficients
+    void (*error_sampling_int16)(unsigned char* stream, int16_t* e);                    // Partial error sampling into 16-bit coefficients
+    void (*KeccakF1600x4)(uint64_t* state);                                             // Keccak-f[1600] permutation of 4 interleaved states
+    void (*chacha20_x8)(unsigned char* output, const uint32_t* input);                  // 8 consecutive ChaCha20 blocks
+    unsigned int (*rejection_sampling)(uint32_t* a, const unsigned char* buf, unsigned int nblocks);    // Rejection sampling of 16-byte blocks of candidates
+} LatticeCryptoBackend;
+
+#if defined(DISPATCH_SUPPORT)
+// Backend in use, resolved once by LatticeCrypto_initialize() and changed afterwards only by LatticeCrypto_set_backend(). 
+// Other threads may run operations meanwhile, so it is read with backend_load()
+extern const LatticeCryptoBackend* LatticeCrypto_backend;
+#define backend_load()    __atomic_load_n(&LatticeCrypto_backend, __ATOMIC_ACQUIRE)
+#endif
+
+// Select the backend once per process, at the first initialization or change of backend
+void resolve_backend(void);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -0,0 +1,167 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: optional cache of the expanded parameter a, keyed by its seed
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#include <stdlib.h>
+#include <string.h>
+#if (OS_TARGET == OS_WIN)
+    #include <windows.h>
+    #define cache_lock_init(l)       InitializeSRWLock(l)
+    #define cache_lock_destroy(l)
+    #define cache_lock(l)            AcquireSRWLockExclusive(l)
+    #define cache_unlock(l)          ReleaseSRWLockExclusive(l)
+    typedef SRWLOCK cache_lock_t;
+#else
+    #include <pthread.h>
+    #define cache_lock_init(l)       pthread_mutex_init(l, NULL)
+    #define cache_lock_destroy(l)    pthread_mutex_destroy(l)
+    #define cache_lock(l)            pthread_mutex_lock(l)
+    #define cache_unlock(l)          pthread_mutex_unlock(l)
+    typedef pthread_mutex_t cache_lock_t;
+#endif
+
+
+typedef struct
+{
+    ExtendableOutput xof;                       // Function that expanded the entry, part of the key
+    unsigned int     N;                         // Ring dimension, 0 for a free entry
+    uint64_t         last_use;                  // Clock value of the last lookup or insertion, for the LRU replacement
+    unsigned char    seed[SEED_BYTES];
+    uint32_t         a[PARAMETER_N_MAX];        // Output of generate_a, already in NTT form
+} a_cache_entry;
+
+struct LatticeCryptoACache
+{
+    cache_lock_t     lock;
+    unsigned int     nentries;
+    uint64_t         clock, hits, misses;
+    a_cache_entry*   entries;
+};
+
+
+static a_cache_entry* a_cache_find(struct LatticeCryptoACache* cache, const unsigned char* seed, unsigned int N, ExtendableOutput xof)
+{ // Entry for (seed, N, xof), or NULL. The seeds are public, so the comparison need not be constant-time
+    unsigned int i;
+
+    for (i = 0; i < cache->nentries; i++) {
+        if (cache->entries[i].N == N && cache->entries[i].xof == xof && memcmp(cache->entries[i].seed, seed, SEED_BYTES) == 0) {
+            return &cache->entries[i];
+        }
+    }
+    return NULL;
+}
+
+
+CRYPTO_STATUS generate_a_cached(uint32_t* a, const unsigned char* seed, unsigned int N, PLatticeCryptoStruct pLatticeCrypto)
+{ // generate_a through the cache of pLatticeCrypto, if enabled
+  // The XOF runs outside the lock, so that misses in different threads do not wait for each other
+    struct LatticeCryptoACache* cache = pLatticeCrypto->ACache;
+    a_cache_entry* entry;
+    unsigned int i;
+    CRYPTO_STATUS Status;
+
+    if (cache == NULL) {
+        return generate_a(a, seed, N, pLatticeCrypto->ExtendableOutputFunction);
+    }
+
+    cache_lock(&cache->lock);
+    entry = a_cache_find(cache, seed, N, pLatticeCrypto->ExtendableOutputFunction);
+    if (entry != NULL) {
+        memcpy(a, entry->a, N*sizeof(uint32_t));
+        entry->last_use = ++cache->clock;
+        cache->hits++;
+        cache_unlock(&cache->lock);
+        return CRYPTO_SUCCESS;
+    }
+    cache->misses++;
+    cache_unlock(&cache->lock);
+
+    Status = generate_a(a, seed, N, pLatticeCrypto->ExtendableOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }
+
+    cache_lock(&cache->lock);
+    if (a_cache_find(cache, seed, N, pLatticeCrypto->ExtendableOutputFunction) == NULL) {     // Another thread may have inserted it meanwhile
+        entry = &cache->entries[0];
+        for (i = 1; i < cache->nentries && entry->N != 0; i++) {                               // First free entry, else the least recently used one
+            if (cache->entries[i].N == 0 || cache->entries[i].last_use < entry->last_use) {
+                entry = &cache->entries[i];
+            }
+        }
+        entry->xof = pLatticeCrypto->ExtendableOutputFunction;
+        entry->N = N;
+        entry->last_use = ++cache->clock;
+        memcpy(entry->seed, seed, SEED_BYTES);
+        memcpy(entry->a, a, N*sizeof(uint32_t));
+    }
+    cache_unlock(&cache->lock);
+
+    return CRYPTO_SUCCESS;
+}
+
+
+CRYPTO_STATUS LatticeCrypto_enable_a_cache(PLatticeCryptoStruct pLatticeCrypto, unsigned int nentries)
+{ // Set up a cache of "nentries" expanded values of a in pLatticeCrypto, replacing any previous one. nentries = 0 removes the cache
+    struct LatticeCryptoACache* cache;
+
+    if (pLatticeCrypto == NULL || nentries > A_CACHE_MAX_ENTRIES) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    LatticeCrypto_disable_a_cache(pLatticeCrypto);
+    if (nentries == 0) {
+        return CRYPTO_SUCCESS;
+    }
+
+    cache = (struct LatticeCryptoACache*)calloc(1, sizeof(struct LatticeCryptoACache));
+    if (cache == NULL) {
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    cache->entries = (a_cache_entry*)calloc(nentries, sizeof(a_cache_entry));
+    if (cache->entries == NULL) {
+        free(cache);
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    cache->nentries = nentries;
+    cache_lock_init(&cache->lock);
+    pLatticeCrypto->ACache = cache;
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void LatticeCrypto_disable_a_cache(PLatticeCryptoStruct pLatticeCrypto)
+{ // Remove the cache of pLatticeCrypto, if any
+    struct LatticeCryptoACache* cache;
+
+    if (pLatticeCrypto == NULL || pLatticeCrypto->ACache == NULL) {
+        return;
+    }
+    cache = pLatticeCrypto->ACache;
+    pLatticeCrypto->ACache = NULL;
+    cache_lock_destroy(&cache->lock);
+    free(cache->entries);
+    free(cache);
+}
+
+
+void LatticeCrypto_get_a_cache_stats(PLatticeCryptoStruct pLatticeCrypto, uint64_t* hits, uint64_t* misses)
+{ // Output the number of lookups of a that hit and missed the cache since it was enabled, 0 and 0 without a cache
+    struct LatticeCryptoACache* cache = (pLatticeCrypto != NULL) ? pLatticeCrypto->ACache : NULL;
+
+    *hits = 0;
+    *misses = 0;
+    if (cache != NULL) {
+        cache_lock(&cache->lock);
+        *hits = cache->hits;
+        *misses = cache->misses;
+        cache_unlock(&cache->lock);
+    }
+}
@@ -0,0 +1,72 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: built-in stream cipher based on AES-256 in counter mode with AES-NI instructions
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#include <string.h>
+
+#define AES_BLOCK_BYTES         16        // Size of an AES block
+#define AES256_ROUNDKEY_BYTES   240       // Size of the 15 round keys of AES-256
+#define AES_BATCH               8         // Number of blocks computed by aes256_ctr_8blocks_asm
+
+
+CRYPTO_STATUS LatticeCrypto_aes256ctr_multi(const unsigned char* seed, unsigned int seed_nbytes, const unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array)
+{ // Output the AES-256-CTR keystreams for the 32-byte key "seed" and the "nnonces" nonces of "nonce_nbytes" bytes each, one after the other in stream_array
+  // The keystream for nonces[nonce_nbytes*i] has array_nbytes[i] bytes, the same as from LatticeCrypto_aes256ctr. The key is expanded once for all of them
+  // Counter block i is nonce||i, with i as a 64-bit big-endian integer starting at 0. There is no portable version, since table-based 
+  // AES is not constant-time: without AES-NI it returns CRYPTO_ERROR_NOT_IMPLEMENTED
+#if defined(ASM_SUPPORT) || defined(DISPATCH_SUPPORT)
+    unsigned int i, nbytes;
+    unsigned char nce[8], round_keys[AES256_ROUNDKEY_BYTES], batch[AES_BATCH*AES_BLOCK_BYTES];
+    uint64_t counter;
+
+    if (seed == NULL || seed_nbytes != 32 || (nonces == NULL && nonce_nbytes != 0) || nonce_nbytes > 8 || array_nbytes == NULL || stream_array == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    if (cpu_supports_aesni() == false) {
+        return CRYPTO_ERROR_NOT_IMPLEMENTED;
+    }
+
+    aes256_key_expansion_asm(seed, round_keys);
+    for (i = 0; i < nnonces; i++) {
+        memset(nce, 0, sizeof(nce));
+        if (nonce_nbytes > 0) {
+            memcpy(nce, &nonces[nonce_nbytes*i], nonce_nbytes);
+        }
+        counter = 0;
+        nbytes = array_nbytes[i];
+        while (nbytes >= AES_BATCH*AES_BLOCK_BYTES) {          // Batches of 8 blocks, written in place
+            aes256_ctr_8blocks_asm(stream_array, round_keys, nce, counter);
+            stream_array += AES_BATCH*AES_BLOCK_BYTES;
+            nbytes -= AES_BATCH*AES_BLOCK_BYTES;
+            counter += AES_BATCH;
+        }
+        if (nbytes > 0) {                                      // Last partial batch, e.g., the N/32 bytes of HelpRec
+            aes256_ctr_8blocks_asm(batch, round_keys, nce, counter);
+            memcpy(stream_array, batch, nbytes);
+            stream_array += nbytes;
+        }
+    }
+    clear_words((void*)batch, NBYTES_TO_NWORDS(sizeof(batch)));
+    clear_words((void*)round_keys, NBYTES_TO_NWORDS(sizeof(round_keys)));
+
+    return CRYPTO_SUCCESS;
+#else
+    UNREFERENCED_PARAMETER(seed); UNREFERENCED_PARAMETER(seed_nbytes); UNREFERENCED_PARAMETER(nonces); UNREFERENCED_PARAMETER(nonce_nbytes); 
+    UNREFERENCED_PARAMETER(nnonces); UNREFERENCED_PARAMETER(array_nbytes); UNREFERENCED_PARAMETER(stream_array);
+    return CRYPTO_ERROR_NOT_IMPLEMENTED;
+#endif
+}
+
+
+CRYPTO_STATUS LatticeCrypto_aes256ctr(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array)
+{ // Output "array_nbytes" of AES-256-CTR keystream for the 32-byte key "seed" and the nonce of up to 8 bytes "nonce", zero-padded
+
+    return LatticeCrypto_aes256ctr_multi(seed, seed_nbytes, nonce, nonce_nbytes, 1, &array_nbytes, stream_array);
+}
@@ -0,0 +1,134 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: built-in stream cipher based on ChaCha20 with a 64-bit nonce and a 64-bit block counter
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#include <string.h>
+
+#define CHACHA20_BLOCK_BYTES    64        // Size of a ChaCha20 block
+#define CHACHA20_BATCH          8         // Number of blocks computed by chacha20_8blocks
+
+#define ROL32(a, n)             (((a) << (n)) | ((a) >> (32-(n))))
+
+#define QUARTERROUND(a, b, c, d)                                    \
+    x[a] += x[b]; x[d] = ROL32(x[d] ^ x[a], 16);                    \
+    x[c] += x[d]; x[b] = ROL32(x[b] ^ x[c], 12);                    \
+    x[a] += x[b]; x[d] = ROL32(x[d] ^ x[a], 8);                     \
+    x[c] += x[d]; x[b] = ROL32(x[b] ^ x[c], 7)
+
+
+static void chacha20_block(unsigned char* output, const uint32_t* input)
+{ // One ChaCha20 block of 64 bytes from the 16-word input state
+    unsigned int i;
+    uint32_t x[16];
+
+    memcpy(x, input, sizeof(x));
+    for (i = 0; i < 10; i++) {
+        QUARTERROUND(0, 4,  8, 12); QUARTERROUND(1, 5,  9, 13); QUARTERROUND(2, 6, 10, 14); QUARTERROUND(3, 7, 11, 15);   // Column round
+        QUARTERROUND(0, 5, 10, 15); QUARTERROUND(1, 6, 11, 12); QUARTERROUND(2, 7,  8, 13); QUARTERROUND(3, 4,  9, 14);   // Diagonal round
+    }
+    for (i = 0; i < 16; i++) {
+        x[i] += input[i];
+        output[4*i]   = (unsigned char)x[i];
+        output[4*i+1] = (unsigned char)(x[i] >> 8);
+        output[4*i+2] = (unsigned char)(x[i] >> 16);
+        output[4*i+3] = (unsigned char)(x[i] >> 24);
+    }
+}
+
+
+void chacha20_8blocks_generic(unsigned char* output, const uint32_t* input)
+{ // 8 consecutive ChaCha20 blocks of 64 bytes, with block counters input[12], ..., input[12]+7 (portable version)
+  // The low word of the counter must not wrap around within the 8 blocks
+    unsigned int i;
+    uint32_t state[16];
+
+    memcpy(state, input, sizeof(state));
+    for (i = 0; i < CHACHA20_BATCH; i++) {
+        chacha20_block(&output[CHACHA20_BLOCK_BYTES*i], state);
+        state[12]++;
+    }
+}
+
+
+static __inline void chacha20_8blocks(unsigned char* output, const uint32_t* input)
+{
+#if defined(DISPATCH_SUPPORT)
+    backend_load()->chacha20_x8(output, input);
+#elif defined(ASM_SUPPORT)
+    chacha20_8blocks_asm(output, input);
+#else
+    chacha20_8blocks_generic(output, input);
+#endif
+}
+
+
+static void chacha20_stream(uint32_t* state, const unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array)
+{ // Output "array_nbytes" of keystream for the key in state[4..11] and the nonce of up to 8 bytes "nonce", zero-padded
+  // The 3*N bytes of get_error are whole batches of 8 blocks, and the N/32 bytes of HelpRec fit in one block
+    unsigned int i;
+    unsigned char nce[8] = {0}, block[CHACHA20_BLOCK_BYTES];
+    uint64_t counter = 0;
+
+    if (nonce_nbytes > 0) {
+        memcpy(nce, nonce, nonce_nbytes);
+    }
+    state[14] = (uint32_t)nce[0] | ((uint32_t)nce[1] << 8) | ((uint32_t)nce[2] << 16) | ((uint32_t)nce[3] << 24);
+    state[15] = (uint32_t)nce[4] | ((uint32_t)nce[5] << 8) | ((uint32_t)nce[6] << 16) | ((uint32_t)nce[7] << 24);
+
+    while (array_nbytes > 0) {
+        state[12] = (uint32_t)counter;
+        state[13] = (uint32_t)(counter >> 32);
+        if (array_nbytes >= CHACHA20_BATCH*CHACHA20_BLOCK_BYTES && state[12] <= 0xFFFFFFFF - CHACHA20_BATCH) {    // Batch of 8 blocks, written in place
+            chacha20_8blocks(stream_array, state);
+            stream_array += CHACHA20_BATCH*CHACHA20_BLOCK_BYTES;
+            array_nbytes -= CHACHA20_BATCH*CHACHA20_BLOCK_BYTES;
+            counter += CHACHA20_BATCH;
+        } else {                                                                     // Single block
+            chacha20_block(block, state);
+            i = (array_nbytes < CHACHA20_BLOCK_BYTES) ? array_nbytes : CHACHA20_BLOCK_BYTES;
+            memcpy(stream_array, block, i);
+            stream_array += i;
+            array_nbytes -= i;
+            counter++;
+        }
+    }
+    clear_words((void*)block, NBYTES_TO_NWORDS(sizeof(block)));
+}
+
+
+CRYPTO_STATUS LatticeCrypto_chacha20_multi(const unsigned char* seed, unsigned int seed_nbytes, const unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array)
+{ // Output the ChaCha20 keystreams for the 32-byte key "seed" and the "nnonces" nonces of "nonce_nbytes" bytes each, one after the other in stream_array
+  // The keystream for nonces[nonce_nbytes*i] has array_nbytes[i] bytes, the same as from LatticeCrypto_chacha20
+    unsigned int i;
+    uint32_t state[16];
+
+    if (seed == NULL || seed_nbytes != 32 || (nonces == NULL && nonce_nbytes != 0) || nonce_nbytes > 8 || array_nbytes == NULL || stream_array == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+
+    state[0] = 0x61707865; state[1] = 0x3320646e; state[2] = 0x79622d32; state[3] = 0x6b206574;    // "expand 32-byte k"
+    for (i = 0; i < 8; i++) {
+        state[4+i] = (uint32_t)seed[4*i] | ((uint32_t)seed[4*i+1] << 8) | ((uint32_t)seed[4*i+2] << 16) | ((uint32_t)seed[4*i+3] << 24);
+    }
+    for (i = 0; i < nnonces; i++) {
+        chacha20_stream(state, &nonces[nonce_nbytes*i], nonce_nbytes, array_nbytes[i], stream_array);
+        stream_array += array_nbytes[i];
+    }
+    clear_words((void*)state, NBYTES_TO_NWORDS(sizeof(state)));
+
+    return CRYPTO_SUCCESS;
+}
+
+
+CRYPTO_STATUS LatticeCrypto_chacha20(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array)
+{ // Output "array_nbytes" of ChaCha20 keystream for the 32-byte key "seed" and the nonce of up to 8 bytes "nonce", zero-padded
+
+    return LatticeCrypto_chacha20_multi(seed, seed_nbytes, nonce, nonce_nbytes, 1, &array_nbytes, stream_array);
+}
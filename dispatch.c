@@ -0,0 +1,356 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: runtime selection of the implementation backend
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#if defined(DISPATCH_SUPPORT)
+    #include <stdlib.h>
+    #include <string.h>
+    #if (OS_TARGET == OS_WIN)
+        #include <windows.h>
+    #else
+        #include <pthread.h>
+    #endif
+    #define backend_store(p)    __atomic_store_n(&LatticeCrypto_backend, p, __ATOMIC_RELEASE)
+#endif
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT)
+    #include <cpuid.h>
+#endif
+
+
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT)
+
+bool cpu_supports_aesni(void)
+{ // AES-NI is not implied by AVX2, so the AES-256-CTR stream checks for it on its own instead of through the backend
+    unsigned int eax, ebx, ecx, edx;
+
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return ((ecx & bit_AES) != 0 && (ecx & bit_AVX) != 0);    // The kernels use the VEX-encoded forms
+}
+
+#endif
+
+
+#if defined(DISPATCH_SUPPORT)
+
+static void NTT_CT_std2rev_12289_xN_avx2(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N)
+{ // Batched forward NTT, AVX2 backend, one call per polynomial as in AMD64/ntt_x64.c
+    unsigned int p;
+
+    for (p = 0; p < npolys; p++) {
+        NTT_CT_std2rev_12289_asm(a[p], psi_rev, N);
+    }
+}
+
+
+static void INTT_GS_rev2std_12289_xN_avx2(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{ // Batched inverse NTT, AVX2 backend
+    if (npolys > 0) {
+        INTT_GS_rev2std_12289_xN_asm(a, omegainv_rev, omegainv1N_rev, Ninv, N, npolys);
+    }
+}
+
+
+static void NTT_CT_std2rev_12289_xN_avx512(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N)
+{ // Batched forward NTT, AVX-512 backend
+    unsigned int p;
+
+    for (p = 0; p < npolys; p++) {
+        NTT_CT_std2rev_12289_avx512_asm(a[p], psi_rev, N);
+    }
+}
+
+
+static void INTT_GS_rev2std_12289_xN_avx512(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{ // Batched inverse NTT, AVX-512 backend
+    unsigned int p;
+
+    for (p = 0; p < npolys; p++) {
+        INTT_GS_rev2std_12289_avx512_asm(a[p], omegainv_rev, omegainv1N_rev, Ninv, N);
+    }
+}
+
+
+static const LatticeCryptoBackend backend_generic = {
+    "generic",
+    NTT_CT_std2rev_12289_generic, INTT_GS_rev2std_12289_generic, NTT_CT_std2rev_12289_xN_generic, INTT_GS_rev2std_12289_xN_generic,
+    false, true,
+    two_reduce12289_generic, pmul_generic, pmuladd_generic,
+    encode_generic, decode_generic, helprec_generic, rec_generic, error_sampling_generic,
+    NTT_CT_std2rev_12289_int16_generic, INTT_GS_rev2std_12289_int16_generic, two_reduce12289_int16_generic, pmul_int16_generic, pmuladd_int16_generic,
+    encode_int16_generic, decode_int16_generic, error_sampling_int16_generic,
+    KeccakF1600_StatePermute4x_generic, chacha20_8blocks_generic, rejection_sampling_generic
+};
+
+static const LatticeCryptoBackend backend_avx2 = {
+    "avx2",
+    NTT_CT_std2rev_12289_asm, INTT_GS_rev2std_12289_asm, NTT_CT_std2rev_12289_xN_avx2, INTT_GS_rev2std_12289_xN_avx2,
+    false, true,
+    two_reduce12289_asm, pmul_asm, pmuladd_asm,
+    encode_asm, decode_asm, helprec_asm, rec_asm, error_sampling_asm,
+    NTT_CT_std2rev_12289_int16_asm, INTT_GS_rev2std_12289_int16_asm, two_reduce12289_int16_asm, pmul_int16_asm, pmuladd_int16_asm,
+    encode_int16_asm, decode_int16_asm, error_sampling_int16_asm,
+    KeccakF1600_StatePermute4x_asm, chacha20_8blocks_asm, rejection_sampling_asm
+};
+
+static const LatticeCryptoBackend backend_avx512 = {
+    "avx512",
+    NTT_CT_std2rev_12289_avx512_asm, INTT_GS_rev2std_12289_avx512_asm, NTT_CT_std2rev_12289_xN_avx512, INTT_GS_rev2std_12289_xN_avx512,
+    false, false,    // The xN kernels just loop over the polynomials
+    two_reduce12289_avx512_asm, pmul_avx512_asm, pmuladd_avx512_asm,
+    encode_avx512_asm, decode_avx512_asm, helprec_avx512_asm, rec_avx512_asm, error_sampling_avx512_asm,
+    NTT_CT_std2rev_12289_int16_asm, INTT_GS_rev2std_12289_int16_asm, two_reduce12289_int16_asm, pmul_int16_asm, pmuladd_int16_asm,    // The 16-bit kernels are AVX2 only
+    encode_int16_asm, decode_int16_asm, error_sampling_int16_asm,
+    KeccakF1600_StatePermute4x_asm, chacha20_8blocks_asm, rejection_sampling_asm
+};
+
+static const LatticeCryptoBackend* const backends[CRYPTO_BACKEND_END_OF_LIST] = {
+    NULL, &backend_generic, &backend_avx2, &backend_avx512
+};
+
+// The generic backend runs everywhere, so it is used until LatticeCrypto_initialize() resolves the best one
+const LatticeCryptoBackend* LatticeCrypto_backend = &backend_generic;
+static const LatticeCryptoBackend* backend_auto = &backend_generic;    // Selection restored by CRYPTO_BACKEND_AUTO
+#if (OS_TARGET == OS_WIN)
+static INIT_ONCE backend_once = INIT_ONCE_STATIC_INIT;
+#else
+static pthread_once_t backend_once = PTHREAD_ONCE_INIT;
+#endif
+
+
+static bool cpu_supports(CRYPTO_BACKEND Backend)
+{ // Check with cpuid and xgetbv that the running CPU and OS support the instructions used by a backend
+    unsigned int eax, ebx, ecx, edx, xcr0_lo, xcr0_hi;
+
+    if (Backend == CRYPTO_BACKEND_GENERIC) {
+        return true;
+    }
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0) {
+        return false;
+    }
+    asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+    if ((xcr0_lo & 0x06) != 0x06) {                      // The OS must save the XMM and YMM state
+        return false;
+    }
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+
+    if (Backend == CRYPTO_BACKEND_AVX2) {
+        return ((ebx & bit_AVX2) != 0);
+    } else if (Backend == CRYPTO_BACKEND_AVX512) {       // The OS must also save the opmask and ZMM state
+        return ((xcr0_lo & 0xE6) == 0xE6 && (ebx & bit_AVX512F) != 0 && (ebx & bit_AVX512BW) != 0);
+    }
+    return false;
+}
+
+
+static void select_backend(void)
+{ // Select the backend named by LATTICECRYPTO_BACKEND if the CPU supports it, else the best one the CPU supports
+    const char* name;
+    int Backend;
+
+    name = getenv("LATTICECRYPTO_BACKEND");
+    if (name != NULL) {
+        for (Backend = CRYPTO_BACKEND_GENERIC; Backend < CRYPTO_BACKEND_END_OF_LIST; Backend++) {
+            if (strcmp(name, backends[Backend]->name) == 0 && cpu_supports((CRYPTO_BACKEND)Backend) == true) {
+                break;
+            }
+        }
+        if (Backend < CRYPTO_BACKEND_END_OF_LIST) {
+            backend_auto = backends[Backend];
+            backend_store(backend_auto);
+            return;
+        }
+    }
+
+    for (Backend = CRYPTO_BACKEND_END_OF_LIST-1; Backend > CRYPTO_BACKEND_GENERIC; Backend--) {
+        if (cpu_supports((CRYPTO_BACKEND)Backend) == true) {
+            break;
+        }
+    }
+    backend_auto = backends[Backend];
+    backend_store(backend_auto);
+}
+
+
+#if (OS_TARGET == OS_WIN)
+static BOOL CALLBACK select_backend_once(PINIT_ONCE once, PVOID parameter, PVOID* context)
+{ // InitOnceExecuteOnce callback
+    UNREFERENCED_PARAMETER(once); UNREFERENCED_PARAMETER(parameter); UNREFERENCED_PARAMETER(context);
+    select_backend();
+    return TRUE;
+}
+#endif
+
+
+void resolve_backend(void)
+{ // Select the backend once per process, at the first initialization or change of backend. Afterwards only LatticeCrypto_set_backend() changes it
+#if (OS_TARGET == OS_WIN)
+    InitOnceExecuteOnce(&backend_once, select_backend_once, NULL, NULL);
+#else
+    pthread_once(&backend_once, select_backend);
+#endif
+}
+
+
+CRYPTO_STATUS LatticeCrypto_set_backend(CRYPTO_BACKEND Backend)
+{ // Force the backend used by all subsequent operations
+    if (Backend != CRYPTO_BACKEND_AUTO && (Backend >= CRYPTO_BACKEND_END_OF_LIST || cpu_supports(Backend) == false)) {
+        return CRYPTO_ERROR_NOT_IMPLEMENTED;
+    }
+
+    resolve_backend();                                      // So that a later LatticeCrypto_initialize() does not override the choice
+    backend_store((Backend == CRYPTO_BACKEND_AUTO) ? backend_auto : backends[Backend]);
+    return CRYPTO_SUCCESS;
+}
+
+
+const char* LatticeCrypto_get_backend_name(void)
+{ // Output the name of the backend in use
+    return backend_load()->name;
+}
+
+
+void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N)
+{
+    if (N != PARAMETER_N) { // The assembly transforms are unrolled for N = 1024
+        NTT_CT_std2rev_12289_generic(a, psi_rev, N);
+        return;
+    }
+    backend_load()->NTT(a, psi_rev, N);
+}
+
+
+void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{
+    if (N != PARAMETER_N) {
+        INTT_GS_rev2std_12289_generic(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+        return;
+    }
+    backend_load()->INTT(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+}
+
+
+void NTT_CT_std2rev_12289_xN(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N)
+{
+    if (N != PARAMETER_N) {
+        NTT_CT_std2rev_12289_xN_generic(a, npolys, psi_rev, N);
+        return;
+    }
+    backend_load()->NTT_xN(a, npolys, psi_rev, N);
+}
+
+
+void INTT_GS_rev2std_12289_xN(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{
+    if (N != PARAMETER_N) {
+        INTT_GS_rev2std_12289_xN_generic(a, npolys, omegainv_rev, omegainv1N_rev, Ninv, N);
+        return;
+    }
+    backend_load()->INTT_xN(a, npolys, omegainv_rev, omegainv1N_rev, Ninv, N);
+}
+
+
+bool NTT_xN_faster(void)
+{
+    return backend_load()->NTT_xN_faster;
+}
+
+
+bool INTT_xN_faster(void)
+{
+    return backend_load()->INTT_xN_faster;
+}
+
+
+void two_reduce12289(int32_t* a, unsigned int N)
+{
+    backend_load()->two_reduce(a, N);
+}
+
+
+void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
+{
+    backend_load()->pmul(a, b, c, N);
+}
+
+
+void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
+{
+    backend_load()->pmuladd(a, b, c, d, N);
+}
+
+
+void NTT_CT_std2rev_12289_int16(int16_t* a, const int16_t* psi_rev, unsigned int N)
+{
+    backend_load()->NTT_int16(a, psi_rev, N);
+}
+
+
+void INTT_GS_rev2std_12289_int16(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N)
+{
+    backend_load()->INTT_int16(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+}
+
+
+void two_reduce12289_int16(int16_t* a, unsigned int N)
+{
+    backend_load()->two_reduce_int16(a, N);
+}
+
+
+void pmul_int16(int16_t* a, int16_t* b, int16_t* c, unsigned int N)
+{
+    backend_load()->pmul_int16(a, b, c, N);
+}
+
+
+void pmuladd_int16(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N)
+{
+    backend_load()->pmuladd_int16(a, b, c, d, N);
+}
+
+#else
+
+// Without runtime dispatch the backend is fixed at compile time
+#if defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT)
+    #define STATIC_BACKEND         CRYPTO_BACKEND_AVX512
+    #define STATIC_BACKEND_NAME    "avx512"
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT)
+    #define STATIC_BACKEND         CRYPTO_BACKEND_AVX2
+    #define STATIC_BACKEND_NAME    "avx2"
+#else
+    #define STATIC_BACKEND         CRYPTO_BACKEND_GENERIC
+    #define STATIC_BACKEND_NAME    "generic"
+#endif
+
+
+void resolve_backend(void)
+{ // Select the backend at initialization (nothing to do without runtime dispatch)
+}
+
+
+CRYPTO_STATUS LatticeCrypto_set_backend(CRYPTO_BACKEND Backend)
+{ // Force the backend used by all subsequent operations, only the compiled-in backend is available
+    if (Backend != CRYPTO_BACKEND_AUTO && Backend != STATIC_BACKEND) {
+        return CRYPTO_ERROR_NOT_IMPLEMENTED;
+    }
+    return CRYPTO_SUCCESS;
+}
+
+
+const char* LatticeCrypto_get_backend_name(void)
+{ // Output the name of the backend in use
+    return STATIC_BACKEND_NAME;
+}
+
+#endif
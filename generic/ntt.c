@@ -1,182 +1,498 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: NTT functions and other polynomial operations
-*
-*****************************************************************************************/
-
-#include "../LatticeCrypto_priv.h"
-
-const uint32_t mask12 = ((uint64_t)1 << 12) - 1;
-
-    
-int32_t reduce12289(int64_t a)
-{ // Reduction modulo q
-    int32_t c0, c1;
-   
-    c0 = (int32_t)(a & mask12);
-    c1 = (int32_t)(a >> 12);
- 
-    return (3*c0 - c1);
-}
-
-    
-int32_t reduce12289_2x(int64_t a)
-{ // Two merged reductions modulo q
-    int32_t c0, c1, c2;
-   
-    c0 = (int32_t)(a & mask12);
-    c1 = (int32_t)((a >> 12) & mask12);
-    c2 = (int32_t)(a >> 24);
- 
-    return (9*c0 - 3*c1 + c2);
-}
-
-
-void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N)
-{ // Forward NTT
-    unsigned int m, i, j, j1, j2, k = N;
-    int32_t S, U, V;
-
-    for (m = 1; m < 128; m = 2*m) {
-        k = k >> 1;
-        for (i = 0; i < m; i++) {
-            j1 = 2*i*k;
-            j2 = j1+k-1;
-            S = psi_rev[m+i];
-            for (j = j1; j <= j2; j++) { 
-                U = a[j]; 
-                V = reduce12289((int64_t)a[j+k]*S);
-                a[j] = U+V;
-                a[j+k] = U-V;
-            }
-        }
-    }
-
-    k = 4;
-    for (i = 0; i < 128; i++) {
-        j1 = 8*i;
-        j2 = j1+3;
-        S = psi_rev[i+128];
-        for (j = j1; j <= j2; j++) {
-            U = reduce12289((int64_t)a[j]);
-            V = reduce12289_2x((int64_t)a[j+4]*S);
-            a[j] = U+V;
-            a[j+4] = U-V;
-        }
-    }
-
-    for (m = 256; m < N; m = 2*m) {
-        k = k >> 1;
-        for (i = 0; i < m; i++) {
-            j1 = 2*i*k;
-            j2 = j1+k-1;
-            S = psi_rev[m+i];
-            for (j = j1; j <= j2; j++) { 
-                U = a[j]; 
-                V = reduce12289((int64_t)a[j+k]*S); 
-                a[j] = U+V;
-                a[j+k] = U-V;
-            }
-        }
-    }
-    return;
-}
-
-
-void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
-{ // Inverse NTT
-    unsigned int m, h, i, j, j1, j2, k = 1;
-    int32_t S, U, V;
-    int64_t temp;
-
-    for (m = N; m > 2; m >>= 1) {
-        j1 = 0;
-        h = m >> 1;
-        for (i = 0; i < h; i++) {
-            j2 = j1+k-1;
-            S = omegainv_rev[h+i];
-            for (j = j1; j <= j2; j++) {
-                U = a[j];
-                V = a[j+k];
-                a[j] = U+V;
-                temp = (int64_t)(U-V)*S;
-                if (m == 32) {
-                    a[j] = reduce12289((int64_t)a[j]);
-                    a[j+k] = reduce12289_2x(temp);
-                } else {
-                    a[j+k] = reduce12289(temp);
-                }
-             }
-             j1 = j1+2*k;
-        }
-        k = 2*k;
-    }
-    for (j = 0; j < k; j++) {
-        U = a[j];
-        V = a[j+k];
-        a[j] = reduce12289((int64_t)(U+V)*Ninv);
-        a[j+k] = reduce12289((int64_t)(U-V)*omegainv1N_rev);
-    }
-    return;
-}
-
-
-void two_reduce12289(int32_t* a, unsigned int N)
-{ // Two consecutive reductions modulo q
-    unsigned int i; 
-
-    for (i = 0; i < N; i++) {
-        a[i] = reduce12289((int64_t)a[i]);
-        a[i] = reduce12289((int64_t)a[i]);
-    }
-}
-
-
-void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
-{ // Component-wise multiplication
-    unsigned int i; 
-
-    for (i = 0; i < N; i++) {
-        c[i] = reduce12289((int64_t)a[i]*b[i]);
-        c[i] = reduce12289((int64_t)c[i]);
-    }
-}
-
-
-void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
-{ // Component-wise multiplication and addition
-    unsigned int i; 
-
-    for (i = 0; i < N; i++) {
-        d[i] = reduce12289((int64_t)a[i]*b[i] + c[i]);
-        d[i] = reduce12289((int64_t)d[i]);
-    }
-}
-
-
-void smul(int32_t* a, int32_t scalar, unsigned int N)
-{ // Component-wise multiplication with scalar
-    unsigned int i; 
-
-    for (i = 0; i < N; i++) {
-        a[i] = a[i]*scalar;
-    }
-}
-
-
-void correction(int32_t* a, int32_t p, unsigned int N)
-{ // Correction modulo q 
-    unsigned int i; 
-    int32_t mask;
-
-    for (i = 0; i < N; i++) {
-        mask = a[i] >> (4*sizeof(int32_t) - 1);
-        a[i] += (p & mask) - p;
-        mask = a[i] >> (4*sizeof(int32_t) - 1);
-        a[i] += (p & mask);
-    }
-}
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: NTT functions and other polynomial operations
+*
+*****************************************************************************************/
+
+#include "../LatticeCrypto_priv.h"
+
+#if !defined(GENERIC_IMPLEMENTATION) || defined(VECTOR_SUPPORT)    // These functions make up the generic backend of dispatch.c, the fallback of AMD64/ntt_x64.c 
+    #define NTT_CT_std2rev_12289        NTT_CT_std2rev_12289_generic   // for N != 1024, or the scalar reference of generic/ntt_vector.c
+    #define INTT_GS_rev2std_12289       INTT_GS_rev2std_12289_generic
+    #define NTT_CT_std2rev_12289_xN     NTT_CT_std2rev_12289_xN_generic
+    #define INTT_GS_rev2std_12289_xN    INTT_GS_rev2std_12289_xN_generic
+    #define two_reduce12289             two_reduce12289_generic
+    #define pmul                        pmul_generic
+    #define pmuladd                     pmuladd_generic
+#endif
+#if !defined(GENERIC_IMPLEMENTATION)
+    #define NTT_CT_std2rev_12289_int16  NTT_CT_std2rev_12289_int16_generic
+    #define INTT_GS_rev2std_12289_int16 INTT_GS_rev2std_12289_int16_generic
+    #define two_reduce12289_int16       two_reduce12289_int16_generic
+    #define pmul_int16                  pmul_int16_generic
+    #define pmuladd_int16               pmuladd_int16_generic
+#endif
+
+const uint32_t mask12 = ((uint64_t)1 << 12) - 1;
+
+    
+int32_t reduce12289(int64_t a)
+{ // Reduction modulo q
+    int32_t c0, c1;
+   
+    c0 = (int32_t)(a & mask12);
+    c1 = (int32_t)(a >> 12);
+ 
+    return (3*c0 - c1);
+}
+
+    
+int32_t reduce12289_2x(int64_t a)
+{ // Two merged reductions modulo q
+    int32_t c0, c1, c2;
+   
+    c0 = (int32_t)(a & mask12);
+    c1 = (int32_t)((a >> 12) & mask12);
+    c2 = (int32_t)(a >> 24);
+ 
+    return (9*c0 - 3*c1 + c2);
+}
+
+
+void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N)
+{ // Forward NTT, N = 512, 1024 or 2048
+  // Stage m=128 reduces both halves, so the scale factor psi_rev[0] is applied there
+    unsigned int m, i, j, j1, j2, k = N;
+    int32_t S, T, U, V;
+
+    for (m = 1; m < 128; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            j1 = 2*i*k;
+            j2 = j1+k-1;
+            S = psi_rev[m+i];
+            for (j = j1; j <= j2; j++) { 
+                U = a[j]; 
+                V = reduce12289((int64_t)a[j+k]*S);
+                a[j] = U+V;
+                a[j+k] = U-V;
+            }
+        }
+    }
+
+    k = k >> 1;
+    T = psi_rev[0];
+    for (i = 0; i < 128; i++) {
+        j1 = 2*i*k;
+        j2 = j1+k-1;
+        S = psi_rev[i+128];
+        for (j = j1; j <= j2; j++) {
+            U = reduce12289((int64_t)a[j]*T);
+            V = reduce12289_2x((int64_t)a[j+k]*S);
+            a[j] = U+V;
+            a[j+k] = U-V;
+        }
+    }
+
+    for (m = 256; m < N; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            j1 = 2*i*k;
+            j2 = j1+k-1;
+            S = psi_rev[m+i];
+            for (j = j1; j <= j2; j++) { 
+                U = a[j]; 
+                V = reduce12289((int64_t)a[j+k]*S); 
+                a[j] = U+V;
+                a[j+k] = U-V;
+            }
+        }
+    }
+    return;
+}
+
+
+void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{ // Inverse NTT
+    unsigned int m, h, i, j, j1, j2, k = 1;
+    int32_t S, U, V;
+    int64_t temp;
+
+    for (m = N; m > 2; m >>= 1) {
+        j1 = 0;
+        h = m >> 1;
+        for (i = 0; i < h; i++) {
+            j2 = j1+k-1;
+            S = omegainv_rev[h+i];
+            for (j = j1; j <= j2; j++) {
+                U = a[j];
+                V = a[j+k];
+                a[j] = U+V;
+                temp = (int64_t)(U-V)*S;
+                if (m == 32) {
+                    a[j] = reduce12289((int64_t)a[j]);
+                    a[j+k] = reduce12289_2x(temp);
+                } else {
+                    a[j+k] = reduce12289(temp);
+                }
+             }
+             j1 = j1+2*k;
+        }
+        k = 2*k;
+    }
+    for (j = 0; j < k; j++) {
+        U = a[j];
+        V = a[j+k];
+        a[j] = reduce12289((int64_t)(U+V)*Ninv);
+        a[j+k] = reduce12289((int64_t)(U-V)*omegainv1N_rev);
+    }
+    return;
+}
+
+
+void NTT_CT_std2rev_12289_xN(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N)
+{ // Forward NTT of "npolys" independent polynomials, each twiddle is loaded once for all polynomials
+    unsigned int m, i, j, j1, j2, p, k = N;
+    int32_t S, T, U, V, *b;
+
+    for (m = 1; m < 128; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            j1 = 2*i*k;
+            j2 = j1+k-1;
+            S = psi_rev[m+i];
+            for (p = 0; p < npolys; p++) {
+                b = a[p];
+                for (j = j1; j <= j2; j++) { 
+                    U = b[j]; 
+                    V = reduce12289((int64_t)b[j+k]*S);
+                    b[j] = U+V;
+                    b[j+k] = U-V;
+                }
+            }
+        }
+    }
+
+    k = k >> 1;
+    T = psi_rev[0];
+    for (i = 0; i < 128; i++) {
+        j1 = 2*i*k;
+        j2 = j1+k-1;
+        S = psi_rev[i+128];
+        for (p = 0; p < npolys; p++) {
+            b = a[p];
+            for (j = j1; j <= j2; j++) {
+                U = reduce12289((int64_t)b[j]*T);
+                V = reduce12289_2x((int64_t)b[j+k]*S);
+                b[j] = U+V;
+                b[j+k] = U-V;
+            }
+        }
+    }
+
+    for (m = 256; m < N; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            j1 = 2*i*k;
+            j2 = j1+k-1;
+            S = psi_rev[m+i];
+            for (p = 0; p < npolys; p++) {
+                b = a[p];
+                for (j = j1; j <= j2; j++) { 
+                    U = b[j]; 
+                    V = reduce12289((int64_t)b[j+k]*S); 
+                    b[j] = U+V;
+                    b[j+k] = U-V;
+                }
+            }
+        }
+    }
+    return;
+}
+
+
+void INTT_GS_rev2std_12289_xN(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{ // Inverse NTT of "npolys" independent polynomials, each twiddle is loaded once for all polynomials
+    unsigned int m, h, i, j, j1, j2, p, k = 1;
+    int32_t S, U, V, *b;
+    int64_t temp;
+
+    for (m = N; m > 2; m >>= 1) {
+        j1 = 0;
+        h = m >> 1;
+        for (i = 0; i < h; i++) {
+            j2 = j1+k-1;
+            S = omegainv_rev[h+i];
+            for (p = 0; p < npolys; p++) {
+                b = a[p];
+                for (j = j1; j <= j2; j++) {
+                    U = b[j];
+                    V = b[j+k];
+                    b[j] = U+V;
+                    temp = (int64_t)(U-V)*S;
+                    if (m == 32) {
+                        b[j] = reduce12289((int64_t)b[j]);
+                        b[j+k] = reduce12289_2x(temp);
+                    } else {
+                        b[j+k] = reduce12289(temp);
+                    }
+                }
+            }
+            j1 = j1+2*k;
+        }
+        k = 2*k;
+    }
+    for (p = 0; p < npolys; p++) {
+        b = a[p];
+        for (j = 0; j < k; j++) {
+            U = b[j];
+            V = b[j+k];
+            b[j] = reduce12289((int64_t)(U+V)*Ninv);
+            b[j+k] = reduce12289((int64_t)(U-V)*omegainv1N_rev);
+        }
+    }
+    return;
+}
+
+
+#if defined(GENERIC_IMPLEMENTATION) && !defined(VECTOR_SUPPORT)
+
+bool NTT_xN_faster(void)
+{ // Loading each twiddle once for all polynomials saves about 3% per polynomial in the inverse NTT, but costs about 1% in the forward one
+    return false;
+}
+
+
+bool INTT_xN_faster(void)
+{
+    return true;
+}
+
+#endif
+
+
+void two_reduce12289(int32_t* a, unsigned int N)
+{ // Two consecutive reductions modulo q, outputs in [0, q-1]
+  // The second reduction leaves the coefficients in (-q, 2q) (see the BOUNDS=TRUE test mode), so one correction step suffices
+    unsigned int i; 
+    int32_t mask;
+
+    for (i = 0; i < N; i++) {
+        a[i] = reduce12289((int64_t)a[i]);
+        a[i] = reduce12289((int64_t)a[i]);
+        mask = a[i] >> (8*sizeof(int32_t) - 1);
+        a[i] += (PARAMETER_Q & mask) - PARAMETER_Q;
+        mask = a[i] >> (8*sizeof(int32_t) - 1);
+        a[i] += (PARAMETER_Q & mask);
+    }
+}
+
+
+void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
+{ // Component-wise multiplication
+    unsigned int i; 
+
+    for (i = 0; i < N; i++) {
+        c[i] = reduce12289((int64_t)a[i]*b[i]);
+        c[i] = reduce12289((int64_t)c[i]);
+    }
+}
+
+
+void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
+{ // Component-wise multiplication and addition, outputs in [0, q-1]
+  // The second reduction leaves the coefficients in (-q, 2q) (see the BOUNDS=TRUE test mode), so one correction step suffices
+    unsigned int i; 
+    int32_t mask;
+
+    for (i = 0; i < N; i++) {
+        d[i] = reduce12289((int64_t)a[i]*b[i] + c[i]);
+        d[i] = reduce12289((int64_t)d[i]);
+        mask = d[i] >> (8*sizeof(int32_t) - 1);
+        d[i] += (PARAMETER_Q & mask) - PARAMETER_Q;
+        mask = d[i] >> (8*sizeof(int32_t) - 1);
+        d[i] += (PARAMETER_Q & mask);
+    }
+}
+
+
+#if !defined(ASM_SUPPORT)    // The assembly builds take the following helpers from AMD64/ntt_x64.c
+
+void smul(int32_t* a, int32_t scalar, unsigned int N)
+{ // Component-wise multiplication with scalar
+    unsigned int i; 
+
+    for (i = 0; i < N; i++) {
+        a[i] = a[i]*scalar;
+    }
+}
+
+
+void correction(int32_t* a, int32_t p, unsigned int N)
+{ // Correction modulo q 
+    unsigned int i; 
+    int32_t mask;
+
+    for (i = 0; i < N; i++) {
+        mask = a[i] >> (4*sizeof(int32_t) - 1);
+        a[i] += (p & mask) - p;
+        mask = a[i] >> (4*sizeof(int32_t) - 1);
+        a[i] += (p & mask);
+    }
+}
+
+
+int16_t montgomery_reduce12289(int32_t a)
+{ // Montgomery reduction modulo q, outputs a*2^-16 mod q in (-q, q) for |a| < q*2^15
+    int16_t u;
+
+    u = (int16_t)((int16_t)a*PARAMETER_QINV);
+    return (int16_t)((a - (int32_t)u*PARAMETER_Q) >> 16);
+}
+
+
+int16_t barrett_reduce12289(int16_t a)
+{ // Barrett reduction modulo q, the quotient is rounded in two steps exactly as vpmulhw/vpmulhrsw do it
+    int32_t t;
+
+    t = ((int32_t)a*PARAMETER_BARRETT) >> 16;
+    t = (t + 512) >> 10;
+    return (int16_t)(a - t*PARAMETER_Q);
+}
+
+#endif
+
+
+void NTT_CT_std2rev_12289_int16(int16_t* a, const int16_t* psi_rev, unsigned int N)
+{ // Forward NTT on 16-bit coefficients, inputs in (-q, q), outputs in [-q/2, q/2]
+  // The twiddles carry the Montgomery factor, so each product is a single Montgomery reduction. The first stage also multiplies 
+  // by psi_rev[0] (3 for the default table) to output the same values modulo q as NTT_CT_std2rev_12289, and a Barrett reduction 
+  // every second stage keeps |a| < 2.5q.
+    unsigned int m, i, j, j1, j2, k = N;
+    int16_t S, T, U, V;
+
+    k = k >> 1;
+    S = psi_rev[1];
+    T = psi_rev[0];
+    for (j = 0; j < k; j++) {
+        U = a[j];
+        V = montgomery_reduce12289((int32_t)a[j+k]*S);
+        a[j] = montgomery_reduce12289((int32_t)(U+V)*T);
+        a[j+k] = montgomery_reduce12289((int32_t)(U-V)*T);
+    }
+
+    for (m = 2; m < N; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            j1 = 2*i*k;
+            j2 = j1+k-1;
+            S = psi_rev[m+i];
+            for (j = j1; j <= j2; j++) {
+                U = a[j];
+                V = montgomery_reduce12289((int32_t)a[j+k]*S);
+                a[j] = U+V;
+                a[j+k] = U-V;
+                if (k & 0x155) {                  // k = 256, 64, 16, 4, 1
+                    a[j] = barrett_reduce12289(a[j]);
+                    a[j+k] = barrett_reduce12289(a[j+k]);
+                }
+            }
+        }
+    }
+    return;
+}
+
+
+void INTT_GS_rev2std_12289_int16(int16_t* a, const int16_t* omegainv_rev, const int16_t omegainv1N_rev, const int16_t Ninv, unsigned int N)
+{ // Inverse NTT on 16-bit coefficients, inputs in (-q, q), outputs in (-q, q)
+  // The sums are Barrett reduced at every stage, except at stage m=32 where they are multiplied by 3 as in INTT_GS_rev2std_12289
+    unsigned int m, h, i, j, j1, j2, k = 1;
+    int16_t S, U, V;
+
+    for (m = N; m > 2; m >>= 1) {
+        j1 = 0;
+        h = m >> 1;
+        for (i = 0; i < h; i++) {
+            j2 = j1+k-1;
+            S = omegainv_rev[h+i];
+            for (j = j1; j <= j2; j++) {
+                U = a[j];
+                V = a[j+k];
+                if (m == 32) {
+                    a[j] = montgomery_reduce12289((int32_t)(U+V)*PARAMETER_MONT3);
+                } else {
+                    a[j] = barrett_reduce12289(U+V);
+                }
+                a[j+k] = montgomery_reduce12289((int32_t)(U-V)*S);
+            }
+            j1 = j1+2*k;
+        }
+        k = 2*k;
+    }
+    for (j = 0; j < k; j++) {
+        U = a[j];
+        V = a[j+k];
+        a[j] = montgomery_reduce12289((int32_t)(U+V)*Ninv);
+        a[j+k] = montgomery_reduce12289((int32_t)(U-V)*omegainv1N_rev);
+    }
+    return;
+}
+
+
+void two_reduce12289_int16(int16_t* a, unsigned int N)
+{ // Two consecutive reductions modulo q (a multiplication by 9), outputs values in [0, q-1]
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        a[i] = montgomery_reduce12289((int32_t)a[i]*PARAMETER_MONT9);
+        a[i] += (a[i] >> 15) & PARAMETER_Q;
+    }
+}
+
+
+void pmul_int16(int16_t* a, int16_t* b, int16_t* c, unsigned int N)
+{ // Component-wise multiplication, the second reduction restores the factor 9 of pmul
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        c[i] = montgomery_reduce12289((int32_t)a[i]*b[i]);
+        c[i] = montgomery_reduce12289((int32_t)c[i]*PARAMETER_MONT9_2);
+    }
+}
+
+
+void pmuladd_int16(int16_t* a, int16_t* b, int16_t* c, int16_t* d, unsigned int N)
+{ // Component-wise multiplication and addition, the second reduction restores the factor 9 of pmuladd
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        d[i] = montgomery_reduce12289((int32_t)a[i]*b[i]) + montgomery_reduce12289((int32_t)c[i]);
+        d[i] = montgomery_reduce12289((int32_t)d[i]*PARAMETER_MONT9_2);
+    }
+}
+
+
+#if !defined(ASM_SUPPORT)
+
+void smul_int16(int16_t* a, int32_t scalar, unsigned int N)
+{ // Component-wise multiplication with scalar, outputs values in (-q, q)
+    unsigned int i;
+    int32_t s = (scalar*PARAMETER_MONT) % PARAMETER_Q;        // Montgomery representation of the scalar, centered in [-q/2, q/2]
+
+    if (s > PARAMETER_Q/2) {
+        s -= PARAMETER_Q;
+    } else if (s < -PARAMETER_Q/2) {
+        s += PARAMETER_Q;
+    }
+
+    for (i = 0; i < N; i++) {
+        a[i] = montgomery_reduce12289((int32_t)a[i]*s);
+    }
+}
+
+
+void correction_int16(int16_t* a, unsigned int N)
+{ // Correction modulo q, outputs values in [0, q-1]
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        a[i] = barrett_reduce12289(a[i]);
+        a[i] += (a[i] >> 15) & PARAMETER_Q;
+    }
+}
+
+#endif
@@ -0,0 +1,490 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: portable vectorized NTT functions, encoding, reconciliation and error sampling
+*           using GCC/Clang vector extensions. The compiler maps the 8x32-bit vectors onto SSE4.1,
+*           AVX2 or NEON registers, and every kernel outputs the same values as its scalar
+*           counterpart in generic/ntt.c or kex.c (little-endian targets only, as kex.c)
+*
+*****************************************************************************************/
+
+#include "../LatticeCrypto_priv.h"
+#include <string.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+    // The 32-byte vectors never cross a non-inlined call boundary, so the ABI note on targets without AVX does not apply
+    #pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+typedef int32_t  v8i32 __attribute__ ((vector_size (32)));
+typedef uint32_t v8u32 __attribute__ ((vector_size (32)));
+typedef int64_t  v8i64 __attribute__ ((vector_size (64)));
+typedef int32_t  v4i32 __attribute__ ((vector_size (16)));
+
+// Reduction modulo q of 64-bit lanes, same as reduce12289, for the component-wise products whose operands are both unbounded
+#define REDUCE(a, vtype)        (3*__builtin_convertvector((a) & 0xfff, vtype) - __builtin_convertvector((a) >> 12, vtype))
+#define WIDEN8(a)               __builtin_convertvector((a), v8i64)
+
+// Products by a twiddle factor S followed by a reduction, in 32-bit lanes: with a = ah*2^12 + al and 0 <= al < 2^12, a*S >> 12 is 
+// ah*S + (al*S >> 12) and the low 12 bits of a*S are those of al*S. The results match reduce12289((int64_t)a*S) for |S| < 2^19, and 
+// reduce12289_2x((int64_t)a*S) for |a*S| < 2^43
+#define MULRED(vtype)                                                       \
+static __inline vtype mulred_##vtype(vtype a, int32_t S)                    \
+{                                                                           \
+    vtype lo = (a & 0xfff)*S;                                               \
+    return 3*(lo & 0xfff) - ((a >> 12)*S + (lo >> 12));                     \
+}                                                                           \
+                                                                            \
+static __inline vtype mulred_2x_##vtype(vtype a, int32_t S)                 \
+{                                                                           \
+    vtype lo = (a & 0xfff)*S, hi = (a >> 12)*S + (lo >> 12);                \
+    return 9*(lo & 0xfff) - 3*(hi & 0xfff) + (hi >> 12);                    \
+}                                                                           \
+                                                                            \
+static __inline vtype red_##vtype(vtype a)                                  \
+{                                                                           \
+    return 3*(a & 0xfff) - (a >> 12);                                       \
+}
+
+MULRED(v8i32)
+MULRED(v4i32)
+
+static const v8u32 lanes = {0, 1, 2, 3, 4, 5, 6, 7};
+
+
+static __inline v8i32 load8(const int32_t* p)
+{
+    v8i32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+static __inline void store8(int32_t* p, v8i32 v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+
+static __inline v4i32 load4(const int32_t* p)
+{
+    v4i32 v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+
+static __inline void store4(int32_t* p, v4i32 v)
+{
+    memcpy(p, &v, sizeof(v));
+}
+
+
+static __inline v8u32 abs8(v8i32 a)
+{ // Absolute value on each lane
+    v8i32 mask = a >> 31;
+    return (v8u32)((mask ^ a) - mask);
+}
+
+
+static void ct_butterflies(int32_t* a, unsigned int j1, unsigned int k, int32_t S)
+{ // Cooley-Tukey butterflies on a[j] and a[j+k], j = j1,...,j1+k-1. Gaps below 4 are done with scalar code
+    unsigned int j = j1, j2 = j1+k;
+    v8i32 U8, V8;
+    v4i32 U4, V4;
+    int32_t U, V;
+
+    for (; j+8 <= j2; j += 8) {
+        U8 = load8(&a[j]);
+        V8 = mulred_v8i32(load8(&a[j+k]), S);
+        store8(&a[j], U8+V8);
+        store8(&a[j+k], U8-V8);
+    }
+    for (; j+4 <= j2; j += 4) {
+        U4 = load4(&a[j]);
+        V4 = mulred_v4i32(load4(&a[j+k]), S);
+        store4(&a[j], U4+V4);
+        store4(&a[j+k], U4-V4);
+    }
+    for (; j < j2; j++) {
+        U = a[j];
+        V = reduce12289((int64_t)a[j+k]*S);
+        a[j] = U+V;
+        a[j+k] = U-V;
+    }
+}
+
+
+static void ct_butterflies_merged(int32_t* a, unsigned int j1, unsigned int k, int32_t T, int32_t S)
+{ // Butterflies of the stage that reduces both halves, scaling the first one by T
+    unsigned int j = j1, j2 = j1+k;
+    v8i32 U8, V8;
+    v4i32 U4, V4;
+    int32_t U, V;
+
+    for (; j+8 <= j2; j += 8) {
+        U8 = mulred_v8i32(load8(&a[j]), T);
+        V8 = mulred_2x_v8i32(load8(&a[j+k]), S);
+        store8(&a[j], U8+V8);
+        store8(&a[j+k], U8-V8);
+    }
+    for (; j+4 <= j2; j += 4) {
+        U4 = mulred_v4i32(load4(&a[j]), T);
+        V4 = mulred_2x_v4i32(load4(&a[j+k]), S);
+        store4(&a[j], U4+V4);
+        store4(&a[j+k], U4-V4);
+    }
+    for (; j < j2; j++) {
+        U = reduce12289((int64_t)a[j]*T);
+        V = reduce12289_2x((int64_t)a[j+k]*S);
+        a[j] = U+V;
+        a[j+k] = U-V;
+    }
+}
+
+
+static void gs_butterflies(int32_t* a, unsigned int j1, unsigned int k, int32_t S, bool merged)
+{ // Gentleman-Sande butterflies on a[j] and a[j+k], j = j1,...,j1+k-1. The merged stage also reduces the sums
+    unsigned int j = j1, j2 = j1+k;
+    v8i32 U8, V8;
+    v4i32 U4, V4;
+    int32_t U, V;
+    int64_t temp;
+
+    for (; j+8 <= j2; j += 8) {
+        U8 = load8(&a[j]);
+        V8 = load8(&a[j+k]);
+        if (merged) {
+            store8(&a[j], red_v8i32(U8+V8));
+            store8(&a[j+k], mulred_2x_v8i32(U8-V8, S));
+        } else {
+            store8(&a[j], U8+V8);
+            store8(&a[j+k], mulred_v8i32(U8-V8, S));
+        }
+    }
+    for (; j+4 <= j2; j += 4) {
+        U4 = load4(&a[j]);
+        V4 = load4(&a[j+k]);
+        if (merged) {
+            store4(&a[j], red_v4i32(U4+V4));
+            store4(&a[j+k], mulred_2x_v4i32(U4-V4, S));
+        } else {
+            store4(&a[j], U4+V4);
+            store4(&a[j+k], mulred_v4i32(U4-V4, S));
+        }
+    }
+    for (; j < j2; j++) {
+        U = a[j];
+        V = a[j+k];
+        a[j] = U+V;
+        temp = (int64_t)(U-V)*S;
+        if (merged) {
+            a[j] = reduce12289((int64_t)a[j]);
+            a[j+k] = reduce12289_2x(temp);
+        } else {
+            a[j+k] = reduce12289(temp);
+        }
+    }
+}
+
+
+void NTT_CT_std2rev_12289_vector(int32_t* a, const int32_t* psi_rev, unsigned int N)
+{ // Forward NTT, N = 512, 1024 or 2048
+  // Stage m=128 reduces both halves, so the scale factor psi_rev[0] is applied there
+    unsigned int m, i, k = N;
+
+    for (m = 1; m < 128; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            ct_butterflies(a, 2*i*k, k, psi_rev[m+i]);
+        }
+    }
+
+    k = k >> 1;
+    for (i = 0; i < 128; i++) {
+        ct_butterflies_merged(a, 2*i*k, k, psi_rev[0], psi_rev[i+128]);
+    }
+
+    for (m = 256; m < N; m = 2*m) {
+        k = k >> 1;
+        for (i = 0; i < m; i++) {
+            ct_butterflies(a, 2*i*k, k, psi_rev[m+i]);
+        }
+    }
+}
+
+
+void INTT_GS_rev2std_12289_vector(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{ // Inverse NTT
+    unsigned int m, h, i, j, j1, k = 1;
+    v8i32 U, V;
+
+    for (m = N; m > 2; m >>= 1) {
+        j1 = 0;
+        h = m >> 1;
+        for (i = 0; i < h; i++) {
+            gs_butterflies(a, j1, k, omegainv_rev[h+i], (m == 32));
+            j1 = j1+2*k;
+        }
+        k = 2*k;
+    }
+    for (j = 0; j < k; j += 8) {
+        U = load8(&a[j]);
+        V = load8(&a[j+k]);
+        store8(&a[j], mulred_v8i32(U+V, Ninv));
+        store8(&a[j+k], mulred_v8i32(U-V, omegainv1N_rev));
+    }
+}
+
+
+void two_reduce12289_vector(int32_t* a, unsigned int N)
+{ // Two consecutive reductions modulo q, outputs in [0, q-1]
+    unsigned int i;
+    v8i32 b, mask;
+
+    for (i = 0; i < N; i += 8) {
+        b = red_v8i32(load8(&a[i]));
+        b = red_v8i32(b);
+        mask = b >> 31;
+        b += (PARAMETER_Q & mask) - PARAMETER_Q;
+        mask = b >> 31;
+        b += (PARAMETER_Q & mask);
+        store8(&a[i], b);
+    }
+}
+
+
+void pmul_vector(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
+{ // Component-wise multiplication
+    unsigned int i;
+    v8i32 d;
+
+    for (i = 0; i < N; i += 8) {
+        d = REDUCE(WIDEN8(load8(&a[i]))*WIDEN8(load8(&b[i])), v8i32);
+        store8(&c[i], red_v8i32(d));
+    }
+}
+
+
+void pmuladd_vector(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
+{ // Component-wise multiplication and addition, outputs in [0, q-1]
+    unsigned int i;
+    v8i32 e, mask;
+
+    for (i = 0; i < N; i += 8) {
+        e = REDUCE(WIDEN8(load8(&a[i]))*WIDEN8(load8(&b[i])) + WIDEN8(load8(&c[i])), v8i32);
+        e = red_v8i32(e);
+        mask = e >> 31;
+        e += (PARAMETER_Q & mask) - PARAMETER_Q;
+        mask = e >> 31;
+        e += (PARAMETER_Q & mask);
+        store8(&d[i], e);
+    }
+}
+
+
+void encode_vector(const uint32_t* pk, unsigned char* m)
+{ // Packs 1024 14-bit coefficients into 1792 bytes
+  // The 7-byte groups do not map onto vector lanes, so each group is assembled in a 64-bit word and stored with 8 bytes,
+  // the last of which the next group overwrites
+    unsigned int j;
+    uint64_t w;
+
+    for (j = 0; j < PARAMETER_N; j += 4) {
+        w = (uint64_t)pk[j] | ((uint64_t)pk[j+1] << 14) | ((uint64_t)pk[j+2] << 28) | ((uint64_t)pk[j+3] << 42);
+        memcpy(&m[7*j/4], &w, (j < PARAMETER_N-4) ? 8 : 7);
+    }
+}
+
+
+void decode_vector(const unsigned char* m, uint32_t *pk)
+{ // Unpacks 1792 bytes into 1024 14-bit coefficients
+    unsigned int j;
+    uint64_t w = 0;
+
+    for (j = 0; j < PARAMETER_N; j += 4) {
+        memcpy(&w, &m[7*j/4], (j < PARAMETER_N-4) ? 8 : 7);
+        pk[j]   = (uint32_t)(w & 0x3FFF);
+        pk[j+1] = (uint32_t)((w >> 14) & 0x3FFF);
+        pk[j+2] = (uint32_t)((w >> 28) & 0x3FFF);
+        pk[j+3] = (uint32_t)((w >> 42) & 0x3FFF);
+    }
+}
+
+
+void helprec_vector(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits)
+{ // Computes the reconciliation vector rvec from x and 256 random bits, 8 values of i at a time
+    unsigned int i, j, k = PARAMETER_N/4;
+    v8u32 bit, norm, r[4], v0[4], v1[4];
+
+    for (i = 0; i < k; i += 8) {
+        bit = (((v8u32){0} + random_bits[i >> 3]) >> lanes) & 1;
+        norm = (v8u32){0};
+        for (j = 0; j < 4; j++) {
+            memcpy(&r[j], &x[i+k*j], sizeof(v8u32));
+            r[j] = (r[j] << 1) - bit;
+            v0[j] = 4 - ((r[j] - PARAMETER_Q4) >> 31) - ((r[j] - PARAMETER_3Q4) >> 31) - ((r[j] - PARAMETER_5Q4) >> 31) - ((r[j] - PARAMETER_7Q4) >> 31);
+            v1[j] = 3 - ((r[j] - PARAMETER_Q2) >> 31) - ((r[j] - PARAMETER_Q) >> 31) - ((r[j] - PARAMETER_3Q2) >> 31);
+            norm += abs8((v8i32)(2*r[j] - PARAMETER_Q*v0[j]));
+        }
+        norm = (v8u32)((v8i32)(norm - PARAMETER_Q) >> 31);    // If norm < q then norm = 0xff...ff, else norm = 0
+        for (j = 0; j < 4; j++) {
+            v0[j] = (norm & (v0[j] ^ v1[j])) ^ v1[j];
+        }
+        r[0] = (v0[0] - v0[3]) & 0x03;
+        r[1] = (v0[1] - v0[3]) & 0x03;
+        r[2] = (v0[2] - v0[3]) & 0x03;
+        r[3] = ((v0[3] << 1) + (1 & ~norm)) & 0x03;
+        for (j = 0; j < 4; j++) {
+            memcpy(&rvec[i+k*j], &r[j], sizeof(v8u32));
+        }
+    }
+}
+
+
+void rec_vector(const uint32_t *x, const uint32_t* rvec, unsigned char *key)
+{ // Reconciles x with rvec into a 256-bit key, 8 key bits at a time
+    unsigned int i, j, k = PARAMETER_N/4;
+    v8u32 xj[4], r[4], t, mask1, mask2, value, norm;
+    uint32_t byte;
+
+    for (i = 0; i < k; i += 8) {
+        for (j = 0; j < 4; j++) {
+            memcpy(&xj[j], &x[i+k*j], sizeof(v8u32));
+            memcpy(&r[j], &rvec[i+k*j], sizeof(v8u32));
+        }
+        norm = (v8u32){0};
+        for (j = 0; j < 4; j++) {
+            t = 8*xj[j] - ((j < 3) ? 2*r[j] + r[3] : r[3])*PARAMETER_Q;
+            mask1 = (v8u32)((v8i32)t >> 31);
+            mask2 = (v8u32)((4*PARAMETER_Q - (v8i32)abs8((v8i32)t)) >> 31);
+            value = (mask1 & ((8*PARAMETER_Q) ^ (uint32_t)(-8*PARAMETER_Q))) ^ (uint32_t)(-8*PARAMETER_Q);
+            norm += abs8((v8i32)(t + (mask2 & value)));
+        }
+        t = (((8*PARAMETER_Q - norm) >> 31) ^ 1) << lanes;    // If norm < 8*q then bit = 1, else bit = 0
+        byte = 0;
+        for (j = 0; j < 8; j++) {
+            byte |= t[j];
+        }
+        key[i >> 3] = (unsigned char)byte;
+    }
+}
+
+
+void error_sampling_vector(unsigned char* stream, int32_t* e)
+{ // Samples 1024 binomially distributed errors from 3072 stream bytes, 8 words of each third of the stream at a time
+    unsigned int i, j;
+    v8u32 p0, p1, p2, acc1, acc2;
+    v8i32 d0, d1, d2, d3;
+
+    for (i = 0; i < PARAMETER_N/4; i += 8) {
+        memcpy(&p0, &stream[4*i], sizeof(v8u32));
+        memcpy(&p1, &stream[4*(i+PARAMETER_N/4)], sizeof(v8u32));
+        memcpy(&p2, &stream[4*(i+2*PARAMETER_N/4)], sizeof(v8u32));
+        acc1 = (v8u32){0};
+        acc2 = (v8u32){0};
+        for (j = 0; j < 8; j++) {
+            acc1 += (p0 >> j) & 0x01010101;
+            acc2 += (p1 >> j) & 0x01010101;
+        }
+        for (j = 0; j < 4; j++) {
+            acc1 += (p2 >> j) & 0x01010101;
+            acc2 += (p2 >> (j+4)) & 0x01010101;
+        }
+        d0 = (v8i32)(acc1 & 0xFF) - (v8i32)((acc1 >> 8) & 0xFF);
+        d1 = (v8i32)((acc1 >> 16) & 0xFF) - (v8i32)(acc1 >> 24);
+        d2 = (v8i32)(acc2 & 0xFF) - (v8i32)((acc2 >> 8) & 0xFF);
+        d3 = (v8i32)((acc2 >> 16) & 0xFF) - (v8i32)(acc2 >> 24);
+        for (j = 0; j < 8; j++) {
+            e[2*(i+j)]   = d0[j];
+            e[2*(i+j)+1] = d1[j];
+            e[2*(i+j)+PARAMETER_N/2]   = d2[j];
+            e[2*(i+j)+PARAMETER_N/2+1] = d3[j];
+        }
+    }
+}
+
+
+// The functions below select the vectorized kernels in generic builds with VECTOR_SUPPORT, where they are faster than the scalar code.
+// Without AVX2 each 8x32-bit vector is split over two SSE2 registers, and the NTTs are slower than the scalar ones. With AVX2 the
+// compiler vectorizes the scalar pointwise products itself, and they are faster than the kernels. two_reduce12289 never gains
+
+void NTT_CT_std2rev_12289(int32_t* a, const int32_t* psi_rev, unsigned int N)
+{
+#if defined(__AVX2__)
+    NTT_CT_std2rev_12289_vector(a, psi_rev, N);
+#else
+    NTT_CT_std2rev_12289_generic(a, psi_rev, N);
+#endif
+}
+
+
+void INTT_GS_rev2std_12289(int32_t* a, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{
+#if defined(__AVX2__)
+    INTT_GS_rev2std_12289_vector(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+#else
+    INTT_GS_rev2std_12289_generic(a, omegainv_rev, omegainv1N_rev, Ninv, N);
+#endif
+}
+
+
+void NTT_CT_std2rev_12289_xN(int32_t** a, unsigned int npolys, const int32_t* psi_rev, unsigned int N)
+{
+    unsigned int p;
+
+    for (p = 0; p < npolys; p++) {
+        NTT_CT_std2rev_12289(a[p], psi_rev, N);
+    }
+}
+
+
+void INTT_GS_rev2std_12289_xN(int32_t** a, unsigned int npolys, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv, unsigned int N)
+{
+    unsigned int p;
+
+    for (p = 0; p < npolys; p++) {
+        INTT_GS_rev2std_12289(a[p], omegainv_rev, omegainv1N_rev, Ninv, N);
+    }
+}
+
+
+bool NTT_xN_faster(void)
+{ // The batched NTTs make one call per polynomial
+    return false;
+}
+
+
+bool INTT_xN_faster(void)
+{
+    return false;
+}
+
+
+void two_reduce12289(int32_t* a, unsigned int N)
+{
+    two_reduce12289_generic(a, N);
+}
+
+
+void pmul(int32_t* a, int32_t* b, int32_t* c, unsigned int N)
+{
+#if defined(__AVX2__)
+    pmul_generic(a, b, c, N);
+#else
+    pmul_vector(a, b, c, N);
+#endif
+}
+
+
+void pmuladd(int32_t* a, int32_t* b, int32_t* c, int32_t* d, unsigned int N)
+{
+#if defined(__AVX2__)
+    pmuladd_generic(a, b, c, d, N);
+#else
+    pmuladd_vector(a, b, c, d, N);
+#endif
+}
@@ -1,531 +1,2001 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: Ring-LWE key exchange
-*           The implementation is based on the instantiation of Peikert's key exchange [1]
-*           due to Alkim, Ducas, Poppelmann and Schwabe [2].
-*
-* [1] C. Peikert, "Lattice cryptography for the internet", in Post-Quantum Cryptography - 
-*     6th International Workshop (PQCrypto 2014), LNCS 8772, pp. 197-219. Springer, 2014.
-* [2] E. Alkim, L. Ducas, T. Pppelmann and P. Schwabe, "Post-quantum key exchange - a new 
-*     hope", IACR Cryptology ePrint Archive, Report 2015/1092, 2015.
-*
-******************************************************************************************/ 
-
-#include "LatticeCrypto_priv.h"
-#include <malloc.h>
-
-extern const int32_t psi_rev_ntt1024_12289[1024];           
-extern const int32_t omegainv_rev_ntt1024_12289[1024];
-extern const int32_t omegainv10N_rev_ntt1024_12289;
-extern const int32_t Ninv11_ntt1024_12289;
-
-/*
- * @param clear_words Clears memory
-*/
-__inline void clear_words(void* mem, digit_t nwords)
-{ 
-  
-    unsigned int i;
-    volatile digit_t *v = mem; 
-
-    for (i = 0; i < nwords; i++) {
-        v[i] = 0;
-    }
-}
-
-/*
- * @param LatticeCrypto_initialize Initialize structure pLatticeCrypto with user-provided functions: RandomBytesFunction, ExtendableOutputFunction and StreamOutputFunction.
-*/
-CRYPTO_STATUS LatticeCrypto_initialize(PLatticeCryptoStruct pLatticeCrypto, RandomBytes RandomBytesFunction, ExtendableOutput ExtendableOutputFunction, StreamOutput StreamOutputFunction)
-{ 
-
-    pLatticeCrypto->RandomBytesFunction = RandomBytesFunction;
-    pLatticeCrypto->ExtendableOutputFunction = ExtendableOutputFunction;
-    pLatticeCrypto->StreamOutputFunction = StreamOutputFunction;
-
-    return CRYPTO_SUCCESS;
-}
-
-/*
- * @param LatticeCrypto_allocate Dynamically allocates memory for LatticeCrypto structure.  
-*/
-PLatticeCryptoStruct LatticeCrypto_allocate()
-{ 
- 
-    PLatticeCryptoStruct LatticeCrypto = NULL;
-
-    LatticeCrypto = (PLatticeCryptoStruct)calloc(1, sizeof(LatticeCryptoStruct));
-
-    if (LatticeCrypto == NULL) {
-        return NULL;
-    }
-    return LatticeCrypto;
-}
-
-/*
- * @param LatticeCrypto_get_error_message Outputs error or success message for given CRYPTO_STATUS  
-*/
-const char* LatticeCrypto_get_error_message(CRYPTO_STATUS Status)
-{  
-    struct error_mapping {
-        unsigned int index;
-        char*        string;
-    } mapping[CRYPTO_STATUS_TYPE_SIZE] = {
-        {CRYPTO_SUCCESS, CRYPTO_MSG_SUCCESS},
-        {CRYPTO_ERROR, CRYPTO_MSG_ERROR},
-        {CRYPTO_ERROR_DURING_TEST, CRYPTO_MSG_ERROR_DURING_TEST},
-        {CRYPTO_ERROR_UNKNOWN, CRYPTO_MSG_ERROR_UNKNOWN},
-        {CRYPTO_ERROR_NOT_IMPLEMENTED, CRYPTO_MSG_ERROR_NOT_IMPLEMENTED},
-        {CRYPTO_ERROR_NO_MEMORY, CRYPTO_MSG_ERROR_NO_MEMORY},
-        {CRYPTO_ERROR_INVALID_PARAMETER, CRYPTO_MSG_ERROR_INVALID_PARAMETER},
-        {CRYPTO_ERROR_SHARED_KEY, CRYPTO_MSG_ERROR_SHARED_KEY},
-        {CRYPTO_ERROR_TOO_MANY_ITERATIONS, CRYPTO_MSG_ERROR_TOO_MANY_ITERATIONS}
-    };
-
-    if (Status >= CRYPTO_STATUS_TYPE_SIZE || mapping[Status].string == NULL) {
-        return "Unrecognized CRYPTO_STATUS";
-    } else {
-        return mapping[Status].string;
-    }
-};
-
-/*
- * @param encode_A Alice's message encryption  
-*/
-void encode_A(const uint32_t* pk, const unsigned char* seed, unsigned char* m)
-{  
-    unsigned int i = 0, j;
-        
-#if defined(GENERIC_IMPLEMENTATION)
-    for (j = 0; j < 1024; j += 4) {        
-        m[i]   = (unsigned char)(pk[j] & 0xFF);
-        m[i+1] = (unsigned char)((pk[j] >> 8) | ((pk[j+1] & 0x03) << 6));
-        m[i+2] = (unsigned char)((pk[j+1] >> 2) & 0xFF);
-        m[i+3] = (unsigned char)((pk[j+1] >> 10) | ((pk[j+2] & 0x0F) << 4));
-        m[i+4] = (unsigned char)((pk[j+2] >> 4) & 0xFF);
-        m[i+5] = (unsigned char)((pk[j+2] >> 12) | ((pk[j+3] & 0x3F) << 2));
-        m[i+6] = (unsigned char)(pk[j+3] >> 6);
-        i += 7;
-    }
-    
-#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
-    encode_asm(pk, m);
-    i = 1792;
-#endif
-
-    for (j = 0; j < 32; j++) {
-        m[i+j] = seed[j];
-    }
-}
-
-/*
- * @param decode_A Alice's message decryption  
-*/
-void decode_A(const unsigned char* m, uint32_t *pk, unsigned char* seed)
-{  
-    unsigned int i = 0, j;
-    
-#if defined(GENERIC_IMPLEMENTATION)
-    for (j = 0; j < 1024; j += 4) {        
-        pk[j]   = ((uint32_t)m[i] | (((uint32_t)m[i+1] & 0x3F) << 8));
-        pk[j+1] = (((uint32_t)m[i+1] >> 6) | ((uint32_t)m[i+2] << 2) | (((uint32_t)m[i+3] & 0x0F) << 10));
-        pk[j+2] = (((uint32_t)m[i+3] >> 4) | ((uint32_t)m[i+4] << 4) | (((uint32_t)m[i+5] & 0x03) << 12));
-        pk[j+3] = (((uint32_t)m[i+5] >> 2) | ((uint32_t)m[i+6] << 6));
-        i += 7;
-    }
-    
-#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
-    decode_asm(m, pk);
-    i = 1792;
-#endif
-
-    for (j = 0; j < 32; j++) {
-        seed[j] = m[i+j];
-    }
-}
-
-/*
- * @param encode_B Bob's message encryption  
-*/
-void encode_B(const uint32_t* pk, const uint32_t* rvec, unsigned char* m)
-{  
-    unsigned int i = 0, j;
-    
-#if defined(GENERIC_IMPLEMENTATION) 
-    for (j = 0; j < 1024; j += 4) {        
-        m[i]   = (unsigned char)(pk[j] & 0xFF);
-        m[i+1] = (unsigned char)((pk[j] >> 8) | ((pk[j+1] & 0x03) << 6));
-        m[i+2] = (unsigned char)((pk[j+1] >> 2) & 0xFF);
-        m[i+3] = (unsigned char)((pk[j+1] >> 10) | ((pk[j+2] & 0x0F) << 4));
-        m[i+4] = (unsigned char)((pk[j+2] >> 4) & 0xFF);
-        m[i+5] = (unsigned char)((pk[j+2] >> 12) | ((pk[j+3] & 0x3F) << 2));
-        m[i+6] = (unsigned char)(pk[j+3] >> 6);
-        i += 7;
-    }
-    
-#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
-    encode_asm(pk, m);
-#endif
-
-    i = 0;
-    for (j = 0; j < 1024/4; j++) {
-        m[1792+j] = (unsigned char)(rvec[i] | (rvec[i+1] << 2) | (rvec[i+2] << 4) | (rvec[i+3] << 6));
-        i += 4;
-    }
-}
-
-/*
- * @param decode_B Bob's message decryption  
-*/
-void decode_B(unsigned char* m, uint32_t* pk, uint32_t* rvec)
-{  
-    unsigned int i = 0, j;
-    
-#if defined(GENERIC_IMPLEMENTATION) 
-    for (j = 0; j < 1024; j += 4) {        
-        pk[j]   = ((uint32_t)m[i] | (((uint32_t)m[i+1] & 0x3F) << 8));
-        pk[j+1] = (((uint32_t)m[i+1] >> 6) | ((uint32_t)m[i+2] << 2) | (((uint32_t)m[i+3] & 0x0F) << 10));
-        pk[j+2] = (((uint32_t)m[i+3] >> 4) | ((uint32_t)m[i+4] << 4) | (((uint32_t)m[i+5] & 0x03) << 12));
-        pk[j+3] = (((uint32_t)m[i+5] >> 2) | ((uint32_t)m[i+6] << 6));
-        i += 7;
-    }
-    
-#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
-    decode_asm(m, pk);
-    i = 1792;
-#endif
-    
-    i = 0;
-    for (j = 0; j < 1024/4; j++) {
-        rvec[i]   = (uint32_t)(m[1792+j] & 0x03);
-        rvec[i+1] = (uint32_t)((m[1792+j] >> 2) & 0x03);
-        rvec[i+2] = (uint32_t)((m[1792+j] >> 4) & 0x03);
-        rvec[i+3] = (uint32_t)(m[1792+j] >> 6);
-        i += 4;
-    }
-}
-
-/*
- * @param Abs Computes absolute value 
-*/
-static __inline uint32_t Abs(int32_t value)
-{ 
-    uint32_t mask;
-
-    mask = (uint32_t)(value >> 31);
-    return ((mask ^ value) - mask);
-}
-
-/*
- * @param HelpRec Reconciliation helper
- * @note Move to kex.h
-*/
-CRYPTO_STATUS HelpRec(const uint32_t* x, uint32_t* rvec, const unsigned char* seed, unsigned int nonce, StreamOutput StreamOutputFunction)
-{  
-    unsigned int i, j, norm;
-    unsigned char bit, random_bits[32], nce[8] = {0};
-    uint32_t v0[4], v1[4];
-    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
-    
-    nce[1] = (unsigned char)nonce;                
-    Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, 32, random_bits, StreamOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        clear_words((void*)random_bits, NBYTES_TO_NWORDS(32));
-        return Status;
-    }    
-
-#if defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT)         
-    helprec_asm(x, rvec, random_bits);
-#else   
-
-    for (i = 0; i < 256; i++) {
-        bit = 1 & (random_bits[i >> 3] >> (i & 0x07));
-        rvec[i]     = (x[i]     << 1) - bit;  
-        rvec[i+256] = (x[i+256] << 1) - bit;
-        rvec[i+512] = (x[i+512] << 1) - bit;
-        rvec[i+768] = (x[i+768] << 1) - bit; 
-
-        norm = 0;
-        v0[0] = 4; v0[1] = 4; v0[2] = 4; v0[3] = 4;
-        v1[0] = 3; v1[1] = 3; v1[2] = 3; v1[3] = 3; 
-        for (j = 0; j < 4; j++) {
-            v0[j] -= (rvec[i+256*j] - PARAMETER_Q4 ) >> 31;
-            v0[j] -= (rvec[i+256*j] - PARAMETER_3Q4) >> 31;
-            v0[j] -= (rvec[i+256*j] - PARAMETER_5Q4) >> 31;
-            v0[j] -= (rvec[i+256*j] - PARAMETER_7Q4) >> 31;
-            v1[j] -= (rvec[i+256*j] - PARAMETER_Q2 ) >> 31;
-            v1[j] -= (rvec[i+256*j] - PARAMETER_Q  ) >> 31;
-            v1[j] -= (rvec[i+256*j] - PARAMETER_3Q2) >> 31;
-            norm += Abs(2*rvec[i+256*j] - PARAMETER_Q*v0[j]);
-        }
-/*
- * @note If norm < q then norm = 0xff...ff, else norm = 0
-*/
-        norm = (uint32_t)((int32_t)(norm - PARAMETER_Q) >> 31);    
-        v0[0] = (norm & (v0[0] ^ v1[0])) ^ v1[0];
-        v0[1] = (norm & (v0[1] ^ v1[1])) ^ v1[1];
-        v0[2] = (norm & (v0[2] ^ v1[2])) ^ v1[2];
-        v0[3] = (norm & (v0[3] ^ v1[3])) ^ v1[3];
-        rvec[i]     = (v0[0] - v0[3]) & 0x03;
-        rvec[i+256] = (v0[1] - v0[3]) & 0x03;
-        rvec[i+512] = (v0[2] - v0[3]) & 0x03;
-        rvec[i+768] = ((v0[3] << 1) + (1 & ~norm)) & 0x03;
-    }
-#endif
-
-    return Status;
-}
-
-/*
- * @param LDDecode Performs low-density decoding
-*/
-static __inline uint32_t LDDecode(int32_t* t)
-{  
-    unsigned int i, norm = 0;
-    uint32_t mask1, mask2, value;
-    int32_t cneg = -8*PARAMETER_Q;
-    
-	for (i = 0; i < 4; i++) { 
-        mask1 = t[i] >> 31;                                    // If t[i] < 0 then mask2 = 0xff...ff, else mask2 = 0
-        mask2 = (4*PARAMETER_Q - (int32_t)Abs(t[i])) >> 31;    // If 4*PARAMETER_Q > Abs(t[i]) then mask2 = 0, else mask2 = 0xff...ff
-
-        value = ((mask1 & (8*PARAMETER_Q ^ cneg)) ^ cneg);
-		norm += Abs(t[i] + (mask2 & value));
-    }
-
-    return ((8*PARAMETER_Q - norm) >> 31) ^ 1;                 // If norm < PARAMETER_Q then return 1, else return 0
-};
-
-/*
- * @param Rec Reconciles crypto exchange
-*/
-void Rec(const uint32_t *x, const uint32_t* rvec, unsigned char *key)               
-{  
-#if defined(GENERIC_IMPLEMENTATION)
-    unsigned int i;
-    uint32_t t[4];
-
-    for (i = 0; i < 32; i++) {
-        key[i] = 0;
-    }
-    for (i = 0; i < 256; i++) {        
-        t[0] = 8*x[i]     - (2*rvec[i] + rvec[i+768]) * PARAMETER_Q;
-        t[1] = 8*x[i+256] - (2*rvec[i+256] + rvec[i+768]) * PARAMETER_Q;
-        t[2] = 8*x[i+512] - (2*rvec[i+512] + rvec[i+768]) * PARAMETER_Q;
-        t[3] = 8*x[i+768] - (rvec[i+768]) * PARAMETER_Q;
-      
-        key[i >> 3] |= (unsigned char)LDDecode((int32_t*)t) << (i & 0x07);
-    }
-    
-#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
-    rec_asm(x, rvec, key);
-#endif
-}
-
-/*
- * @param get_error Samples for errors
-*/
-CRYPTO_STATUS get_error(int32_t* e, unsigned char* seed, unsigned int nonce, StreamOutput StreamOutputFunction)              
-{  
-    unsigned char stream[3*PARAMETER_N];    
-    uint32_t* pstream = (uint32_t*)&stream;   
-    uint32_t acc1, acc2, temp;  
-    uint8_t *pacc1 = (uint8_t*)&acc1, *pacc2 = (uint8_t*)&acc2;
-    unsigned char nce[8] = {0};
-    unsigned int i, j;
-    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
-    
-    nce[0] = (unsigned char)nonce;
-    Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, 3*PARAMETER_N, stream, StreamOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        clear_words((void*)stream, NBYTES_TO_NWORDS(3*PARAMETER_N));
-        return Status;
-    }    
-
-#if defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT)         
-    error_sampling_asm(stream, e);
-#else    
-    for (i = 0; i < PARAMETER_N/4; i++)
-    {
-        acc1 = 0;
-        acc2 = 0;
-        for (j = 0; j < 8; j++) {
-            acc1 += (pstream[i] >> j) & 0x01010101;
-            acc2 += (pstream[i+PARAMETER_N/4] >> j) & 0x01010101;
-        }
-        for (j = 0; j < 4; j++) {
-            temp = pstream[i+2*PARAMETER_N/4] >> j;
-            acc1 += temp & 0x01010101;
-            acc2 += (temp >> 4) & 0x01010101;
-        }
-        e[2*i]   = pacc1[0] - pacc1[1];                               
-        e[2*i+1] = pacc1[2] - pacc1[3];
-        e[2*i+PARAMETER_N/2]   = pacc2[0] - pacc2[1];               
-        e[2*i+PARAMETER_N/2+1] = pacc2[2] - pacc2[3];
-    }
-#endif
-
-    return Status;
-}
-
-/*
- * @param generate_a Generates temporary variable a
- * @note Rename this variable
-*/
-CRYPTO_STATUS generate_a(uint32_t* a, const unsigned char* seed, ExtendableOutput ExtendableOutputFunction)             
-{  
-
-    return extended_output(seed, SEED_BYTES, PARAMETER_N, a, ExtendableOutputFunction);
-}
-
-/*
- * @param KeyGeneration_A Alice's SecretKeyA key generation and PublicKeyA computation
- * @return Produces the private key SecretKeyA as 32-bit signed 1024-element array (4096 bytes in total)
- * @note public key PublicKeyA occupies 1824 bytes
-*/
-CRYPTO_STATUS KeyGeneration_A(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
-{   
-    uint32_t a[PARAMETER_N];
-    int32_t e[PARAMETER_N];
-    unsigned char seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];
-    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
-
-    Status = random_bytes(SEED_BYTES, seed, pLatticeCrypto->RandomBytesFunction);   
-    if (Status != CRYPTO_SUCCESS) {
-        return Status;
-    }
-    Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction);   
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-
-    Status = generate_a(a, seed, pLatticeCrypto->ExtendableOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-
-    Status = get_error(SecretKeyA, error_seed, 0, pLatticeCrypto->StreamOutputFunction);  
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-    Status = get_error(e, error_seed, 1, pLatticeCrypto->StreamOutputFunction);   
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-    NTT_CT_std2rev_12289(SecretKeyA, psi_rev_ntt1024_12289, PARAMETER_N); 
-    NTT_CT_std2rev_12289(e, psi_rev_ntt1024_12289, PARAMETER_N);
-    smul(e, 3, PARAMETER_N);
-
-    pmuladd((int32_t*)a, SecretKeyA, e, (int32_t*)a, PARAMETER_N); 
-    correction((int32_t*)a, PARAMETER_Q, PARAMETER_N);
-    encode_A(a, seed, PublicKeyA);
-    
-cleanup:
-    clear_words((void*)e, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
-
-    return Status;
-}
-
-/*
- * @param SecretAgreement_B Bob's key generation from Alice's 1824 byte PublicKeyA and shared secret computation
- * @return public key PublicKeyB (2048 bytes) and SharedSecretB (256 bits)
- * @note Rename this variable
-*/
-CRYPTO_STATUS SecretAgreement_B(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
-{ 
-    uint32_t pk_A[PARAMETER_N], a[PARAMETER_N], v[PARAMETER_N], r[PARAMETER_N];
-    int32_t sk_B[PARAMETER_N], e[PARAMETER_N];
-    unsigned char seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];
-    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
-
-    decode_A(PublicKeyA, pk_A, seed);
-    Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction); 
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-
-    Status = generate_a(a, seed, pLatticeCrypto->ExtendableOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-
-    Status = get_error(sk_B, error_seed, 0, pLatticeCrypto->StreamOutputFunction);  
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-    Status = get_error(e, error_seed, 1, pLatticeCrypto->StreamOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }   
-    NTT_CT_std2rev_12289(sk_B, psi_rev_ntt1024_12289, PARAMETER_N); 
-    NTT_CT_std2rev_12289(e, psi_rev_ntt1024_12289, PARAMETER_N);
-    smul(e, 3, PARAMETER_N);
-
-    pmuladd((int32_t*)a, sk_B, e, (int32_t*)a, PARAMETER_N); 
-    correction((int32_t*)a, PARAMETER_Q, PARAMETER_N);
-     
-    Status = get_error(e, error_seed, 2, pLatticeCrypto->StreamOutputFunction);  
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }   
-    NTT_CT_std2rev_12289(e, psi_rev_ntt1024_12289, PARAMETER_N); 
-    smul(e, 81, PARAMETER_N);
-    
-    pmuladd((int32_t*)pk_A, sk_B, e, (int32_t*)v, PARAMETER_N);    
-    INTT_GS_rev2std_12289((int32_t*)v, omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PARAMETER_N);
-    two_reduce12289((int32_t*)v, PARAMETER_N);
-#if defined(GENERIC_IMPLEMENTATION)
-    correction((int32_t*)v, PARAMETER_Q, PARAMETER_N); 
-#endif
-
-    Status = HelpRec(v, r, error_seed, 3, pLatticeCrypto->StreamOutputFunction); 
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }   
-    Rec(v, r, SharedSecretB);
-    encode_B(a, r, PublicKeyB);
-    
-cleanup:
-    clear_words((void*)sk_B, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)e, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
-    clear_words((void*)a, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)v, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)r, NBYTES_TO_NWORDS(4*PARAMETER_N));
-
-    return Status;
-}
-
-/*
- * @param SecretAgreement_A Computes shared secret SharedSecretA using Bob's 2048-byte public key PublicKeyB and Alice's 256-bit private key SecretKeyA.
- * @return Outputs 256-bit SharedSecretA
-*/
-CRYPTO_STATUS SecretAgreement_A(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
-{ 
-    uint32_t u[PARAMETER_N], r[PARAMETER_N];
-    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
-
-    decode_B(PublicKeyB, u, r);
-    
-    pmul(SecretKeyA, (int32_t*)u, (int32_t*)u, PARAMETER_N);       
-    INTT_GS_rev2std_12289((int32_t*)u, omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PARAMETER_N);
-    two_reduce12289((int32_t*)u, PARAMETER_N);
-#if defined(GENERIC_IMPLEMENTATION)
-    correction((int32_t*)u, PARAMETER_Q, PARAMETER_N); 
-#endif
-
-    Rec(u, r, SharedSecretA);
-    
-/*
- * @param clear_words Cleans up the registers
-*/
-    clear_words((void*)u, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)r, NBYTES_TO_NWORDS(4*PARAMETER_N));
-
-    return Status;
-}
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: Ring-LWE key exchange
+*           The implementation is based on the instantiation of Peikert's key exchange [1]
+*           due to Alkim, Ducas, Poppelmann and Schwabe [2].
+*
+* [1] C. Peikert, "Lattice cryptography for the internet", in Post-Quantum Cryptography - 
+*     6th International Workshop (PQCrypto 2014), LNCS 8772, pp. 197-219. Springer, 2014.
+* [2] E. Alkim, L. Ducas, T. Pöppelmann and P. Schwabe, "Post-quantum key exchange - a new 
+*     hope", IACR Cryptology ePrint Archive, Report 2015/1092, 2015.
+*
+******************************************************************************************/ 
+
+#include "LatticeCrypto_priv.h"
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern const int32_t psi_rev_ntt1024_12289[1024];           
+extern const int32_t psi_rev3_ntt1024_12289[1024];           
+extern const int32_t psi_rev81_ntt1024_12289[1024];           
+extern const int32_t omegainv_rev_ntt1024_12289[1024];
+extern const int32_t omegainv10N_rev_ntt1024_12289;
+extern const int32_t Ninv11_ntt1024_12289;
+extern const int16_t psi_rev_ntt1024_12289_int16[1024];           
+extern const int16_t psi_rev3_ntt1024_12289_int16[1024];           
+extern const int16_t psi_rev81_ntt1024_12289_int16[1024];           
+extern const int16_t omegainv_rev_ntt1024_12289_int16[1024];
+extern const int16_t omegainv10N_rev_ntt1024_12289_int16;
+extern const int16_t Ninv11_ntt1024_12289_int16;
+
+/*
+ * @param clear_words Clears memory
+*/
+__inline void clear_words(void* mem, digit_t nwords)
+{ 
+  
+    unsigned int i;
+    volatile digit_t *v = mem; 
+
+    for (i = 0; i < nwords; i++) {
+        v[i] = 0;
+    }
+}
+
+/*
+ * @param LatticeCrypto_initialize Initialize structure pLatticeCrypto with user-provided functions: RandomBytesFunction, ExtendableOutputFunction and StreamOutputFunction.
+ * @note ExtendableOutputFunction = NULL selects the built-in LatticeCrypto_shake128(), StreamOutputFunction = NULL the built-in LatticeCrypto_chacha20()
+ * @note With LatticeCrypto_aes256ctr() StreamOutputMultiFunction is set to its multi-nonce version, which expands the key once, else to NULL
+ * @note With runtime dispatch it also selects the backend, see LatticeCrypto_set_backend()
+*/
+CRYPTO_STATUS LatticeCrypto_initialize(PLatticeCryptoStruct pLatticeCrypto, RandomBytes RandomBytesFunction, ExtendableOutput ExtendableOutputFunction, StreamOutput StreamOutputFunction)
+{ 
+
+    pLatticeCrypto->RandomBytesFunction = RandomBytesFunction;
+    pLatticeCrypto->ExtendableOutputFunction = (ExtendableOutputFunction != NULL) ? ExtendableOutputFunction : LatticeCrypto_shake128;
+    pLatticeCrypto->StreamOutputFunction = (StreamOutputFunction != NULL) ? StreamOutputFunction : LatticeCrypto_chacha20;
+    if (pLatticeCrypto->StreamOutputFunction == LatticeCrypto_aes256ctr) {
+        pLatticeCrypto->StreamOutputMultiFunction = LatticeCrypto_aes256ctr_multi;
+    } else {
+        pLatticeCrypto->StreamOutputMultiFunction = NULL;
+    }
+    resolve_backend();
+
+    return CRYPTO_SUCCESS;
+}
+
+/*
+ * @param LatticeCrypto_allocate Dynamically allocates memory for LatticeCrypto structure.  
+*/
+PLatticeCryptoStruct LatticeCrypto_allocate()
+{ 
+ 
+    PLatticeCryptoStruct LatticeCrypto = NULL;
+
+    LatticeCrypto = (PLatticeCryptoStruct)calloc(1, sizeof(LatticeCryptoStruct));
+
+    if (LatticeCrypto == NULL) {
+        return NULL;
+    }
+    return LatticeCrypto;
+}
+
+/*
+ * @param LatticeCrypto_free Releases a LatticeCrypto structure from LatticeCrypto_allocate(), with its cache of a, its pools and its workers
+*/
+void LatticeCrypto_free(PLatticeCryptoStruct pLatticeCrypto)
+{ 
+
+    if (pLatticeCrypto == NULL) {
+        return;
+    }
+    LatticeCrypto_disable_workers(pLatticeCrypto);
+    LatticeCrypto_disable_keypair_pool(pLatticeCrypto);
+    LatticeCrypto_disable_noise_pool(pLatticeCrypto);
+    LatticeCrypto_disable_a_cache(pLatticeCrypto);
+    free(pLatticeCrypto);
+}
+
+/*
+ * @param LatticeCrypto_allocate_workspace Allocates a workspace for the key exchange functions with suffix _ws, aligned to WORKSPACE_ALIGN bytes and zeroed
+*/
+PLatticeCryptoWorkspace LatticeCrypto_allocate_workspace()
+{ 
+    PLatticeCryptoWorkspace workspace = NULL;
+
+#if (OS_TARGET == OS_WIN)
+    workspace = (PLatticeCryptoWorkspace)_aligned_malloc(sizeof(struct LatticeCryptoWorkspace), WORKSPACE_ALIGN);
+#else
+    if (posix_memalign((void**)&workspace, WORKSPACE_ALIGN, sizeof(struct LatticeCryptoWorkspace)) != 0) {
+        workspace = NULL;
+    }
+#endif
+    if (workspace == NULL) {
+        return NULL;
+    }
+    clear_words((void*)workspace, NBYTES_TO_NWORDS(sizeof(struct LatticeCryptoWorkspace)));
+    return workspace;
+}
+
+/*
+ * @param LatticeCrypto_free_workspace Wipes and releases a workspace from LatticeCrypto_allocate_workspace()
+*/
+void LatticeCrypto_free_workspace(PLatticeCryptoWorkspace workspace)
+{ 
+
+    if (workspace == NULL) {
+        return;
+    }
+    clear_words((void*)workspace, NBYTES_TO_NWORDS(sizeof(struct LatticeCryptoWorkspace)));
+#if (OS_TARGET == OS_WIN)
+    _aligned_free(workspace);
+#else
+    free(workspace);
+#endif
+}
+
+/*
+ * @param LatticeCrypto_get_error_message Outputs error or success message for given CRYPTO_STATUS  
+*/
+const char* LatticeCrypto_get_error_message(CRYPTO_STATUS Status)
+{  
+    struct error_mapping {
+        unsigned int index;
+        char*        string;
+    } mapping[CRYPTO_STATUS_TYPE_SIZE] = {
+        {CRYPTO_SUCCESS, CRYPTO_MSG_SUCCESS},
+        {CRYPTO_ERROR, CRYPTO_MSG_ERROR},
+        {CRYPTO_ERROR_DURING_TEST, CRYPTO_MSG_ERROR_DURING_TEST},
+        {CRYPTO_ERROR_UNKNOWN, CRYPTO_MSG_ERROR_UNKNOWN},
+        {CRYPTO_ERROR_NOT_IMPLEMENTED, CRYPTO_MSG_ERROR_NOT_IMPLEMENTED},
+        {CRYPTO_ERROR_NO_MEMORY, CRYPTO_MSG_ERROR_NO_MEMORY},
+        {CRYPTO_ERROR_INVALID_PARAMETER, CRYPTO_MSG_ERROR_INVALID_PARAMETER},
+        {CRYPTO_ERROR_SHARED_KEY, CRYPTO_MSG_ERROR_SHARED_KEY},
+        {CRYPTO_ERROR_TOO_MANY_ITERATIONS, CRYPTO_MSG_ERROR_TOO_MANY_ITERATIONS}
+    };
+
+    if (Status >= CRYPTO_STATUS_TYPE_SIZE || mapping[Status].string == NULL) {
+        return "Unrecognized CRYPTO_STATUS";
+    } else {
+        return mapping[Status].string;
+    }
+};
+
+/*
+ * @param encode_n Packs N 14-bit coefficients into 7*N/4 bytes (portable version)
+*/
+static void encode_n(const uint32_t* pk, unsigned char* m, unsigned int N)
+{  
+    unsigned int i = 0, j;
+        
+    for (j = 0; j < N; j += 4) {        
+        m[i]   = (unsigned char)(pk[j] & 0xFF);
+        m[i+1] = (unsigned char)((pk[j] >> 8) | ((pk[j+1] & 0x03) << 6));
+        m[i+2] = (unsigned char)((pk[j+1] >> 2) & 0xFF);
+        m[i+3] = (unsigned char)((pk[j+1] >> 10) | ((pk[j+2] & 0x0F) << 4));
+        m[i+4] = (unsigned char)((pk[j+2] >> 4) & 0xFF);
+        m[i+5] = (unsigned char)((pk[j+2] >> 12) | ((pk[j+3] & 0x3F) << 2));
+        m[i+6] = (unsigned char)(pk[j+3] >> 6);
+        i += 7;
+    }
+}
+
+/*
+ * @param decode_n Unpacks 7*N/4 bytes into N 14-bit coefficients (portable version)
+*/
+static void decode_n(const unsigned char* m, uint32_t *pk, unsigned int N)
+{  
+    unsigned int i = 0, j;
+    
+    for (j = 0; j < N; j += 4) {        
+        pk[j]   = ((uint32_t)m[i] | (((uint32_t)m[i+1] & 0x3F) << 8));
+        pk[j+1] = (((uint32_t)m[i+1] >> 6) | ((uint32_t)m[i+2] << 2) | (((uint32_t)m[i+3] & 0x0F) << 10));
+        pk[j+2] = (((uint32_t)m[i+3] >> 4) | ((uint32_t)m[i+4] << 4) | (((uint32_t)m[i+5] & 0x03) << 12));
+        pk[j+3] = (((uint32_t)m[i+5] >> 2) | ((uint32_t)m[i+6] << 6));
+        i += 7;
+    }
+}
+
+/*
+ * @param encode_generic Packs 1024 14-bit coefficients into 1792 bytes (portable version)
+*/
+void encode_generic(const uint32_t* pk, unsigned char* m)
+{  
+    encode_n(pk, m, PARAMETER_N);
+}
+
+/*
+ * @param decode_generic Unpacks 1792 bytes into 1024 14-bit coefficients (portable version)
+*/
+void decode_generic(const unsigned char* m, uint32_t *pk)
+{  
+    decode_n(m, pk, PARAMETER_N);
+}
+
+/*
+ * @param encode_poly Packs N 14-bit coefficients into 7*N/4 bytes using the selected implementation
+*/
+static __inline void encode_poly(const uint32_t* pk, unsigned char* m, unsigned int N)
+{  
+    unsigned int i;
+
+    if (N % PARAMETER_N != 0) {
+        encode_n(pk, m, N);
+        return;
+    }
+    for (i = 0; i < N; i += PARAMETER_N) {
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->encode(&pk[i], &m[POLY_BYTES(i)]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT) 
+        encode_avx512_asm(&pk[i], &m[POLY_BYTES(i)]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
+        encode_asm(&pk[i], &m[POLY_BYTES(i)]);
+#elif defined(VECTOR_SUPPORT)
+        encode_vector(&pk[i], &m[POLY_BYTES(i)]);
+#else
+        encode_generic(&pk[i], &m[POLY_BYTES(i)]);
+#endif
+    }
+}
+
+/*
+ * @param decode_poly Unpacks 7*N/4 bytes into N 14-bit coefficients using the selected implementation
+*/
+static __inline void decode_poly(const unsigned char* m, uint32_t *pk, unsigned int N)
+{  
+    unsigned int i;
+
+    if (N % PARAMETER_N != 0) {
+        decode_n(m, pk, N);
+        return;
+    }
+    for (i = 0; i < N; i += PARAMETER_N) {
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->decode(&m[POLY_BYTES(i)], &pk[i]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT) 
+        decode_avx512_asm(&m[POLY_BYTES(i)], &pk[i]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
+        decode_asm(&m[POLY_BYTES(i)], &pk[i]);
+#elif defined(VECTOR_SUPPORT)
+        decode_vector(&m[POLY_BYTES(i)], &pk[i]);
+#else
+        decode_generic(&m[POLY_BYTES(i)], &pk[i]);
+#endif
+    }
+}
+
+/*
+ * @param encode_A Alice's message encryption  
+*/
+void encode_A(const uint32_t* pk, const unsigned char* seed, unsigned char* m, unsigned int N)
+{  
+    unsigned int j;
+        
+    encode_poly(pk, m, N);
+
+    for (j = 0; j < SEED_BYTES; j++) {
+        m[POLY_BYTES(N)+j] = seed[j];
+    }
+}
+
+/*
+ * @param decode_A Alice's message decryption  
+*/
+void decode_A(const unsigned char* m, uint32_t *pk, unsigned char* seed, unsigned int N)
+{  
+    unsigned int j;
+    
+    decode_poly(m, pk, N);
+
+    for (j = 0; j < SEED_BYTES; j++) {
+        seed[j] = m[POLY_BYTES(N)+j];
+    }
+}
+
+/*
+ * @param encode_B Bob's message encryption  
+*/
+void encode_B(const uint32_t* pk, const uint32_t* rvec, unsigned char* m, unsigned int N)
+{  
+    unsigned int i = 0, j;
+    
+    encode_poly(pk, m, N);
+
+    for (j = 0; j < N/4; j++) {
+        m[POLY_BYTES(N)+j] = (unsigned char)(rvec[i] | (rvec[i+1] << 2) | (rvec[i+2] << 4) | (rvec[i+3] << 6));
+        i += 4;
+    }
+}
+
+/*
+ * @param decode_rvec Unpacks the N 2-bit values of rvec packed 4 per byte by encode_B
+*/
+static void decode_rvec(const unsigned char* m, uint32_t* rvec, unsigned int N)
+{  
+    unsigned int i = 0, j;
+    
+    for (j = 0; j < N/4; j++) {
+        rvec[i]   = (uint32_t)(m[j] & 0x03);
+        rvec[i+1] = (uint32_t)((m[j] >> 2) & 0x03);
+        rvec[i+2] = (uint32_t)((m[j] >> 4) & 0x03);
+        rvec[i+3] = (uint32_t)(m[j] >> 6);
+        i += 4;
+    }
+}
+
+/*
+ * @param decode_B Bob's message decryption  
+*/
+void decode_B(unsigned char* m, uint32_t* pk, uint32_t* rvec, unsigned int N)
+{  
+    decode_poly(m, pk, N);
+    decode_rvec(&m[POLY_BYTES(N)], rvec, N);
+}
+
+/*
+ * @param decode_pmul Unpacks the N 14-bit coefficients packed in m straight into c and multiplies them component-wise by a or, if a is NULL, 
+ *        by the N 14-bit coefficients packed in a_packed
+ * @note The portable decoder runs by blocks of PACKED_BLOCK coefficients, so that each block is still in L1 when pmul reads it. The vectorized 
+ *       decoders run on whole polynomials and are faster than the portable one on blocks, so with them m is decoded into c first
+*/
+static void decode_pmul(const unsigned char* m, int32_t* a, const unsigned char* a_packed, int32_t* c, unsigned int N)
+{  
+    unsigned int i;
+    uint32_t block[PACKED_BLOCK];
+    bool decoded = false;
+
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT) || defined(VECTOR_SUPPORT)
+    if (N % PARAMETER_N == 0) {
+        decode_poly(m, (uint32_t*)c, N);
+        decoded = true;
+    }
+#endif
+    if (decoded == true && a != NULL) {
+        pmul(a, c, c, N);
+        return;
+    }
+    for (i = 0; i < N; i += PACKED_BLOCK) {
+        if (decoded == false) {
+            decode_n(&m[POLY_BYTES(i)], (uint32_t*)&c[i], PACKED_BLOCK);
+        }
+        if (a != NULL) {
+            pmul(&a[i], &c[i], &c[i], PACKED_BLOCK);
+        } else {
+            decode_n(&a_packed[POLY_BYTES(i)], block, PACKED_BLOCK);
+            pmul((int32_t*)block, &c[i], &c[i], PACKED_BLOCK);
+        }
+    }
+    if (a == NULL) {
+        clear_words((void*)block, NBYTES_TO_NWORDS(4*PACKED_BLOCK));
+    }
+}
+
+/*
+ * @param encode_int16_generic Packs 1024 14-bit coefficients stored in 16 bits into 1792 bytes (portable version)
+*/
+void encode_int16_generic(const int16_t* pk, unsigned char* m)
+{  
+    unsigned int i = 0, j;
+    const uint16_t* p = (const uint16_t*)pk;
+        
+    for (j = 0; j < 1024; j += 4) {        
+        m[i]   = (unsigned char)(p[j] & 0xFF);
+        m[i+1] = (unsigned char)((p[j] >> 8) | ((p[j+1] & 0x03) << 6));
+        m[i+2] = (unsigned char)((p[j+1] >> 2) & 0xFF);
+        m[i+3] = (unsigned char)((p[j+1] >> 10) | ((p[j+2] & 0x0F) << 4));
+        m[i+4] = (unsigned char)((p[j+2] >> 4) & 0xFF);
+        m[i+5] = (unsigned char)((p[j+2] >> 12) | ((p[j+3] & 0x3F) << 2));
+        m[i+6] = (unsigned char)(p[j+3] >> 6);
+        i += 7;
+    }
+}
+
+/*
+ * @param decode_int16_generic Unpacks 1792 bytes into 1024 14-bit coefficients stored in 16 bits (portable version)
+*/
+void decode_int16_generic(const unsigned char* m, int16_t *pk)
+{  
+    unsigned int i = 0, j;
+    
+    for (j = 0; j < 1024; j += 4) {        
+        pk[j]   = (int16_t)((uint16_t)m[i] | (((uint16_t)m[i+1] & 0x3F) << 8));
+        pk[j+1] = (int16_t)(((uint16_t)m[i+1] >> 6) | ((uint16_t)m[i+2] << 2) | (((uint16_t)m[i+3] & 0x0F) << 10));
+        pk[j+2] = (int16_t)(((uint16_t)m[i+3] >> 4) | ((uint16_t)m[i+4] << 4) | (((uint16_t)m[i+5] & 0x03) << 12));
+        pk[j+3] = (int16_t)(((uint16_t)m[i+5] >> 2) | ((uint16_t)m[i+6] << 6));
+        i += 7;
+    }
+}
+
+/*
+ * @param encode_poly_int16 Packs 1024 14-bit coefficients stored in 16 bits into 1792 bytes using the selected implementation
+*/
+static __inline void encode_poly_int16(const int16_t* pk, unsigned char* m)
+{  
+#if defined(DISPATCH_SUPPORT)
+    backend_load()->encode_int16(pk, m);
+#elif defined(ASM_SUPPORT)
+    encode_int16_asm(pk, m);
+#else
+    encode_int16_generic(pk, m);
+#endif
+}
+
+/*
+ * @param decode_poly_int16 Unpacks 1792 bytes into 1024 14-bit coefficients stored in 16 bits using the selected implementation
+*/
+static __inline void decode_poly_int16(const unsigned char* m, int16_t *pk)
+{  
+#if defined(DISPATCH_SUPPORT)
+    backend_load()->decode_int16(m, pk);
+#elif defined(ASM_SUPPORT)
+    decode_int16_asm(m, pk);
+#else
+    decode_int16_generic(m, pk);
+#endif
+}
+
+/*
+ * @param encode_A_int16 Alice's message encryption from 16-bit coefficients
+*/
+static void encode_A_int16(const int16_t* pk, const unsigned char* seed, unsigned char* m)
+{  
+    unsigned int j;
+        
+    encode_poly_int16(pk, m);
+
+    for (j = 0; j < 32; j++) {
+        m[1792+j] = seed[j];
+    }
+}
+
+/*
+ * @param decode_A_int16 Alice's message decryption into 16-bit coefficients
+*/
+static void decode_A_int16(const unsigned char* m, int16_t *pk, unsigned char* seed)
+{  
+    unsigned int j;
+    
+    decode_poly_int16(m, pk);
+
+    for (j = 0; j < 32; j++) {
+        seed[j] = m[1792+j];
+    }
+}
+
+/*
+ * @param encode_B_int16 Bob's message encryption from 16-bit coefficients
+*/
+static void encode_B_int16(const int16_t* pk, const uint32_t* rvec, unsigned char* m)
+{  
+    unsigned int i = 0, j;
+    
+    encode_poly_int16(pk, m);
+
+    for (j = 0; j < 1024/4; j++) {
+        m[1792+j] = (unsigned char)(rvec[i] | (rvec[i+1] << 2) | (rvec[i+2] << 4) | (rvec[i+3] << 6));
+        i += 4;
+    }
+}
+
+/*
+ * @param decode_B_int16 Bob's message decryption into 16-bit coefficients
+*/
+static void decode_B_int16(unsigned char* m, int16_t* pk, uint32_t* rvec)
+{  
+    unsigned int i = 0, j;
+    
+    decode_poly_int16(m, pk);
+    
+    for (j = 0; j < 1024/4; j++) {
+        rvec[i]   = (uint32_t)(m[1792+j] & 0x03);
+        rvec[i+1] = (uint32_t)((m[1792+j] >> 2) & 0x03);
+        rvec[i+2] = (uint32_t)((m[1792+j] >> 4) & 0x03);
+        rvec[i+3] = (uint32_t)(m[1792+j] >> 6);
+        i += 4;
+    }
+}
+
+/*
+ * @param Abs Computes absolute value 
+*/
+static __inline uint32_t Abs(int32_t value)
+{ 
+    uint32_t mask;
+
+    mask = (uint32_t)(value >> 31);
+    return ((mask ^ value) - mask);
+}
+
+/*
+ * @param barrett_reduce32 Barrett reduction of a 32-bit value modulo q into (-q, 2q), in constant time
+*/
+static __inline int32_t barrett_reduce32(int32_t a)
+{ 
+    return a - (int32_t)(((int64_t)a*PARAMETER_BARRETT32) >> 32)*PARAMETER_Q;
+}
+
+/*
+ * @param helprec_n Computes the reconciliation vector rvec from x and N/4 random bits (portable version)
+*/
+static void helprec_n(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits, unsigned int N)
+{  
+    unsigned int i, j, norm, k = N/4;
+    unsigned char bit;
+    uint32_t v0[4], v1[4];
+
+    for (i = 0; i < k; i++) {
+        bit = 1 & (random_bits[i >> 3] >> (i & 0x07));
+        rvec[i]     = (x[i]     << 1) - bit;  
+        rvec[i+k]   = (x[i+k]   << 1) - bit;
+        rvec[i+2*k] = (x[i+2*k] << 1) - bit;
+        rvec[i+3*k] = (x[i+3*k] << 1) - bit; 
+
+        norm = 0;
+        v0[0] = 4; v0[1] = 4; v0[2] = 4; v0[3] = 4;
+        v1[0] = 3; v1[1] = 3; v1[2] = 3; v1[3] = 3; 
+        for (j = 0; j < 4; j++) {
+            v0[j] -= (rvec[i+k*j] - PARAMETER_Q4 ) >> 31;
+            v0[j] -= (rvec[i+k*j] - PARAMETER_3Q4) >> 31;
+            v0[j] -= (rvec[i+k*j] - PARAMETER_5Q4) >> 31;
+            v0[j] -= (rvec[i+k*j] - PARAMETER_7Q4) >> 31;
+            v1[j] -= (rvec[i+k*j] - PARAMETER_Q2 ) >> 31;
+            v1[j] -= (rvec[i+k*j] - PARAMETER_Q  ) >> 31;
+            v1[j] -= (rvec[i+k*j] - PARAMETER_3Q2) >> 31;
+            norm += Abs(2*rvec[i+k*j] - PARAMETER_Q*v0[j]);
+        }
+/*
+ * @note If norm < q then norm = 0xff...ff, else norm = 0
+*/
+        norm = (uint32_t)((int32_t)(norm - PARAMETER_Q) >> 31);    
+        v0[0] = (norm & (v0[0] ^ v1[0])) ^ v1[0];
+        v0[1] = (norm & (v0[1] ^ v1[1])) ^ v1[1];
+        v0[2] = (norm & (v0[2] ^ v1[2])) ^ v1[2];
+        v0[3] = (norm & (v0[3] ^ v1[3])) ^ v1[3];
+        rvec[i]     = (v0[0] - v0[3]) & 0x03;
+        rvec[i+k]   = (v0[1] - v0[3]) & 0x03;
+        rvec[i+2*k] = (v0[2] - v0[3]) & 0x03;
+        rvec[i+3*k] = ((v0[3] << 1) + (1 & ~norm)) & 0x03;
+    }
+}
+
+/*
+ * @param helprec_generic Computes the reconciliation vector rvec from x and 256 random bits (portable version)
+*/
+void helprec_generic(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits)
+{  
+    helprec_n(x, rvec, random_bits, PARAMETER_N);
+}
+
+/*
+ * @param helprec_poly Computes the reconciliation vector rvec from x and N/4 random bits with the kernel of the backend in use
+*/
+static void helprec_poly(const uint32_t* x, uint32_t* rvec, unsigned char* random_bits, unsigned int N)
+{  
+    unsigned int i;
+
+    if (N % PARAMETER_N != 0) {
+        helprec_n(x, rvec, random_bits, N);
+        return;
+    }
+    for (i = 0; i < N; i += PARAMETER_N) {
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->helprec(&x[i], &rvec[i], &random_bits[i/32]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT)         
+        helprec_avx512_asm(&x[i], &rvec[i], &random_bits[i/32]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT)         
+        helprec_asm(&x[i], &rvec[i], &random_bits[i/32]);
+#elif defined(VECTOR_SUPPORT)
+        helprec_vector(&x[i], &rvec[i], &random_bits[i/32]);
+#else   
+        helprec_generic(&x[i], &rvec[i], &random_bits[i/32]);
+#endif
+    }
+}
+
+/*
+ * @param HelpRec Reconciliation helper
+ * @note Move to kex.h
+*/
+CRYPTO_STATUS HelpRec(const uint32_t* x, uint32_t* rvec, const unsigned char* seed, unsigned int nonce, unsigned int N, StreamOutput StreamOutputFunction)
+{  
+    unsigned char random_bits[PARAMETER_N_MAX/32], nce[NONCE_SEED_BYTES] = {0};
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    nce[1] = (unsigned char)nonce;                
+    Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, N/32, random_bits, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        clear_words((void*)random_bits, NBYTES_TO_NWORDS(PARAMETER_N_MAX/32));
+        return Status;
+    }    
+
+    helprec_poly(x, rvec, random_bits, N);
+
+    return Status;
+}
+
+/*
+ * @param LDDecode Performs low-density decoding
+*/
+static __inline uint32_t LDDecode(int32_t* t)
+{  
+    unsigned int i, norm = 0;
+    uint32_t mask1, mask2, value;
+    int32_t cneg = -8*PARAMETER_Q;
+    
+	for (i = 0; i < 4; i++) { 
+        mask1 = t[i] >> 31;                                    // If t[i] < 0 then mask2 = 0xff...ff, else mask2 = 0
+        mask2 = (4*PARAMETER_Q - (int32_t)Abs(t[i])) >> 31;    // If 4*PARAMETER_Q > Abs(t[i]) then mask2 = 0, else mask2 = 0xff...ff
+
+        value = ((mask1 & (8*PARAMETER_Q ^ cneg)) ^ cneg);
+		norm += Abs(t[i] + (mask2 & value));
+    }
+
+    return ((8*PARAMETER_Q - norm) >> 31) ^ 1;                 // If norm < PARAMETER_Q then return 1, else return 0
+};
+
+/*
+ * @param rec_n Reconciles x with rvec into an N/4-bit key (portable version)
+*/
+static void rec_n(const uint32_t *x, const uint32_t* rvec, unsigned char *key, unsigned int N)               
+{  
+    unsigned int i, k = N/4;
+    uint32_t t[4];
+
+    for (i = 0; i < N/32; i++) {
+        key[i] = 0;
+    }
+    for (i = 0; i < k; i++) {        
+        t[0] = 8*x[i]     - (2*rvec[i] + rvec[i+3*k]) * PARAMETER_Q;
+        t[1] = 8*x[i+k]   - (2*rvec[i+k] + rvec[i+3*k]) * PARAMETER_Q;
+        t[2] = 8*x[i+2*k] - (2*rvec[i+2*k] + rvec[i+3*k]) * PARAMETER_Q;
+        t[3] = 8*x[i+3*k] - (rvec[i+3*k]) * PARAMETER_Q;
+      
+        key[i >> 3] |= (unsigned char)LDDecode((int32_t*)t) << (i & 0x07);
+    }
+}
+
+/*
+ * @param rec_generic Reconciles x with rvec into a 256-bit key (portable version)
+*/
+void rec_generic(const uint32_t *x, const uint32_t* rvec, unsigned char *key)               
+{  
+    rec_n(x, rvec, key, PARAMETER_N);
+}
+
+/*
+ * @param Rec Reconciles crypto exchange
+*/
+void Rec(const uint32_t *x, const uint32_t* rvec, unsigned char *key, unsigned int N)               
+{  
+    unsigned int i;
+
+    if (N % PARAMETER_N != 0) {
+        rec_n(x, rvec, key, N);
+        return;
+    }
+    for (i = 0; i < N; i += PARAMETER_N) {
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->rec(&x[i], &rvec[i], &key[i/32]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT) 
+        rec_avx512_asm(&x[i], &rvec[i], &key[i/32]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT) 
+        rec_asm(&x[i], &rvec[i], &key[i/32]);
+#elif defined(VECTOR_SUPPORT)
+        rec_vector(&x[i], &rvec[i], &key[i/32]);
+#else
+        rec_generic(&x[i], &rvec[i], &key[i/32]);
+#endif
+    }
+}
+
+/*
+ * @param rec_packed_n Reconciles x with the rvec packed 4 per byte in m into an N/4-bit key, unpacking each value of rvec when it is used (portable version)
+*/
+static void rec_packed_n(const uint32_t *x, const unsigned char* m, unsigned char *key, unsigned int N)               
+{  
+    unsigned int i, j, k = N/4;
+    uint32_t t[4], r0, r1, r2, r3;
+
+    for (i = 0; i < N/32; i++) {
+        key[i] = 0;
+    }
+    for (i = 0; i < k; i += 4) {                                                // The values of rvec i to i+3 share a byte, and so do those k, 2k and 3k further
+        r0 = m[i >> 2];
+        r1 = m[(i+k) >> 2];
+        r2 = m[(i+2*k) >> 2];
+        r3 = m[(i+3*k) >> 2];
+        for (j = i; j < i+4; j++) {
+            t[0] = 8*x[j]     - (2*(r0 & 0x03) + (r3 & 0x03)) * PARAMETER_Q;
+            t[1] = 8*x[j+k]   - (2*(r1 & 0x03) + (r3 & 0x03)) * PARAMETER_Q;
+            t[2] = 8*x[j+2*k] - (2*(r2 & 0x03) + (r3 & 0x03)) * PARAMETER_Q;
+            t[3] = 8*x[j+3*k] - (r3 & 0x03) * PARAMETER_Q;
+            key[j >> 3] |= (unsigned char)LDDecode((int32_t*)t) << (j & 0x07);
+            r0 >>= 2;
+            r1 >>= 2;
+            r2 >>= 2;
+            r3 >>= 2;
+        }
+    }
+}
+
+/*
+ * @param Rec_packed Reconciles x with the rvec packed in m, as encode_B outputs it, using the selected implementation
+ * @note The portable implementation unpacks rvec lazily and ignores r, which may be NULL; the vectorized ones read rvec unpacked into the 
+ *       N-coefficient buffer r, wiped afterwards
+*/
+static void Rec_packed(const uint32_t *x, const unsigned char* m, uint32_t* r, unsigned char *key, unsigned int N)               
+{  
+#if !defined(DISPATCH_SUPPORT) && !defined(ASM_SUPPORT) && !defined(VECTOR_SUPPORT)
+    unsigned int i;
+#endif
+
+    if (N % PARAMETER_N != 0) {
+        rec_packed_n(x, m, key, N);
+        return;
+    }
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT) || defined(VECTOR_SUPPORT)
+    decode_rvec(m, r, N);
+    Rec(x, r, key, N);
+    clear_words((void*)r, NBYTES_TO_NWORDS(4*N));
+#else
+    UNREFERENCED_PARAMETER(r);
+    for (i = 0; i < N; i += PARAMETER_N) {                                      // As Rec, by blocks of 1024 coefficients
+        rec_packed_n(&x[i], &m[i/4], &key[i/32], PARAMETER_N);
+    }
+#endif
+}
+
+/*
+ * @param binomial_swar64 Sums of the 8 bits of 8 bytes of s0 (s1) plus the 4 low (high) bits of the 8 bytes of s2, byte by byte, 
+ *        and the differences of the sums of the bytes 2k and 2k+1 plus 16, as 4 16-bit lanes of d1 (d2)
+ * @note Each sum is at most 12, so the lanes never borrow from each other
+*/
+static __inline void binomial_swar64(uint64_t s0, uint64_t s1, uint64_t s2, uint64_t* d1, uint64_t* d2)
+{  
+    const uint64_t m1 = 0x5555555555555555, m2 = 0x3333333333333333, m4 = 0x0F0F0F0F0F0F0F0F, m8 = 0x00FF00FF00FF00FF, bias = 0x0010001000100010;
+    uint64_t acc1, acc2;
+
+    s0 = s0 - ((s0 >> 1) & m1);                        // Bit counts of the 2-bit fields
+    s1 = s1 - ((s1 >> 1) & m1);
+    s2 = s2 - ((s2 >> 1) & m1);
+    s0 = (s0 & m2) + ((s0 >> 2) & m2);                 // Bit counts of the nibbles
+    s1 = (s1 & m2) + ((s1 >> 2) & m2);
+    s2 = (s2 & m2) + ((s2 >> 2) & m2);
+    acc1 = ((s0 + (s0 >> 4)) & m4) + (s2 & m4);        // Bit counts of the bytes, plus those of the low or high nibbles of s2
+    acc2 = ((s1 + (s1 >> 4)) & m4) + ((s2 >> 4) & m4);
+    *d1 = (acc1 & m8) + bias - ((acc1 >> 8) & m8);
+    *d2 = (acc2 & m8) + bias - ((acc2 >> 8) & m8);
+}
+
+/*
+ * @param error_sampling_n Samples N binomially distributed errors from 3*N stream bytes (portable version)
+ * @note Processes the stream 64 bits at a time, with the same output as the sampling bit by bit of 32-bit words
+*/
+static void error_sampling_n(unsigned char* stream, int32_t* e, unsigned int N)              
+{  
+    uint64_t* pstream = (uint64_t*)stream;   
+    uint64_t d1, d2;  
+    unsigned int i, k;
+
+    for (i = 0; i < N/8; i++)
+    {
+        binomial_swar64(pstream[i], pstream[i+N/8], pstream[i+2*N/8], &d1, &d2);
+        for (k = 0; k < 4; k++) {
+            e[4*i+k]     = (int32_t)((d1 >> (16*k)) & 0xFFFF) - 16;                               
+            e[4*i+k+N/2] = (int32_t)((d2 >> (16*k)) & 0xFFFF) - 16;
+        }
+    }
+}
+
+/*
+ * @param error_sampling_psi8_n Samples N errors of width 8, the differences of the bit counts of pairs of bytes, from 2*N stream bytes (portable version)
+*/
+static void error_sampling_psi8_n(unsigned char* stream, int32_t* e, unsigned int N)              
+{  
+    uint64_t* pstream = (uint64_t*)stream;   
+    uint64_t d1, d2;  
+    unsigned int i, k;
+
+    for (i = 0; i < N/8; i++)
+    {
+        binomial_swar64(pstream[i], pstream[i+N/8], 0, &d1, &d2);
+        for (k = 0; k < 4; k++) {
+            e[4*i+k]     = (int32_t)((d1 >> (16*k)) & 0xFFFF) - 16;                               
+            e[4*i+k+N/2] = (int32_t)((d2 >> (16*k)) & 0xFFFF) - 16;
+        }
+    }
+}
+
+/*
+ * @param error_sampling_psi4_n Samples N errors of width 4, the differences of the bit counts of pairs of nibbles, from N stream bytes (portable version)
+ * @note The low nibbles give the first N/2 errors and the high nibbles the last N/2, as the third part of the stream does for width 12
+*/
+static void error_sampling_psi4_n(unsigned char* stream, int32_t* e, unsigned int N)              
+{  
+    uint64_t* pstream = (uint64_t*)stream;   
+    uint64_t d1, d2;  
+    unsigned int i, k;
+
+    for (i = 0; i < N/8; i++)
+    {
+        binomial_swar64(0, 0, pstream[i], &d1, &d2);
+        for (k = 0; k < 4; k++) {
+            e[4*i+k]     = (int32_t)((d1 >> (16*k)) & 0xFFFF) - 16;                               
+            e[4*i+k+N/2] = (int32_t)((d2 >> (16*k)) & 0xFFFF) - 16;
+        }
+    }
+}
+
+/*
+ * @param error_sampling_generic Samples 1024 binomially distributed errors from 3072 stream bytes (portable version)
+*/
+void error_sampling_generic(unsigned char* stream, int32_t* e)              
+{  
+    error_sampling_n(stream, e, PARAMETER_N);
+}
+
+/*
+ * @param error_sampling_int16_generic Samples 1024 binomially distributed errors from 3072 stream bytes into 16-bit coefficients (portable version)
+*/
+void error_sampling_int16_generic(unsigned char* stream, int16_t* e)              
+{  
+    uint64_t* pstream = (uint64_t*)stream;   
+    uint64_t d1, d2;  
+    unsigned int i, k;
+
+    for (i = 0; i < PARAMETER_N/8; i++)
+    {
+        binomial_swar64(pstream[i], pstream[i+PARAMETER_N/8], pstream[i+2*PARAMETER_N/8], &d1, &d2);
+        for (k = 0; k < 4; k++) {
+            e[4*i+k]               = (int16_t)(((d1 >> (16*k)) & 0xFFFF) - 16);                               
+            e[4*i+k+PARAMETER_N/2] = (int16_t)(((d2 >> (16*k)) & 0xFFFF) - 16);
+        }
+    }
+}
+
+/*
+ * @param error_stream Generates the 3*N stream bytes consumed by the error sampling
+*/
+static CRYPTO_STATUS error_stream(unsigned char* stream, unsigned char* seed, unsigned int nonce, unsigned int N, StreamOutput StreamOutputFunction)              
+{  
+    unsigned char nce[NONCE_SEED_BYTES] = {0};
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    nce[0] = (unsigned char)nonce;
+    Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, 3*N, stream, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        clear_words((void*)stream, NBYTES_TO_NWORDS(3*N));
+    }    
+
+    return Status;
+}
+
+/*
+ * @param error_sampling_poly Samples N errors of width noise_k from noise_k*N/4 stream bytes, with the kernel of the backend in use for width 12
+*/
+void error_sampling_poly(unsigned char* stream, int32_t* e, unsigned int N, unsigned int noise_k)              
+{  
+    unsigned int i;
+
+    if (noise_k == 8) {
+        error_sampling_psi8_n(stream, e, N);
+        return;
+    }
+    if (noise_k == 4) {
+        error_sampling_psi4_n(stream, e, N);
+        return;
+    }
+    if (N % PARAMETER_N != 0) {
+        error_sampling_n(stream, e, N);
+        return;
+    }
+    for (i = 0; i < N; i += PARAMETER_N) {
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->error_sampling(&stream[3*i], &e[i]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT)         
+        error_sampling_avx512_asm(&stream[3*i], &e[i]);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT)         
+        error_sampling_asm(&stream[3*i], &e[i]);
+#else    
+        error_sampling_generic(&stream[3*i], &e[i]);                            // Also with VECTOR_SUPPORT, where the SWAR sampler beats error_sampling_vector
+#endif
+    }
+}
+
+/*
+ * @param get_error Samples for errors
+*/
+CRYPTO_STATUS get_error(int32_t* e, unsigned char* seed, unsigned int nonce, unsigned int N, StreamOutput StreamOutputFunction)              
+{  
+    unsigned char stream[3*PARAMETER_N_MAX];    
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    Status = error_stream(stream, seed, nonce, N, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }    
+
+    error_sampling_poly(stream, e, N, NOISE_K);
+
+    return Status;
+}
+
+/*
+ * @param noise_stream Generates in one contiguous buffer the noise_k*N/4 stream bytes of each of the errors with nonces 0, ..., npolys-1, followed 
+ *        by the N/32 random bytes of HelpRec with nonce npolys if with_helprec is set
+ * @note It makes a single request to StreamOutputMultiFunction if available, and for width 12 the output is the same as from get_error and HelpRec
+*/
+static CRYPTO_STATUS noise_stream(unsigned char* stream, unsigned char* seed, unsigned int npolys, bool with_helprec, unsigned int N, unsigned int noise_k, PLatticeCryptoStruct pLatticeCrypto)              
+{  
+    unsigned char nonces[(NOISE_MAX_POLYS+1)*NONCE_SEED_BYTES] = {0};
+    unsigned int p, array_nbytes[NOISE_MAX_POLYS+1];
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    for (p = 0; p < npolys; p++) {
+        nonces[p*NONCE_SEED_BYTES] = (unsigned char)p;
+        array_nbytes[p] = noise_k*N/4;
+    }
+    if (with_helprec == true) {
+        nonces[npolys*NONCE_SEED_BYTES+1] = (unsigned char)npolys;
+        array_nbytes[npolys] = N/32;
+    }
+    Status = stream_output_multi(seed, ERROR_SEED_BYTES, nonces, NONCE_SEED_BYTES, npolys + (with_helprec == true), array_nbytes, stream, 
+                                 pLatticeCrypto->StreamOutputMultiFunction, pLatticeCrypto->StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        clear_words((void*)stream, NBYTES_TO_NWORDS(noise_k*N/4*npolys + N/32*(with_helprec == true)));
+    }    
+
+    return Status;
+}
+
+/*
+ * @param get_noise_buffered Samples the errors e[0], ..., e[npolys-1] of width noise_k with nonces 0, ..., npolys-1 and, if random_bits is not NULL, 
+ *        the N/32 random bytes of HelpRec with nonce npolys, with the NOISE_STREAM_BYTES_N(N) bytes at stream
+ * @note The stream of each error has noise_k*N/4 bytes, so that narrower noise costs proportionally less stream. With a StreamOutputMultiFunction 
+ *       all the streams come from one request, which shares the key schedule of AES-256-CTR. Else each error is sampled from its own request as 
+ *       soon as its stream is output, so that only the first noise_k*N/4 bytes at stream are used and they stay in L1
+*/
+static CRYPTO_STATUS get_noise_buffered(int32_t** e, unsigned int npolys, unsigned char* random_bits, unsigned char* seed, unsigned int N, unsigned int noise_k, unsigned char* stream, PLatticeCryptoStruct pLatticeCrypto)              
+{  
+    unsigned char nce[NONCE_SEED_BYTES] = {0};
+    unsigned int p, nbytes = noise_k*N/4;
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    if (pLatticeCrypto->StreamOutputMultiFunction != NULL) {
+        Status = noise_stream(stream, seed, npolys, (random_bits != NULL), N, noise_k, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            return Status;
+        }    
+        for (p = 0; p < npolys; p++) {
+            error_sampling_poly(&stream[nbytes*p], e[p], N, noise_k);
+        }
+        if (random_bits != NULL) {
+            memcpy(random_bits, &stream[nbytes*npolys], N/32);
+        }
+        clear_words((void*)stream, NBYTES_TO_NWORDS(nbytes*npolys + N/32*(random_bits != NULL)));
+        return Status;
+    }
+
+    for (p = 0; p < npolys; p++) {
+        nce[0] = (unsigned char)p;
+        Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, nbytes, stream, pLatticeCrypto->StreamOutputFunction);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        error_sampling_poly(stream, e[p], N, noise_k);
+    }
+    if (random_bits != NULL) {
+        nce[0] = 0;
+        nce[1] = (unsigned char)npolys;
+        Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, N/32, random_bits, pLatticeCrypto->StreamOutputFunction);
+    }
+
+cleanup:
+    clear_words((void*)stream, NBYTES_TO_NWORDS(nbytes));
+
+    return Status;
+}
+
+/*
+ * @param get_noise The same as get_noise_buffered with the stream on the stack
+*/
+CRYPTO_STATUS get_noise(int32_t** e, unsigned int npolys, unsigned char* random_bits, unsigned char* seed, unsigned int N, unsigned int noise_k, PLatticeCryptoStruct pLatticeCrypto)              
+{  
+    unsigned char stream[NOISE_STREAM_BYTES];    
+
+    return get_noise_buffered(e, npolys, random_bits, seed, N, noise_k, stream, pLatticeCrypto);
+}
+
+/*
+ * @param error_sampling_int16_poly Samples 1024 errors into 16-bit coefficients from 3072 stream bytes, with the kernel of the backend in use
+*/
+static __inline void error_sampling_int16_poly(unsigned char* stream, int16_t* e)              
+{  
+#if defined(DISPATCH_SUPPORT)
+    backend_load()->error_sampling_int16(stream, e);
+#elif defined(ASM_SUPPORT)
+    error_sampling_int16_asm(stream, e);
+#else    
+    error_sampling_int16_generic(stream, e);
+#endif
+}
+
+/*
+ * @param get_error_int16 Samples for errors into 16-bit coefficients
+*/
+CRYPTO_STATUS get_error_int16(int16_t* e, unsigned char* seed, unsigned int nonce, StreamOutput StreamOutputFunction)              
+{  
+    unsigned char stream[3*PARAMETER_N];    
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    Status = error_stream(stream, seed, nonce, PARAMETER_N, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }    
+
+    error_sampling_int16_poly(stream, e);
+
+    return Status;
+}
+
+/*
+ * @param get_noise_int16 Samples the errors e[0], ..., e[npolys-1] into 16-bit coefficients as get_noise does, with N = 1024
+*/
+CRYPTO_STATUS get_noise_int16(int16_t** e, unsigned int npolys, unsigned char* random_bits, unsigned char* seed, PLatticeCryptoStruct pLatticeCrypto)              
+{  
+    unsigned char stream[NOISE_STREAM_BYTES_N(PARAMETER_N)], nce[NONCE_SEED_BYTES] = {0};
+    unsigned int p;
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+    
+    if (pLatticeCrypto->StreamOutputMultiFunction != NULL) {
+        Status = noise_stream(stream, seed, npolys, (random_bits != NULL), PARAMETER_N, NOISE_K, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            return Status;
+        }    
+        for (p = 0; p < npolys; p++) {
+            error_sampling_int16_poly(&stream[3*PARAMETER_N*p], e[p]);
+        }
+        if (random_bits != NULL) {
+            memcpy(random_bits, &stream[3*PARAMETER_N*npolys], PARAMETER_N/32);
+        }
+        clear_words((void*)stream, NBYTES_TO_NWORDS(3*PARAMETER_N*npolys + PARAMETER_N/32*(random_bits != NULL)));
+        return Status;
+    }
+
+    for (p = 0; p < npolys; p++) {                                              // As get_noise_buffered, one request per error into the same 3*N bytes
+        nce[0] = (unsigned char)p;
+        Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, 3*PARAMETER_N, stream, pLatticeCrypto->StreamOutputFunction);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        error_sampling_int16_poly(stream, e[p]);
+    }
+    if (random_bits != NULL) {
+        nce[0] = 0;
+        nce[1] = (unsigned char)npolys;
+        Status = stream_output(seed, ERROR_SEED_BYTES, nce, NONCE_SEED_BYTES, PARAMETER_N/32, random_bits, pLatticeCrypto->StreamOutputFunction);
+    }
+
+cleanup:
+    clear_words((void*)stream, NBYTES_TO_NWORDS(3*PARAMETER_N));
+
+    return Status;
+}
+
+/*
+ * @param generate_a Generates temporary variable a
+ * @note Rename this variable
+*/
+CRYPTO_STATUS generate_a(uint32_t* a, const unsigned char* seed, unsigned int N, ExtendableOutput ExtendableOutputFunction)             
+{  
+
+    return extended_output(seed, SEED_BYTES, N, a, ExtendableOutputFunction);
+}
+
+#if defined(BOUND_TRACKING)
+
+int32_t bound_min[BOUND_END_OF_LIST], bound_max[BOUND_END_OF_LIST];
+
+/*
+ * @param reset_bounds Clears the coefficient ranges recorded by track_bound
+*/
+void reset_bounds(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < BOUND_END_OF_LIST; i++) {
+        bound_min[i] = INT32_MAX;
+        bound_max[i] = INT32_MIN;
+    }
+}
+
+/*
+ * @param track_bound Widens the coefficient range recorded for a stage of the key exchange
+*/
+void track_bound(BOUND_STAGE stage, const int32_t* a, unsigned int N)
+{
+    unsigned int i;
+
+    for (i = 0; i < N; i++) {
+        if (a[i] < bound_min[stage]) bound_min[stage] = a[i];
+        if (a[i] > bound_max[stage]) bound_max[stage] = a[i];
+    }
+}
+
+#endif
+
+/*
+ * @param get_noise_ntt Samples s, e and, if v is not NULL, v and the N/32 random bytes of HelpRec from error_seed, and outputs NTT(s), 
+ *        NTT(e) scaled by 3 and NTT(v) scaled by 81, for the parameter set params and its noise width
+ * @note The error stream goes to the NOISE_STREAM_BYTES_N(N) bytes at stream, or 2*3*N bytes if v is NULL, or to the stack if stream is NULL
+*/
+CRYPTO_STATUS get_noise_ntt(const LatticeCryptoParams* params, int32_t* s, int32_t* e, int32_t* v, unsigned char* random_bits, unsigned char* error_seed, unsigned char* stream, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    int32_t *noise[3] = { s, e, v };
+    unsigned int N = params->N, npolys = (v != NULL) ? 3 : 2;           // s, e and v with nonces 0, 1 and 2, and the bits of HelpRec with nonce 3, or s and e
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+
+    if (v == NULL) {
+        random_bits = NULL;
+    }
+    if (stream != NULL) {
+        Status = get_noise_buffered(noise, npolys, random_bits, error_seed, N, params->noise_k, stream, pLatticeCrypto);
+    } else {
+        Status = get_noise(noise, npolys, random_bits, error_seed, N, params->noise_k, pLatticeCrypto);
+    }
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }
+    NTT_CT_std2rev_12289(s, params->psi_rev, N); 
+    NTT_CT_std2rev_12289(e, params->psi_rev3, N);                               // NTT(e) scaled by 3
+    if (v != NULL) {
+        NTT_CT_std2rev_12289(v, params->psi_rev81, N);                          // NTT(v) scaled by 81
+    }
+
+    return Status;
+}
+
+// Buffers of a step of the key exchange with ring dimension N, on the stack or in a workspace, with the error stream of get_noise_ntt
+typedef struct
+{
+    uint32_t *pk, *a, *v, *r;
+    int32_t *s, *e;
+    unsigned char *stream, *random_bits, *seed, *error_seed;
+} KexBuffers;
+
+/*
+ * @param workspace_buffers Points the buffers of a step of the key exchange to those of workspace
+*/
+static void workspace_buffers(PLatticeCryptoWorkspace workspace, KexBuffers* buffers)
+{
+    buffers->pk = workspace->pk;
+    buffers->a = workspace->a;
+    buffers->v = workspace->v;
+    buffers->r = workspace->r;
+    buffers->s = workspace->s;
+    buffers->e = workspace->e;
+    buffers->stream = workspace->stream;
+    buffers->random_bits = workspace->random_bits;
+    buffers->seed = workspace->seed;
+    buffers->error_seed = workspace->error_seed;
+}
+
+/*
+ * @param KeyGeneration_A_work Alice's key generation on 32-bit coefficients for the parameter set params, with the buffers a, e, stream and seeds of buffers
+*/
+static CRYPTO_STATUS KeyGeneration_A_work(const LatticeCryptoParams* params, int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto, const KexBuffers* buffers) 
+{   
+    uint32_t* a = buffers->a;
+    int32_t* e = buffers->e;
+    unsigned char *seed = buffers->seed, *error_seed = buffers->error_seed;
+    unsigned int N = params->N;
+    bool pooled;
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+
+    Status = random_bytes(SEED_BYTES, seed, pLatticeCrypto->RandomBytesFunction);   
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }
+    pooled = noise_pool_take(pLatticeCrypto, params, SecretKeyA, e, NULL, NULL);    // NTT(SecretKeyA) and NTT(e) scaled by 3 from the pool, if it has them
+    if (pooled == false) {
+        Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction);   
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+    }
+
+    Status = generate_a_cached(a, seed, N, pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    if (pooled == false) {
+        Status = get_noise_ntt(params, SecretKeyA, e, NULL, NULL, error_seed, buffers->stream, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+    }
+    TRACK_BOUND(BOUND_NTT, SecretKeyA, N);
+    TRACK_BOUND(BOUND_NTT_X3, e, N);
+
+    pmuladd((int32_t*)a, SecretKeyA, e, (int32_t*)a, N);                        // Outputs values in [0, q-1], ready for encoding
+    TRACK_BOUND(BOUND_PMULADD, a, N);
+    encode_A(a, seed, PublicKeyA, N);
+    
+cleanup:
+    clear_words((void*)e, NBYTES_TO_NWORDS(4*N));
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+
+    return Status;
+}
+
+/*
+ * @param KeyGeneration_A_params Alice's key generation on 32-bit coefficients for the parameter set params, with N <= PARAMETER_N and buffers on the stack
+*/
+static CRYPTO_STATUS KeyGeneration_A_params(const LatticeCryptoParams* params, int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    uint32_t a[PARAMETER_N];
+    int32_t e[PARAMETER_N];
+    unsigned char stream[2*3*PARAMETER_N], seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];     // The errors s and e, without the bits of HelpRec
+    KexBuffers buffers = { NULL, a, NULL, NULL, NULL, e, stream, NULL, seed, error_seed };
+
+    return KeyGeneration_A_work(params, SecretKeyA, PublicKeyA, pLatticeCrypto, &buffers);
+}
+
+/*
+ * @param KeyGeneration_A_params_max Alice's key generation on 32-bit coefficients for the parameter set params, with N <= PARAMETER_N_MAX and buffers 
+ *        on the stack
+*/
+static CRYPTO_STATUS KeyGeneration_A_params_max(const LatticeCryptoParams* params, int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    uint32_t a[PARAMETER_N_MAX];
+    int32_t e[PARAMETER_N_MAX];
+    unsigned char stream[2*3*PARAMETER_N_MAX], seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];
+    KexBuffers buffers = { NULL, a, NULL, NULL, NULL, e, stream, NULL, seed, error_seed };
+
+    return KeyGeneration_A_work(params, SecretKeyA, PublicKeyA, pLatticeCrypto, &buffers);
+}
+
+/*
+ * @param SecretAgreement_B_work Bob's key generation and shared secret computation on 32-bit coefficients for the parameter set params, with the 
+ *        buffers of buffers
+*/
+static CRYPTO_STATUS SecretAgreement_B_work(const LatticeCryptoParams* params, unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto, const KexBuffers* buffers) 
+{ 
+    uint32_t *pk_A = buffers->pk, *a = buffers->a, *v = buffers->v, *r = buffers->r;
+    int32_t *sk_B = buffers->s, *e = buffers->e;
+    unsigned char *seed = buffers->seed, *error_seed = buffers->error_seed, *random_bits = buffers->random_bits;
+    unsigned int N = params->N;
+    bool pooled;
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+
+    decode_A(PublicKeyA, pk_A, seed, N);
+    pooled = noise_pool_take(pLatticeCrypto, params, sk_B, e, (int32_t*)v, random_bits);   // NTT(sk_B), and NTT(e) and NTT(v) scaled by 3 and 81 from the pool, if it has them
+    if (pooled == false) {
+        Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction); 
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+    }
+
+    Status = generate_a_cached(a, seed, N, pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    if (pooled == false) {
+        Status = get_noise_ntt(params, sk_B, e, (int32_t*)v, random_bits, error_seed, buffers->stream, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+    }
+    TRACK_BOUND(BOUND_NTT, sk_B, N);
+    TRACK_BOUND(BOUND_NTT_X3, e, N);
+    TRACK_BOUND(BOUND_NTT_X81, v, N);
+
+    pmuladd((int32_t*)a, sk_B, e, (int32_t*)a, N);                              // Outputs values in [0, q-1], ready for encoding
+    TRACK_BOUND(BOUND_PMULADD, a, N);
+    
+    pmuladd((int32_t*)pk_A, sk_B, (int32_t*)v, (int32_t*)v, N);    
+    TRACK_BOUND(BOUND_PMULADD, v, N);
+    INTT_GS_rev2std_12289((int32_t*)v, params->omegainv_rev, params->omegainv1N_rev, params->Ninv, N);
+    TRACK_BOUND(BOUND_INTT_B, v, N);
+    two_reduce12289((int32_t*)v, N);                                            // Outputs values in [0, q-1]
+    TRACK_BOUND(BOUND_TWO_REDUCE, v, N);
+
+    helprec_poly(v, r, random_bits, N); 
+    Rec(v, r, SharedSecretB, N);
+    encode_B(a, r, PublicKeyB, N);
+    
+cleanup:
+    clear_words((void*)sk_B, NBYTES_TO_NWORDS(4*N));
+    clear_words((void*)e, NBYTES_TO_NWORDS(4*N));
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+    clear_words((void*)random_bits, NBYTES_TO_NWORDS(N/32));
+    clear_words((void*)a, NBYTES_TO_NWORDS(4*N));
+    clear_words((void*)v, NBYTES_TO_NWORDS(4*N));
+    clear_words((void*)r, NBYTES_TO_NWORDS(4*N));
+
+    return Status;
+}
+
+/*
+ * @param SecretAgreement_B_params Bob's key generation and shared secret computation on 32-bit coefficients for the parameter set params, with 
+ *        N <= PARAMETER_N and buffers on the stack
+*/
+static CRYPTO_STATUS SecretAgreement_B_params(const LatticeCryptoParams* params, unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    uint32_t pk_A[PARAMETER_N], a[PARAMETER_N], v[PARAMETER_N], r[PARAMETER_N];
+    int32_t sk_B[PARAMETER_N], e[PARAMETER_N];
+    unsigned char stream[NOISE_STREAM_BYTES_N(PARAMETER_N)], random_bits[PARAMETER_N/32], seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];
+    KexBuffers buffers = { pk_A, a, v, r, sk_B, e, stream, random_bits, seed, error_seed };
+
+    return SecretAgreement_B_work(params, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto, &buffers);
+}
+
+/*
+ * @param SecretAgreement_B_params_max Bob's key generation and shared secret computation on 32-bit coefficients for the parameter set params, with 
+ *        N <= PARAMETER_N_MAX and buffers on the stack
+*/
+static CRYPTO_STATUS SecretAgreement_B_params_max(const LatticeCryptoParams* params, unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    uint32_t pk_A[PARAMETER_N_MAX], a[PARAMETER_N_MAX], v[PARAMETER_N_MAX], r[PARAMETER_N_MAX];
+    int32_t sk_B[PARAMETER_N_MAX], e[PARAMETER_N_MAX];
+    unsigned char stream[NOISE_STREAM_BYTES], random_bits[PARAMETER_N_MAX/32], seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];
+    KexBuffers buffers = { pk_A, a, v, r, sk_B, e, stream, random_bits, seed, error_seed };
+
+    return SecretAgreement_B_work(params, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto, &buffers);
+}
+
+/*
+ * @param SecretAgreement_A_work Alice's shared secret computation on 32-bit coefficients for the parameter set params, with the N-coefficient buffers u and r
+ * @note The secret key is SecretKeyA or, if it is NULL, the packed key PackedSecretKeyA. The portable build unpacks PublicKeyB straight into u by 
+ *       blocks fused with pmul and reads its rvec packed, so r may be NULL there. The ASM, VECTOR and DISPATCH builds decode PublicKeyB into u 
+ *       before pmul and its rvec into r before Rec
+*/
+static CRYPTO_STATUS SecretAgreement_A_work(const LatticeCryptoParams* params, unsigned char* PublicKeyB, int32_t* SecretKeyA, const unsigned char* PackedSecretKeyA, unsigned char* SharedSecretA, uint32_t* u, uint32_t* r) 
+{ 
+    unsigned int N = params->N;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    decode_pmul(PublicKeyB, SecretKeyA, PackedSecretKeyA, (int32_t*)u, N);
+    TRACK_BOUND(BOUND_PMUL, u, N);
+    INTT_GS_rev2std_12289((int32_t*)u, params->omegainv_rev, params->omegainv1N_rev, params->Ninv, N);
+    TRACK_BOUND(BOUND_INTT_A, u, N);
+    two_reduce12289((int32_t*)u, N);                                            // Outputs values in [0, q-1]
+    TRACK_BOUND(BOUND_TWO_REDUCE, u, N);
+
+    Rec_packed(u, &PublicKeyB[POLY_BYTES(N)], r, SharedSecretA, N);
+    
+/*
+ * @param clear_words Cleans up the registers
+*/
+    clear_words((void*)u, NBYTES_TO_NWORDS(4*N));
+
+    return Status;
+}
+
+/*
+ * @param SecretAgreement_A_params Alice's shared secret computation on 32-bit coefficients for the parameter set params, with N <= PARAMETER_N and 
+ *        buffers on the stack
+*/
+static CRYPTO_STATUS SecretAgreement_A_params(const LatticeCryptoParams* params, unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT) || defined(VECTOR_SUPPORT)
+    uint32_t u[PARAMETER_N], r[PARAMETER_N];
+#else
+    uint32_t u[PARAMETER_N], *r = NULL;                                         // The portable reconciliation reads rvec packed
+#endif
+
+    return SecretAgreement_A_work(params, PublicKeyB, SecretKeyA, NULL, SharedSecretA, u, r);
+}
+
+/*
+ * @param SecretAgreement_A_params_max Alice's shared secret computation on 32-bit coefficients for the parameter set params, with N <= PARAMETER_N_MAX 
+ *        and buffers on the stack
+*/
+static CRYPTO_STATUS SecretAgreement_A_params_max(const LatticeCryptoParams* params, unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT) || defined(VECTOR_SUPPORT)
+    uint32_t u[PARAMETER_N_MAX], r[PARAMETER_N_MAX];
+#else
+    uint32_t u[PARAMETER_N_MAX], *r = NULL;                                     // The portable reconciliation reads rvec packed
+#endif
+
+    return SecretAgreement_A_work(params, PublicKeyB, SecretKeyA, NULL, SharedSecretA, u, r);
+}
+
+/*
+ * @param KeyGeneration_A_int32 Alice's key generation on 32-bit coefficients
+*/
+CRYPTO_STATUS KeyGeneration_A_int32(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    return KeyGeneration_A_params(&params_ntt1024_12289, SecretKeyA, PublicKeyA, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_B_int32 Bob's key generation and shared secret computation on 32-bit coefficients
+*/
+CRYPTO_STATUS SecretAgreement_B_int32(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    return SecretAgreement_B_params(&params_ntt1024_12289, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_A_int32 Alice's shared secret computation on 32-bit coefficients
+*/
+CRYPTO_STATUS SecretAgreement_A_int32(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+    return SecretAgreement_A_params(&params_ntt1024_12289, PublicKeyB, SecretKeyA, SharedSecretA);
+}
+
+/*
+ * @param KeyGeneration_A_ws Alice's key generation on 32-bit coefficients with the buffers of workspace instead of the stack
+*/
+CRYPTO_STATUS KeyGeneration_A_ws(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace) 
+{   
+    KexBuffers buffers;
+
+    if (workspace == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    workspace_buffers(workspace, &buffers);
+
+    return KeyGeneration_A_work(&params_ntt1024_12289, SecretKeyA, PublicKeyA, pLatticeCrypto, &buffers);
+}
+
+/*
+ * @param SecretAgreement_B_ws Bob's key generation and shared secret computation on 32-bit coefficients with the buffers of workspace instead of the stack
+*/
+CRYPTO_STATUS SecretAgreement_B_ws(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace) 
+{ 
+    KexBuffers buffers;
+
+    if (workspace == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    workspace_buffers(workspace, &buffers);
+
+    return SecretAgreement_B_work(&params_ntt1024_12289, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto, &buffers);
+}
+
+/*
+ * @param SecretAgreement_A_ws Alice's shared secret computation on 32-bit coefficients with the buffers of workspace instead of the stack
+*/
+CRYPTO_STATUS SecretAgreement_A_ws(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA, PLatticeCryptoWorkspace workspace) 
+{ 
+    if (workspace == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    return SecretAgreement_A_work(&params_ntt1024_12289, PublicKeyB, SecretKeyA, NULL, SharedSecretA, workspace->pk, workspace->r);
+}
+
+/*
+ * @param LatticeCrypto_pack_secret_key Packs Alice's secret key, reduced to [0, q-1], into SKA_PACKED_BYTES bytes in the format of encode_A
+*/
+CRYPTO_STATUS LatticeCrypto_pack_secret_key(const int32_t* SecretKeyA, unsigned char* PackedSecretKeyA) 
+{ 
+    uint32_t sk[PARAMETER_N];
+    unsigned int i;
+
+    if (SecretKeyA == NULL || PackedSecretKeyA == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    for (i = 0; i < PARAMETER_N; i++) {                                         // Barrett reduction into (-q, 2q), in constant time
+        sk[i] = (uint32_t)barrett_reduce32(SecretKeyA[i]);
+    }
+    correction((int32_t*)sk, PARAMETER_Q, PARAMETER_N);                         // Outputs values in [0, q-1]
+    encode_n(sk, PackedSecretKeyA, PARAMETER_N);                                // The SIMD encoders may store past the packed coefficients
+    clear_words((void*)sk, NBYTES_TO_NWORDS(4*PARAMETER_N));
+
+    return CRYPTO_SUCCESS;
+}
+
+/*
+ * @param KeyGeneration_A_packed Alice's key generation on 32-bit coefficients, with the secret key output packed into SKA_PACKED_BYTES bytes
+*/
+CRYPTO_STATUS KeyGeneration_A_packed(unsigned char* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    int32_t sk[PARAMETER_N];
+    CRYPTO_STATUS Status;
+
+    if (SecretKeyA == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    Status = KeyGeneration_A_params(&params_ntt1024_12289, sk, PublicKeyA, pLatticeCrypto);
+    if (Status == CRYPTO_SUCCESS) {
+        Status = LatticeCrypto_pack_secret_key(sk, SecretKeyA);
+    }
+    clear_words((void*)sk, NBYTES_TO_NWORDS(4*PARAMETER_N));
+
+    return Status;
+}
+
+/*
+ * @param SecretAgreement_A_packed Alice's shared secret computation on 32-bit coefficients from the packed secret key SecretKeyA, unpacked on the fly 
+ *        by blocks fused with pmul
+*/
+CRYPTO_STATUS SecretAgreement_A_packed(unsigned char* PublicKeyB, const unsigned char* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+#if defined(DISPATCH_SUPPORT) || defined(ASM_SUPPORT) || defined(VECTOR_SUPPORT)
+    uint32_t u[PARAMETER_N], r[PARAMETER_N];
+#else
+    uint32_t u[PARAMETER_N], *r = NULL;                                         // The portable reconciliation reads rvec packed
+#endif
+
+    if (SecretKeyA == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    return SecretAgreement_A_work(&params_ntt1024_12289, PublicKeyB, NULL, SecretKeyA, SharedSecretA, u, r);
+}
+
+/*
+ * @param KeyGeneration_A_batch Alice's key generation for count clients on 32-bit coefficients with the buffers of workspace, with the NTTs of up to 
+ *        KEX_BATCH_LANES clients interleaved, or one call per client if that is not faster on the backend in use
+ * @return count private keys at SecretKeyA (1024 coefficients each) and count public keys at PublicKeyA (1824 bytes each)
+ * @note The random draws, the generation of a and the noise of each client are made in the same order as by count calls to KeyGeneration_A_int32, 
+ *       so the outputs are the same
+*/
+CRYPTO_STATUS KeyGeneration_A_batch(unsigned int count, int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace) 
+{   
+    const LatticeCryptoParams* params = &params_ntt1024_12289;
+    uint32_t* a;
+    int32_t *e, *ps[KEX_BATCH_LANES], *pe[KEX_BATCH_LANES], *noise[2];
+    unsigned char *seed, *error_seed;
+    unsigned int first, lanes, i, nfresh;
+    KexBuffers buffers;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    if (count == 0) {
+        return CRYPTO_SUCCESS;
+    }
+    if (SecretKeyA == NULL || PublicKeyA == NULL || pLatticeCrypto == NULL || workspace == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    if (NTT_xN_faster() == false) {                                             // Nothing to gain from the batch
+        workspace_buffers(workspace, &buffers);
+        for (i = 0; i < count && Status == CRYPTO_SUCCESS; i++) {
+            Status = KeyGeneration_A_work(params, &SecretKeyA[i*PARAMETER_N], &PublicKeyA[i*PKA_BYTES], pLatticeCrypto, &buffers);
+        }
+        return Status;
+    }
+    a = workspace->a;
+    e = workspace->e;
+    seed = workspace->seed;
+    error_seed = workspace->error_seed;
+
+    for (first = 0; first < count; first += lanes) {
+        lanes = (count - first < KEX_BATCH_LANES) ? count - first : KEX_BATCH_LANES;
+        nfresh = 0;
+        for (i = 0; i < lanes; i++) {                                           // Randomness, a and the noise of each client
+            int32_t* sk = &SecretKeyA[(first+i)*PARAMETER_N];
+            bool pooled;
+
+            Status = random_bytes(SEED_BYTES, &seed[i*SEED_BYTES], pLatticeCrypto->RandomBytesFunction);   
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+            pooled = noise_pool_take(pLatticeCrypto, params, sk, &e[i*PARAMETER_N], NULL, NULL);
+            if (pooled == false) {
+                Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction);   
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }
+            }
+            Status = generate_a_cached(&a[i*PARAMETER_N], &seed[i*SEED_BYTES], PARAMETER_N, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+            if (pooled == false) {
+                noise[0] = sk;
+                noise[1] = &e[i*PARAMETER_N];
+                Status = get_noise_buffered(noise, 2, NULL, error_seed, PARAMETER_N, params->noise_k, workspace->stream, pLatticeCrypto);
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }
+                ps[nfresh] = noise[0];
+                pe[nfresh] = noise[1];
+                nfresh++;
+            }
+        }
+        NTT_CT_std2rev_12289_xN(ps, nfresh, params->psi_rev, PARAMETER_N);     // NTT(SecretKeyA) of the clients not served by the noise pool
+        NTT_CT_std2rev_12289_xN(pe, nfresh, params->psi_rev3, PARAMETER_N);    // NTT(e) scaled by 3
+
+        for (i = 0; i < lanes; i++) {
+            pmuladd((int32_t*)&a[i*PARAMETER_N], &SecretKeyA[(first+i)*PARAMETER_N], &e[i*PARAMETER_N], (int32_t*)&a[i*PARAMETER_N], PARAMETER_N);
+            encode_A(&a[i*PARAMETER_N], &seed[i*SEED_BYTES], &PublicKeyA[(first+i)*PKA_BYTES], PARAMETER_N);
+        }
+    }
+    
+cleanup:
+    clear_words((void*)e, NBYTES_TO_NWORDS(4*KEX_BATCH_LANES*PARAMETER_N));
+    clear_words((void*)a, NBYTES_TO_NWORDS(4*KEX_BATCH_LANES*PARAMETER_N));
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+
+    return Status;
+}
+
+/*
+ * @param SecretAgreement_B_batch Bob's key generation and shared secret computation for count clients on 32-bit coefficients with the buffers of 
+ *        workspace, with the NTTs of up to KEX_BATCH_LANES clients interleaved, or one call per client if that is not faster on the backend in use
+ * @return count public keys at PublicKeyB (2048 bytes each) and count shared secrets at SharedSecretB (256 bits each), from the count public keys at PublicKeyA
+ * @note As KeyGeneration_A_batch, the outputs are the same as from count calls to SecretAgreement_B_int32
+*/
+CRYPTO_STATUS SecretAgreement_B_batch(unsigned int count, unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoWorkspace workspace) 
+{ 
+    const LatticeCryptoParams* params = &params_ntt1024_12289;
+    uint32_t *pk_A, *a, *v, *r;
+    int32_t *sk_B, *e, *ps[KEX_BATCH_LANES], *pe[KEX_BATCH_LANES], *pv[KEX_BATCH_LANES], *noise[3];
+    unsigned char *seed, *error_seed, *random_bits;
+    unsigned int first, lanes, i, nfresh;
+    KexBuffers buffers;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    if (count == 0) {
+        return CRYPTO_SUCCESS;
+    }
+    if (PublicKeyA == NULL || SharedSecretB == NULL || PublicKeyB == NULL || pLatticeCrypto == NULL || workspace == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    if (NTT_xN_faster() == false && INTT_xN_faster() == false) {               // Nothing to gain from the batch
+        workspace_buffers(workspace, &buffers);
+        for (i = 0; i < count && Status == CRYPTO_SUCCESS; i++) {
+            Status = SecretAgreement_B_work(params, &PublicKeyA[i*PKA_BYTES], &SharedSecretB[i*SHAREDKEY_BYTES], &PublicKeyB[i*PKB_BYTES], pLatticeCrypto, &buffers);
+        }
+        return Status;
+    }
+    pk_A = workspace->pk;
+    a = workspace->a;
+    v = workspace->v;
+    r = workspace->r;
+    sk_B = workspace->s;
+    e = workspace->e;
+    seed = workspace->seed;
+    error_seed = workspace->error_seed;
+    random_bits = workspace->random_bits;
+
+    for (first = 0; first < count; first += lanes) {
+        lanes = (count - first < KEX_BATCH_LANES) ? count - first : KEX_BATCH_LANES;
+        nfresh = 0;
+        for (i = 0; i < lanes; i++) {                                           // Alice's key, randomness, a and the noise of each client
+            unsigned char* bits = &random_bits[i*PARAMETER_N/32];
+            bool pooled;
+
+            decode_A(&PublicKeyA[(first+i)*PKA_BYTES], &pk_A[i*PARAMETER_N], seed, PARAMETER_N);
+            pooled = noise_pool_take(pLatticeCrypto, params, &sk_B[i*PARAMETER_N], &e[i*PARAMETER_N], (int32_t*)&v[i*PARAMETER_N], bits);
+            if (pooled == false) {
+                Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction); 
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }
+            }
+            Status = generate_a_cached(&a[i*PARAMETER_N], seed, PARAMETER_N, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+            if (pooled == false) {
+                noise[0] = &sk_B[i*PARAMETER_N];
+                noise[1] = &e[i*PARAMETER_N];
+                noise[2] = (int32_t*)&v[i*PARAMETER_N];
+                Status = get_noise_buffered(noise, 3, bits, error_seed, PARAMETER_N, params->noise_k, workspace->stream, pLatticeCrypto);
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }
+                ps[nfresh] = noise[0];
+                pe[nfresh] = noise[1];
+                pv[nfresh] = noise[2];
+                nfresh++;
+            }
+        }
+        NTT_CT_std2rev_12289_xN(ps, nfresh, params->psi_rev, PARAMETER_N);     // NTT(sk_B) of the clients not served by the noise pool
+        NTT_CT_std2rev_12289_xN(pe, nfresh, params->psi_rev3, PARAMETER_N);    // NTT(e) scaled by 3
+        NTT_CT_std2rev_12289_xN(pv, nfresh, params->psi_rev81, PARAMETER_N);   // NTT(v) scaled by 81
+
+        for (i = 0; i < lanes; i++) {
+            pmuladd((int32_t*)&a[i*PARAMETER_N], &sk_B[i*PARAMETER_N], &e[i*PARAMETER_N], (int32_t*)&a[i*PARAMETER_N], PARAMETER_N); 
+            pmuladd((int32_t*)&pk_A[i*PARAMETER_N], &sk_B[i*PARAMETER_N], (int32_t*)&v[i*PARAMETER_N], (int32_t*)&v[i*PARAMETER_N], PARAMETER_N);    
+            pv[i] = (int32_t*)&v[i*PARAMETER_N];
+        }
+        INTT_GS_rev2std_12289_xN(pv, lanes, params->omegainv_rev, params->omegainv1N_rev, params->Ninv, PARAMETER_N);
+
+        for (i = 0; i < lanes; i++) {
+            two_reduce12289((int32_t*)&v[i*PARAMETER_N], PARAMETER_N);
+            helprec_poly(&v[i*PARAMETER_N], r, &random_bits[i*PARAMETER_N/32], PARAMETER_N); 
+            Rec(&v[i*PARAMETER_N], r, &SharedSecretB[(first+i)*SHAREDKEY_BYTES], PARAMETER_N);
+            encode_B(&a[i*PARAMETER_N], r, &PublicKeyB[(first+i)*PKB_BYTES], PARAMETER_N);
+        }
+    }
+    
+cleanup:
+    clear_words((void*)sk_B, NBYTES_TO_NWORDS(4*KEX_BATCH_LANES*PARAMETER_N));
+    clear_words((void*)e, NBYTES_TO_NWORDS(4*KEX_BATCH_LANES*PARAMETER_N));
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+    clear_words((void*)random_bits, NBYTES_TO_NWORDS(KEX_BATCH_LANES*PARAMETER_N/32));
+    clear_words((void*)a, NBYTES_TO_NWORDS(4*KEX_BATCH_LANES*PARAMETER_N));
+    clear_words((void*)v, NBYTES_TO_NWORDS(4*KEX_BATCH_LANES*PARAMETER_N));
+    clear_words((void*)r, NBYTES_TO_NWORDS(4*PARAMETER_N));
+
+    return Status;
+}
+
+/*
+ * @param KeyGeneration_A_int16 Alice's key generation on 16-bit coefficients
+ * @note SecretKeyA is stored reduced to [0, q-1], so it can also be used by SecretAgreement_A_int32
+*/
+CRYPTO_STATUS KeyGeneration_A_int16(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    uint32_t a[PARAMETER_N];
+    int16_t a16[PARAMETER_N], s[PARAMETER_N], e[PARAMETER_N], *noise[2] = { s, e };
+    unsigned char seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES];
+    unsigned int i;
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+
+    Status = random_bytes(SEED_BYTES, seed, pLatticeCrypto->RandomBytesFunction);   
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }
+    Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction);   
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    Status = generate_a_cached(a, seed, PARAMETER_N, pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    Status = get_noise_int16(noise, 2, NULL, error_seed, pLatticeCrypto);       // s and e with nonces 0 and 1
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    NTT_CT_std2rev_12289_int16(s, psi_rev_ntt1024_12289_int16, PARAMETER_N); 
+    NTT_CT_std2rev_12289_int16(e, psi_rev3_ntt1024_12289_int16, PARAMETER_N); 
+
+    for (i = 0; i < PARAMETER_N; i++) {
+        a16[i] = (int16_t)a[i];
+    }
+    pmuladd_int16(a16, s, e, a16, PARAMETER_N); 
+    correction_int16(a16, PARAMETER_N);
+    encode_A_int16(a16, seed, PublicKeyA);
+
+    correction_int16(s, PARAMETER_N);
+    for (i = 0; i < PARAMETER_N; i++) {
+        SecretKeyA[i] = s[i];
+    }
+    
+cleanup:
+    clear_words((void*)s, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)e, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+
+    return Status;
+}
+
+/*
+ * @param SecretAgreement_B_int16 Bob's key generation and shared secret computation on 16-bit coefficients
+*/
+CRYPTO_STATUS SecretAgreement_B_int16(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    uint32_t a[PARAMETER_N], r[PARAMETER_N];
+    int16_t pk_A[PARAMETER_N], a16[PARAMETER_N], sk_B[PARAMETER_N], e[PARAMETER_N], v[PARAMETER_N], *noise[3] = { sk_B, e, v };
+    unsigned char seed[SEED_BYTES], error_seed[ERROR_SEED_BYTES], random_bits[PARAMETER_N/32];
+    unsigned int i;
+    CRYPTO_STATUS Status = CRYPTO_ERROR_UNKNOWN;
+
+    decode_A_int16(PublicKeyA, pk_A, seed);
+    Status = random_bytes(ERROR_SEED_BYTES, error_seed, pLatticeCrypto->RandomBytesFunction); 
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    Status = generate_a_cached(a, seed, PARAMETER_N, pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    Status = get_noise_int16(noise, 3, random_bits, error_seed, pLatticeCrypto);    // sk_B, e and v with nonces 0, 1 and 2, and the bits of HelpRec with nonce 3
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }   
+    NTT_CT_std2rev_12289_int16(sk_B, psi_rev_ntt1024_12289_int16, PARAMETER_N); 
+    NTT_CT_std2rev_12289_int16(e, psi_rev3_ntt1024_12289_int16, PARAMETER_N); 
+    NTT_CT_std2rev_12289_int16(v, psi_rev81_ntt1024_12289_int16, PARAMETER_N); 
+
+    for (i = 0; i < PARAMETER_N; i++) {
+        a16[i] = (int16_t)a[i];
+    }
+    pmuladd_int16(a16, sk_B, e, a16, PARAMETER_N); 
+    correction_int16(a16, PARAMETER_N);
+    
+    pmuladd_int16(pk_A, sk_B, v, v, PARAMETER_N);    
+    INTT_GS_rev2std_12289_int16(v, omegainv_rev_ntt1024_12289_int16, omegainv10N_rev_ntt1024_12289_int16, Ninv11_ntt1024_12289_int16, PARAMETER_N);
+    two_reduce12289_int16(v, PARAMETER_N);
+
+    for (i = 0; i < PARAMETER_N; i++) {    // The reconciliation works on 32-bit coefficients
+        a[i] = (uint32_t)v[i];
+    }
+    helprec_poly(a, r, random_bits, PARAMETER_N); 
+    Rec(a, r, SharedSecretB, PARAMETER_N);
+    encode_B_int16(a16, r, PublicKeyB);
+    
+cleanup:
+    clear_words((void*)sk_B, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)e, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+    clear_words((void*)random_bits, NBYTES_TO_NWORDS(PARAMETER_N/32));
+    clear_words((void*)a, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)v, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)r, NBYTES_TO_NWORDS(4*PARAMETER_N));
+
+    return Status;
+}
+
+/*
+ * @param SecretAgreement_A_int16 Alice's shared secret computation on 16-bit coefficients
+ * @note SecretKeyA may come from either key generation, it is reduced modulo q on the way in
+*/
+CRYPTO_STATUS SecretAgreement_A_int16(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+    uint32_t x[PARAMETER_N], r[PARAMETER_N];
+    int16_t u[PARAMETER_N], s[PARAMETER_N];
+    unsigned int i;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    decode_B_int16(PublicKeyB, u, r);
+    for (i = 0; i < PARAMETER_N; i++) {                                         // Barrett reduction into (-q, 2q), in constant time
+        s[i] = (int16_t)barrett_reduce32(SecretKeyA[i]);
+    }
+    correction_int16(s, PARAMETER_N);                                           // Outputs values in [0, q-1]
+    
+    pmul_int16(s, u, u, PARAMETER_N);       
+    INTT_GS_rev2std_12289_int16(u, omegainv_rev_ntt1024_12289_int16, omegainv10N_rev_ntt1024_12289_int16, Ninv11_ntt1024_12289_int16, PARAMETER_N);
+    two_reduce12289_int16(u, PARAMETER_N);
+
+    for (i = 0; i < PARAMETER_N; i++) {    // The reconciliation works on 32-bit coefficients
+        x[i] = (uint32_t)u[i];
+    }
+    Rec(x, r, SharedSecretA, PARAMETER_N);
+    
+    clear_words((void*)s, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)u, NBYTES_TO_NWORDS(2*PARAMETER_N));
+    clear_words((void*)x, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)r, NBYTES_TO_NWORDS(4*PARAMETER_N));
+
+    return Status;
+}
+
+/*
+ * @param KeyGeneration_A Alice's SecretKeyA key generation and PublicKeyA computation
+ * @return Produces the private key SecretKeyA as 32-bit signed 1024-element array (4096 bytes in total)
+ * @note public key PublicKeyA occupies 1824 bytes
+*/
+CRYPTO_STATUS KeyGeneration_A(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+#if defined(INT16_SUPPORT)
+    return KeyGeneration_A_int16(SecretKeyA, PublicKeyA, pLatticeCrypto);
+#else
+    return KeyGeneration_A_int32(SecretKeyA, PublicKeyA, pLatticeCrypto);
+#endif
+}
+
+/*
+ * @param SecretAgreement_B Bob's key generation from Alice's 1824 byte PublicKeyA and shared secret computation
+ * @return public key PublicKeyB (2048 bytes) and SharedSecretB (256 bits)
+ * @note Rename this variable
+*/
+CRYPTO_STATUS SecretAgreement_B(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+#if defined(INT16_SUPPORT)
+    return SecretAgreement_B_int16(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+#else
+    return SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+#endif
+}
+
+/*
+ * @param SecretAgreement_A Computes shared secret SharedSecretA using Bob's 2048-byte public key PublicKeyB and Alice's 256-bit private key SecretKeyA.
+ * @return Outputs 256-bit SharedSecretA
+*/
+CRYPTO_STATUS SecretAgreement_A(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+#if defined(INT16_SUPPORT)
+    return SecretAgreement_A_int16(PublicKeyB, SecretKeyA, SharedSecretA);
+#else
+    return SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA);
+#endif
+}
+
+/*
+ * @param KeyGeneration_A_512 Alice's key generation with ring dimension N = 512
+ * @return private key SecretKeyA (512 coefficients) and public key PublicKeyA (928 bytes)
+*/
+CRYPTO_STATUS KeyGeneration_A_512(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    return KeyGeneration_A_params(&params_ntt512_12289, SecretKeyA, PublicKeyA, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_B_512 Bob's key generation from Alice's 928-byte PublicKeyA and shared secret computation with ring dimension N = 512
+ * @return public key PublicKeyB (1024 bytes) and SharedSecretB (128 bits)
+*/
+CRYPTO_STATUS SecretAgreement_B_512(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    return SecretAgreement_B_params(&params_ntt512_12289, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_A_512 Computes shared secret SharedSecretA using Bob's 1024-byte public key PublicKeyB and Alice's private key SecretKeyA, with ring dimension N = 512
+ * @return Outputs 128-bit SharedSecretA
+*/
+CRYPTO_STATUS SecretAgreement_A_512(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+    return SecretAgreement_A_params(&params_ntt512_12289, PublicKeyB, SecretKeyA, SharedSecretA);
+}
+
+/*
+ * @param KeyGeneration_A_2048 Alice's key generation with ring dimension N = 2048
+ * @return private key SecretKeyA (2048 coefficients) and public key PublicKeyA (3616 bytes)
+*/
+CRYPTO_STATUS KeyGeneration_A_2048(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    return KeyGeneration_A_params_max(&params_ntt2048_12289, SecretKeyA, PublicKeyA, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_B_2048 Bob's key generation from Alice's 3616-byte PublicKeyA and shared secret computation with ring dimension N = 2048
+ * @return public key PublicKeyB (4096 bytes) and SharedSecretB (512 bits)
+*/
+CRYPTO_STATUS SecretAgreement_B_2048(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    return SecretAgreement_B_params_max(&params_ntt2048_12289, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_A_2048 Computes shared secret SharedSecretA using Bob's 4096-byte public key PublicKeyB and Alice's private key SecretKeyA, with ring dimension N = 2048
+ * @return Outputs 512-bit SharedSecretA
+*/
+CRYPTO_STATUS SecretAgreement_A_2048(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA) 
+{ 
+    return SecretAgreement_A_params_max(&params_ntt2048_12289, PublicKeyB, SecretKeyA, SharedSecretA);
+}
+
+/*
+ * @param KeyGeneration_A_psi8 Alice's key generation with N = 1024 and noise of width 8
+ * @return private key SecretKeyA (1024 coefficients) and public key PublicKeyA (1824 bytes)
+*/
+CRYPTO_STATUS KeyGeneration_A_psi8(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    return KeyGeneration_A_params(&params_ntt1024_12289_psi8, SecretKeyA, PublicKeyA, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_B_psi8 Bob's key generation from Alice's 1824-byte PublicKeyA and shared secret computation with N = 1024 and noise of width 8
+ * @return public key PublicKeyB (2048 bytes) and SharedSecretB (256 bits)
+*/
+CRYPTO_STATUS SecretAgreement_B_psi8(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    return SecretAgreement_B_params(&params_ntt1024_12289_psi8, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+}
+
+/*
+ * @param KeyGeneration_A_psi4 Alice's key generation with N = 1024 and noise of width 4
+ * @return private key SecretKeyA (1024 coefficients) and public key PublicKeyA (1824 bytes)
+*/
+CRYPTO_STATUS KeyGeneration_A_psi4(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto) 
+{   
+    return KeyGeneration_A_params(&params_ntt1024_12289_psi4, SecretKeyA, PublicKeyA, pLatticeCrypto);
+}
+
+/*
+ * @param SecretAgreement_B_psi4 Bob's key generation from Alice's 1824-byte PublicKeyA and shared secret computation with N = 1024 and noise of width 4
+ * @return public key PublicKeyB (2048 bytes) and SharedSecretB (256 bits)
+*/
+CRYPTO_STATUS SecretAgreement_B_psi4(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto) 
+{ 
+    return SecretAgreement_B_params(&params_ntt1024_12289_psi4, PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+}
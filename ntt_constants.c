@@ -1,145 +1,813 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: fixed constants for the Number Theoretic Transform (NTT)
-*
-*****************************************************************************************/ 
-
-#include "LatticeCrypto_priv.h"
-
-
-// N^-1 * prime_scale^-8
-const int32_t Ninv8_ntt1024_12289 = 8350;
-// N^-1 * prime_scale^-7 * omegainv_rev_ntt1024_12289[1]
-const int32_t omegainv7N_rev_ntt1024_12289 = 795;
-// N^-1 * prime_scale^-11
-const int32_t Ninv11_ntt1024_12289 = 2585;
-// N^-1 * prime_scale^-10 * omegainv_rev_ntt1024_12289[1]
-const int32_t omegainv10N_rev_ntt1024_12289 = 10953;
-
-
-// Index-reversed matrices containing powers of psi (psi_rev_nttxxx_yyy) and inverse powers of omega (omegainv_rev_nttxxx_yyy),
-// where xxx is parameter N and yyy is the prime q.
-
-const int32_t psi_rev_ntt1024_12289[1024] = {
-8193, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
-875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 2859, 
-7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 1777, 10626, 
-3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 8311, 9603, 9042, 
-3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 9326, 4896, 9923, 3051, 3091, 81, 1000, 4320, 1177, 8034, 9521, 10654, 11563, 
-7678, 10436, 12149, 3014, 9088, 5086, 1326, 11119, 2319, 11334, 790, 2747, 7443, 3135, 3712, 1062, 9995, 7484, 8736, 9283, 2744, 11726, 2975, 9664, 949, 7468, 9650, 7266, 
-5828, 6561, 7698, 3328, 6512, 1351, 7311, 8155, 5736, 722, 10984, 4043, 7143, 10810, 1, 8668, 2545, 3504, 8747, 11077, 1646, 9094, 5860, 1759, 8582, 3694, 7110, 8907, 11934, 
-8058, 9741, 9558, 3932, 5911, 4890, 3637, 8830, 5542, 12144, 5755, 7657, 7901, 11029, 11955, 9863, 10861, 1696, 3284, 2881, 7197, 2089, 9000, 2013, 729, 9048, 11809, 2842, 
-11267, 9, 6498, 544, 2468, 339, 1381, 2525, 8112, 3584, 6958, 4989, 10616, 8011, 5374, 9452, 12159, 4354, 9893, 7837, 3296, 8340, 7222, 2197, 118, 2476, 5767, 827, 8541, 
-11336, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 10484, 9407, 11836, 5908, 418, 3772, 7515, 5429, 7552, 10996, 12133, 2767, 3969, 
-8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 10777, 1815, 5383, 3202, 4493, 6920, 10232, 1975, 8532, 2925, 347, 4754, 1858, 11863, 
-8974, 9551, 5868, 9634, 5735,11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 3762, 9370, 4016, 4077, 8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 6992, 6119, 8333, 
-10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 3329, 5919, 4433, 8455,7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 683, 2459, 3656, 
-64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 1112, 4079, 11231, 441, 922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 8500, 12142, 6833, 4449, 
-4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 3262, 10316, 6715, 1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 5339, 6843, 6196, 8579, 2033, 
-8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 3199, 56, 3565, 654, 1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 7232, 4698, 8844, 4780, 10240, 4912, 
-1321, 12097, 7048, 2920, 3127, 4169, 11502, 3482, 11279, 5468, 5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 9784, 6383, 1579, 431, 7507, 5886, 3029, 
-6695, 4213, 504, 11684, 2302, 8689, 9026, 4624, 6212, 11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 
-8841, 343, 4538, 1908, 1208, 4727, 7078, 10423, 10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 
-3278, 4209, 6877, 3449, 1136, 3708, 3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 
-125, 540, 8921, 8062, 612, 8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 7187, 
-3975, 4883, 3087, 6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 2275, 9828, 5063, 
-4176, 3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 2575, 8881, 10347, 377, 
-4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 20, 5002, 5163, 4608, 8946, 8170, 
-10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 2148, 6330, 3959, 5797, 4913, 3528, 8054, 3825, 8914, 9998, 4335, 8896, 9342, 3982, 
-6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 9389, 12050, 994, 7735, 5464, 7383, 4670, 512, 364, 9929, 3028, 5216, 5518, 1226, 7550, 
-8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 9600, 4605, 8151, 12109, 463, 8882, 8308, 10821, 9247, 10945, 9806, 2054, 6203, 6643, 3120, 
-6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 3723, 845, 1936, 7, 5054, 3154, 3285, 4360, 3805, 11522, 2213, 4153, 12239, 12073, 5526, 769, 
-4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 9656, 1406, 2945, 5349, 7207, 4590, 11607, 11309, 5202, 844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 
-5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 11839, 10345, 578, 6921, 7628, 510, 5386, 2622, 7806, 5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 
-10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 6151, 3469, 4443, 8871, 1555, 1802, 5103, 1891, 1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 
-6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 2276, 11307, 2593, 879, 7899, 8071, 3454, 8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 
-7592, 10588, 3466, 8972, 9757, 3332, 139, 2046, 2940, 10808, 9332, 874, 2301, 5650, 12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 
-3821, 10608, 2929, 6263, 4649, 6320, 9687, 10388, 502, 5118, 8496, 6226, 10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 
-5275, 8449, 10447, 4113, 72, 2828, 4352, 7455, 2712, 11048, 7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 
-4518, 9195, 7469, 11129, 9173, 12100, 1763, 2209, 9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939
-};
-
-
-const int32_t omegainv_rev_ntt1024_12289[1024] = {
-8193, 11796, 2381, 5444, 11854, 4337, 1912, 10911, 7012, 1168, 9041, 11082, 4645, 11885, 11224, 2143, 7313, 10682, 8509, 11414, 5088, 8005, 5011, 11287, 2566, 2187, 6039, 2422, 
-6267, 9302, 8643, 9852, 8456, 3778, 773, 11899, 442, 9888, 11222, 5101, 9430, 1045, 2481, 5012, 7428, 354, 6591, 9377, 1440, 8526, 27, 9223, 1017, 7404, 1632, 7205, 11744, 7270, 
-2678, 8585, 10752, 12047, 7575, 4143, 8758, 11813, 7384, 3985, 11869, 6730, 10745, 10111, 8889, 2399, 9153, 5191, 671, 3000, 243, 9273, 3247, 2686, 3978, 2969, 2370, 9424, 6957, 
-8779, 1630, 10163, 5407, 3186, 11136, 9405, 10040, 8241, 113, 4919, 8374, 2166, 3, 7852, 9140, 12129, 5291, 2704, 4938, 8653, 1663, 10512, 7635, 1426, 9018, 8232, 8925, 10600, 4372, 
-10115, 2847, 4414, 9644, 4053, 7247, 9984, 10805, 7394, 5195, 9509, 953, 3748, 11462, 6522, 9813, 12171, 10092, 5067, 3949, 8993, 4452, 2396, 7935, 130, 2837, 6915, 4278, 1673, 7300, 
-5331, 8705, 4177, 9764, 10908, 11950, 9821, 11745, 5791, 12280, 1022, 9447, 480, 3241, 11560, 10276, 3289, 10200, 5092, 9408, 9005, 10593, 1428, 2426, 334, 1260, 4388, 4632, 6534, 
-145, 6747, 3459, 8652, 7399, 6378, 8357, 2731, 2548, 4231, 355, 3382, 5179, 8595, 3707, 10530, 6429, 3195, 10643, 1212, 3542, 8785, 9744, 3621, 12288, 1479, 5146, 8246, 1305, 11567, 
-6553, 4134, 4978, 10938, 5777, 8961, 4591, 5728, 6461, 5023, 2639, 4821, 11340, 2625, 9314, 563, 9545, 3006, 3553, 4805, 2294, 11227, 8577, 9154, 4846, 9542, 11499, 955, 9970, 1170, 
-10963, 7203, 3201, 9275, 140, 1853, 4611, 726, 1635, 2768, 4255, 11112, 7969, 11289, 12208, 9198, 9238, 2366, 7393, 2963, 11184, 12147, 8812, 5681, 4212, 975, 2844, 8851, 6008, 11404, 
-1956, 7280, 12231, 12048, 3532, 11286, 3602, 6068, 8209, 421, 6077, 7665, 3263, 3600, 9987, 605, 11785, 8076, 5594, 9260, 6403, 4782, 11858, 10710, 5906, 2505, 9450, 8332, 10162, 
-12138, 2766, 1323, 9115, 12237, 3336, 6234, 677, 6415, 6821, 1010, 8807, 787, 8120, 9162, 9369, 5241, 192, 10968, 7377, 2049, 7509, 3445, 7591, 5057, 6137, 4948, 1728, 400, 3643, 
-6874, 6136, 6427, 1987, 10587, 11635, 8724, 12233, 9090, 5529, 7083, 1359, 5435, 11316, 1254, 8410, 10367, 3998, 10256, 3710, 6093, 5446, 6950, 316, 11907, 8301, 11821, 6364, 1018, 
-1041, 8775, 2344, 11011, 5574, 1973, 9027, 7210, 11767, 10120, 4916, 4324, 5315, 4075, 4467, 4789, 5537, 7540, 7840, 5456, 147, 3789, 6118, 8471, 1190, 9606, 3860, 5445, 7753, 11239, 
-11367, 11848, 1058, 8210, 11177, 10211, 7967, 1958, 9139, 1319, 709, 8243, 6224, 11454, 8719, 8049, 12225, 8633, 9830, 11606, 9786, 2948, 1566, 6507, 5486, 9235, 9166, 10542, 5257, 
-3834, 7856, 6370, 8960, 7991, 168, 9597, 6328, 5106, 1962, 10695, 6167, 9734, 7105, 11089, 1360, 3956, 6170, 5297, 10885, 11964, 11341, 1146, 1159, 6299, 8240, 3728, 8212, 8273, 2919, 
-8527, 11637, 5766, 295, 6099, 9280, 1693, 174, 723, 6554, 2655, 6421, 2738, 3315, 426, 10431, 7535, 11942, 9364, 3757, 10314, 2057, 5369, 7796, 9087, 6906, 10474, 1512, 350, 1483, 
-6374, 12240, 11026, 6347, 1583, 2500, 1489, 6956, 10258, 2281, 5876, 3991, 8320, 9522, 156, 1293, 4737, 6860, 4774, 8517, 11871, 6381, 453, 2882, 1805, 2051, 1954, 11713, 3963, 2447, 
-6142, 4115, 9259, 10446, 9928, 218, 9381, 8760, 8855, 1350, 6457, 8474, 1734, 7866, 3869, 1530, 10595, 11010, 11424, 7119, 2672, 10080, 10526, 189, 3116, 1160, 4820, 3094, 7771, 10036, 
-1868, 5411, 9559, 8095, 9270, 2840, 2478, 4565, 7315, 5078, 10506, 9646, 1095, 9244, 5781, 8195, 8838, 4378, 1241, 9577, 4834, 7937, 9461, 12217, 8176, 1842, 3840, 7014, 10499, 11038, 
-6879, 2035, 1040, 10407, 6164, 4770, 11345, 7002, 3669, 5673, 3020, 5406, 4665, 3846, 1573, 6063, 3793, 7171, 11787, 1901, 2602, 5969, 7640, 6026, 9360, 1681, 8468, 1030, 466, 1120, 
-2535, 21, 5808, 791, 9855, 9462, 2873, 2307, 4289, 11641, 12139, 170, 6639, 9988, 11415, 2957, 1481, 9349, 10243, 12150, 8957, 2532, 3317, 8823, 1701, 4697, 8711, 778, 4504, 2626, 
-11759, 12281, 11832, 4301, 4523, 10440, 6513, 3268, 8494, 3758, 8835, 4218, 4390, 11410, 9696, 982, 10013, 904, 2485, 5547, 5039, 24, 1371, 11675, 11009, 5461, 9343, 2637, 7779, 1015, 
-10362, 11924, 11408, 10699, 4411, 9955, 11066, 10398, 7186, 10487, 10734, 3418, 7846, 8820, 6138, 417, 9996, 4693, 2338, 1398, 9199, 7246, 11463, 6671, 1658, 6500, 8787, 751, 7570, 
-6389, 910, 3065, 1506, 6586, 4483, 9667, 6903, 11779, 4661, 5368, 11711, 1944, 450, 8929, 4684, 12226, 7154, 9916, 7302, 8481, 3670, 9348, 11722, 6627, 5289, 3837, 2595, 3221, 4273, 
-8239, 5207, 11445, 7087, 980, 682, 7699, 5082, 6940, 9344, 10883, 2633, 293, 9057, 3769, 4855, 8809, 10118, 3007, 1265, 6759, 6685, 8345, 8190, 11520, 6763, 216, 50, 8136, 10076, 767, 
-8484, 7929, 9004, 9135, 7235, 12282, 10353, 11444, 8566, 1706, 8360, 7559, 3229, 10268, 2832, 3572, 1282, 3536, 5370, 3753, 3941, 6184, 9169, 5646, 6086, 10235, 2483, 1344, 3042, 1468, 
-3981, 3407, 11826, 180, 4138, 7684, 2689, 10880, 7070, 204, 5509, 1057, 9689, 4705, 9168, 9272, 1236, 4475, 5246, 4251, 4739, 11063, 6771, 7073, 9261, 2360, 11925, 11777, 7619, 4906, 
-6825, 4554, 11295, 239, 2900, 7021, 146, 11883, 10602, 5189, 6094, 1403, 1804, 11667, 10552, 5672, 4499, 636, 5609, 8307, 2947, 3393, 7954, 2291, 3375, 8464, 4235, 8761, 7376, 6492, 
-8330, 5959, 10141, 7350, 5115, 2442, 1248, 10344, 1029, 5724, 1325, 6691, 8945, 1892, 3624, 10767, 2151, 4119, 3343, 7681, 7126, 7287, 12269, 8342, 338, 9834, 5690, 1744, 1314, 8635, 
-9395, 4167, 6085, 923, 11251, 6092, 10058, 12096, 2800, 11864, 1836, 11897, 2185, 1620, 375, 7711, 11912, 1942, 3408, 9714, 11124, 9513, 1178, 5478, 8778, 3276, 8951, 2212, 9615, 1392, 
-5784, 1255, 11783, 1756, 8144, 8328, 8755, 6463, 2065, 7725, 3495, 10771, 8524, 8113, 7226, 2461, 10014, 5653, 8022, 11158, 1445, 7429, 11164, 1275, 6781, 1176, 5734, 12077, 6323, 9520, 
-3114, 6302, 6693, 579, 3889, 10872, 6613, 4505, 10032, 5835, 9202, 7406, 8314, 5102, 11877, 6701, 6444, 2528, 9233, 4963, 8545, 3607, 10962, 7057, 8347, 11841, 11275, 7365, 7508, 4566, 
-5836, 12221, 2260, 1535, 3200, 2717, 60, 4238, 11677, 4227, 3368, 11749, 12164, 1526, 4222, 6162, 4840, 8257, 3163, 7885, 346, 2068, 1389, 11197, 5209, 3359, 9084, 11825, 10361, 3678, 
-4265, 9118, 7800, 10463, 9363, 9051, 8581, 11153, 8840, 5412, 8080, 9011, 6296, 3515, 11851, 1218, 5061, 1536, 1721, 9860, 4103, 10916, 2982, 11572, 3589, 9839, 10584, 11475, 11873, 
-2110, 716, 5416, 2164, 1866, 5211, 7562, 11081, 10381, 7751, 11946, 3448
-};
-
-                            
-const int32_t psi_rev_ntt512_12289[512] = {
-8193, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 875, 3780, 1607, 
-4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 2859, 7188, 1067, 2401, 11847, 390, 
-11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 
-12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 
-1544, 5559, 420, 8304, 4905, 476, 3531, 9326, 4896, 9923, 3051, 3091, 81, 1000, 4320, 1177, 8034, 9521, 10654, 11563, 7678, 10436, 12149, 3014, 9088, 5086, 1326, 11119, 2319, 11334, 790, 
-2747, 7443, 3135, 3712, 1062, 9995, 7484, 8736, 9283, 2744, 11726, 2975, 9664, 949, 7468, 9650, 7266, 5828, 6561, 7698, 3328, 6512, 1351, 7311, 8155, 5736, 722, 10984, 4043, 7143, 10810, 
-1, 8668, 2545, 3504, 8747, 11077, 1646, 9094, 5860, 1759, 8582, 3694, 7110, 8907, 11934, 8058, 9741, 9558, 3932, 5911, 4890, 3637, 8830, 5542, 12144, 5755, 7657, 7901, 11029, 11955, 9863, 
-10861, 1696, 3284, 2881, 7197, 2089, 9000, 2013, 729, 9048, 11809, 2842, 11267, 9, 6498, 544, 2468, 339, 1381, 2525, 8112, 3584, 6958, 4989, 10616, 8011, 5374, 9452, 12159, 4354, 9893, 
-7837, 3296, 8340, 7222, 2197, 118, 2476, 5767, 827, 8541, 11336, 8855, 8760, 9381, 218, 9928, 10446, 9259, 4115, 6142, 2447, 3963, 11713, 1954, 2051, 1805, 2882, 453, 6381, 11871, 8517, 
-4774, 6860, 4737, 1293, 156, 9522, 8320, 3991, 5876, 2281, 10258, 6956, 1489, 2500, 1583, 6347, 11026, 12240, 6374, 1483, 350, 1512, 10474, 6906, 9087, 7796, 5369, 2057, 10314, 3757, 
-9364, 11942, 7535, 10431, 426, 3315, 2738, 6421, 2655, 6554, 723, 174, 1693, 9280, 6099, 295, 5766, 11637, 8527, 2919, 8273, 8212, 3728, 8240, 6299, 1159, 1146, 11341, 11964, 10885, 5297, 
-6170, 3956, 1360, 11089, 7105, 9734, 6167, 10695, 1962, 5106, 6328, 9597, 168, 7991, 8960, 6370, 7856, 3834, 5257, 10542, 9166, 9235, 5486, 6507, 1566, 2948, 9786, 11606, 9830, 8633, 
-12225, 8049, 8719, 11454, 6224, 8243, 709, 1319, 9139, 1958, 7967, 10211, 11177, 8210, 1058, 11848, 11367, 11239, 7753, 5445, 3860, 9606, 1190, 8471, 6118, 3789, 147, 5456, 7840, 7540, 
-5537, 4789, 4467, 4075, 5315, 4324, 4916, 10120, 11767, 7210, 9027, 1973, 5574, 11011, 2344, 8775, 1041, 1018, 6364, 11821, 8301, 11907, 316, 6950, 5446, 6093, 3710, 10256, 3998, 10367, 
-8410, 1254, 11316, 5435, 1359, 7083, 5529, 9090, 12233, 8724, 11635, 10587, 1987, 6427, 6136, 6874, 3643, 400, 1728, 4948, 6137, 5057, 7591, 3445, 7509, 2049, 7377, 10968, 192, 5241, 9369, 
-9162, 8120, 787, 8807, 1010, 6821, 6415, 677, 6234, 3336, 12237, 9115, 1323, 2766, 12138, 10162, 8332, 9450, 2505, 5906, 10710, 11858, 4782, 6403, 9260, 5594, 8076, 11785, 605, 9987, 3600, 
-3263, 7665, 6077, 421, 8209, 6068, 3602, 11286, 3532, 12048, 12231, 7280, 1956, 11404, 6008, 8851, 2844, 975, 4212, 5681, 8812, 12147, 11184
-};
-
-
-const int32_t omegainv_rev_ntt512_12289[512] = {
-8193, 11796, 2381, 5444, 11854, 4337, 1912, 10911, 7012, 1168, 9041, 11082, 4645, 11885, 11224, 2143, 7313, 10682, 8509, 11414, 5088, 8005, 5011, 11287, 2566, 2187, 6039, 2422, 6267, 9302, 
-8643, 9852, 8456, 3778, 773, 11899, 442, 9888, 11222, 5101, 9430, 1045, 2481, 5012, 7428, 354, 6591, 9377, 1440, 8526, 27, 9223, 1017, 7404, 1632, 7205, 11744, 7270, 2678, 8585, 10752, 
-12047, 7575, 4143, 8758, 11813, 7384, 3985, 11869, 6730, 10745, 10111, 8889, 2399, 9153, 5191, 671, 3000, 243, 9273, 3247, 2686, 3978, 2969, 2370, 9424, 6957, 8779, 1630, 10163, 5407, 3186, 
-11136, 9405, 10040, 8241, 113, 4919, 8374, 2166, 3, 7852, 9140, 12129, 5291, 2704, 4938, 8653, 1663, 10512, 7635, 1426, 9018, 8232, 8925, 10600, 4372, 10115, 2847, 4414, 9644, 4053, 7247, 
-9984, 10805, 7394, 5195, 9509, 953, 3748, 11462, 6522, 9813, 12171, 10092, 5067, 3949, 8993, 4452, 2396, 7935, 130, 2837, 6915, 4278, 1673, 7300, 5331, 8705, 4177, 9764, 10908, 11950, 9821, 
-11745, 5791, 12280, 1022, 9447, 480, 3241, 11560, 10276, 3289, 10200, 5092, 9408, 9005, 10593, 1428, 2426, 334, 1260, 4388, 4632, 6534, 145, 6747, 3459, 8652, 7399, 6378, 8357, 2731, 2548, 
-4231, 355, 3382, 5179, 8595, 3707, 10530, 6429, 3195, 10643, 1212, 3542, 8785, 9744, 3621, 12288, 1479, 5146, 8246, 1305, 11567, 6553, 4134, 4978, 10938, 5777, 8961, 4591, 5728, 6461, 5023, 
-2639, 4821, 11340, 2625, 9314, 563, 9545, 3006, 3553, 4805, 2294, 11227, 8577, 9154, 4846, 9542, 11499, 955, 9970, 1170, 10963, 7203, 3201, 9275, 140, 1853, 4611, 726, 1635, 2768, 4255, 
-11112, 7969, 11289, 12208, 9198, 9238, 2366, 7393, 2963, 1105, 142, 3477, 6608, 8077, 11314, 9445, 3438, 6281, 885, 10333, 5009, 58, 241, 8757, 1003, 8687, 6221, 4080, 11868, 6212, 4624, 
-9026, 8689, 2302, 11684, 504, 4213, 6695, 3029, 5886, 7507, 431, 1579, 6383, 9784, 2839, 3957, 2127, 151, 9523, 10966, 3174, 52, 8953, 6055, 11612, 5874, 5468, 11279, 3482, 11502, 4169, 
-3127, 2920, 7048, 12097, 1321, 4912, 10240, 4780, 8844, 4698, 7232, 6152, 7341, 10561, 11889, 8646, 5415, 6153, 5862, 10302, 1702, 654, 3565, 56, 3199, 6760, 5206, 10930, 6854, 973, 11035, 
-3879, 1922, 8291, 2033, 8579, 6196, 6843, 5339, 11973, 382, 3988, 468, 5925, 11271, 11248, 3514, 9945, 1278, 6715, 10316, 3262, 5079, 522, 2169, 7373, 7965, 6974, 8214, 7822, 7500, 6752, 
-4749, 4449, 6833, 12142, 8500, 6171, 3818, 11099, 2683, 8429, 6844, 4536, 1050, 922, 441, 11231, 4079, 1112, 2078, 4322, 10331, 3150, 10970, 11580, 4046, 6065, 835, 3570, 4240, 64, 3656, 
-2459, 683, 2503, 9341, 10723, 5782, 6803, 3054, 3123, 1747, 7032, 8455, 4433, 5919, 3329, 4298, 12121, 2692, 5961, 7183, 10327, 1594, 6122, 2555, 5184, 1200, 10929, 8333, 6119, 6992, 1404, 
-325, 948, 11143, 11130, 5990, 4049, 8561, 4077, 4016, 9370, 3762, 652, 6523, 11994, 6190, 3009, 10596, 12115, 11566, 5735, 9634, 5868, 9551, 8974, 11863, 1858, 4754, 347, 2925, 8532, 1975, 
-10232, 6920, 4493, 3202, 5383, 1815, 10777, 11939, 10806, 5915, 49, 1263, 5942, 10706, 9789, 10800, 5333, 2031, 10008, 6413, 8298, 3969, 2767, 12133, 10996, 7552, 5429, 7515, 3772, 418, 5908, 
-11836, 9407, 10484, 10238, 10335, 576, 8326, 9842, 6147, 8174, 3030, 1843, 2361, 12071, 2908, 3529, 3434
-};
\ No newline at end of file
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: fixed constants for the Number Theoretic Transform (NTT)
+*
+*****************************************************************************************/ 
+
+#include "LatticeCrypto_priv.h"
+
+
+// N^-1 * prime_scale^-8
+const int32_t Ninv8_ntt1024_12289 = 8350;
+// N^-1 * prime_scale^-7 * omegainv_rev_ntt1024_12289[1]
+const int32_t omegainv7N_rev_ntt1024_12289 = 795;
+// N^-1 * prime_scale^-11
+const int32_t Ninv11_ntt1024_12289 = 2585;
+// N^-1 * prime_scale^-10 * omegainv_rev_ntt1024_12289[1]
+const int32_t omegainv10N_rev_ntt1024_12289 = 10953;
+
+// The same constants for N = 512 and N = 2048
+const int32_t Ninv11_ntt512_12289 = 5170;
+const int32_t omegainv10N_rev_ntt512_12289 = 9617;
+const int32_t Ninv11_ntt2048_12289 = 7437;
+const int32_t omegainv10N_rev_ntt2048_12289 = 11621;
+
+
+// Index-reversed matrices containing powers of psi (psi_rev_nttxxx_yyy) and inverse powers of omega (omegainv_rev_nttxxx_yyy),
+// where xxx is parameter N and yyy is the prime q. Entry 0 of psi_rev_nttxxx_yyy is not a power of psi: it holds a factor
+// that the forward NTT applies to all coefficients, so that a scaled transform costs no extra pass.
+
+const int32_t psi_rev_ntt1024_12289[1024] = {
+1, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 2859, 
+7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 1777, 10626, 
+3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 8311, 9603, 9042, 
+3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 9326, 4896, 9923, 3051, 3091, 81, 1000, 4320, 1177, 8034, 9521, 10654, 11563, 
+7678, 10436, 12149, 3014, 9088, 5086, 1326, 11119, 2319, 11334, 790, 2747, 7443, 3135, 3712, 1062, 9995, 7484, 8736, 9283, 2744, 11726, 2975, 9664, 949, 7468, 9650, 7266, 
+5828, 6561, 7698, 3328, 6512, 1351, 7311, 8155, 5736, 722, 10984, 4043, 7143, 10810, 1, 8668, 2545, 3504, 8747, 11077, 1646, 9094, 5860, 1759, 8582, 3694, 7110, 8907, 11934, 
+8058, 9741, 9558, 3932, 5911, 4890, 3637, 8830, 5542, 12144, 5755, 7657, 7901, 11029, 11955, 9863, 10861, 1696, 3284, 2881, 7197, 2089, 9000, 2013, 729, 9048, 11809, 2842, 
+11267, 9, 6498, 544, 2468, 339, 1381, 2525, 8112, 3584, 6958, 4989, 10616, 8011, 5374, 9452, 12159, 4354, 9893, 7837, 3296, 8340, 7222, 2197, 118, 2476, 5767, 827, 8541, 
+11336, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 10484, 9407, 11836, 5908, 418, 3772, 7515, 5429, 7552, 10996, 12133, 2767, 3969, 
+8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 10777, 1815, 5383, 3202, 4493, 6920, 10232, 1975, 8532, 2925, 347, 4754, 1858, 11863, 
+8974, 9551, 5868, 9634, 5735,11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 3762, 9370, 4016, 4077, 8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 6992, 6119, 8333, 
+10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 3329, 5919, 4433, 8455,7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 683, 2459, 3656, 
+64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 1112, 4079, 11231, 441, 922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 8500, 12142, 6833, 4449, 
+4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 3262, 10316, 6715, 1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 5339, 6843, 6196, 8579, 2033, 
+8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 3199, 56, 3565, 654, 1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 7232, 4698, 8844, 4780, 10240, 4912, 
+1321, 12097, 7048, 2920, 3127, 4169, 11502, 3482, 11279, 5468, 5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 9784, 6383, 1579, 431, 7507, 5886, 3029, 
+6695, 4213, 504, 11684, 2302, 8689, 9026, 4624, 6212, 11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 
+8841, 343, 4538, 1908, 1208, 4727, 7078, 10423, 10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 
+3278, 4209, 6877, 3449, 1136, 3708, 3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 
+125, 540, 8921, 8062, 612, 8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 7187, 
+3975, 4883, 3087, 6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 2275, 9828, 5063, 
+4176, 3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 2575, 8881, 10347, 377, 
+4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 20, 5002, 5163, 4608, 8946, 8170, 
+10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 2148, 6330, 3959, 5797, 4913, 3528, 8054, 3825, 8914, 9998, 4335, 8896, 9342, 3982, 
+6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 9389, 12050, 994, 7735, 5464, 7383, 4670, 512, 364, 9929, 3028, 5216, 5518, 1226, 7550, 
+8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 9600, 4605, 8151, 12109, 463, 8882, 8308, 10821, 9247, 10945, 9806, 2054, 6203, 6643, 3120, 
+6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 3723, 845, 1936, 7, 5054, 3154, 3285, 4360, 3805, 11522, 2213, 4153, 12239, 12073, 5526, 769, 
+4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 9656, 1406, 2945, 5349, 7207, 4590, 11607, 11309, 5202, 844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 
+5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 11839, 10345, 578, 6921, 7628, 510, 5386, 2622, 7806, 5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 
+10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 6151, 3469, 4443, 8871, 1555, 1802, 5103, 1891, 1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 
+6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 2276, 11307, 2593, 879, 7899, 8071, 3454, 8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 
+7592, 10588, 3466, 8972, 9757, 3332, 139, 2046, 2940, 10808, 9332, 874, 2301, 5650, 12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 
+3821, 10608, 2929, 6263, 4649, 6320, 9687, 10388, 502, 5118, 8496, 6226, 10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 
+5275, 8449, 10447, 4113, 72, 2828, 4352, 7455, 2712, 11048, 7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 
+4518, 9195, 7469, 11129, 9173, 12100, 1763, 2209, 9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939
+};
+
+
+// Copies of psi_rev_ntt1024_12289 that also scale the transform by 3 and 81, for the error polynomials of the key exchange.
+// Entry 0 holds the scale factor and entries 128 to 255 (stage m=128) are multiplied by it.
+
+const int32_t psi_rev3_ntt1024_12289[1024] = {
+3, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 2859, 
+7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 1777, 10626, 
+3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 8311, 9603, 9042, 
+3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 3400, 2399, 5191, 9153, 9273, 243, 3000, 671, 3531, 11813, 3985, 7384, 
+10111, 10745, 6730, 11869, 9042, 2686, 2969, 3978, 8779, 6957, 9424, 2370, 8241, 10040, 9405, 11136, 3186, 5407, 10163, 1630, 3271, 8232, 10600, 8925, 4414, 2847, 10115, 4372, 
+9509, 5195, 7394, 10805, 9984, 7247, 4053, 9644, 12176, 4919, 2166, 8374, 12129, 9140, 7852, 3, 1426, 7635, 10512, 1663, 8653, 4938, 2704, 5291, 5277, 1168, 11082, 9041, 
+2143, 11224, 11885, 4645, 4096, 11796, 5444, 2381, 10911, 1912, 4337, 11854, 4976, 10682, 11414, 8509, 11287, 5011, 8005, 5088, 9852, 8643, 9302, 6267, 2422, 6039, 2187, 2566, 
+10849, 8526, 9223, 27, 7205, 1632, 7404, 1017, 4143, 7575, 12047, 10752, 8585, 2678, 7270, 11744, 3833, 3778, 11899, 773, 5101, 11222, 9888, 442, 9377, 6591, 354, 7428, 
+5012, 2481, 1045, 9430, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 10484, 9407, 11836, 5908, 418, 3772, 7515, 5429, 7552, 10996, 
+12133, 2767, 3969, 8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 10777, 1815, 5383, 3202, 4493, 6920, 10232, 1975, 8532, 2925, 347, 
+4754, 1858, 11863, 8974, 9551, 5868, 9634, 5735, 11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 3762, 9370, 4016, 4077, 8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 
+6992, 6119, 8333, 10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 3329, 5919, 4433, 8455, 7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 
+683, 2459, 3656, 64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 1112, 4079, 11231, 441, 922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 
+8500, 12142, 6833, 4449, 4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 3262, 10316, 6715, 1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 
+5339, 6843, 6196, 8579, 2033, 8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 3199, 56, 3565, 654, 1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 
+7232, 4698, 8844, 4780, 10240, 4912, 1321, 12097, 7048, 2920, 3127, 4169, 11502, 3482, 11279, 5468, 5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 
+9784, 6383, 1579, 431, 7507, 5886, 3029, 6695, 4213, 504, 11684, 2302, 8689, 9026, 4624, 6212, 11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 
+3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 8841, 343, 4538, 1908, 1208, 4727, 7078, 10423, 10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 
+8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 3278, 4209, 6877, 3449, 1136, 3708, 3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 
+10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 125, 540, 8921, 8062, 612, 8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 
+3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 7187, 3975, 4883, 3087, 6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 
+6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 2275, 9828, 5063, 4176, 3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 
+2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 2575, 8881, 10347, 377, 4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 
+2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 20, 5002, 5163, 4608, 8946, 8170, 10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 
+2148, 6330, 3959, 5797, 4913, 3528, 8054, 3825, 8914, 9998, 4335, 8896, 9342, 3982, 6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 
+9389, 12050, 994, 7735, 5464, 7383, 4670, 512, 364, 9929, 3028, 5216, 5518, 1226, 7550, 8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 
+9600, 4605, 8151, 12109, 463, 8882, 8308, 10821, 9247, 10945, 9806, 2054, 6203, 6643, 3120, 6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 
+3723, 845, 1936, 7, 5054, 3154, 3285, 4360, 3805, 11522, 2213, 4153, 12239, 12073, 5526, 769, 4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 
+9656, 1406, 2945, 5349, 7207, 4590, 11607, 11309, 5202, 844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 
+11839, 10345, 578, 6921, 7628, 510, 5386, 2622, 7806, 5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 
+6151, 3469, 4443, 8871, 1555, 1802, 5103, 1891, 1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 
+2276, 11307, 2593, 879, 7899, 8071, 3454, 8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 7592, 10588, 3466, 8972, 9757, 3332, 139, 
+2046, 2940, 10808, 9332, 874, 2301, 5650, 12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 3821, 10608, 2929, 6263, 4649, 6320, 
+9687, 10388, 502, 5118, 8496, 6226, 10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 5275, 8449, 10447, 4113, 72, 
+2828, 4352, 7455, 2712, 11048, 7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 4518, 9195, 7469, 11129, 
+9173, 12100, 1763, 2209, 9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939
+};
+
+
+const int32_t psi_rev81_ntt1024_12289[1024] = {
+81, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 2859, 
+7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 1777, 10626, 
+3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 8311, 9603, 9042, 
+3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 5777, 3328, 4978, 1351, 4591, 6561, 7266, 5828, 9314, 11726, 9283, 2744, 
+2639, 7468, 9664, 949, 10643, 11077, 6429, 9094, 3542, 3504, 8668, 2545, 1305, 722, 8155, 5736, 12288, 10810, 4043, 7143, 2294, 1062, 3553, 7484, 8577, 3135, 2747, 7443, 
+10963, 5086, 3014, 9088, 11499, 11334, 11119, 2319, 9238, 9923, 9326, 4896, 7969, 1000, 3091, 81, 1635, 9521, 1177, 8034, 140, 10436, 11563, 7678, 7300, 6958, 4278, 10616, 
+8705, 8112, 1381, 2525, 12280, 11267, 11809, 2842, 11950, 2468, 6498, 544, 11462, 5767, 953, 8541, 9813, 118, 7222, 2197, 7935, 12159, 5374, 9452, 3949, 3296, 9893, 7837, 
+10276, 9000, 3241, 729, 10200, 7197, 3284, 2881, 1260, 7901, 5755, 7657, 10593, 10861, 11955, 9863, 5179, 3694, 1759, 8582, 2548, 8058, 8907, 11934, 7399, 5911, 9558, 3932, 
+145, 5542, 3637, 8830, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 10484, 9407, 11836, 5908, 418, 3772, 7515, 5429, 7552, 10996, 
+12133, 2767, 3969, 8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 10777, 1815, 5383, 3202, 4493, 6920, 10232, 1975, 8532, 2925, 347, 
+4754, 1858, 11863, 8974, 9551, 5868, 9634, 5735, 11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 3762, 9370, 4016, 4077, 8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 
+6992, 6119, 8333, 10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 3329, 5919, 4433, 8455, 7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 
+683, 2459, 3656, 64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 1112, 4079, 11231, 441, 922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 
+8500, 12142, 6833, 4449, 4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 3262, 10316, 6715, 1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 
+5339, 6843, 6196, 8579, 2033, 8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 3199, 56, 3565, 654, 1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 
+7232, 4698, 8844, 4780, 10240, 4912, 1321, 12097, 7048, 2920, 3127, 4169, 11502, 3482, 11279, 5468, 5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 
+9784, 6383, 1579, 431, 7507, 5886, 3029, 6695, 4213, 504, 11684, 2302, 8689, 9026, 4624, 6212, 11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 
+3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 8841, 343, 4538, 1908, 1208, 4727, 7078, 10423, 10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 
+8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 3278, 4209, 6877, 3449, 1136, 3708, 3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 
+10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 125, 540, 8921, 8062, 612, 8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 
+3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 7187, 3975, 4883, 3087, 6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 
+6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 2275, 9828, 5063, 4176, 3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 
+2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 2575, 8881, 10347, 377, 4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 
+2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 20, 5002, 5163, 4608, 8946, 8170, 10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 
+2148, 6330, 3959, 5797, 4913, 3528, 8054, 3825, 8914, 9998, 4335, 8896, 9342, 3982, 6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 
+9389, 12050, 994, 7735, 5464, 7383, 4670, 512, 364, 9929, 3028, 5216, 5518, 1226, 7550, 8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 
+9600, 4605, 8151, 12109, 463, 8882, 8308, 10821, 9247, 10945, 9806, 2054, 6203, 6643, 3120, 6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 
+3723, 845, 1936, 7, 5054, 3154, 3285, 4360, 3805, 11522, 2213, 4153, 12239, 12073, 5526, 769, 4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 
+9656, 1406, 2945, 5349, 7207, 4590, 11607, 11309, 5202, 844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 
+11839, 10345, 578, 6921, 7628, 510, 5386, 2622, 7806, 5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 
+6151, 3469, 4443, 8871, 1555, 1802, 5103, 1891, 1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 
+2276, 11307, 2593, 879, 7899, 8071, 3454, 8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 7592, 10588, 3466, 8972, 9757, 3332, 139, 
+2046, 2940, 10808, 9332, 874, 2301, 5650, 12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 3821, 10608, 2929, 6263, 4649, 6320, 
+9687, 10388, 502, 5118, 8496, 6226, 10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 5275, 8449, 10447, 4113, 72, 
+2828, 4352, 7455, 2712, 11048, 7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 4518, 9195, 7469, 11129, 
+9173, 12100, 1763, 2209, 9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939
+};
+
+
+const int32_t omegainv_rev_ntt1024_12289[1024] = {
+8193, 11796, 2381, 5444, 11854, 4337, 1912, 10911, 7012, 1168, 9041, 11082, 4645, 11885, 11224, 2143, 7313, 10682, 8509, 11414, 5088, 8005, 5011, 11287, 2566, 2187, 6039, 2422, 
+6267, 9302, 8643, 9852, 8456, 3778, 773, 11899, 442, 9888, 11222, 5101, 9430, 1045, 2481, 5012, 7428, 354, 6591, 9377, 1440, 8526, 27, 9223, 1017, 7404, 1632, 7205, 11744, 7270, 
+2678, 8585, 10752, 12047, 7575, 4143, 8758, 11813, 7384, 3985, 11869, 6730, 10745, 10111, 8889, 2399, 9153, 5191, 671, 3000, 243, 9273, 3247, 2686, 3978, 2969, 2370, 9424, 6957, 
+8779, 1630, 10163, 5407, 3186, 11136, 9405, 10040, 8241, 113, 4919, 8374, 2166, 3, 7852, 9140, 12129, 5291, 2704, 4938, 8653, 1663, 10512, 7635, 1426, 9018, 8232, 8925, 10600, 4372, 
+10115, 2847, 4414, 9644, 4053, 7247, 9984, 10805, 7394, 5195, 9509, 953, 3748, 11462, 6522, 9813, 12171, 10092, 5067, 3949, 8993, 4452, 2396, 7935, 130, 2837, 6915, 4278, 1673, 7300, 
+5331, 8705, 4177, 9764, 10908, 11950, 9821, 11745, 5791, 12280, 1022, 9447, 480, 3241, 11560, 10276, 3289, 10200, 5092, 9408, 9005, 10593, 1428, 2426, 334, 1260, 4388, 4632, 6534, 
+145, 6747, 3459, 8652, 7399, 6378, 8357, 2731, 2548, 4231, 355, 3382, 5179, 8595, 3707, 10530, 6429, 3195, 10643, 1212, 3542, 8785, 9744, 3621, 12288, 1479, 5146, 8246, 1305, 11567, 
+6553, 4134, 4978, 10938, 5777, 8961, 4591, 5728, 6461, 5023, 2639, 4821, 11340, 2625, 9314, 563, 9545, 3006, 3553, 4805, 2294, 11227, 8577, 9154, 4846, 9542, 11499, 955, 9970, 1170, 
+10963, 7203, 3201, 9275, 140, 1853, 4611, 726, 1635, 2768, 4255, 11112, 7969, 11289, 12208, 9198, 9238, 2366, 7393, 2963, 11184, 12147, 8812, 5681, 4212, 975, 2844, 8851, 6008, 11404, 
+1956, 7280, 12231, 12048, 3532, 11286, 3602, 6068, 8209, 421, 6077, 7665, 3263, 3600, 9987, 605, 11785, 8076, 5594, 9260, 6403, 4782, 11858, 10710, 5906, 2505, 9450, 8332, 10162, 
+12138, 2766, 1323, 9115, 12237, 3336, 6234, 677, 6415, 6821, 1010, 8807, 787, 8120, 9162, 9369, 5241, 192, 10968, 7377, 2049, 7509, 3445, 7591, 5057, 6137, 4948, 1728, 400, 3643, 
+6874, 6136, 6427, 1987, 10587, 11635, 8724, 12233, 9090, 5529, 7083, 1359, 5435, 11316, 1254, 8410, 10367, 3998, 10256, 3710, 6093, 5446, 6950, 316, 11907, 8301, 11821, 6364, 1018, 
+1041, 8775, 2344, 11011, 5574, 1973, 9027, 7210, 11767, 10120, 4916, 4324, 5315, 4075, 4467, 4789, 5537, 7540, 7840, 5456, 147, 3789, 6118, 8471, 1190, 9606, 3860, 5445, 7753, 11239, 
+11367, 11848, 1058, 8210, 11177, 10211, 7967, 1958, 9139, 1319, 709, 8243, 6224, 11454, 8719, 8049, 12225, 8633, 9830, 11606, 9786, 2948, 1566, 6507, 5486, 9235, 9166, 10542, 5257, 
+3834, 7856, 6370, 8960, 7991, 168, 9597, 6328, 5106, 1962, 10695, 6167, 9734, 7105, 11089, 1360, 3956, 6170, 5297, 10885, 11964, 11341, 1146, 1159, 6299, 8240, 3728, 8212, 8273, 2919, 
+8527, 11637, 5766, 295, 6099, 9280, 1693, 174, 723, 6554, 2655, 6421, 2738, 3315, 426, 10431, 7535, 11942, 9364, 3757, 10314, 2057, 5369, 7796, 9087, 6906, 10474, 1512, 350, 1483, 
+6374, 12240, 11026, 6347, 1583, 2500, 1489, 6956, 10258, 2281, 5876, 3991, 8320, 9522, 156, 1293, 4737, 6860, 4774, 8517, 11871, 6381, 453, 2882, 1805, 2051, 1954, 11713, 3963, 2447, 
+6142, 4115, 9259, 10446, 9928, 218, 9381, 8760, 8855, 1350, 6457, 8474, 1734, 7866, 3869, 1530, 10595, 11010, 11424, 7119, 2672, 10080, 10526, 189, 3116, 1160, 4820, 3094, 7771, 10036, 
+1868, 5411, 9559, 8095, 9270, 2840, 2478, 4565, 7315, 5078, 10506, 9646, 1095, 9244, 5781, 8195, 8838, 4378, 1241, 9577, 4834, 7937, 9461, 12217, 8176, 1842, 3840, 7014, 10499, 11038, 
+6879, 2035, 1040, 10407, 6164, 4770, 11345, 7002, 3669, 5673, 3020, 5406, 4665, 3846, 1573, 6063, 3793, 7171, 11787, 1901, 2602, 5969, 7640, 6026, 9360, 1681, 8468, 1030, 466, 1120, 
+2535, 21, 5808, 791, 9855, 9462, 2873, 2307, 4289, 11641, 12139, 170, 6639, 9988, 11415, 2957, 1481, 9349, 10243, 12150, 8957, 2532, 3317, 8823, 1701, 4697, 8711, 778, 4504, 2626, 
+11759, 12281, 11832, 4301, 4523, 10440, 6513, 3268, 8494, 3758, 8835, 4218, 4390, 11410, 9696, 982, 10013, 904, 2485, 5547, 5039, 24, 1371, 11675, 11009, 5461, 9343, 2637, 7779, 1015, 
+10362, 11924, 11408, 10699, 4411, 9955, 11066, 10398, 7186, 10487, 10734, 3418, 7846, 8820, 6138, 417, 9996, 4693, 2338, 1398, 9199, 7246, 11463, 6671, 1658, 6500, 8787, 751, 7570, 
+6389, 910, 3065, 1506, 6586, 4483, 9667, 6903, 11779, 4661, 5368, 11711, 1944, 450, 8929, 4684, 12226, 7154, 9916, 7302, 8481, 3670, 9348, 11722, 6627, 5289, 3837, 2595, 3221, 4273, 
+8239, 5207, 11445, 7087, 980, 682, 7699, 5082, 6940, 9344, 10883, 2633, 293, 9057, 3769, 4855, 8809, 10118, 3007, 1265, 6759, 6685, 8345, 8190, 11520, 6763, 216, 50, 8136, 10076, 767, 
+8484, 7929, 9004, 9135, 7235, 12282, 10353, 11444, 8566, 1706, 8360, 7559, 3229, 10268, 2832, 3572, 1282, 3536, 5370, 3753, 3941, 6184, 9169, 5646, 6086, 10235, 2483, 1344, 3042, 1468, 
+3981, 3407, 11826, 180, 4138, 7684, 2689, 10880, 7070, 204, 5509, 1057, 9689, 4705, 9168, 9272, 1236, 4475, 5246, 4251, 4739, 11063, 6771, 7073, 9261, 2360, 11925, 11777, 7619, 4906, 
+6825, 4554, 11295, 239, 2900, 7021, 146, 11883, 10602, 5189, 6094, 1403, 1804, 11667, 10552, 5672, 4499, 636, 5609, 8307, 2947, 3393, 7954, 2291, 3375, 8464, 4235, 8761, 7376, 6492, 
+8330, 5959, 10141, 7350, 5115, 2442, 1248, 10344, 1029, 5724, 1325, 6691, 8945, 1892, 3624, 10767, 2151, 4119, 3343, 7681, 7126, 7287, 12269, 8342, 338, 9834, 5690, 1744, 1314, 8635, 
+9395, 4167, 6085, 923, 11251, 6092, 10058, 12096, 2800, 11864, 1836, 11897, 2185, 1620, 375, 7711, 11912, 1942, 3408, 9714, 11124, 9513, 1178, 5478, 8778, 3276, 8951, 2212, 9615, 1392, 
+5784, 1255, 11783, 1756, 8144, 8328, 8755, 6463, 2065, 7725, 3495, 10771, 8524, 8113, 7226, 2461, 10014, 5653, 8022, 11158, 1445, 7429, 11164, 1275, 6781, 1176, 5734, 12077, 6323, 9520, 
+3114, 6302, 6693, 579, 3889, 10872, 6613, 4505, 10032, 5835, 9202, 7406, 8314, 5102, 11877, 6701, 6444, 2528, 9233, 4963, 8545, 3607, 10962, 7057, 8347, 11841, 11275, 7365, 7508, 4566, 
+5836, 12221, 2260, 1535, 3200, 2717, 60, 4238, 11677, 4227, 3368, 11749, 12164, 1526, 4222, 6162, 4840, 8257, 3163, 7885, 346, 2068, 1389, 11197, 5209, 3359, 9084, 11825, 10361, 3678, 
+4265, 9118, 7800, 10463, 9363, 9051, 8581, 11153, 8840, 5412, 8080, 9011, 6296, 3515, 11851, 1218, 5061, 1536, 1721, 9860, 4103, 10916, 2982, 11572, 3589, 9839, 10584, 11475, 11873, 
+2110, 716, 5416, 2164, 1866, 5211, 7562, 11081, 10381, 7751, 11946, 3448
+};
+
+                            
+const int32_t psi_rev_ntt512_12289[512] = {
+1, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 875, 3780, 1607, 
+4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 2859, 7188, 1067, 2401, 11847, 390, 
+11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 
+12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 
+1544, 5559, 420, 8304, 4905, 476, 3531, 9326, 4896, 9923, 3051, 3091, 81, 1000, 4320, 1177, 8034, 9521, 10654, 11563, 7678, 10436, 12149, 3014, 9088, 5086, 1326, 11119, 2319, 11334, 790, 
+2747, 7443, 3135, 3712, 1062, 9995, 7484, 8736, 9283, 2744, 11726, 2975, 9664, 949, 7468, 9650, 7266, 5828, 6561, 7698, 3328, 6512, 1351, 7311, 8155, 5736, 722, 10984, 4043, 7143, 10810, 
+1, 8668, 2545, 3504, 8747, 11077, 1646, 9094, 5860, 1759, 8582, 3694, 7110, 8907, 11934, 8058, 9741, 9558, 3932, 5911, 4890, 3637, 8830, 5542, 12144, 5755, 7657, 7901, 11029, 11955, 9863, 
+10861, 1696, 3284, 2881, 7197, 2089, 9000, 2013, 729, 9048, 11809, 2842, 11267, 9, 6498, 544, 2468, 339, 1381, 2525, 8112, 3584, 6958, 4989, 10616, 8011, 5374, 9452, 12159, 4354, 9893, 
+7837, 3296, 8340, 7222, 2197, 118, 2476, 5767, 827, 8541, 11336, 8855, 8760, 9381, 218, 9928, 10446, 9259, 4115, 6142, 2447, 3963, 11713, 1954, 2051, 1805, 2882, 453, 6381, 11871, 8517, 
+4774, 6860, 4737, 1293, 156, 9522, 8320, 3991, 5876, 2281, 10258, 6956, 1489, 2500, 1583, 6347, 11026, 12240, 6374, 1483, 350, 1512, 10474, 6906, 9087, 7796, 5369, 2057, 10314, 3757, 
+9364, 11942, 7535, 10431, 426, 3315, 2738, 6421, 2655, 6554, 723, 174, 1693, 9280, 6099, 295, 5766, 11637, 8527, 2919, 8273, 8212, 3728, 8240, 6299, 1159, 1146, 11341, 11964, 10885, 5297, 
+6170, 3956, 1360, 11089, 7105, 9734, 6167, 10695, 1962, 5106, 6328, 9597, 168, 7991, 8960, 6370, 7856, 3834, 5257, 10542, 9166, 9235, 5486, 6507, 1566, 2948, 9786, 11606, 9830, 8633, 
+12225, 8049, 8719, 11454, 6224, 8243, 709, 1319, 9139, 1958, 7967, 10211, 11177, 8210, 1058, 11848, 11367, 11239, 7753, 5445, 3860, 9606, 1190, 8471, 6118, 3789, 147, 5456, 7840, 7540, 
+5537, 4789, 4467, 4075, 5315, 4324, 4916, 10120, 11767, 7210, 9027, 1973, 5574, 11011, 2344, 8775, 1041, 1018, 6364, 11821, 8301, 11907, 316, 6950, 5446, 6093, 3710, 10256, 3998, 10367, 
+8410, 1254, 11316, 5435, 1359, 7083, 5529, 9090, 12233, 8724, 11635, 10587, 1987, 6427, 6136, 6874, 3643, 400, 1728, 4948, 6137, 5057, 7591, 3445, 7509, 2049, 7377, 10968, 192, 5241, 9369, 
+9162, 8120, 787, 8807, 1010, 6821, 6415, 677, 6234, 3336, 12237, 9115, 1323, 2766, 12138, 10162, 8332, 9450, 2505, 5906, 10710, 11858, 4782, 6403, 9260, 5594, 8076, 11785, 605, 9987, 3600, 
+3263, 7665, 6077, 421, 8209, 6068, 3602, 11286, 3532, 12048, 12231, 7280, 1956, 11404, 6008, 8851, 2844, 975, 4212, 5681, 8812, 12147, 11184
+};
+
+
+const int32_t omegainv_rev_ntt512_12289[512] = {
+8193, 11796, 2381, 5444, 11854, 4337, 1912, 10911, 7012, 1168, 9041, 11082, 4645, 11885, 11224, 2143, 7313, 10682, 8509, 11414, 5088, 8005, 5011, 11287, 2566, 2187, 6039, 2422, 6267, 9302, 
+8643, 9852, 8456, 3778, 773, 11899, 442, 9888, 11222, 5101, 9430, 1045, 2481, 5012, 7428, 354, 6591, 9377, 1440, 8526, 27, 9223, 1017, 7404, 1632, 7205, 11744, 7270, 2678, 8585, 10752, 
+12047, 7575, 4143, 8758, 11813, 7384, 3985, 11869, 6730, 10745, 10111, 8889, 2399, 9153, 5191, 671, 3000, 243, 9273, 3247, 2686, 3978, 2969, 2370, 9424, 6957, 8779, 1630, 10163, 5407, 3186, 
+11136, 9405, 10040, 8241, 113, 4919, 8374, 2166, 3, 7852, 9140, 12129, 5291, 2704, 4938, 8653, 1663, 10512, 7635, 1426, 9018, 8232, 8925, 10600, 4372, 10115, 2847, 4414, 9644, 4053, 7247, 
+9984, 10805, 7394, 5195, 9509, 953, 3748, 11462, 6522, 9813, 12171, 10092, 5067, 3949, 8993, 4452, 2396, 7935, 130, 2837, 6915, 4278, 1673, 7300, 5331, 8705, 4177, 9764, 10908, 11950, 9821, 
+11745, 5791, 12280, 1022, 9447, 480, 3241, 11560, 10276, 3289, 10200, 5092, 9408, 9005, 10593, 1428, 2426, 334, 1260, 4388, 4632, 6534, 145, 6747, 3459, 8652, 7399, 6378, 8357, 2731, 2548, 
+4231, 355, 3382, 5179, 8595, 3707, 10530, 6429, 3195, 10643, 1212, 3542, 8785, 9744, 3621, 12288, 1479, 5146, 8246, 1305, 11567, 6553, 4134, 4978, 10938, 5777, 8961, 4591, 5728, 6461, 5023, 
+2639, 4821, 11340, 2625, 9314, 563, 9545, 3006, 3553, 4805, 2294, 11227, 8577, 9154, 4846, 9542, 11499, 955, 9970, 1170, 10963, 7203, 3201, 9275, 140, 1853, 4611, 726, 1635, 2768, 4255, 
+11112, 7969, 11289, 12208, 9198, 9238, 2366, 7393, 2963, 1105, 142, 3477, 6608, 8077, 11314, 9445, 3438, 6281, 885, 10333, 5009, 58, 241, 8757, 1003, 8687, 6221, 4080, 11868, 6212, 4624, 
+9026, 8689, 2302, 11684, 504, 4213, 6695, 3029, 5886, 7507, 431, 1579, 6383, 9784, 2839, 3957, 2127, 151, 9523, 10966, 3174, 52, 8953, 6055, 11612, 5874, 5468, 11279, 3482, 11502, 4169, 
+3127, 2920, 7048, 12097, 1321, 4912, 10240, 4780, 8844, 4698, 7232, 6152, 7341, 10561, 11889, 8646, 5415, 6153, 5862, 10302, 1702, 654, 3565, 56, 3199, 6760, 5206, 10930, 6854, 973, 11035, 
+3879, 1922, 8291, 2033, 8579, 6196, 6843, 5339, 11973, 382, 3988, 468, 5925, 11271, 11248, 3514, 9945, 1278, 6715, 10316, 3262, 5079, 522, 2169, 7373, 7965, 6974, 8214, 7822, 7500, 6752, 
+4749, 4449, 6833, 12142, 8500, 6171, 3818, 11099, 2683, 8429, 6844, 4536, 1050, 922, 441, 11231, 4079, 1112, 2078, 4322, 10331, 3150, 10970, 11580, 4046, 6065, 835, 3570, 4240, 64, 3656, 
+2459, 683, 2503, 9341, 10723, 5782, 6803, 3054, 3123, 1747, 7032, 8455, 4433, 5919, 3329, 4298, 12121, 2692, 5961, 7183, 10327, 1594, 6122, 2555, 5184, 1200, 10929, 8333, 6119, 6992, 1404, 
+325, 948, 11143, 11130, 5990, 4049, 8561, 4077, 4016, 9370, 3762, 652, 6523, 11994, 6190, 3009, 10596, 12115, 11566, 5735, 9634, 5868, 9551, 8974, 11863, 1858, 4754, 347, 2925, 8532, 1975, 
+10232, 6920, 4493, 3202, 5383, 1815, 10777, 11939, 10806, 5915, 49, 1263, 5942, 10706, 9789, 10800, 5333, 2031, 10008, 6413, 8298, 3969, 2767, 12133, 10996, 7552, 5429, 7515, 3772, 418, 5908, 
+11836, 9407, 10484, 10238, 10335, 576, 8326, 9842, 6147, 8174, 3030, 1843, 2361, 12071, 2908, 3529, 3434
+};
+
+
+// Scaled copies and tables for N = 512 and N = 2048, built like the ones for N = 1024 above
+
+const int32_t psi_rev3_ntt512_12289[512] = {
+3, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 
+2859, 7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 
+1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 
+8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 3400, 2399, 5191, 9153, 9273, 243, 3000, 671, 3531, 
+11813, 3985, 7384, 10111, 10745, 6730, 11869, 9042, 2686, 2969, 3978, 8779, 6957, 9424, 2370, 8241, 10040, 9405, 11136, 3186, 5407, 10163, 1630, 3271, 8232, 10600, 
+8925, 4414, 2847, 10115, 4372, 9509, 5195, 7394, 10805, 9984, 7247, 4053, 9644, 12176, 4919, 2166, 8374, 12129, 9140, 7852, 3, 1426, 7635, 10512, 1663, 8653, 4938, 
+2704, 5291, 5277, 1168, 11082, 9041, 2143, 11224, 11885, 4645, 4096, 11796, 5444, 2381, 10911, 1912, 4337, 11854, 4976, 10682, 11414, 8509, 11287, 5011, 8005, 5088, 
+9852, 8643, 9302, 6267, 2422, 6039, 2187, 2566, 10849, 8526, 9223, 27, 7205, 1632, 7404, 1017, 4143, 7575, 12047, 10752, 8585, 2678, 7270, 11744, 3833, 3778, 11899, 
+773, 5101, 11222, 9888, 442, 9377, 6591, 354, 7428, 5012, 2481, 1045, 9430, 8855, 8760, 9381, 218, 9928, 10446, 9259, 4115, 6142, 2447, 3963, 11713, 1954, 2051, 1805, 
+2882, 453, 6381, 11871, 8517, 4774, 6860, 4737, 1293, 156, 9522, 8320, 3991, 5876, 2281, 10258, 6956, 1489, 2500, 1583, 6347, 11026, 12240, 6374, 1483, 350, 1512, 
+10474, 6906, 9087, 7796, 5369, 2057, 10314, 3757, 9364, 11942, 7535, 10431, 426, 3315, 2738, 6421, 2655, 6554, 723, 174, 1693, 9280, 6099, 295, 5766, 11637, 8527, 
+2919, 8273, 8212, 3728, 8240, 6299, 1159, 1146, 11341, 11964, 10885, 5297, 6170, 3956, 1360, 11089, 7105, 9734, 6167, 10695, 1962, 5106, 6328, 9597, 168, 7991, 8960, 
+6370, 7856, 3834, 5257, 10542, 9166, 9235, 5486, 6507, 1566, 2948, 9786, 11606, 9830, 8633, 12225, 8049, 8719, 11454, 6224, 8243, 709, 1319, 9139, 1958, 7967, 10211, 
+11177, 8210, 1058, 11848, 11367, 11239, 7753, 5445, 3860, 9606, 1190, 8471, 6118, 3789, 147, 5456, 7840, 7540, 5537, 4789, 4467, 4075, 5315, 4324, 4916, 10120, 11767, 
+7210, 9027, 1973, 5574, 11011, 2344, 8775, 1041, 1018, 6364, 11821, 8301, 11907, 316, 6950, 5446, 6093, 3710, 10256, 3998, 10367, 8410, 1254, 11316, 5435, 1359, 7083, 
+5529, 9090, 12233, 8724, 11635, 10587, 1987, 6427, 6136, 6874, 3643, 400, 1728, 4948, 6137, 5057, 7591, 3445, 7509, 2049, 7377, 10968, 192, 5241, 9369, 9162, 8120, 
+787, 8807, 1010, 6821, 6415, 677, 6234, 3336, 12237, 9115, 1323, 2766, 12138, 10162, 8332, 9450, 2505, 5906, 10710, 11858, 4782, 6403, 9260, 5594, 8076, 11785, 605, 
+9987, 3600, 3263, 7665, 6077, 421, 8209, 6068, 3602, 11286, 3532, 12048, 12231, 7280, 1956, 11404, 6008, 8851, 2844, 975, 4212, 5681, 8812, 12147, 11184
+};
+
+
+const int32_t psi_rev81_ntt512_12289[512] = {
+81, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 
+2859, 7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 
+1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 
+8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 5777, 3328, 4978, 1351, 4591, 6561, 7266, 5828, 9314, 
+11726, 9283, 2744, 2639, 7468, 9664, 949, 10643, 11077, 6429, 9094, 3542, 3504, 8668, 2545, 1305, 722, 8155, 5736, 12288, 10810, 4043, 7143, 2294, 1062, 3553, 7484, 
+8577, 3135, 2747, 7443, 10963, 5086, 3014, 9088, 11499, 11334, 11119, 2319, 9238, 9923, 9326, 4896, 7969, 1000, 3091, 81, 1635, 9521, 1177, 8034, 140, 10436, 11563, 
+7678, 7300, 6958, 4278, 10616, 8705, 8112, 1381, 2525, 12280, 11267, 11809, 2842, 11950, 2468, 6498, 544, 11462, 5767, 953, 8541, 9813, 118, 7222, 2197, 7935, 12159, 
+5374, 9452, 3949, 3296, 9893, 7837, 10276, 9000, 3241, 729, 10200, 7197, 3284, 2881, 1260, 7901, 5755, 7657, 10593, 10861, 11955, 9863, 5179, 3694, 1759, 8582, 2548, 
+8058, 8907, 11934, 7399, 5911, 9558, 3932, 145, 5542, 3637, 8830, 8855, 8760, 9381, 218, 9928, 10446, 9259, 4115, 6142, 2447, 3963, 11713, 1954, 2051, 1805, 2882, 453, 
+6381, 11871, 8517, 4774, 6860, 4737, 1293, 156, 9522, 8320, 3991, 5876, 2281, 10258, 6956, 1489, 2500, 1583, 6347, 11026, 12240, 6374, 1483, 350, 1512, 10474, 6906, 
+9087, 7796, 5369, 2057, 10314, 3757, 9364, 11942, 7535, 10431, 426, 3315, 2738, 6421, 2655, 6554, 723, 174, 1693, 9280, 6099, 295, 5766, 11637, 8527, 2919, 8273, 8212, 
+3728, 8240, 6299, 1159, 1146, 11341, 11964, 10885, 5297, 6170, 3956, 1360, 11089, 7105, 9734, 6167, 10695, 1962, 5106, 6328, 9597, 168, 7991, 8960, 6370, 7856, 3834, 
+5257, 10542, 9166, 9235, 5486, 6507, 1566, 2948, 9786, 11606, 9830, 8633, 12225, 8049, 8719, 11454, 6224, 8243, 709, 1319, 9139, 1958, 7967, 10211, 11177, 8210, 1058, 
+11848, 11367, 11239, 7753, 5445, 3860, 9606, 1190, 8471, 6118, 3789, 147, 5456, 7840, 7540, 5537, 4789, 4467, 4075, 5315, 4324, 4916, 10120, 11767, 7210, 9027, 1973, 
+5574, 11011, 2344, 8775, 1041, 1018, 6364, 11821, 8301, 11907, 316, 6950, 5446, 6093, 3710, 10256, 3998, 10367, 8410, 1254, 11316, 5435, 1359, 7083, 5529, 9090, 12233, 
+8724, 11635, 10587, 1987, 6427, 6136, 6874, 3643, 400, 1728, 4948, 6137, 5057, 7591, 3445, 7509, 2049, 7377, 10968, 192, 5241, 9369, 9162, 8120, 787, 8807, 1010, 6821, 
+6415, 677, 6234, 3336, 12237, 9115, 1323, 2766, 12138, 10162, 8332, 9450, 2505, 5906, 10710, 11858, 4782, 6403, 9260, 5594, 8076, 11785, 605, 9987, 3600, 3263, 7665, 
+6077, 421, 8209, 6068, 3602, 11286, 3532, 12048, 12231, 7280, 1956, 11404, 6008, 8851, 2844, 975, 4212, 5681, 8812, 12147, 11184
+};
+
+
+const int32_t psi_rev_ntt2048_12289[2048] = {
+1, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 
+2859, 7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 
+1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 
+8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 9326, 4896, 9923, 3051, 3091, 81, 1000, 4320, 1177, 
+8034, 9521, 10654, 11563, 7678, 10436, 12149, 3014, 9088, 5086, 1326, 11119, 2319, 11334, 790, 2747, 7443, 3135, 3712, 1062, 9995, 7484, 8736, 9283, 2744, 11726, 2975, 
+9664, 949, 7468, 9650, 7266, 5828, 6561, 7698, 3328, 6512, 1351, 7311, 8155, 5736, 722, 10984, 4043, 7143, 10810, 1, 8668, 2545, 3504, 8747, 11077, 1646, 9094, 5860, 
+1759, 8582, 3694, 7110, 8907, 11934, 8058, 9741, 9558, 3932, 5911, 4890, 3637, 8830, 5542, 12144, 5755, 7657, 7901, 11029, 11955, 9863, 10861, 1696, 3284, 2881, 7197, 
+2089, 9000, 2013, 729, 9048, 11809, 2842, 11267, 9, 6498, 544, 2468, 339, 1381, 2525, 8112, 3584, 6958, 4989, 10616, 8011, 5374, 9452, 12159, 4354, 9893, 7837, 3296, 
+8340, 7222, 2197, 118, 2476, 5767, 827, 8541, 11336, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 10484, 9407, 11836, 5908, 
+418, 3772, 7515, 5429, 7552, 10996, 12133, 2767, 3969, 8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 10777, 1815, 5383, 3202, 
+4493, 6920, 10232, 1975, 8532, 2925, 347, 4754, 1858, 11863, 8974, 9551, 5868, 9634, 5735, 11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 3762, 9370, 4016, 4077, 
+8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 6992, 6119, 8333, 10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 3329, 5919, 4433, 8455, 
+7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 683, 2459, 3656, 64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 1112, 4079, 11231, 441, 
+922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 8500, 12142, 6833, 4449, 4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 3262, 10316, 6715, 
+1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 5339, 6843, 6196, 8579, 2033, 8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 3199, 56, 3565, 654, 
+1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 7232, 4698, 8844, 4780, 10240, 4912, 1321, 12097, 7048, 2920, 3127, 4169, 11502, 3482, 11279, 5468, 
+5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 9784, 6383, 1579, 431, 7507, 5886, 3029, 6695, 4213, 504, 11684, 2302, 8689, 9026, 4624, 6212, 
+11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 8841, 343, 4538, 1908, 1208, 4727, 7078, 10423, 
+10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 3278, 4209, 6877, 3449, 1136, 3708, 
+3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 125, 540, 8921, 8062, 612, 
+8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 7187, 3975, 4883, 3087, 
+6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 2275, 9828, 5063, 4176, 
+3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 2575, 8881, 10347, 377, 
+4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 20, 5002, 5163, 4608, 
+8946, 8170, 10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 2148, 6330, 3959, 5797, 4913, 3528, 8054, 3825, 8914, 9998, 4335, 
+8896, 9342, 3982, 6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 9389, 12050, 994, 7735, 5464, 7383, 4670, 512, 364, 9929, 3028, 
+5216, 5518, 1226, 7550, 8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 9600, 4605, 8151, 12109, 463, 8882, 8308, 10821, 9247, 10945, 
+9806, 2054, 6203, 6643, 3120, 6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 3723, 845, 1936, 7, 5054, 3154, 3285, 4360, 3805, 11522, 
+2213, 4153, 12239, 12073, 5526, 769, 4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 9656, 1406, 2945, 5349, 7207, 4590, 11607, 11309, 5202, 
+844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 11839, 10345, 578, 6921, 7628, 510, 5386, 2622, 7806, 
+5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 6151, 3469, 4443, 8871, 1555, 1802, 5103, 1891, 
+1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 2276, 11307, 2593, 879, 7899, 8071, 3454, 
+8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 7592, 10588, 3466, 8972, 9757, 3332, 139, 2046, 2940, 10808, 9332, 874, 2301, 5650, 
+12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 3821, 10608, 2929, 6263, 4649, 6320, 9687, 10388, 502, 5118, 8496, 6226, 
+10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 5275, 8449, 10447, 4113, 72, 2828, 4352, 7455, 2712, 11048, 
+7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 4518, 9195, 7469, 11129, 9173, 12100, 1763, 2209, 
+9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939, 4540, 4866, 4546, 1451, 3057, 11240, 3283, 1402, 11004, 4280, 9297, 11161, 8947, 9649, 6095, 
+6668, 11640, 10960, 6350, 2854, 8325, 11386, 1596, 996, 6450, 3286, 12197, 11400, 9459, 4979, 631, 11574, 3428, 6944, 2588, 5773, 2135, 11681, 7362, 344, 7854, 2961, 
+1054, 10452, 898, 930, 6930, 444, 4837, 1725, 8097, 5977, 1955, 3530, 10051, 8028, 6386, 6942, 591, 1570, 2952, 3413, 9972, 1788, 1191, 4162, 2075, 8964, 7994, 1108, 
+328, 5841, 11397, 7944, 5679, 5854, 11461, 4288, 4996, 3395, 6789, 818, 5699, 10856, 9939, 2137, 1653, 11565, 4047, 770, 6927, 8296, 4969, 329, 2848, 9354, 5306, 7192, 
+4436, 10807, 11428, 4637, 3236, 5623, 1990, 6139, 3725, 3803, 5319, 1841, 1033, 3971, 8082, 8370, 925, 3996, 9486, 8045, 2071, 3048, 11003, 2801, 1051, 6015, 4813, 
+3096, 6817, 5363, 1016, 3406, 9127, 5511, 9595, 9499, 3788, 10957, 5884, 1824, 2492, 11257, 4525, 7259, 3746, 10284, 5420, 3752, 10516, 7579, 3433, 2050, 6951, 6925, 
+6424, 1699, 6714, 494, 287, 6647, 7114, 2222, 5228, 2431, 276, 2667, 8490, 9641, 10396, 2145, 11892, 2709, 7501, 9301, 5528, 3727, 3987, 10342, 3118, 3147, 2440, 8083, 
+10940, 7936, 9980, 1331, 10026, 7920, 6293, 4574, 8976, 3384, 11738, 8434, 6319, 6161, 1114, 880, 8621, 6766, 9190, 376, 2583, 10667, 2581, 7709, 11270, 4446, 3002, 
+3629, 3858, 3886, 9136, 6533, 10139, 3001, 4127, 8489, 8409, 443, 6076, 3145, 9514, 301, 11757, 11957, 148, 9979, 3797, 11979, 9671, 11302, 3745, 8805, 7050, 5878, 
+7330, 2172, 7481, 4299, 9835, 8078, 596, 8965, 11305, 7055, 6064, 9975, 12092, 3573, 2484, 11714, 9590, 2104, 7541, 7016, 746, 9613, 11435, 2701, 11802, 4778, 8796, 
+7522, 2138, 3829, 9472, 11917, 9517, 4738, 4494, 10566, 6189, 10515, 11507, 10877, 3353, 6620, 11508, 67, 11599, 11766, 1277, 8466, 10758, 9116, 7137, 11661, 11970, 
+7470, 8959, 2819, 6735, 6975, 9749, 3774, 7905, 4656, 1132, 2924, 7121, 286, 9868, 7729, 6059, 2580, 11168, 1056, 9851, 7164, 11028, 2909, 10577, 11775, 5555, 6793, 
+5427, 1816, 8518, 1897, 7793, 11054, 5260, 603, 6079, 7582, 5599, 10424, 11870, 7038, 2788, 6637, 9418, 5785, 10799, 8310, 2460, 796, 3579, 9071, 6545, 8612, 11919, 
+5775, 8941, 775, 7906, 6135, 12020, 7686, 6953, 9883, 6253, 6859, 940, 1603, 9170, 7663, 2636, 3031, 9504, 10089, 2928, 4784, 8692, 1174, 11976, 4055, 11981, 11450, 
+2789, 8116, 5375, 10931, 2644, 2574, 1738, 2101, 11459, 1330, 793, 5392, 9700, 5037, 9388, 10571, 8893, 3517, 3215, 11431, 7263, 1391, 6401, 4549, 7620, 967, 863, 
+10610, 4373, 3653, 3832, 2299, 7913, 4199, 8297, 6841, 11313, 6598, 1199, 3705, 3783, 3562, 5136, 1542, 7314, 3086, 9121, 8926, 8458, 11469, 4593, 9519, 3167, 1884, 
+957, 2168, 2343, 12088, 2070, 1569, 2230, 4718, 4236, 9943, 10479, 2012, 5875, 802, 1461, 10244, 4186, 9727, 11096, 5169, 6011, 5322, 8316, 10364, 1116, 3838, 3505, 
+10226, 10791, 8767, 939, 124, 924, 2517, 4381, 3196, 8355, 6600, 9357, 1589, 7480, 2820, 2490, 8299, 9910, 8402, 7767, 9467, 8703, 5154, 4357, 4567, 7075, 5986, 8453, 
+4074, 230, 8367, 860, 6173, 807, 1520, 3719, 7218, 5819, 4001, 1110, 7253, 10044, 9964, 4943, 11031, 9654, 10737, 7781, 5595, 1257, 3464, 6341, 1832, 10480, 3491, 
+4470, 11937, 4909, 9901, 8613, 7223, 4667, 8364, 6798, 1840, 6179, 8014, 10278, 11958, 7444, 11021, 7631, 4947, 5546, 5771, 691, 2002, 8179, 4365, 3462, 8074, 305, 
+8691, 7512, 992, 7392, 7847, 10470, 990, 5395, 3644, 1122, 423, 10684, 10271, 6822, 469, 7459, 8628, 11182, 9473, 2405, 5474, 803, 7893, 10056, 3134, 1572, 2367, 
+10106, 3350, 6880, 228, 6456, 12160, 5174, 8588, 9685, 7430, 8880, 8868, 6618, 5978, 2677, 2225, 3498, 12162, 6163, 8928, 5083, 9178, 2745, 4485, 11221, 5709, 10098, 
+3807, 10133, 6416, 11688, 8218, 8910, 4082, 6219, 5729, 12166, 2418, 758, 2783, 7656, 5055, 6455, 10681, 4271, 263, 5551, 877, 9310, 5810, 9699, 3558, 1142, 5425, 
+8948, 11128, 2052, 11814, 11804, 7736, 6904, 11146, 10406, 4646, 6078, 6103, 1859, 9014, 4931, 5572, 4481, 3628, 9592, 5062, 5686, 3918, 4221, 47, 9356, 110, 11523, 
+9963, 9880, 899, 6699, 2887, 7573, 5188, 6549, 2239, 3321, 8448, 5074, 8156, 2201, 10983, 10882, 8177, 10227, 10263, 4724, 6644, 4258, 5614, 1795, 381, 9056, 11103, 
+7812, 2288, 5210, 387, 11605, 8351, 5457, 9319, 8393, 1357, 8923, 11020, 4815, 6054, 2042, 9313, 2402, 1037, 11374, 10794, 356, 10386, 6033, 993, 2246, 3804, 6041, 
+536, 6769, 8105, 10216, 6283, 41, 11483, 7940, 7265, 9737, 10604, 1455, 1370, 3866, 3429, 5649, 10640, 6344, 6269, 10023, 3483, 6133, 1425, 8863, 8303, 1615, 4519, 
+7520, 535, 11915, 12148, 8799, 11959, 2298, 6978, 11135, 1405, 8091, 9392, 9785, 7862, 9825, 5577, 5213, 4824, 11765, 11500, 7925, 9658, 8937, 7148, 10015, 3940, 1610, 
+9413, 369, 5035, 7391, 6368, 4054, 11123, 3204, 7451, 9329, 9333, 10083, 6200, 1803, 12213, 10137, 43, 6468, 5330, 868, 5716, 10274, 6042, 11327, 2726, 1932, 6380, 
+4728, 271, 1829, 1511, 3331, 10949, 3351, 3662, 6674, 2779, 2846, 6396, 8415, 9317, 4791, 7425, 9740, 2752, 1387, 11399, 8432, 9882, 7184, 7440, 6284, 3552, 11742, 
+2061, 11790, 11608, 12167, 3897, 1686, 11216, 2009, 9662, 642, 3265, 10131, 3458, 11893, 4188, 7097, 1657, 1644, 10543, 5155, 5065, 479, 7968, 2444, 1710, 11553, 5177, 
+1938, 2965, 5048, 6569, 6252, 5380, 1637, 190, 2001, 10119, 8408, 11253, 3211, 5515, 7400, 7390, 2154, 2915, 4279, 12095, 5581, 8380, 10910, 433, 5401, 229, 1310, 
+8117, 3631, 12245, 5222, 5846, 5685, 2439, 8264, 7190, 9528, 8718, 4311, 10267, 2507, 8864, 2624, 9861, 5153, 2107, 8565, 9965, 5665, 9726, 3101, 2582, 5156, 6544, 
+8725, 825, 5778, 4807, 935, 6497, 7798, 6160, 6260, 4923, 2885, 2632, 10495, 1098, 6262, 7881, 10363, 2494, 6474, 1915, 1188, 12014, 366, 598, 7231, 3219, 1497, 2043, 
+6106, 10648, 4957, 7159, 2208, 9047, 6475, 3394, 9434, 4871, 9113, 9383, 10852, 674, 7357, 5238, 7318, 9002, 8128, 2670, 11571, 7221, 3026, 2258, 5726, 1633, 10205, 
+2303, 7647, 4033, 11622, 8916, 5390, 8538, 6493, 5438, 10394, 11476, 2886, 4111, 6452, 6244, 2236, 1303, 4556, 3952, 2296, 4020, 7756, 5487, 9119, 5968, 11172, 6972, 
+7583, 7689, 2986, 4543, 4768, 10275, 4417, 7284, 11645, 6066, 10713, 4006, 1184, 6098, 5798, 9809, 3634, 4393, 5382, 8995, 7244, 10157, 9484, 5087, 10692, 9814, 4946, 
+3179, 1396, 132, 8912, 7040, 7523, 4972, 12075, 3008, 8375, 11602, 8359, 227, 4137, 10990, 11727, 4454, 6286, 6510, 11643, 3108, 7378, 11719, 8438, 6467, 5827, 3544, 
+11741, 582, 2378, 2408, 8033, 9633
+};
+
+
+const int32_t psi_rev3_ntt2048_12289[2048] = {
+3, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 
+2859, 7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 
+1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 
+8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 3400, 2399, 5191, 9153, 9273, 243, 3000, 671, 3531, 
+11813, 3985, 7384, 10111, 10745, 6730, 11869, 9042, 2686, 2969, 3978, 8779, 6957, 9424, 2370, 8241, 10040, 9405, 11136, 3186, 5407, 10163, 1630, 3271, 8232, 10600, 
+8925, 4414, 2847, 10115, 4372, 9509, 5195, 7394, 10805, 9984, 7247, 4053, 9644, 12176, 4919, 2166, 8374, 12129, 9140, 7852, 3, 1426, 7635, 10512, 1663, 8653, 4938, 
+2704, 5291, 5277, 1168, 11082, 9041, 2143, 11224, 11885, 4645, 4096, 11796, 5444, 2381, 10911, 1912, 4337, 11854, 4976, 10682, 11414, 8509, 11287, 5011, 8005, 5088, 
+9852, 8643, 9302, 6267, 2422, 6039, 2187, 2566, 10849, 8526, 9223, 27, 7205, 1632, 7404, 1017, 4143, 7575, 12047, 10752, 8585, 2678, 7270, 11744, 3833, 3778, 11899, 
+773, 5101, 11222, 9888, 442, 9377, 6591, 354, 7428, 5012, 2481, 1045, 9430, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 
+10484, 9407, 11836, 5908, 418, 3772, 7515, 5429, 7552, 10996, 12133, 2767, 3969, 8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 
+10777, 1815, 5383, 3202, 4493, 6920, 10232, 1975, 8532, 2925, 347, 4754, 1858, 11863, 8974, 9551, 5868, 9634, 5735, 11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 
+3762, 9370, 4016, 4077, 8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 6992, 6119, 8333, 10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 
+3329, 5919, 4433, 8455, 7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 683, 2459, 3656, 64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 
+1112, 4079, 11231, 441, 922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 8500, 12142, 6833, 4449, 4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 
+3262, 10316, 6715, 1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 5339, 6843, 6196, 8579, 2033, 8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 
+3199, 56, 3565, 654, 1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 7232, 4698, 8844, 4780, 10240, 4912, 1321, 12097, 7048, 2920, 3127, 4169, 11502, 
+3482, 11279, 5468, 5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 9784, 6383, 1579, 431, 7507, 5886, 3029, 6695, 4213, 504, 11684, 2302, 8689, 
+9026, 4624, 6212, 11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 8841, 343, 4538, 1908, 1208, 
+4727, 7078, 10423, 10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 3278, 4209, 6877, 
+3449, 1136, 3708, 3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 125, 
+540, 8921, 8062, 612, 8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 
+7187, 3975, 4883, 3087, 6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 
+2275, 9828, 5063, 4176, 3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 
+2575, 8881, 10347, 377, 4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 
+20, 5002, 5163, 4608, 8946, 8170, 10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 2148, 6330, 3959, 5797, 4913, 3528, 8054, 
+3825, 8914, 9998, 4335, 8896, 9342, 3982, 6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 9389, 12050, 994, 7735, 5464, 7383, 
+4670, 512, 364, 9929, 3028, 5216, 5518, 1226, 7550, 8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 9600, 4605, 8151, 12109, 463, 
+8882, 8308, 10821, 9247, 10945, 9806, 2054, 6203, 6643, 3120, 6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 3723, 845, 1936, 7, 5054, 
+3154, 3285, 4360, 3805, 11522, 2213, 4153, 12239, 12073, 5526, 769, 4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 9656, 1406, 2945, 5349, 
+7207, 4590, 11607, 11309, 5202, 844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 11839, 10345, 578, 6921, 
+7628, 510, 5386, 2622, 7806, 5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 6151, 3469, 4443, 
+8871, 1555, 1802, 5103, 1891, 1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 2276, 11307, 
+2593, 879, 7899, 8071, 3454, 8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 7592, 10588, 3466, 8972, 9757, 3332, 139, 2046, 2940, 
+10808, 9332, 874, 2301, 5650, 12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 3821, 10608, 2929, 6263, 4649, 6320, 9687, 
+10388, 502, 5118, 8496, 6226, 10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 5275, 8449, 10447, 4113, 72, 
+2828, 4352, 7455, 2712, 11048, 7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 4518, 9195, 7469, 
+11129, 9173, 12100, 1763, 2209, 9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939, 4540, 4866, 4546, 1451, 3057, 11240, 3283, 1402, 11004, 4280, 
+9297, 11161, 8947, 9649, 6095, 6668, 11640, 10960, 6350, 2854, 8325, 11386, 1596, 996, 6450, 3286, 12197, 11400, 9459, 4979, 631, 11574, 3428, 6944, 2588, 5773, 2135, 
+11681, 7362, 344, 7854, 2961, 1054, 10452, 898, 930, 6930, 444, 4837, 1725, 8097, 5977, 1955, 3530, 10051, 8028, 6386, 6942, 591, 1570, 2952, 3413, 9972, 1788, 1191, 
+4162, 2075, 8964, 7994, 1108, 328, 5841, 11397, 7944, 5679, 5854, 11461, 4288, 4996, 3395, 6789, 818, 5699, 10856, 9939, 2137, 1653, 11565, 4047, 770, 6927, 8296, 
+4969, 329, 2848, 9354, 5306, 7192, 4436, 10807, 11428, 4637, 3236, 5623, 1990, 6139, 3725, 3803, 5319, 1841, 1033, 3971, 8082, 8370, 925, 3996, 9486, 8045, 2071, 3048, 
+11003, 2801, 1051, 6015, 4813, 3096, 6817, 5363, 1016, 3406, 9127, 5511, 9595, 9499, 3788, 10957, 5884, 1824, 2492, 11257, 4525, 7259, 3746, 10284, 5420, 3752, 10516, 
+7579, 3433, 2050, 6951, 6925, 6424, 1699, 6714, 494, 287, 6647, 7114, 2222, 5228, 2431, 276, 2667, 8490, 9641, 10396, 2145, 11892, 2709, 7501, 9301, 5528, 3727, 3987, 
+10342, 3118, 3147, 2440, 8083, 10940, 7936, 9980, 1331, 10026, 7920, 6293, 4574, 8976, 3384, 11738, 8434, 6319, 6161, 1114, 880, 8621, 6766, 9190, 376, 2583, 10667, 
+2581, 7709, 11270, 4446, 3002, 3629, 3858, 3886, 9136, 6533, 10139, 3001, 4127, 8489, 8409, 443, 6076, 3145, 9514, 301, 11757, 11957, 148, 9979, 3797, 11979, 9671, 
+11302, 3745, 8805, 7050, 5878, 7330, 2172, 7481, 4299, 9835, 8078, 596, 8965, 11305, 7055, 6064, 9975, 12092, 3573, 2484, 11714, 9590, 2104, 7541, 7016, 746, 9613, 
+11435, 2701, 11802, 4778, 8796, 7522, 2138, 3829, 9472, 11917, 9517, 4738, 4494, 10566, 6189, 10515, 11507, 10877, 3353, 6620, 11508, 67, 11599, 11766, 1277, 8466, 
+10758, 9116, 7137, 11661, 11970, 7470, 8959, 2819, 6735, 6975, 9749, 3774, 7905, 4656, 1132, 2924, 7121, 286, 9868, 7729, 6059, 2580, 11168, 1056, 9851, 7164, 11028, 
+2909, 10577, 11775, 5555, 6793, 5427, 1816, 8518, 1897, 7793, 11054, 5260, 603, 6079, 7582, 5599, 10424, 11870, 7038, 2788, 6637, 9418, 5785, 10799, 8310, 2460, 796, 
+3579, 9071, 6545, 8612, 11919, 5775, 8941, 775, 7906, 6135, 12020, 7686, 6953, 9883, 6253, 6859, 940, 1603, 9170, 7663, 2636, 3031, 9504, 10089, 2928, 4784, 8692, 
+1174, 11976, 4055, 11981, 11450, 2789, 8116, 5375, 10931, 2644, 2574, 1738, 2101, 11459, 1330, 793, 5392, 9700, 5037, 9388, 10571, 8893, 3517, 3215, 11431, 7263, 1391, 
+6401, 4549, 7620, 967, 863, 10610, 4373, 3653, 3832, 2299, 7913, 4199, 8297, 6841, 11313, 6598, 1199, 3705, 3783, 3562, 5136, 1542, 7314, 3086, 9121, 8926, 8458, 
+11469, 4593, 9519, 3167, 1884, 957, 2168, 2343, 12088, 2070, 1569, 2230, 4718, 4236, 9943, 10479, 2012, 5875, 802, 1461, 10244, 4186, 9727, 11096, 5169, 6011, 5322, 
+8316, 10364, 1116, 3838, 3505, 10226, 10791, 8767, 939, 124, 924, 2517, 4381, 3196, 8355, 6600, 9357, 1589, 7480, 2820, 2490, 8299, 9910, 8402, 7767, 9467, 8703, 5154, 
+4357, 4567, 7075, 5986, 8453, 4074, 230, 8367, 860, 6173, 807, 1520, 3719, 7218, 5819, 4001, 1110, 7253, 10044, 9964, 4943, 11031, 9654, 10737, 7781, 5595, 1257, 3464, 
+6341, 1832, 10480, 3491, 4470, 11937, 4909, 9901, 8613, 7223, 4667, 8364, 6798, 1840, 6179, 8014, 10278, 11958, 7444, 11021, 7631, 4947, 5546, 5771, 691, 2002, 8179, 
+4365, 3462, 8074, 305, 8691, 7512, 992, 7392, 7847, 10470, 990, 5395, 3644, 1122, 423, 10684, 10271, 6822, 469, 7459, 8628, 11182, 9473, 2405, 5474, 803, 7893, 10056, 
+3134, 1572, 2367, 10106, 3350, 6880, 228, 6456, 12160, 5174, 8588, 9685, 7430, 8880, 8868, 6618, 5978, 2677, 2225, 3498, 12162, 6163, 8928, 5083, 9178, 2745, 4485, 
+11221, 5709, 10098, 3807, 10133, 6416, 11688, 8218, 8910, 4082, 6219, 5729, 12166, 2418, 758, 2783, 7656, 5055, 6455, 10681, 4271, 263, 5551, 877, 9310, 5810, 9699, 
+3558, 1142, 5425, 8948, 11128, 2052, 11814, 11804, 7736, 6904, 11146, 10406, 4646, 6078, 6103, 1859, 9014, 4931, 5572, 4481, 3628, 9592, 5062, 5686, 3918, 4221, 47, 
+9356, 110, 11523, 9963, 9880, 899, 6699, 2887, 7573, 5188, 6549, 2239, 3321, 8448, 5074, 8156, 2201, 10983, 10882, 8177, 10227, 10263, 4724, 6644, 4258, 5614, 1795, 
+381, 9056, 11103, 7812, 2288, 5210, 387, 11605, 8351, 5457, 9319, 8393, 1357, 8923, 11020, 4815, 6054, 2042, 9313, 2402, 1037, 11374, 10794, 356, 10386, 6033, 993, 
+2246, 3804, 6041, 536, 6769, 8105, 10216, 6283, 41, 11483, 7940, 7265, 9737, 10604, 1455, 1370, 3866, 3429, 5649, 10640, 6344, 6269, 10023, 3483, 6133, 1425, 8863, 
+8303, 1615, 4519, 7520, 535, 11915, 12148, 8799, 11959, 2298, 6978, 11135, 1405, 8091, 9392, 9785, 7862, 9825, 5577, 5213, 4824, 11765, 11500, 7925, 9658, 8937, 7148, 
+10015, 3940, 1610, 9413, 369, 5035, 7391, 6368, 4054, 11123, 3204, 7451, 9329, 9333, 10083, 6200, 1803, 12213, 10137, 43, 6468, 5330, 868, 5716, 10274, 6042, 11327, 
+2726, 1932, 6380, 4728, 271, 1829, 1511, 3331, 10949, 3351, 3662, 6674, 2779, 2846, 6396, 8415, 9317, 4791, 7425, 9740, 2752, 1387, 11399, 8432, 9882, 7184, 7440, 
+6284, 3552, 11742, 2061, 11790, 11608, 12167, 3897, 1686, 11216, 2009, 9662, 642, 3265, 10131, 3458, 11893, 4188, 7097, 1657, 1644, 10543, 5155, 5065, 479, 7968, 2444, 
+1710, 11553, 5177, 1938, 2965, 5048, 6569, 6252, 5380, 1637, 190, 2001, 10119, 8408, 11253, 3211, 5515, 7400, 7390, 2154, 2915, 4279, 12095, 5581, 8380, 10910, 433, 
+5401, 229, 1310, 8117, 3631, 12245, 5222, 5846, 5685, 2439, 8264, 7190, 9528, 8718, 4311, 10267, 2507, 8864, 2624, 9861, 5153, 2107, 8565, 9965, 5665, 9726, 3101, 
+2582, 5156, 6544, 8725, 825, 5778, 4807, 935, 6497, 7798, 6160, 6260, 4923, 2885, 2632, 10495, 1098, 6262, 7881, 10363, 2494, 6474, 1915, 1188, 12014, 366, 598, 7231, 
+3219, 1497, 2043, 6106, 10648, 4957, 7159, 2208, 9047, 6475, 3394, 9434, 4871, 9113, 9383, 10852, 674, 7357, 5238, 7318, 9002, 8128, 2670, 11571, 7221, 3026, 2258, 
+5726, 1633, 10205, 2303, 7647, 4033, 11622, 8916, 5390, 8538, 6493, 5438, 10394, 11476, 2886, 4111, 6452, 6244, 2236, 1303, 4556, 3952, 2296, 4020, 7756, 5487, 9119, 
+5968, 11172, 6972, 7583, 7689, 2986, 4543, 4768, 10275, 4417, 7284, 11645, 6066, 10713, 4006, 1184, 6098, 5798, 9809, 3634, 4393, 5382, 8995, 7244, 10157, 9484, 5087, 
+10692, 9814, 4946, 3179, 1396, 132, 8912, 7040, 7523, 4972, 12075, 3008, 8375, 11602, 8359, 227, 4137, 10990, 11727, 4454, 6286, 6510, 11643, 3108, 7378, 11719, 8438, 
+6467, 5827, 3544, 11741, 582, 2378, 2408, 8033, 9633
+};
+
+
+const int32_t psi_rev81_ntt2048_12289[2048] = {
+81, 493, 6845, 9908, 1378, 10377, 7952, 435, 10146, 1065, 404, 7644, 1207, 3248, 11121, 5277, 2437, 3646, 2987, 6022, 9867, 6250, 10102, 9723, 1002, 7278, 4284, 7201, 
+875, 3780, 1607, 4976, 8146, 4714, 242, 1537, 3704, 9611, 5019, 545, 5084, 10657, 4885, 11272, 3066, 12262, 3763, 10849, 2912, 5698, 11935, 4861, 7277, 9808, 11244, 
+2859, 7188, 1067, 2401, 11847, 390, 11516, 8511, 3833, 2780, 7094, 4895, 1484, 2305, 5042, 8236, 2645, 7875, 9442, 2174, 7917, 1689, 3364, 4057, 3271, 10863, 4654, 
+1777, 10626, 3636, 7351, 9585, 6998, 160, 3149, 4437, 12286, 10123, 3915, 7370, 12176, 4048, 2249, 2884, 1153, 9103, 6882, 2126, 10659, 3510, 5332, 2865, 9919, 9320, 
+8311, 9603, 9042, 3016, 12046, 9289, 11618, 7098, 3136, 9890, 3400, 2178, 1544, 5559, 420, 8304, 4905, 476, 3531, 5777, 3328, 4978, 1351, 4591, 6561, 7266, 5828, 9314, 
+11726, 9283, 2744, 2639, 7468, 9664, 949, 10643, 11077, 6429, 9094, 3542, 3504, 8668, 2545, 1305, 722, 8155, 5736, 12288, 10810, 4043, 7143, 2294, 1062, 3553, 7484, 
+8577, 3135, 2747, 7443, 10963, 5086, 3014, 9088, 11499, 11334, 11119, 2319, 9238, 9923, 9326, 4896, 7969, 1000, 3091, 81, 1635, 9521, 1177, 8034, 140, 10436, 11563, 
+7678, 7300, 6958, 4278, 10616, 8705, 8112, 1381, 2525, 12280, 11267, 11809, 2842, 11950, 2468, 6498, 544, 11462, 5767, 953, 8541, 9813, 118, 7222, 2197, 7935, 12159, 
+5374, 9452, 3949, 3296, 9893, 7837, 10276, 9000, 3241, 729, 10200, 7197, 3284, 2881, 1260, 7901, 5755, 7657, 10593, 10861, 11955, 9863, 5179, 3694, 1759, 8582, 2548, 
+8058, 8907, 11934, 7399, 5911, 9558, 3932, 145, 5542, 3637, 8830, 3434, 3529, 2908, 12071, 2361, 1843, 3030, 8174, 6147, 9842, 8326, 576, 10335, 10238, 10484, 9407, 
+11836, 5908, 418, 3772, 7515, 5429, 7552, 10996, 12133, 2767, 3969, 8298, 6413, 10008, 2031, 5333, 10800, 9789, 10706, 5942, 1263, 49, 5915, 10806, 11939, 10777, 1815, 
+5383, 3202, 4493, 6920, 10232, 1975, 8532, 2925, 347, 4754, 1858, 11863, 8974, 9551, 5868, 9634, 5735, 11566, 12115, 10596, 3009, 6190, 11994, 6523, 652, 3762, 9370, 
+4016, 4077, 8561, 4049, 5990, 11130, 11143, 948, 325, 1404, 6992, 6119, 8333, 10929, 1200, 5184, 2555, 6122, 1594, 10327, 7183, 5961, 2692, 12121, 4298, 3329, 5919, 
+4433, 8455, 7032, 1747, 3123, 3054, 6803, 5782, 10723, 9341, 2503, 683, 2459, 3656, 64, 4240, 3570, 835, 6065, 4046, 11580, 10970, 3150, 10331, 4322, 2078, 1112, 4079, 
+11231, 441, 922, 1050, 4536, 6844, 8429, 2683, 11099, 3818, 6171, 8500, 12142, 6833, 4449, 4749, 6752, 7500, 7822, 8214, 6974, 7965, 7373, 2169, 522, 5079, 3262, 
+10316, 6715, 1278, 9945, 3514, 11248, 11271, 5925, 468, 3988, 382, 11973, 5339, 6843, 6196, 8579, 2033, 8291, 1922, 3879, 11035, 973, 6854, 10930, 5206, 6760, 3199, 
+56, 3565, 654, 1702, 10302, 5862, 6153, 5415, 8646, 11889, 10561, 7341, 6152, 7232, 4698, 8844, 4780, 10240, 4912, 1321, 12097, 7048, 2920, 3127, 4169, 11502, 3482, 
+11279, 5468, 5874, 11612, 6055, 8953, 52, 3174, 10966, 9523, 151, 2127, 3957, 2839, 9784, 6383, 1579, 431, 7507, 5886, 3029, 6695, 4213, 504, 11684, 2302, 8689, 9026, 
+4624, 6212, 11868, 4080, 6221, 8687, 1003, 8757, 241, 58, 5009, 10333, 885, 6281, 3438, 9445, 11314, 8077, 6608, 3477, 142, 1105, 8841, 343, 4538, 1908, 1208, 4727, 
+7078, 10423, 10125, 6873, 11573, 10179, 416, 814, 1705, 2450, 8700, 717, 9307, 1373, 8186, 2429, 10568, 10753, 7228, 11071, 438, 8774, 5993, 3278, 4209, 6877, 3449, 
+1136, 3708, 3238, 2926, 1826, 4489, 3171, 8024, 8611, 1928, 464, 3205, 8930, 7080, 1092, 10900, 10221, 11943, 4404, 9126, 4032, 7449, 6127, 8067, 10763, 125, 540, 
+8921, 8062, 612, 8051, 12229, 9572, 9089, 10754, 10029, 68, 6453, 7723, 4781, 4924, 1014, 448, 3942, 5232, 1327, 8682, 3744, 7326, 3056, 9761, 5845, 5588, 412, 7187, 
+3975, 4883, 3087, 6454, 2257, 7784, 5676, 1417, 8400, 11710, 5596, 5987, 9175, 2769, 5966, 212, 6555, 11113, 5508, 11014, 1125, 4860, 10844, 1131, 4267, 6636, 2275, 
+9828, 5063, 4176, 3765, 1518, 8794, 4564, 10224, 5826, 3534, 3961, 4145, 10533, 506, 11034, 6505, 10897, 2674, 10077, 3338, 9013, 3511, 6811, 11111, 2776, 1165, 2575, 
+8881, 10347, 377, 4578, 11914, 10669, 10104, 392, 10453, 425, 9489, 193, 2231, 6197, 1038, 11366, 6204, 8122, 2894, 3654, 10975, 10545, 6599, 2455, 11951, 3947, 20, 
+5002, 5163, 4608, 8946, 8170, 10138, 1522, 8665, 10397, 3344, 5598, 10964, 6565, 11260, 1945, 11041, 9847, 7174, 4939, 2148, 6330, 3959, 5797, 4913, 3528, 8054, 3825, 
+8914, 9998, 4335, 8896, 9342, 3982, 6680, 11653, 7790, 6617, 1737, 622, 10485, 10886, 6195, 7100, 1687, 406, 12143, 5268, 9389, 12050, 994, 7735, 5464, 7383, 4670, 
+512, 364, 9929, 3028, 5216, 5518, 1226, 7550, 8038, 7043, 7814, 11053, 3017, 3121, 7584, 2600, 11232, 6780, 12085, 5219, 1409, 9600, 4605, 8151, 12109, 463, 8882, 
+8308, 10821, 9247, 10945, 9806, 2054, 6203, 6643, 3120, 6105, 8348, 8536, 6919, 8753, 11007, 8717, 9457, 2021, 9060, 4730, 3929, 10583, 3723, 845, 1936, 7, 5054, 3154, 
+3285, 4360, 3805, 11522, 2213, 4153, 12239, 12073, 5526, 769, 4099, 3944, 5604, 5530, 11024, 9282, 2171, 3480, 7434, 8520, 3232, 11996, 9656, 1406, 2945, 5349, 7207, 
+4590, 11607, 11309, 5202, 844, 7082, 4050, 8016, 9068, 9694, 8452, 7000, 5662, 567, 2941, 8619, 3808, 4987, 2373, 5135, 63, 7605, 3360, 11839, 10345, 578, 6921, 7628, 
+510, 5386, 2622, 7806, 5703, 10783, 9224, 11379, 5900, 4719, 11538, 3502, 5789, 10631, 5618, 826, 5043, 3090, 10891, 9951, 7596, 2293, 11872, 6151, 3469, 4443, 8871, 
+1555, 1802, 5103, 1891, 1223, 2334, 7878, 1590, 881, 365, 1927, 11274, 4510, 9652, 2946, 6828, 1280, 614, 10918, 12265, 7250, 6742, 9804, 11385, 2276, 11307, 2593, 
+879, 7899, 8071, 3454, 8531, 3795, 9021, 5776, 1849, 7766, 7988, 457, 8, 530, 9663, 7785, 11511, 3578, 7592, 10588, 3466, 8972, 9757, 3332, 139, 2046, 2940, 10808, 
+9332, 874, 2301, 5650, 12119, 150, 648, 8000, 9982, 9416, 2827, 2434, 11498, 6481, 12268, 9754, 11169, 11823, 11259, 3821, 10608, 2929, 6263, 4649, 6320, 9687, 10388, 
+502, 5118, 8496, 6226, 10716, 8443, 7624, 6883, 9269, 6616, 8620, 5287, 944, 7519, 6125, 1882, 11249, 10254, 5410, 1251, 1790, 5275, 8449, 10447, 4113, 72, 2828, 4352, 
+7455, 2712, 11048, 7911, 3451, 4094, 6508, 3045, 11194, 2643, 1783, 7211, 4974, 7724, 9811, 9449, 3019, 4194, 2730, 6878, 10421, 2253, 4518, 9195, 7469, 11129, 9173, 
+12100, 1763, 2209, 9617, 5170, 865, 1279, 1694, 10759, 8420, 4423, 10555, 3815, 5832, 10939, 4540, 4866, 4546, 1451, 3057, 11240, 3283, 1402, 11004, 4280, 9297, 11161, 
+8947, 9649, 6095, 6668, 11640, 10960, 6350, 2854, 8325, 11386, 1596, 996, 6450, 3286, 12197, 11400, 9459, 4979, 631, 11574, 3428, 6944, 2588, 5773, 2135, 11681, 7362, 
+344, 7854, 2961, 1054, 10452, 898, 930, 6930, 444, 4837, 1725, 8097, 5977, 1955, 3530, 10051, 8028, 6386, 6942, 591, 1570, 2952, 3413, 9972, 1788, 1191, 4162, 2075, 
+8964, 7994, 1108, 328, 5841, 11397, 7944, 5679, 5854, 11461, 4288, 4996, 3395, 6789, 818, 5699, 10856, 9939, 2137, 1653, 11565, 4047, 770, 6927, 8296, 4969, 329, 2848, 
+9354, 5306, 7192, 4436, 10807, 11428, 4637, 3236, 5623, 1990, 6139, 3725, 3803, 5319, 1841, 1033, 3971, 8082, 8370, 925, 3996, 9486, 8045, 2071, 3048, 11003, 2801, 
+1051, 6015, 4813, 3096, 6817, 5363, 1016, 3406, 9127, 5511, 9595, 9499, 3788, 10957, 5884, 1824, 2492, 11257, 4525, 7259, 3746, 10284, 5420, 3752, 10516, 7579, 3433, 
+2050, 6951, 6925, 6424, 1699, 6714, 494, 287, 6647, 7114, 2222, 5228, 2431, 276, 2667, 8490, 9641, 10396, 2145, 11892, 2709, 7501, 9301, 5528, 3727, 3987, 10342, 3118, 
+3147, 2440, 8083, 10940, 7936, 9980, 1331, 10026, 7920, 6293, 4574, 8976, 3384, 11738, 8434, 6319, 6161, 1114, 880, 8621, 6766, 9190, 376, 2583, 10667, 2581, 7709, 
+11270, 4446, 3002, 3629, 3858, 3886, 9136, 6533, 10139, 3001, 4127, 8489, 8409, 443, 6076, 3145, 9514, 301, 11757, 11957, 148, 9979, 3797, 11979, 9671, 11302, 3745, 
+8805, 7050, 5878, 7330, 2172, 7481, 4299, 9835, 8078, 596, 8965, 11305, 7055, 6064, 9975, 12092, 3573, 2484, 11714, 9590, 2104, 7541, 7016, 746, 9613, 11435, 2701, 
+11802, 4778, 8796, 7522, 2138, 3829, 9472, 11917, 9517, 4738, 4494, 10566, 6189, 10515, 11507, 10877, 3353, 6620, 11508, 67, 11599, 11766, 1277, 8466, 10758, 9116, 
+7137, 11661, 11970, 7470, 8959, 2819, 6735, 6975, 9749, 3774, 7905, 4656, 1132, 2924, 7121, 286, 9868, 7729, 6059, 2580, 11168, 1056, 9851, 7164, 11028, 2909, 10577, 
+11775, 5555, 6793, 5427, 1816, 8518, 1897, 7793, 11054, 5260, 603, 6079, 7582, 5599, 10424, 11870, 7038, 2788, 6637, 9418, 5785, 10799, 8310, 2460, 796, 3579, 9071, 
+6545, 8612, 11919, 5775, 8941, 775, 7906, 6135, 12020, 7686, 6953, 9883, 6253, 6859, 940, 1603, 9170, 7663, 2636, 3031, 9504, 10089, 2928, 4784, 8692, 1174, 11976, 
+4055, 11981, 11450, 2789, 8116, 5375, 10931, 2644, 2574, 1738, 2101, 11459, 1330, 793, 5392, 9700, 5037, 9388, 10571, 8893, 3517, 3215, 11431, 7263, 1391, 6401, 4549, 
+7620, 967, 863, 10610, 4373, 3653, 3832, 2299, 7913, 4199, 8297, 6841, 11313, 6598, 1199, 3705, 3783, 3562, 5136, 1542, 7314, 3086, 9121, 8926, 8458, 11469, 4593, 
+9519, 3167, 1884, 957, 2168, 2343, 12088, 2070, 1569, 2230, 4718, 4236, 9943, 10479, 2012, 5875, 802, 1461, 10244, 4186, 9727, 11096, 5169, 6011, 5322, 8316, 10364, 
+1116, 3838, 3505, 10226, 10791, 8767, 939, 124, 924, 2517, 4381, 3196, 8355, 6600, 9357, 1589, 7480, 2820, 2490, 8299, 9910, 8402, 7767, 9467, 8703, 5154, 4357, 4567, 
+7075, 5986, 8453, 4074, 230, 8367, 860, 6173, 807, 1520, 3719, 7218, 5819, 4001, 1110, 7253, 10044, 9964, 4943, 11031, 9654, 10737, 7781, 5595, 1257, 3464, 6341, 1832, 
+10480, 3491, 4470, 11937, 4909, 9901, 8613, 7223, 4667, 8364, 6798, 1840, 6179, 8014, 10278, 11958, 7444, 11021, 7631, 4947, 5546, 5771, 691, 2002, 8179, 4365, 3462, 
+8074, 305, 8691, 7512, 992, 7392, 7847, 10470, 990, 5395, 3644, 1122, 423, 10684, 10271, 6822, 469, 7459, 8628, 11182, 9473, 2405, 5474, 803, 7893, 10056, 3134, 1572, 
+2367, 10106, 3350, 6880, 228, 6456, 12160, 5174, 8588, 9685, 7430, 8880, 8868, 6618, 5978, 2677, 2225, 3498, 12162, 6163, 8928, 5083, 9178, 2745, 4485, 11221, 5709, 
+10098, 3807, 10133, 6416, 11688, 8218, 8910, 4082, 6219, 5729, 12166, 2418, 758, 2783, 7656, 5055, 6455, 10681, 4271, 263, 5551, 877, 9310, 5810, 9699, 3558, 1142, 
+5425, 8948, 11128, 2052, 11814, 11804, 7736, 6904, 11146, 10406, 4646, 6078, 6103, 1859, 9014, 4931, 5572, 4481, 3628, 9592, 5062, 5686, 3918, 4221, 47, 9356, 110, 
+11523, 9963, 9880, 899, 6699, 2887, 7573, 5188, 6549, 2239, 3321, 8448, 5074, 8156, 2201, 10983, 10882, 8177, 10227, 10263, 4724, 6644, 4258, 5614, 1795, 381, 9056, 
+11103, 7812, 2288, 5210, 387, 11605, 8351, 5457, 9319, 8393, 1357, 8923, 11020, 4815, 6054, 2042, 9313, 2402, 1037, 11374, 10794, 356, 10386, 6033, 993, 2246, 3804, 
+6041, 536, 6769, 8105, 10216, 6283, 41, 11483, 7940, 7265, 9737, 10604, 1455, 1370, 3866, 3429, 5649, 10640, 6344, 6269, 10023, 3483, 6133, 1425, 8863, 8303, 1615, 
+4519, 7520, 535, 11915, 12148, 8799, 11959, 2298, 6978, 11135, 1405, 8091, 9392, 9785, 7862, 9825, 5577, 5213, 4824, 11765, 11500, 7925, 9658, 8937, 7148, 10015, 3940, 
+1610, 9413, 369, 5035, 7391, 6368, 4054, 11123, 3204, 7451, 9329, 9333, 10083, 6200, 1803, 12213, 10137, 43, 6468, 5330, 868, 5716, 10274, 6042, 11327, 2726, 1932, 
+6380, 4728, 271, 1829, 1511, 3331, 10949, 3351, 3662, 6674, 2779, 2846, 6396, 8415, 9317, 4791, 7425, 9740, 2752, 1387, 11399, 8432, 9882, 7184, 7440, 6284, 3552, 
+11742, 2061, 11790, 11608, 12167, 3897, 1686, 11216, 2009, 9662, 642, 3265, 10131, 3458, 11893, 4188, 7097, 1657, 1644, 10543, 5155, 5065, 479, 7968, 2444, 1710, 
+11553, 5177, 1938, 2965, 5048, 6569, 6252, 5380, 1637, 190, 2001, 10119, 8408, 11253, 3211, 5515, 7400, 7390, 2154, 2915, 4279, 12095, 5581, 8380, 10910, 433, 5401, 
+229, 1310, 8117, 3631, 12245, 5222, 5846, 5685, 2439, 8264, 7190, 9528, 8718, 4311, 10267, 2507, 8864, 2624, 9861, 5153, 2107, 8565, 9965, 5665, 9726, 3101, 2582, 
+5156, 6544, 8725, 825, 5778, 4807, 935, 6497, 7798, 6160, 6260, 4923, 2885, 2632, 10495, 1098, 6262, 7881, 10363, 2494, 6474, 1915, 1188, 12014, 366, 598, 7231, 3219, 
+1497, 2043, 6106, 10648, 4957, 7159, 2208, 9047, 6475, 3394, 9434, 4871, 9113, 9383, 10852, 674, 7357, 5238, 7318, 9002, 8128, 2670, 11571, 7221, 3026, 2258, 5726, 
+1633, 10205, 2303, 7647, 4033, 11622, 8916, 5390, 8538, 6493, 5438, 10394, 11476, 2886, 4111, 6452, 6244, 2236, 1303, 4556, 3952, 2296, 4020, 7756, 5487, 9119, 5968, 
+11172, 6972, 7583, 7689, 2986, 4543, 4768, 10275, 4417, 7284, 11645, 6066, 10713, 4006, 1184, 6098, 5798, 9809, 3634, 4393, 5382, 8995, 7244, 10157, 9484, 5087, 10692, 
+9814, 4946, 3179, 1396, 132, 8912, 7040, 7523, 4972, 12075, 3008, 8375, 11602, 8359, 227, 4137, 10990, 11727, 4454, 6286, 6510, 11643, 3108, 7378, 11719, 8438, 6467, 
+5827, 3544, 11741, 582, 2378, 2408, 8033, 9633
+};
+
+
+const int32_t omegainv_rev_ntt2048_12289[2048] = {
+8193, 11796, 2381, 5444, 11854, 4337, 1912, 10911, 7012, 1168, 9041, 11082, 4645, 11885, 11224, 2143, 7313, 10682, 8509, 11414, 5088, 8005, 5011, 11287, 2566, 2187, 
+6039, 2422, 6267, 9302, 8643, 9852, 8456, 3778, 773, 11899, 442, 9888, 11222, 5101, 9430, 1045, 2481, 5012, 7428, 354, 6591, 9377, 1440, 8526, 27, 9223, 1017, 7404, 
+1632, 7205, 11744, 7270, 2678, 8585, 10752, 12047, 7575, 4143, 8758, 11813, 7384, 3985, 11869, 6730, 10745, 10111, 8889, 2399, 9153, 5191, 671, 3000, 243, 9273, 3247, 
+2686, 3978, 2969, 2370, 9424, 6957, 8779, 1630, 10163, 5407, 3186, 11136, 9405, 10040, 8241, 113, 4919, 8374, 2166, 3, 7852, 9140, 12129, 5291, 2704, 4938, 8653, 1663, 
+10512, 7635, 1426, 9018, 8232, 8925, 10600, 4372, 10115, 2847, 4414, 9644, 4053, 7247, 9984, 10805, 7394, 5195, 9509, 953, 3748, 11462, 6522, 9813, 12171, 10092, 5067, 
+3949, 8993, 4452, 2396, 7935, 130, 2837, 6915, 4278, 1673, 7300, 5331, 8705, 4177, 9764, 10908, 11950, 9821, 11745, 5791, 12280, 1022, 9447, 480, 3241, 11560, 10276, 
+3289, 10200, 5092, 9408, 9005, 10593, 1428, 2426, 334, 1260, 4388, 4632, 6534, 145, 6747, 3459, 8652, 7399, 6378, 8357, 2731, 2548, 4231, 355, 3382, 5179, 8595, 3707, 
+10530, 6429, 3195, 10643, 1212, 3542, 8785, 9744, 3621, 12288, 1479, 5146, 8246, 1305, 11567, 6553, 4134, 4978, 10938, 5777, 8961, 4591, 5728, 6461, 5023, 2639, 4821, 
+11340, 2625, 9314, 563, 9545, 3006, 3553, 4805, 2294, 11227, 8577, 9154, 4846, 9542, 11499, 955, 9970, 1170, 10963, 7203, 3201, 9275, 140, 1853, 4611, 726, 1635, 2768, 
+4255, 11112, 7969, 11289, 12208, 9198, 9238, 2366, 7393, 2963, 11184, 12147, 8812, 5681, 4212, 975, 2844, 8851, 6008, 11404, 1956, 7280, 12231, 12048, 3532, 11286, 
+3602, 6068, 8209, 421, 6077, 7665, 3263, 3600, 9987, 605, 11785, 8076, 5594, 9260, 6403, 4782, 11858, 10710, 5906, 2505, 9450, 8332, 10162, 12138, 2766, 1323, 9115, 
+12237, 3336, 6234, 677, 6415, 6821, 1010, 8807, 787, 8120, 9162, 9369, 5241, 192, 10968, 7377, 2049, 7509, 3445, 7591, 5057, 6137, 4948, 1728, 400, 3643, 6874, 6136, 
+6427, 1987, 10587, 11635, 8724, 12233, 9090, 5529, 7083, 1359, 5435, 11316, 1254, 8410, 10367, 3998, 10256, 3710, 6093, 5446, 6950, 316, 11907, 8301, 11821, 6364, 
+1018, 1041, 8775, 2344, 11011, 5574, 1973, 9027, 7210, 11767, 10120, 4916, 4324, 5315, 4075, 4467, 4789, 5537, 7540, 7840, 5456, 147, 3789, 6118, 8471, 1190, 9606, 
+3860, 5445, 7753, 11239, 11367, 11848, 1058, 8210, 11177, 10211, 7967, 1958, 9139, 1319, 709, 8243, 6224, 11454, 8719, 8049, 12225, 8633, 9830, 11606, 9786, 2948, 
+1566, 6507, 5486, 9235, 9166, 10542, 5257, 3834, 7856, 6370, 8960, 7991, 168, 9597, 6328, 5106, 1962, 10695, 6167, 9734, 7105, 11089, 1360, 3956, 6170, 5297, 10885, 
+11964, 11341, 1146, 1159, 6299, 8240, 3728, 8212, 8273, 2919, 8527, 11637, 5766, 295, 6099, 9280, 1693, 174, 723, 6554, 2655, 6421, 2738, 3315, 426, 10431, 7535, 
+11942, 9364, 3757, 10314, 2057, 5369, 7796, 9087, 6906, 10474, 1512, 350, 1483, 6374, 12240, 11026, 6347, 1583, 2500, 1489, 6956, 10258, 2281, 5876, 3991, 8320, 9522, 
+156, 1293, 4737, 6860, 4774, 8517, 11871, 6381, 453, 2882, 1805, 2051, 1954, 11713, 3963, 2447, 6142, 4115, 9259, 10446, 9928, 218, 9381, 8760, 8855, 1350, 6457, 8474, 
+1734, 7866, 3869, 1530, 10595, 11010, 11424, 7119, 2672, 10080, 10526, 189, 3116, 1160, 4820, 3094, 7771, 10036, 1868, 5411, 9559, 8095, 9270, 2840, 2478, 4565, 7315, 
+5078, 10506, 9646, 1095, 9244, 5781, 8195, 8838, 4378, 1241, 9577, 4834, 7937, 9461, 12217, 8176, 1842, 3840, 7014, 10499, 11038, 6879, 2035, 1040, 10407, 6164, 4770, 
+11345, 7002, 3669, 5673, 3020, 5406, 4665, 3846, 1573, 6063, 3793, 7171, 11787, 1901, 2602, 5969, 7640, 6026, 9360, 1681, 8468, 1030, 466, 1120, 2535, 21, 5808, 791, 
+9855, 9462, 2873, 2307, 4289, 11641, 12139, 170, 6639, 9988, 11415, 2957, 1481, 9349, 10243, 12150, 8957, 2532, 3317, 8823, 1701, 4697, 8711, 778, 4504, 2626, 11759, 
+12281, 11832, 4301, 4523, 10440, 6513, 3268, 8494, 3758, 8835, 4218, 4390, 11410, 9696, 982, 10013, 904, 2485, 5547, 5039, 24, 1371, 11675, 11009, 5461, 9343, 2637, 
+7779, 1015, 10362, 11924, 11408, 10699, 4411, 9955, 11066, 10398, 7186, 10487, 10734, 3418, 7846, 8820, 6138, 417, 9996, 4693, 2338, 1398, 9199, 7246, 11463, 6671, 
+1658, 6500, 8787, 751, 7570, 6389, 910, 3065, 1506, 6586, 4483, 9667, 6903, 11779, 4661, 5368, 11711, 1944, 450, 8929, 4684, 12226, 7154, 9916, 7302, 8481, 3670, 9348, 
+11722, 6627, 5289, 3837, 2595, 3221, 4273, 8239, 5207, 11445, 7087, 980, 682, 7699, 5082, 6940, 9344, 10883, 2633, 293, 9057, 3769, 4855, 8809, 10118, 3007, 1265, 
+6759, 6685, 8345, 8190, 11520, 6763, 216, 50, 8136, 10076, 767, 8484, 7929, 9004, 9135, 7235, 12282, 10353, 11444, 8566, 1706, 8360, 7559, 3229, 10268, 2832, 3572, 
+1282, 3536, 5370, 3753, 3941, 6184, 9169, 5646, 6086, 10235, 2483, 1344, 3042, 1468, 3981, 3407, 11826, 180, 4138, 7684, 2689, 10880, 7070, 204, 5509, 1057, 9689, 
+4705, 9168, 9272, 1236, 4475, 5246, 4251, 4739, 11063, 6771, 7073, 9261, 2360, 11925, 11777, 7619, 4906, 6825, 4554, 11295, 239, 2900, 7021, 146, 11883, 10602, 5189, 
+6094, 1403, 1804, 11667, 10552, 5672, 4499, 636, 5609, 8307, 2947, 3393, 7954, 2291, 3375, 8464, 4235, 8761, 7376, 6492, 8330, 5959, 10141, 7350, 5115, 2442, 1248, 
+10344, 1029, 5724, 1325, 6691, 8945, 1892, 3624, 10767, 2151, 4119, 3343, 7681, 7126, 7287, 12269, 8342, 338, 9834, 5690, 1744, 1314, 8635, 9395, 4167, 6085, 923, 
+11251, 6092, 10058, 12096, 2800, 11864, 1836, 11897, 2185, 1620, 375, 7711, 11912, 1942, 3408, 9714, 11124, 9513, 1178, 5478, 8778, 3276, 8951, 2212, 9615, 1392, 5784, 
+1255, 11783, 1756, 8144, 8328, 8755, 6463, 2065, 7725, 3495, 10771, 8524, 8113, 7226, 2461, 10014, 5653, 8022, 11158, 1445, 7429, 11164, 1275, 6781, 1176, 5734, 12077, 
+6323, 9520, 3114, 6302, 6693, 579, 3889, 10872, 6613, 4505, 10032, 5835, 9202, 7406, 8314, 5102, 11877, 6701, 6444, 2528, 9233, 4963, 8545, 3607, 10962, 7057, 8347, 
+11841, 11275, 7365, 7508, 4566, 5836, 12221, 2260, 1535, 3200, 2717, 60, 4238, 11677, 4227, 3368, 11749, 12164, 1526, 4222, 6162, 4840, 8257, 3163, 7885, 346, 2068, 
+1389, 11197, 5209, 3359, 9084, 11825, 10361, 3678, 4265, 9118, 7800, 10463, 9363, 9051, 8581, 11153, 8840, 5412, 8080, 9011, 6296, 3515, 11851, 1218, 5061, 1536, 1721, 
+9860, 4103, 10916, 2982, 11572, 3589, 9839, 10584, 11475, 11873, 2110, 716, 5416, 2164, 1866, 5211, 7562, 11081, 10381, 7751, 11946, 3448, 2656, 4256, 9881, 9911, 
+11707, 548, 8745, 6462, 5822, 3851, 570, 4911, 9181, 646, 5779, 6003, 7835, 562, 1299, 8152, 12062, 3930, 687, 3914, 9281, 214, 7317, 4766, 5249, 3377, 12157, 10893, 
+9110, 7343, 2475, 1597, 7202, 2805, 2132, 5045, 3294, 6907, 7896, 8655, 2480, 6491, 6191, 11105, 8283, 1576, 6223, 644, 5005, 7872, 2014, 7521, 7746, 9303, 4600, 4706, 
+5317, 1117, 6321, 3170, 6802, 4533, 8269, 9993, 8337, 7733, 10986, 10053, 6045, 5837, 8178, 9403, 813, 1895, 6851, 5796, 3751, 6899, 3373, 667, 8256, 4642, 9986, 2084, 
+10656, 6563, 10031, 9263, 5068, 718, 9619, 4161, 3287, 4971, 7051, 4932, 11615, 1437, 2906, 3176, 7418, 2855, 8895, 5814, 3242, 10081, 5130, 7332, 1641, 6183, 10246, 
+10792, 9070, 5058, 11691, 11923, 275, 11101, 10374, 5815, 9795, 1926, 4408, 6027, 11191, 1794, 9657, 9404, 7366, 6029, 6129, 4491, 5792, 11354, 7482, 6511, 11464, 
+3564, 5745, 7133, 9707, 9188, 2563, 6624, 2324, 3724, 10182, 7136, 2428, 9665, 3425, 9782, 2022, 7978, 3571, 2761, 5099, 4025, 9850, 6604, 6443, 7067, 44, 8658, 4172, 
+10979, 12060, 6888, 11856, 1379, 3909, 6708, 194, 8010, 9374, 10135, 4899, 4889, 6774, 9078, 1036, 3881, 2170, 10288, 12099, 10652, 6909, 6037, 5720, 7241, 9324, 
+10351, 7112, 736, 10579, 9845, 4321, 11810, 7224, 7134, 1746, 10645, 10632, 5192, 8101, 396, 8831, 2158, 9024, 11647, 2627, 10280, 1073, 10603, 8392, 122, 681, 499, 
+10228, 547, 8737, 6005, 4849, 5105, 2407, 3857, 890, 10902, 9537, 2549, 4864, 7498, 2972, 3874, 5893, 9443, 9510, 5615, 8627, 8938, 1340, 8958, 10778, 10460, 12018, 
+7561, 5909, 10357, 9563, 962, 6247, 2015, 6573, 11421, 6959, 5821, 12246, 2152, 76, 10486, 6089, 2206, 2956, 2960, 4838, 9085, 1166, 8235, 5921, 4898, 7254, 11920, 
+2876, 10679, 8349, 2274, 5141, 3352, 2631, 4364, 789, 524, 7465, 7076, 6712, 2464, 4427, 2504, 2897, 4198, 10884, 1154, 5311, 9991, 330, 3490, 141, 374, 11754, 4769, 
+7770, 10674, 3986, 3426, 10864, 6156, 8806, 2266, 6020, 5945, 1649, 6640, 8860, 8423, 10919, 10834, 1685, 2552, 5024, 4349, 806, 12248, 6006, 2073, 4184, 5520, 11753, 
+6248, 8485, 10043, 11296, 6256, 1903, 11933, 1495, 915, 11252, 9887, 2976, 10247, 6235, 7474, 1269, 3366, 10932, 3896, 2970, 6832, 3938, 684, 11902, 7079, 10001, 4477, 
+1186, 3233, 11908, 10494, 6675, 8031, 5645, 7565, 2026, 2062, 4112, 1407, 1306, 10088, 4133, 7215, 3841, 8968, 10050, 5740, 7101, 4716, 9402, 5590, 11390, 2409, 2326, 
+766, 12179, 2933, 12242, 8068, 8371, 6603, 7227, 2697, 8661, 7808, 6717, 7358, 3275, 10430, 6186, 6211, 7643, 1883, 1143, 5385, 4553, 485, 475, 10237, 1161, 3341, 
+6864, 11147, 8731, 2590, 6479, 2979, 11412, 6738, 12026, 8018, 1608, 5834, 7234, 4633, 9506, 11531, 9871, 123, 6560, 6070, 8207, 3379, 4071, 601, 5873, 2156, 8482, 
+2191, 6580, 1068, 7804, 9544, 3111, 7206, 3361, 6126, 127, 8791, 10064, 9612, 6311, 5671, 3421, 3409, 4859, 2604, 3701, 7115, 129, 5833, 12061, 5409, 8939, 2183, 9922, 
+10717, 9155, 2233, 4396, 11486, 6815, 9884, 2816, 1107, 3661, 4830, 11820, 5467, 2018, 1605, 11866, 11167, 8645, 6894, 11299, 1819, 4442, 4897, 11297, 4777, 3598, 
+11984, 4215, 8827, 7924, 4110, 10287, 11598, 6518, 6743, 7342, 4658, 1268, 4845, 331, 2011, 4275, 6110, 10449, 5491, 3925, 7622, 5066, 3676, 2388, 7380, 352, 7819, 
+8798, 1809, 10457, 5948, 8825, 11032, 6694, 4508, 1552, 2635, 1258, 7346, 2325, 2245, 5036, 11179, 8288, 6470, 5071, 8570, 10769, 11482, 6116, 11429, 3922, 12059, 
+8215, 3836, 6303, 5214, 7722, 7932, 7135, 3586, 2822, 4522, 3887, 2379, 3990, 9799, 9469, 4809, 10700, 2932, 5689, 3934, 9093, 7908, 9772, 11365, 12165, 11350, 3522, 
+1498, 2063, 8784, 8451, 11173, 1925, 3973, 6967, 6278, 7120, 1193, 2562, 8103, 2045, 10828, 11487, 6414, 10277, 1810, 2346, 8053, 7571, 10059, 10720, 10219, 201, 9946, 
+10121, 11332, 10405, 9122, 2770, 7696, 820, 3831, 3363, 3168, 9203, 4975, 10747, 7153, 8727, 8506, 8584, 11090, 5691, 976, 5448, 3992, 8090, 4376, 9990, 8457, 8636, 
+7916, 1679, 11426, 11322, 4669, 7740, 5888, 10898, 5026, 858, 9074, 8772, 3396, 1718, 2901, 7252, 2589, 6897, 11496, 10959, 830, 10188, 10551, 9715, 9645, 1358, 6914, 
+4173, 9500, 839, 308, 8234, 313, 11115, 3597, 7505, 9361, 2200, 2785, 9258, 9653, 4626, 3119, 10686, 11349, 5430, 6036, 2406, 5336, 4603, 269, 6154, 4383, 11514, 3348, 
+6514, 370, 3677, 5744, 3218, 8710, 11493, 9829, 3979, 1490, 6504, 2871, 5652, 9501, 5251, 419, 1865, 6690, 4707, 6210, 11686, 7029, 1235, 4496, 10392, 3771, 10473, 
+6862, 5496, 6734, 514, 1712, 9380, 1261, 5125, 2438, 11233, 1121, 9709, 6230, 4560, 2421, 12003, 5168, 9365, 11157, 7633, 4384, 8515, 2540, 5314, 5554, 9470, 3330, 
+4819, 319, 628, 5152, 3173, 1531, 3823, 11012, 523, 690, 12222, 781, 5669, 8936, 1412, 782, 1774, 6100, 1723, 7795, 7551, 2772, 372, 2817, 8460, 10151, 4767, 3493, 
+7511, 487, 9588, 854, 2676, 11543, 5273, 4748, 10185, 2699, 575, 9805, 8716, 197, 2314, 6225, 5234, 984, 3324, 11693, 4211, 2454, 7990, 4808, 10117, 4959, 6411, 5239, 
+3484, 8544, 987, 2618, 310, 8492, 2310, 12141, 332, 532, 11988, 2775, 9144, 6213, 11846, 3880, 3800, 8162, 9288, 2150, 5756, 3153, 8403, 8431, 8660, 9287, 7843, 1019, 
+4580, 9708, 1622, 9706, 11913, 3099, 5523, 3668, 11409, 11175, 6128, 5970, 3855, 551, 8905, 3313, 7715, 5996, 4369, 2263, 10958, 2309, 4353, 1349, 4206, 9849, 9142, 
+9171, 1947, 8302, 8562, 6761, 2988, 4788, 9580, 397, 10144, 1893, 2648, 3799, 9622, 12013, 9858, 7061, 10067, 5175, 5642, 12002, 11795, 5575, 10590, 5865, 5364, 5338, 
+10239, 8856, 4710, 1773, 8537, 6869, 2005, 8543, 5030, 7764, 1032, 9797, 10465, 6405, 1332, 8501, 2790, 2694, 6778, 3162, 8883, 11273, 6926, 5472, 9193, 7476, 6274, 
+11238, 9488, 1286, 9241, 10218, 4244, 2803, 8293, 11364, 3919, 4207, 8318, 11256, 10448, 6970, 8486, 8564, 6150, 10299, 6666, 9053, 7652, 861, 1482, 7853, 5097, 6983, 
+2935, 9441, 11960, 7320, 3993, 5362, 11519, 8242, 724, 10636, 10152, 2350, 1433, 6590, 11471, 5500, 8894, 7293, 8001, 828, 6435, 6610, 4345, 892, 6448, 11961, 11181, 
+4295, 3325, 10214, 8127, 11098, 10501, 2317, 8876, 9337, 10719, 11698, 5347, 5903, 4261, 2238, 8759, 10334, 6312, 4192, 10564, 7452, 11845, 5359, 11359, 11391, 1837, 
+11235, 9328, 4435, 11945, 4927, 608, 10154, 6516, 9701, 5345, 8861, 715, 11658, 7310, 2830, 889, 92, 9003, 5839, 11293, 10693, 903, 3964, 9435, 5939, 1329, 649, 5621, 
+6194, 2640, 3342, 1128, 2992, 8009, 1285, 10887, 9006, 1049, 9232, 10838, 7743, 7423, 7749
+};
+
+
+// Parameter sets of the key exchange: ring dimension, NTT tables and sizes of the messages and of the shared key
+
+const LatticeCryptoParams params_ntt512_12289 = {
+    512, NOISE_K, psi_rev_ntt512_12289, psi_rev3_ntt512_12289, psi_rev81_ntt512_12289, omegainv_rev_ntt512_12289, 
+    omegainv10N_rev_ntt512_12289, Ninv11_ntt512_12289, PKA_BYTES_512, PKB_BYTES_512, SHAREDKEY_BYTES_512
+};
+
+const LatticeCryptoParams params_ntt1024_12289 = {
+    1024, NOISE_K, psi_rev_ntt1024_12289, psi_rev3_ntt1024_12289, psi_rev81_ntt1024_12289, omegainv_rev_ntt1024_12289, 
+    omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PKA_BYTES, PKB_BYTES, SHAREDKEY_BYTES
+};
+
+const LatticeCryptoParams params_ntt2048_12289 = {
+    2048, NOISE_K, psi_rev_ntt2048_12289, psi_rev3_ntt2048_12289, psi_rev81_ntt2048_12289, omegainv_rev_ntt2048_12289, 
+    omegainv10N_rev_ntt2048_12289, Ninv11_ntt2048_12289, PKA_BYTES_2048, PKB_BYTES_2048, SHAREDKEY_BYTES_2048
+};
+
+
+// The default parameter set with narrower noise, psi_8 and psi_4, which takes 2/3 and 1/3 of the error stream
+const LatticeCryptoParams params_ntt1024_12289_psi8 = {
+    1024, 8, psi_rev_ntt1024_12289, psi_rev3_ntt1024_12289, psi_rev81_ntt1024_12289, omegainv_rev_ntt1024_12289, 
+    omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PKA_BYTES, PKB_BYTES, SHAREDKEY_BYTES
+};
+
+const LatticeCryptoParams params_ntt1024_12289_psi4 = {
+    1024, 4, psi_rev_ntt1024_12289, psi_rev3_ntt1024_12289, psi_rev81_ntt1024_12289, omegainv_rev_ntt1024_12289, 
+    omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PKA_BYTES, PKB_BYTES, SHAREDKEY_BYTES
+};
+
+// 16-bit versions for the Montgomery arithmetic of NTT_CT_std2rev_12289_int16 and INTT_GS_rev2std_12289_int16: each constant is
+// multiplied by 3 (the scaling left by reduce12289) and by the Montgomery factor 2^16, and is centered in [-q/2, q/2].
+const int16_t Ninv8_ntt1024_12289_int16 = 1579;
+const int16_t omegainv7N_rev_ntt1024_12289_int16 = -431;
+const int16_t Ninv11_ntt1024_12289_int16 = -4493;
+const int16_t omegainv10N_rev_ntt1024_12289_int16 = -3202;
+
+
+// 16-bit versions of the tables above, scaled in the same way. The entries 16 to 31 of omegainv_rev_ntt1024_12289_int16 are multiplied 
+// by 9 instead of 3, since stage m=32 of INTT_GS_rev2std_12289 applies one extra reduction. Entry 0 of psi_rev_ntt1024_12289_int16
+// is the factor 3*2^16 that stage m=1 of NTT_CT_std2rev_12289_int16 applies to all coefficients.
+
+const int16_t psi_rev_ntt1024_12289_int16[1024] = {
+-16, 4401, 1081, 1229, 2530, 6014, -4342, 5329, -2579, -4751, 5825, 586, 5266, -2812, -5890, 1591, -2125, 3109, 1364, 1960, 1885, -1688, -1875, 4189, -3743, -5847, 5190, -4615, 
+-1711, 965, -1134, -5882, 4843, -1690, -3872, -14, 2181, 5981, 5719, 3569, 4679, 1534, -4426, 3983, 100, 432, 1237, -1538, 2564, -5145, 5664, -4042, -5831, 2829, 4431, 3412, 
+-4407, -4783, -1549, -5217, 6049, 79, -997, 117, 4676, -2903, -4586, 834, -13, 5351, 3403, -5453, -3110, -3604, 2083, -3782, -2446, -4668, -3467, -3180, -1762, -730, -3854, 2030, 
+3269, 5274, -5892, -1367, -2560, -1228, 2742, 48, -2211, -1195, 4970, 1808, -3323, 883, 3012, 6130, 1820, 489, 2851, 1502, 5285, 711, 3316, 1053, -1652, 2203, 6109, 2796, 
+900, 3888, -1156, -1553, -2967, -1020, 1517, -5244, 2019, -126, -2921, 5569, 2315, -4746, 4673, 4949, -1748, -4602, 989, 340, -300, -1296, -3711, 4614, 5746, -5654, -4868, 1582, 
+-673, 42, 5070, 2240, 932, 2060, 4647, 3362, -5858, -237, 2991, -351, 5204, 3802, -1004, 2053, -4703, -163, 3146, -4597, -1060, 5252, -3281, 1556, 5133, -2895, 3402, 5357, 
+-5655, 5064, 5625, -278, -4092, -5880, 2962, 5914, 4699, -5753, 737, -3698, -3243, -3687, -914, -16, -3509, -3853, 5381, -4773, -5186, -1758, 1964, 4552, -3566, -2133, 2341, -3159, 
+4956, 5680, -6038, 3901, -5460, -1467, 3736, -4506, 3253, -6101, -2649, 2320, -6057, 378, -3526, -4418, 5344, 1949, -1730, -2558, -3388, 3060, -4551, 3443, 3468, 4659, 625, 2700, 
+-4609, 3684, 4063, -144, -5656, 3585, -2621, -5424, 2482, -3533, 5387, 4101, -727, -6090, 2190, -5286, 39, -3764, 2080, 4070, 1469, -2502, -3580, 1739, -4951, 1715, -1888, -2749, 
+6040, -943, -1477, 2959, -5788, 4981, 2628, 3488, -909, -4910, 676, 4395, -40, 2285, 1963, 3073, -5603, -4051, 4302, -3044, -5041, 3784, 5601, 1093, 2650, -841, 2058, -3890, 
+2496, 4884, -2059, 2411, -4296, -371, 4371, 695, -754, 3133, 750, 3240, 4370, -784, 3672, -850, 5600, -386, -4462, -105, -2076, 1846, -119, -3955, 5267, -1333, 2356, -5552, 
+-2330, -5150, -5473, 3884, -5348, 4424, 5613, -5737, -721, 2784, 2510, 1012, -728, 4720, -6056, 1857, 1253, -2452, -2811, -3787, -1797, -3339, 2472, -6034, 6047, -2879, -5200, 2114, 
+-1271, 408, 1851, -2818, 5378, 3079, -4013, 360, -926, -5475, -4327, 2936, 6084, 2688, 4966, -4108, 3608, 2806, -101, -1911, -3374, -812, 292, 1753, 5800, 478, -1988, -3181, 
+1361, -2477, 2949, -1024, 5894, 4325, -1071, 1272, -3291, -945, -3474, -1244, -5539, 4582, 3619, -5503, -3819, 4639, 5233, -2463, -4511, 1158, 1097, 315, -6061, -5538, 357, -424, 
+-821, 2352, 1273, 2550, -2250, 2569, 2890, -2262, 3755, -983, -4550, 4922, 2163, 3937, 4759, -3036, -5299, 3161, 4130, 637, 5221, 4367, 3999, 3512, 4801, -2363, -6112, 5056, 
+599, 1113, -824, -2085, 4339, 2523, 6115, -619, -4514, -3279, 937, -2834, 2727, 2441, -2028, -896, 4405, 1825, -2654, -5075, 4520, -136, -617, -3157, -5889, 3070, 5434, -120, 
+-5111, -1434, 5964, -2746, -4083, -4858, 3442, 3072, -2167, 2436, -876, -5259, 303, 5733, 3871, -1465, 4328, -1457, 1432, 4220, -832, -1628, -3410, -4900, -2416, 2835, -1867, 3732, 
+3213, -3816, -686, 5393, 2778, 4136, 692, 3481, -5963, 4225, -2609, 35, -3845, 3052, -250, -1080, -5553, -3835, -1224, -3813, -3759, -4933, -3856, -928, 5879, -5571, -1871, -2184, 
+-5852, -3652, 3311, 5947, 4873, 5813, -2272, -5391, 6012, -5488, 1126, -5950, 5250, -1898, -2647, 5278, -2243, 633, -833, -3107, 5633, -735, -2702, -2333, -4021, 817, -1444, 2610, 
+4203, -1997, 2958, -2, -5047, -5090, 5281, -5205, 2424, -3292, -5899, 569, -6028, -5887, 2117, -2652, 2340, -4638, 1910, -1580, -5494, -2597, 6019, 4865, -2124, 4588, -2679, -5183, 
+-2354, -3779, 5536, 3270, 1452, -3067, 3706, 280, 6107, -162, -2000, 3649, 4732, -6102, 2497, -5926, 960, -5684, 2044, -18, -707, -1088, -4936, -678, -2762, -5050, -3935, 5121, 
+-1627, 2311, 3346, -3733, 1541, 5674, 260, 3581, 4792, -3385, 5697, -4391, -2155, -4394, -236, -4952, 755, -1654, -4793, 1906, 779, -3025, -3513, 2520, 668, 4852, 2856, -3392, 
+5721, -5762, -2105, -4178, -5711, -4026, -1458, -5807, 5462, 4425, 467, 2509, 5015, -5371, 1205, 290, -5525, 710, -3827, 5096, 4901, -1931, -4875, 3518, 4193, -4498, -5768, -2306, 
+-5917, -1475, -4252, 3260, 5269, 1625, -5730, 4740, 5938, -4333, 5372, -5795, -6032, 486, 6000, 1342, -1907, 6017, 4798, 5489, -4356, -3088, 1171, -840, -4319, 2479, -952, 5227, 
+2852, 2981, -3554, 3326, 5017, -2413, 5408, -1707, -320, 5991, 3415, 6, 4332, 4459, -2451, 226, -3461, 5694, -4348, -3545, -3378, 5561, 4175, 5747, -4610, 2205, -4183, -5290, 
+2499, -2968, -1899, 5560, -4874, 4997, -5974, 245, 4844, -211, 4374, 5132, -2004, -2267, 3721, -2113, -1750, 4729, -3214, 2337, 4286, -2130, -808, -2999, -2414, 5793, 2336, 1735, 
+-2756, 3824, -3615, -870, -1401, 4762, -986, 4097, -5824, 893, 708, 2567, -2265, 4962, 2090, -5718, -2087, -2134, -4802, 884, -780, 1546, -4733, 4623, 2121, 3264, 2519, 2034, 
+-6132, 54, 4763, 2880, 4881, 5356, 2251, -1090, -484, -3074, 2861, 4003, -936, 4313, -764, 632, 1611, -1397, -103, -4869, -4066, -4293, -3844, 4531, 2508, -1946, -1419, 2718, 
+1877, -1231, 5891, -112, 5159, -1308, -3404, 3974, 565, -17, 1459, -5003, 800, 3456, -2393, -15, -4139, -1659, -3641, -2457, -4338, -1044, 2131, 5765, 3946, -1141, -2556, 4688, 
+5261, 2082, 2036, 439, -4711, 294, -1377, 3391, 2791, -1215, -2711, -3355, -5366, 2380, 4653, -53, -1399, -4569, 3217, 2100, -2725, 517, -6058, -1101, 3863, -1008, 1210, -4604, 
+-5089, -5763, 3041, -135, 842, 4129, -153, -5085, -2006, -5225, -482, -116, 2271, 3912, -1770, -273, 5413, 5688, 1950, -3865, -927, 5335, -284, -2210, 541, 1354, 179, -5617, 
+-104, 5941, 2646, 5532, -302, -4254, 4375, -5678, 5010, -477, -3158, -862, -1807, -5840, 6035, 3951, 1574, 5325, 2020, 1353, 4098, 2465, -2642, 384, -5399, 2729, 2893, 2175, 
+451, 3423, -4621, -1775, -3494, 6043, -6108, -1317, 725, 3132, 5896, -5006, -1366, -4918, 4977, -128, 3809, 5149, -1670, 159, 4197, 1418, 2638, 5989, 3916, 3645, -4156, -2224, 
+4131, 2116, -882, -1844, -1695, 51, -4377, 2720, -2400, 1921, -5110, 45, -3188, 3924, -2077, 367, -5384, 336, 3693, 5631, -4833, 4191, 309, 2318, 2292, -1896, -650, -2808, 
+4765, 5838, 4257, 4135, -757, -1304, 590, 91, 906, 473, -836, 4745, -2741, 1431, -2815, 2586, 312, -5534, 4351, -4307, -537, 4562, -4062, 1623, -5, 4894, -4363, -1152, 
+3908, 4102, 3610, 5764, -4722, -3686, -6060, -4059, -5816, 436, 5231, -5421, -3950, -4775, -5850, -694, 2781, -3716, 852, -5659, 5476, 553, 5310, 819, 1446, 348, 3386, -6018, 
+700, 3024, -3630, 1523, 5885, 3303, -1551, 4114, -2526, -98, 459, 2966, 3166, 405, 5000, -2978
+};
+
+
+// Copies of psi_rev_ntt1024_12289_int16 that also scale the transform by 3 and 81. Only entry 0 differs, since it holds
+// the Montgomery factor that stage m=1 applies to all coefficients.
+
+const int16_t psi_rev3_ntt1024_12289_int16[1024] = {
+-48, 4401, 1081, 1229, 2530, 6014, -4342, 5329, -2579, -4751, 5825, 586, 5266, -2812, -5890, 1591, -2125, 3109, 1364, 1960, 1885, -1688, -1875, 4189, -3743, -5847, 5190, -4615, 
+-1711, 965, -1134, -5882, 4843, -1690, -3872, -14, 2181, 5981, 5719, 3569, 4679, 1534, -4426, 3983, 100, 432, 1237, -1538, 2564, -5145, 5664, -4042, -5831, 2829, 4431, 3412, 
+-4407, -4783, -1549, -5217, 6049, 79, -997, 117, 4676, -2903, -4586, 834, -13, 5351, 3403, -5453, -3110, -3604, 2083, -3782, -2446, -4668, -3467, -3180, -1762, -730, -3854, 2030, 
+3269, 5274, -5892, -1367, -2560, -1228, 2742, 48, -2211, -1195, 4970, 1808, -3323, 883, 3012, 6130, 1820, 489, 2851, 1502, 5285, 711, 3316, 1053, -1652, 2203, 6109, 2796, 
+900, 3888, -1156, -1553, -2967, -1020, 1517, -5244, 2019, -126, -2921, 5569, 2315, -4746, 4673, 4949, -1748, -4602, 989, 340, -300, -1296, -3711, 4614, 5746, -5654, -4868, 1582, 
+-673, 42, 5070, 2240, 932, 2060, 4647, 3362, -5858, -237, 2991, -351, 5204, 3802, -1004, 2053, -4703, -163, 3146, -4597, -1060, 5252, -3281, 1556, 5133, -2895, 3402, 5357, 
+-5655, 5064, 5625, -278, -4092, -5880, 2962, 5914, 4699, -5753, 737, -3698, -3243, -3687, -914, -16, -3509, -3853, 5381, -4773, -5186, -1758, 1964, 4552, -3566, -2133, 2341, -3159, 
+4956, 5680, -6038, 3901, -5460, -1467, 3736, -4506, 3253, -6101, -2649, 2320, -6057, 378, -3526, -4418, 5344, 1949, -1730, -2558, -3388, 3060, -4551, 3443, 3468, 4659, 625, 2700, 
+-4609, 3684, 4063, -144, -5656, 3585, -2621, -5424, 2482, -3533, 5387, 4101, -727, -6090, 2190, -5286, 39, -3764, 2080, 4070, 1469, -2502, -3580, 1739, -4951, 1715, -1888, -2749, 
+6040, -943, -1477, 2959, -5788, 4981, 2628, 3488, -909, -4910, 676, 4395, -40, 2285, 1963, 3073, -5603, -4051, 4302, -3044, -5041, 3784, 5601, 1093, 2650, -841, 2058, -3890, 
+2496, 4884, -2059, 2411, -4296, -371, 4371, 695, -754, 3133, 750, 3240, 4370, -784, 3672, -850, 5600, -386, -4462, -105, -2076, 1846, -119, -3955, 5267, -1333, 2356, -5552, 
+-2330, -5150, -5473, 3884, -5348, 4424, 5613, -5737, -721, 2784, 2510, 1012, -728, 4720, -6056, 1857, 1253, -2452, -2811, -3787, -1797, -3339, 2472, -6034, 6047, -2879, -5200, 2114, 
+-1271, 408, 1851, -2818, 5378, 3079, -4013, 360, -926, -5475, -4327, 2936, 6084, 2688, 4966, -4108, 3608, 2806, -101, -1911, -3374, -812, 292, 1753, 5800, 478, -1988, -3181, 
+1361, -2477, 2949, -1024, 5894, 4325, -1071, 1272, -3291, -945, -3474, -1244, -5539, 4582, 3619, -5503, -3819, 4639, 5233, -2463, -4511, 1158, 1097, 315, -6061, -5538, 357, -424, 
+-821, 2352, 1273, 2550, -2250, 2569, 2890, -2262, 3755, -983, -4550, 4922, 2163, 3937, 4759, -3036, -5299, 3161, 4130, 637, 5221, 4367, 3999, 3512, 4801, -2363, -6112, 5056, 
+599, 1113, -824, -2085, 4339, 2523, 6115, -619, -4514, -3279, 937, -2834, 2727, 2441, -2028, -896, 4405, 1825, -2654, -5075, 4520, -136, -617, -3157, -5889, 3070, 5434, -120, 
+-5111, -1434, 5964, -2746, -4083, -4858, 3442, 3072, -2167, 2436, -876, -5259, 303, 5733, 3871, -1465, 4328, -1457, 1432, 4220, -832, -1628, -3410, -4900, -2416, 2835, -1867, 3732, 
+3213, -3816, -686, 5393, 2778, 4136, 692, 3481, -5963, 4225, -2609, 35, -3845, 3052, -250, -1080, -5553, -3835, -1224, -3813, -3759, -4933, -3856, -928, 5879, -5571, -1871, -2184, 
+-5852, -3652, 3311, 5947, 4873, 5813, -2272, -5391, 6012, -5488, 1126, -5950, 5250, -1898, -2647, 5278, -2243, 633, -833, -3107, 5633, -735, -2702, -2333, -4021, 817, -1444, 2610, 
+4203, -1997, 2958, -2, -5047, -5090, 5281, -5205, 2424, -3292, -5899, 569, -6028, -5887, 2117, -2652, 2340, -4638, 1910, -1580, -5494, -2597, 6019, 4865, -2124, 4588, -2679, -5183, 
+-2354, -3779, 5536, 3270, 1452, -3067, 3706, 280, 6107, -162, -2000, 3649, 4732, -6102, 2497, -5926, 960, -5684, 2044, -18, -707, -1088, -4936, -678, -2762, -5050, -3935, 5121, 
+-1627, 2311, 3346, -3733, 1541, 5674, 260, 3581, 4792, -3385, 5697, -4391, -2155, -4394, -236, -4952, 755, -1654, -4793, 1906, 779, -3025, -3513, 2520, 668, 4852, 2856, -3392, 
+5721, -5762, -2105, -4178, -5711, -4026, -1458, -5807, 5462, 4425, 467, 2509, 5015, -5371, 1205, 290, -5525, 710, -3827, 5096, 4901, -1931, -4875, 3518, 4193, -4498, -5768, -2306, 
+-5917, -1475, -4252, 3260, 5269, 1625, -5730, 4740, 5938, -4333, 5372, -5795, -6032, 486, 6000, 1342, -1907, 6017, 4798, 5489, -4356, -3088, 1171, -840, -4319, 2479, -952, 5227, 
+2852, 2981, -3554, 3326, 5017, -2413, 5408, -1707, -320, 5991, 3415, 6, 4332, 4459, -2451, 226, -3461, 5694, -4348, -3545, -3378, 5561, 4175, 5747, -4610, 2205, -4183, -5290, 
+2499, -2968, -1899, 5560, -4874, 4997, -5974, 245, 4844, -211, 4374, 5132, -2004, -2267, 3721, -2113, -1750, 4729, -3214, 2337, 4286, -2130, -808, -2999, -2414, 5793, 2336, 1735, 
+-2756, 3824, -3615, -870, -1401, 4762, -986, 4097, -5824, 893, 708, 2567, -2265, 4962, 2090, -5718, -2087, -2134, -4802, 884, -780, 1546, -4733, 4623, 2121, 3264, 2519, 2034, 
+-6132, 54, 4763, 2880, 4881, 5356, 2251, -1090, -484, -3074, 2861, 4003, -936, 4313, -764, 632, 1611, -1397, -103, -4869, -4066, -4293, -3844, 4531, 2508, -1946, -1419, 2718, 
+1877, -1231, 5891, -112, 5159, -1308, -3404, 3974, 565, -17, 1459, -5003, 800, 3456, -2393, -15, -4139, -1659, -3641, -2457, -4338, -1044, 2131, 5765, 3946, -1141, -2556, 4688, 
+5261, 2082, 2036, 439, -4711, 294, -1377, 3391, 2791, -1215, -2711, -3355, -5366, 2380, 4653, -53, -1399, -4569, 3217, 2100, -2725, 517, -6058, -1101, 3863, -1008, 1210, -4604, 
+-5089, -5763, 3041, -135, 842, 4129, -153, -5085, -2006, -5225, -482, -116, 2271, 3912, -1770, -273, 5413, 5688, 1950, -3865, -927, 5335, -284, -2210, 541, 1354, 179, -5617, 
+-104, 5941, 2646, 5532, -302, -4254, 4375, -5678, 5010, -477, -3158, -862, -1807, -5840, 6035, 3951, 1574, 5325, 2020, 1353, 4098, 2465, -2642, 384, -5399, 2729, 2893, 2175, 
+451, 3423, -4621, -1775, -3494, 6043, -6108, -1317, 725, 3132, 5896, -5006, -1366, -4918, 4977, -128, 3809, 5149, -1670, 159, 4197, 1418, 2638, 5989, 3916, 3645, -4156, -2224, 
+4131, 2116, -882, -1844, -1695, 51, -4377, 2720, -2400, 1921, -5110, 45, -3188, 3924, -2077, 367, -5384, 336, 3693, 5631, -4833, 4191, 309, 2318, 2292, -1896, -650, -2808, 
+4765, 5838, 4257, 4135, -757, -1304, 590, 91, 906, 473, -836, 4745, -2741, 1431, -2815, 2586, 312, -5534, 4351, -4307, -537, 4562, -4062, 1623, -5, 4894, -4363, -1152, 
+3908, 4102, 3610, 5764, -4722, -3686, -6060, -4059, -5816, 436, 5231, -5421, -3950, -4775, -5850, -694, 2781, -3716, 852, -5659, 5476, 553, 5310, 819, 1446, 348, 3386, -6018, 
+700, 3024, -3630, 1523, 5885, 3303, -1551, 4114, -2526, -98, 459, 2966, 3166, 405, 5000, -2978
+};
+
+
+const int16_t psi_rev81_ntt1024_12289_int16[1024] = {
+-1296, 4401, 1081, 1229, 2530, 6014, -4342, 5329, -2579, -4751, 5825, 586, 5266, -2812, -5890, 1591, -2125, 3109, 1364, 1960, 1885, -1688, -1875, 4189, -3743, -5847, 5190, -4615, 
+-1711, 965, -1134, -5882, 4843, -1690, -3872, -14, 2181, 5981, 5719, 3569, 4679, 1534, -4426, 3983, 100, 432, 1237, -1538, 2564, -5145, 5664, -4042, -5831, 2829, 4431, 3412, 
+-4407, -4783, -1549, -5217, 6049, 79, -997, 117, 4676, -2903, -4586, 834, -13, 5351, 3403, -5453, -3110, -3604, 2083, -3782, -2446, -4668, -3467, -3180, -1762, -730, -3854, 2030, 
+3269, 5274, -5892, -1367, -2560, -1228, 2742, 48, -2211, -1195, 4970, 1808, -3323, 883, 3012, 6130, 1820, 489, 2851, 1502, 5285, 711, 3316, 1053, -1652, 2203, 6109, 2796, 
+900, 3888, -1156, -1553, -2967, -1020, 1517, -5244, 2019, -126, -2921, 5569, 2315, -4746, 4673, 4949, -1748, -4602, 989, 340, -300, -1296, -3711, 4614, 5746, -5654, -4868, 1582, 
+-673, 42, 5070, 2240, 932, 2060, 4647, 3362, -5858, -237, 2991, -351, 5204, 3802, -1004, 2053, -4703, -163, 3146, -4597, -1060, 5252, -3281, 1556, 5133, -2895, 3402, 5357, 
+-5655, 5064, 5625, -278, -4092, -5880, 2962, 5914, 4699, -5753, 737, -3698, -3243, -3687, -914, -16, -3509, -3853, 5381, -4773, -5186, -1758, 1964, 4552, -3566, -2133, 2341, -3159, 
+4956, 5680, -6038, 3901, -5460, -1467, 3736, -4506, 3253, -6101, -2649, 2320, -6057, 378, -3526, -4418, 5344, 1949, -1730, -2558, -3388, 3060, -4551, 3443, 3468, 4659, 625, 2700, 
+-4609, 3684, 4063, -144, -5656, 3585, -2621, -5424, 2482, -3533, 5387, 4101, -727, -6090, 2190, -5286, 39, -3764, 2080, 4070, 1469, -2502, -3580, 1739, -4951, 1715, -1888, -2749, 
+6040, -943, -1477, 2959, -5788, 4981, 2628, 3488, -909, -4910, 676, 4395, -40, 2285, 1963, 3073, -5603, -4051, 4302, -3044, -5041, 3784, 5601, 1093, 2650, -841, 2058, -3890, 
+2496, 4884, -2059, 2411, -4296, -371, 4371, 695, -754, 3133, 750, 3240, 4370, -784, 3672, -850, 5600, -386, -4462, -105, -2076, 1846, -119, -3955, 5267, -1333, 2356, -5552, 
+-2330, -5150, -5473, 3884, -5348, 4424, 5613, -5737, -721, 2784, 2510, 1012, -728, 4720, -6056, 1857, 1253, -2452, -2811, -3787, -1797, -3339, 2472, -6034, 6047, -2879, -5200, 2114, 
+-1271, 408, 1851, -2818, 5378, 3079, -4013, 360, -926, -5475, -4327, 2936, 6084, 2688, 4966, -4108, 3608, 2806, -101, -1911, -3374, -812, 292, 1753, 5800, 478, -1988, -3181, 
+1361, -2477, 2949, -1024, 5894, 4325, -1071, 1272, -3291, -945, -3474, -1244, -5539, 4582, 3619, -5503, -3819, 4639, 5233, -2463, -4511, 1158, 1097, 315, -6061, -5538, 357, -424, 
+-821, 2352, 1273, 2550, -2250, 2569, 2890, -2262, 3755, -983, -4550, 4922, 2163, 3937, 4759, -3036, -5299, 3161, 4130, 637, 5221, 4367, 3999, 3512, 4801, -2363, -6112, 5056, 
+599, 1113, -824, -2085, 4339, 2523, 6115, -619, -4514, -3279, 937, -2834, 2727, 2441, -2028, -896, 4405, 1825, -2654, -5075, 4520, -136, -617, -3157, -5889, 3070, 5434, -120, 
+-5111, -1434, 5964, -2746, -4083, -4858, 3442, 3072, -2167, 2436, -876, -5259, 303, 5733, 3871, -1465, 4328, -1457, 1432, 4220, -832, -1628, -3410, -4900, -2416, 2835, -1867, 3732, 
+3213, -3816, -686, 5393, 2778, 4136, 692, 3481, -5963, 4225, -2609, 35, -3845, 3052, -250, -1080, -5553, -3835, -1224, -3813, -3759, -4933, -3856, -928, 5879, -5571, -1871, -2184, 
+-5852, -3652, 3311, 5947, 4873, 5813, -2272, -5391, 6012, -5488, 1126, -5950, 5250, -1898, -2647, 5278, -2243, 633, -833, -3107, 5633, -735, -2702, -2333, -4021, 817, -1444, 2610, 
+4203, -1997, 2958, -2, -5047, -5090, 5281, -5205, 2424, -3292, -5899, 569, -6028, -5887, 2117, -2652, 2340, -4638, 1910, -1580, -5494, -2597, 6019, 4865, -2124, 4588, -2679, -5183, 
+-2354, -3779, 5536, 3270, 1452, -3067, 3706, 280, 6107, -162, -2000, 3649, 4732, -6102, 2497, -5926, 960, -5684, 2044, -18, -707, -1088, -4936, -678, -2762, -5050, -3935, 5121, 
+-1627, 2311, 3346, -3733, 1541, 5674, 260, 3581, 4792, -3385, 5697, -4391, -2155, -4394, -236, -4952, 755, -1654, -4793, 1906, 779, -3025, -3513, 2520, 668, 4852, 2856, -3392, 
+5721, -5762, -2105, -4178, -5711, -4026, -1458, -5807, 5462, 4425, 467, 2509, 5015, -5371, 1205, 290, -5525, 710, -3827, 5096, 4901, -1931, -4875, 3518, 4193, -4498, -5768, -2306, 
+-5917, -1475, -4252, 3260, 5269, 1625, -5730, 4740, 5938, -4333, 5372, -5795, -6032, 486, 6000, 1342, -1907, 6017, 4798, 5489, -4356, -3088, 1171, -840, -4319, 2479, -952, 5227, 
+2852, 2981, -3554, 3326, 5017, -2413, 5408, -1707, -320, 5991, 3415, 6, 4332, 4459, -2451, 226, -3461, 5694, -4348, -3545, -3378, 5561, 4175, 5747, -4610, 2205, -4183, -5290, 
+2499, -2968, -1899, 5560, -4874, 4997, -5974, 245, 4844, -211, 4374, 5132, -2004, -2267, 3721, -2113, -1750, 4729, -3214, 2337, 4286, -2130, -808, -2999, -2414, 5793, 2336, 1735, 
+-2756, 3824, -3615, -870, -1401, 4762, -986, 4097, -5824, 893, 708, 2567, -2265, 4962, 2090, -5718, -2087, -2134, -4802, 884, -780, 1546, -4733, 4623, 2121, 3264, 2519, 2034, 
+-6132, 54, 4763, 2880, 4881, 5356, 2251, -1090, -484, -3074, 2861, 4003, -936, 4313, -764, 632, 1611, -1397, -103, -4869, -4066, -4293, -3844, 4531, 2508, -1946, -1419, 2718, 
+1877, -1231, 5891, -112, 5159, -1308, -3404, 3974, 565, -17, 1459, -5003, 800, 3456, -2393, -15, -4139, -1659, -3641, -2457, -4338, -1044, 2131, 5765, 3946, -1141, -2556, 4688, 
+5261, 2082, 2036, 439, -4711, 294, -1377, 3391, 2791, -1215, -2711, -3355, -5366, 2380, 4653, -53, -1399, -4569, 3217, 2100, -2725, 517, -6058, -1101, 3863, -1008, 1210, -4604, 
+-5089, -5763, 3041, -135, 842, 4129, -153, -5085, -2006, -5225, -482, -116, 2271, 3912, -1770, -273, 5413, 5688, 1950, -3865, -927, 5335, -284, -2210, 541, 1354, 179, -5617, 
+-104, 5941, 2646, 5532, -302, -4254, 4375, -5678, 5010, -477, -3158, -862, -1807, -5840, 6035, 3951, 1574, 5325, 2020, 1353, 4098, 2465, -2642, 384, -5399, 2729, 2893, 2175, 
+451, 3423, -4621, -1775, -3494, 6043, -6108, -1317, 725, 3132, 5896, -5006, -1366, -4918, 4977, -128, 3809, 5149, -1670, 159, 4197, 1418, 2638, 5989, 3916, 3645, -4156, -2224, 
+4131, 2116, -882, -1844, -1695, 51, -4377, 2720, -2400, 1921, -5110, 45, -3188, 3924, -2077, 367, -5384, 336, 3693, 5631, -4833, 4191, 309, 2318, 2292, -1896, -650, -2808, 
+4765, 5838, 4257, 4135, -757, -1304, 590, 91, 906, 473, -836, 4745, -2741, 1431, -2815, 2586, 312, -5534, 4351, -4307, -537, 4562, -4062, 1623, -5, 4894, -4363, -1152, 
+3908, 4102, 3610, 5764, -4722, -3686, -6060, -4059, -5816, 436, 5231, -5421, -3950, -4775, -5850, -694, 2781, -3716, 852, -5659, 5476, 553, 5310, 819, 1446, 348, 3386, -6018, 
+700, 3024, -3630, 1523, 5885, 3303, -1551, 4114, -2526, -98, 459, 2966, 3166, 405, 5000, -2978
+};
+
+
+const int16_t omegainv_rev_ntt1024_12289_int16[1024] = {
+4091, -4401, -1229, -1081, -5329, 4342, -6014, -2530, -1591, 5890, 2812, -5266, -586, -5825, 4751, 2579, 5357, 3402, -2895, 5133, 1556, -3281, 5252, -1060, -278, 5625, 5064, -5655, 
+-5880, -4092, 2962, -5914, -117, 997, -79, -6049, 5217, 1549, 4783, 4407, -3412, -4431, -2829, 5831, 4042, -5664, 5145, -2564, 1538, -1237, -432, -100, -3983, 4426, -1534, -4679, 
+-3569, -5719, -5981, -2181, 14, 3872, 1690, -4843, -4949, -4673, 4746, -2315, -5569, 2921, 126, -2019, 5244, -1517, 1020, 2967, 1553, 1156, -3888, -900, -2796, -6109, -2203, 1652, 
+-1053, -3316, -711, -5285, -1502, -2851, -489, -1820, -6130, -3012, -883, 3323, -1808, -4970, 1195, 2211, -48, -2742, 1228, 2560, 1367, 5892, -5274, -3269, -2030, 3854, 730, 1762, 
+3180, 3467, 4668, 2446, 3782, -2083, 3604, 3110, 5453, -3403, -5351, 13, -834, 4586, 2903, -4676, -2959, 1477, 943, -6040, 2749, 1888, -1715, 4951, -1739, 3580, 2502, -1469, 
+-4070, -2080, 3764, -39, 5286, -2190, 6090, 727, -4101, -5387, 3533, -2482, 5424, 2621, -3585, 5656, 144, -4063, -3684, 4609, -2700, -625, -4659, -3468, -3443, 4551, -3060, 3388, 
+2558, 1730, -1949, -5344, 4418, 3526, -378, 6057, -2320, 2649, 6101, -3253, 4506, -3736, 1467, 5460, -3901, 6038, -5680, -4956, 3159, -2341, 2133, 3566, -4552, -1964, 1758, 5186, 
+4773, -5381, 3853, 3509, 16, 914, 3687, 3243, 3698, -737, 5753, -4699, -5914, -2962, 5880, 4092, 278, -5625, -5064, 5655, -5357, -3402, 2895, -5133, -1556, 3281, -5252, 1060, 
+4597, -3146, 163, 4703, -2053, 1004, -3802, -5204, 351, -2991, 237, 5858, -3362, -4647, -2060, -932, -2240, -5070, -42, 673, -1582, 4868, 5654, -5746, -4614, 3711, 1296, 300, 
+-340, -989, 4602, 1748, 5391, 2272, -5813, -4873, -5947, -3311, 3652, 5852, 2184, 1871, 5571, -5879, 928, 3856, 4933, 3759, 3813, 1224, 3835, 5553, 1080, 250, -3052, 3845, 
+-35, 2609, -4225, 5963, -3481, -692, -4136, -2778, -5393, 686, 3816, -3213, -3732, 1867, -2835, 2416, 4900, 3410, 1628, 832, -4220, -1432, 1457, -4328, 1465, -3871, -5733, -303, 
+5259, 876, -2436, 2167, -3072, -3442, 4858, 4083, 2746, -5964, 1434, 5111, 120, -5434, -3070, 5889, 3157, 617, 136, -4520, 5075, 2654, -1825, -4405, 896, 2028, -2441, -2727, 
+2834, -937, 3279, 4514, 619, -6115, -2523, -4339, 2085, 824, -1113, -599, -5056, 6112, 2363, -4801, -3512, -3999, -4367, -5221, -637, -4130, -3161, 5299, 3036, -4759, -3937, -2163, 
+-4922, 4550, 983, -3755, 2262, -2890, -2569, 2250, -2550, -1273, -2352, 821, 424, -357, 5538, 6061, -315, -1097, -1158, 4511, 2463, -5233, -4639, 3819, 5503, -3619, -4582, 5539, 
+1244, 3474, 945, 3291, -1272, 1071, -4325, -5894, 1024, -2949, 2477, -1361, 3181, 1988, -478, -5800, -1753, -292, 812, 3374, 1911, 101, -2806, -3608, 4108, -4966, -2688, -6084, 
+-2936, 4327, 5475, 926, -360, 4013, -3079, -5378, 2818, -1851, -408, 1271, -2114, 5200, 2879, -6047, 6034, -2472, 3339, 1797, 3787, 2811, 2452, -1253, -1857, 6056, -4720, 728, 
+-1012, -2510, -2784, 721, 5737, -5613, -4424, 5348, -3884, 5473, 5150, 2330, 5552, -2356, 1333, -5267, 3955, 119, -1846, 2076, 105, 4462, 386, -5600, 850, -3672, 784, -4370, 
+-3240, -750, -3133, 754, -695, -4371, 371, 4296, -2411, 2059, -4884, -2496, 3890, -2058, 841, -2650, -1093, -5601, -3784, 5041, 3044, -4302, 4051, 5603, -3073, -1963, -2285, 40, 
+-4395, -676, 4910, 909, -3488, -2628, -4981, 5788, 2978, -5000, -405, -3166, -2966, -459, 98, 2526, -4114, 1551, -3303, -5885, -1523, 3630, -3024, -700, 6018, -3386, -348, -1446, 
+-819, -5310, -553, -5476, 5659, -852, 3716, -2781, 694, 5850, 4775, 3950, 5421, -5231, -436, 5816, 4059, 6060, 3686, 4722, -5764, -3610, -4102, -3908, 1152, 4363, -4894, 5, 
+-1623, 4062, -4562, 537, 4307, -4351, 5534, -312, -2586, 2815, -1431, 2741, -4745, 836, -473, -906, -91, -590, 1304, 757, -4135, -4257, -5838, -4765, 2808, 650, 1896, -2292, 
+-2318, -309, -4191, 4833, -5631, -3693, -336, 5384, -367, 2077, -3924, 3188, -45, 5110, -1921, 2400, -2720, 4377, -51, 1695, 1844, 882, -2116, -4131, 2224, 4156, -3645, -3916, 
+-5989, -2638, -1418, -4197, -159, 1670, -5149, -3809, 128, -4977, 4918, 1366, 5006, -5896, -3132, -725, 1317, 6108, -6043, 3494, 1775, 4621, -3423, -451, -2175, -2893, -2729, 5399, 
+-384, 2642, -2465, -4098, -1353, -2020, -5325, -1574, -3951, -6035, 5840, 1807, 862, 3158, 477, -5010, 5678, -4375, 4254, 302, -5532, -2646, -5941, 104, 5617, -179, -1354, -541, 
+2210, 284, -5335, 927, 3865, -1950, -5688, -5413, 273, 1770, -3912, -2271, 116, 482, 5225, 2006, 5085, 153, -4129, -842, 135, -3041, 5763, 5089, 4604, -1210, 1008, -3863, 
+1101, 6058, -517, 2725, -2100, -3217, 4569, 1399, 53, -4653, -2380, 5366, 3355, 2711, 1215, -2791, -3391, 1377, -294, 4711, -439, -2036, -2082, -5261, -4688, 2556, 1141, -3946, 
+-5765, -2131, 1044, 4338, 2457, 3641, 1659, 4139, 15, 2393, -3456, -800, 5003, -1459, 17, -565, -3974, 3404, 1308, -5159, 112, -5891, 1231, -1877, -2718, 1419, 1946, -2508, 
+-4531, 3844, 4293, 4066, 4869, 103, 1397, -1611, -632, 764, -4313, 936, -4003, -2861, 3074, 484, 1090, -2251, -5356, -4881, -2880, -4763, -54, 6132, -2034, -2519, -3264, -2121, 
+-4623, 4733, -1546, 780, -884, 4802, 2134, 2087, 5718, -2090, -4962, 2265, -2567, -708, -893, 5824, -4097, 986, -4762, 1401, 870, 3615, -3824, 2756, -1735, -2336, -5793, 2414, 
+2999, 808, 2130, -4286, -2337, 3214, -4729, 1750, 2113, -3721, 2267, 2004, -5132, -4374, 211, -4844, -245, 5974, -4997, 4874, -5560, 1899, 2968, -2499, 5290, 4183, -2205, 4610, 
+-5747, -4175, -5561, 3378, 3545, 4348, -5694, 3461, -226, 2451, -4459, -4332, -6, -3415, -5991, 320, 1707, -5408, 2413, -5017, -3326, 3554, -2981, -2852, -5227, 952, -2479, 4319, 
+840, -1171, 3088, 4356, -5489, -4798, -6017, 1907, -1342, -6000, -486, 6032, 5795, -5372, 4333, -5938, -4740, 5730, -1625, -5269, -3260, 4252, 1475, 5917, 2306, 5768, 4498, -4193, 
+-3518, 4875, 1931, -4901, -5096, 3827, -710, 5525, -290, -1205, 5371, -5015, -2509, -467, -4425, -5462, 5807, 1458, 4026, 5711, 4178, 2105, 5762, -5721, 3392, -2856, -4852, -668, 
+-2520, 3513, 3025, -779, -1906, 4793, 1654, -755, 4952, 236, 4394, 2155, 4391, -5697, 3385, -4792, -3581, -260, -5674, -1541, 3733, -3346, -2311, 1627, -5121, 3935, 5050, 2762, 
+678, 4936, 1088, 707, 18, -2044, 5684, -960, 5926, -2497, 6102, -4732, -3649, 2000, 162, -6107, -280, -3706, 3067, -1452, -3270, -5536, 3779, 2354, 5183, 2679, -4588, 2124, 
+-4865, -6019, 2597, 5494, 1580, -1910, 4638, -2340, 2652, -2117, 5887, 6028, -569, 5899, 3292, -2424, 5205, -5281, 5090, 5047, 2, -2958, 1997, -4203, -2610, 1444, -817, 4021, 
+2333, 2702, 735, -5633, 3107, 833, -633, 2243, -5278, 2647, 1898, -5250, 5950, -1126, 5488, -6012
+};
@@ -0,0 +1,400 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: optional pools of noise in NTT form and of Alice's key pairs, filled by background threads
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#include <stdlib.h>
+#include <string.h>
+#if (OS_TARGET == OS_WIN)
+    #include <windows.h>
+    #define pool_load(p)             ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(p), 0, 0))
+    #define pool_store(p, x)         InterlockedExchange64((volatile LONG64*)(p), (LONG64)(x))
+    #define pool_increment(p)        InterlockedIncrement64((volatile LONG64*)(p))
+    #define pool_sleep()             Sleep(1)
+    typedef HANDLE pool_thread_t;
+#else
+    #include <pthread.h>
+    #include <time.h>
+    #define pool_load(p)             __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define pool_store(p, x)         __atomic_store_n(p, x, __ATOMIC_RELEASE)
+    #define pool_increment(p)        __atomic_fetch_add(p, 1, __ATOMIC_RELAXED)
+    #define pool_sleep()             { struct timespec ts = { 0, 1000000 }; nanosleep(&ts, NULL); }
+    typedef pthread_t pool_thread_t;
+#endif
+
+#define POOL_SLOT_ALIGN     64        // Slots start on their own cache lines
+
+
+// Function filling a slot of a pool, from the functions of the structure that owns the pool
+typedef CRYPTO_STATUS (*pool_fill)(unsigned char* slot, PLatticeCryptoStruct owner);
+
+typedef struct
+{
+    PLatticeCryptoStruct owner;                 // Functions used by the producer
+    pool_fill        fill;
+    unsigned int     nslots;
+    size_t           slot_nbytes;               // Size of a slot, a multiple of POOL_SLOT_ALIGN
+    unsigned char*   data;                      // Slot i at data[i*slot_nbytes]
+    uint64_t*        seq;                       // Position that may use slot i next: the producer fills it when seq[i] = pos, a consumer takes it when seq[i] = pos+1
+    uint64_t         head;                      // Next position to fill, only used by the producer
+    uint64_t         tail;                      // Next position to take, advanced by the consumers
+    uint64_t         produced, stop, hits, misses;
+    pool_thread_t    thread;
+} pool_ring;
+
+typedef struct
+{
+    int32_t          s[PARAMETER_N];            // NTT(s)
+    int32_t          e[PARAMETER_N];            // NTT(e) scaled by 3
+    int32_t          v[PARAMETER_N];            // NTT(v) scaled by 81, only used by SecretAgreement_B
+    unsigned char    random_bits[PARAMETER_N/32];
+} noise_pool_slot;
+
+typedef struct
+{
+    int32_t          SecretKeyA[PARAMETER_N];
+    unsigned char    PublicKeyA[PKA_BYTES];
+} keypair_pool_slot;
+
+struct LatticeCryptoNoisePool
+{
+    pool_ring        ring;
+};
+
+struct LatticeCryptoKeypairPool
+{
+    pool_ring        ring;
+};
+
+
+static bool pool_cas(uint64_t* p, uint64_t* expected, uint64_t desired)
+{ // Set *p to desired if it equals *expected, else load it into *expected
+#if (OS_TARGET == OS_WIN)
+    uint64_t old = (uint64_t)InterlockedCompareExchange64((volatile LONG64*)p, (LONG64)desired, (LONG64)*expected);
+
+    if (old == *expected) {
+        return true;
+    }
+    *expected = old;
+    return false;
+#else
+    return __atomic_compare_exchange_n(p, expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+
+#if (OS_TARGET == OS_WIN)
+static DWORD WINAPI pool_producer(LPVOID arg)
+#else
+static void* pool_producer(void* arg)
+#endif
+{ // Fill the free slots in order until stopped, and wait while the ring is full
+  // On an error of the fill function it stops producing, and the consumers compute the values on the request path
+    pool_ring* ring = (pool_ring*)arg;
+    uint64_t i;
+
+    while (pool_load(&ring->stop) == 0) {
+        i = ring->head % ring->nslots;
+        if (pool_load(&ring->seq[i]) != ring->head) {                       // Not taken yet since the last round
+            pool_sleep();
+            continue;
+        }
+        if (ring->fill(&ring->data[i*ring->slot_nbytes], ring->owner) != CRYPTO_SUCCESS) {
+            break;
+        }
+        pool_store(&ring->seq[i], ring->head+1);                            // Publish the slot
+        ring->head++;
+        pool_increment(&ring->produced);
+    }
+    return 0;
+}
+
+
+static CRYPTO_STATUS pool_start(pool_ring* ring, PLatticeCryptoStruct owner, unsigned int nslots, size_t slot_nbytes, pool_fill fill)
+{ // Allocate "nslots" empty slots of "slot_nbytes" bytes in ring and start its producer thread
+    unsigned int i;
+    bool started;
+
+    ring->slot_nbytes = (slot_nbytes + POOL_SLOT_ALIGN-1) & ~(size_t)(POOL_SLOT_ALIGN-1);
+    ring->data = (unsigned char*)calloc(nslots, ring->slot_nbytes);
+    ring->seq = (uint64_t*)calloc(nslots, sizeof(uint64_t));
+    if (ring->data == NULL || ring->seq == NULL) {
+        free(ring->data);
+        free(ring->seq);
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    for (i = 0; i < nslots; i++) {
+        ring->seq[i] = i;
+    }
+    ring->nslots = nslots;
+    ring->owner = owner;
+    ring->fill = fill;
+
+#if (OS_TARGET == OS_WIN)
+    ring->thread = CreateThread(NULL, 0, pool_producer, ring, 0, NULL);
+    started = (ring->thread != NULL);
+#else
+    started = (pthread_create(&ring->thread, NULL, pool_producer, ring) == 0);
+#endif
+    if (started == false) {
+        free(ring->data);
+        free(ring->seq);
+        return CRYPTO_ERROR;
+    }
+    return CRYPTO_SUCCESS;
+}
+
+
+static void pool_stop(pool_ring* ring)
+{ // Stop the producer thread of ring and release its slots, cleared
+    pool_store(&ring->stop, 1);
+#if (OS_TARGET == OS_WIN)
+    WaitForSingleObject(ring->thread, INFINITE);
+    CloseHandle(ring->thread);
+#else
+    pthread_join(ring->thread, NULL);
+#endif
+    clear_words((void*)ring->data, NBYTES_TO_NWORDS(ring->nslots*ring->slot_nbytes));
+    free(ring->data);
+    free(ring->seq);
+}
+
+
+static unsigned char* pool_claim(pool_ring* ring, uint64_t* pos)
+{ // Claim the oldest ready slot of ring without locking, and output its position for pool_release(). Returns NULL if the ring is empty
+    uint64_t seq;
+
+    *pos = pool_load(&ring->tail);
+    for (;;) {
+        seq = pool_load(&ring->seq[*pos % ring->nslots]);
+        if (seq == *pos+1) {
+            if (pool_cas(&ring->tail, pos, *pos+1)) {                       // The slot is ours, else *pos is the new tail
+                pool_increment(&ring->hits);
+                return &ring->data[(*pos % ring->nslots)*ring->slot_nbytes];
+            }
+        } else if (seq == *pos) {                                           // Not filled yet
+            pool_increment(&ring->misses);
+            return NULL;
+        } else {                                                            // Taken by another consumer since tail was loaded
+            *pos = pool_load(&ring->tail);
+        }
+    }
+}
+
+
+static void pool_release(pool_ring* ring, uint64_t pos)
+{ // Clear the slot claimed at position pos and hand it back to the producer for its next round
+    uint64_t i = pos % ring->nslots;
+
+    clear_words((void*)&ring->data[i*ring->slot_nbytes], NBYTES_TO_NWORDS(ring->slot_nbytes));
+    pool_store(&ring->seq[i], pos+ring->nslots);
+}
+
+
+static void pool_stats(pool_ring* ring, unsigned int* nready, uint64_t* produced, uint64_t* hits, uint64_t* misses)
+{ // Number of ready slots, and of slots filled, taken and requested from the empty ring
+    uint64_t taken;
+
+    *hits = pool_load(&ring->hits);
+    *misses = pool_load(&ring->misses);
+    taken = pool_load(&ring->tail);
+    *produced = pool_load(&ring->produced);                                 // Counted just after the slot is published
+    *nready = (*produced > taken) ? (unsigned int)(*produced - taken) : 0;
+}
+
+
+static CRYPTO_STATUS noise_pool_fill(unsigned char* slot, PLatticeCryptoStruct owner)
+{ // Noise of a party in NTT form from a fresh error seed
+    noise_pool_slot* noise = (noise_pool_slot*)slot;
+    unsigned char error_seed[ERROR_SEED_BYTES];
+    CRYPTO_STATUS Status;
+
+    Status = random_bytes(ERROR_SEED_BYTES, error_seed, owner->RandomBytesFunction);
+    if (Status == CRYPTO_SUCCESS) {
+        Status = get_noise_ntt(&params_ntt1024_12289, noise->s, noise->e, noise->v, noise->random_bits, error_seed, NULL, owner);
+    }
+    clear_words((void*)error_seed, NBYTES_TO_NWORDS(ERROR_SEED_BYTES));
+
+    return Status;
+}
+
+
+bool noise_pool_take(PLatticeCryptoStruct pLatticeCrypto, const LatticeCryptoParams* params, int32_t* s, int32_t* e, int32_t* v, unsigned char* random_bits)
+{ // Take the oldest ready slot of the pool of pLatticeCrypto, if any, into s and e, and v and random_bits if they are not NULL
+  // Returns false without a pool for params, or if it is empty, so that the caller samples the noise itself. The slot is cleared before its release
+    struct LatticeCryptoNoisePool* pool = pLatticeCrypto->NoisePool;
+    noise_pool_slot* noise;
+    uint64_t pos;
+
+    if (pool == NULL || params != &params_ntt1024_12289) {
+        return false;
+    }
+    noise = (noise_pool_slot*)pool_claim(&pool->ring, &pos);
+    if (noise == NULL) {
+        return false;
+    }
+
+    memcpy(s, noise->s, PARAMETER_N*sizeof(int32_t));
+    memcpy(e, noise->e, PARAMETER_N*sizeof(int32_t));
+    if (v != NULL) {
+        memcpy(v, noise->v, PARAMETER_N*sizeof(int32_t));
+    }
+    if (random_bits != NULL) {
+        memcpy(random_bits, noise->random_bits, PARAMETER_N/32);
+    }
+    pool_release(&pool->ring, pos);
+
+    return true;
+}
+
+
+CRYPTO_STATUS LatticeCrypto_enable_noise_pool(PLatticeCryptoStruct pLatticeCrypto, unsigned int nslots)
+{ // Set up a pool of "nslots" noise slots in pLatticeCrypto and start its producer thread, replacing any previous pool. nslots = 0 removes the pool
+    struct LatticeCryptoNoisePool* pool;
+    CRYPTO_STATUS Status;
+
+    if (pLatticeCrypto == NULL || nslots > NOISE_POOL_MAX_SLOTS) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    LatticeCrypto_disable_noise_pool(pLatticeCrypto);
+    if (nslots == 0) {
+        return CRYPTO_SUCCESS;
+    }
+
+    pool = (struct LatticeCryptoNoisePool*)calloc(1, sizeof(struct LatticeCryptoNoisePool));
+    if (pool == NULL) {
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    Status = pool_start(&pool->ring, pLatticeCrypto, nslots, sizeof(noise_pool_slot), noise_pool_fill);
+    if (Status != CRYPTO_SUCCESS) {
+        free(pool);
+        return Status;
+    }
+    pLatticeCrypto->NoisePool = pool;
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void LatticeCrypto_disable_noise_pool(PLatticeCryptoStruct pLatticeCrypto)
+{ // Stop the producer thread of the pool of pLatticeCrypto, if any, and remove the pool with the noise it still holds
+    struct LatticeCryptoNoisePool* pool;
+
+    if (pLatticeCrypto == NULL || pLatticeCrypto->NoisePool == NULL) {
+        return;
+    }
+    pool = pLatticeCrypto->NoisePool;
+    pLatticeCrypto->NoisePool = NULL;
+    pool_stop(&pool->ring);
+    free(pool);
+}
+
+
+void LatticeCrypto_get_noise_pool_stats(PLatticeCryptoStruct pLatticeCrypto, unsigned int* nready, uint64_t* hits, uint64_t* misses)
+{ // Output the number of ready slots, and the number of requests that took a slot and that found the pool empty since it was enabled, 0 without a pool
+    struct LatticeCryptoNoisePool* pool = (pLatticeCrypto != NULL) ? pLatticeCrypto->NoisePool : NULL;
+    uint64_t produced;
+
+    *nready = 0;
+    *hits = 0;
+    *misses = 0;
+    if (pool != NULL) {
+        pool_stats(&pool->ring, nready, &produced, hits, misses);
+    }
+}
+
+
+static CRYPTO_STATUS keypair_pool_fill(unsigned char* slot, PLatticeCryptoStruct owner)
+{ // Alice's key pair
+    keypair_pool_slot* keypair = (keypair_pool_slot*)slot;
+
+    return KeyGeneration_A(keypair->SecretKeyA, keypair->PublicKeyA, owner);
+}
+
+
+CRYPTO_STATUS LatticeCrypto_enable_keypair_pool(PLatticeCryptoStruct pLatticeCrypto, unsigned int nkeypairs)
+{ // Set up a pool of "nkeypairs" key pairs of Alice in pLatticeCrypto and start its refill thread, replacing any previous pool. nkeypairs = 0 removes the pool
+    struct LatticeCryptoKeypairPool* pool;
+    CRYPTO_STATUS Status;
+
+    if (pLatticeCrypto == NULL || nkeypairs > KEYPAIR_POOL_MAX_KEYPAIRS) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    LatticeCrypto_disable_keypair_pool(pLatticeCrypto);
+    if (nkeypairs == 0) {
+        return CRYPTO_SUCCESS;
+    }
+
+    pool = (struct LatticeCryptoKeypairPool*)calloc(1, sizeof(struct LatticeCryptoKeypairPool));
+    if (pool == NULL) {
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    Status = pool_start(&pool->ring, pLatticeCrypto, nkeypairs, sizeof(keypair_pool_slot), keypair_pool_fill);
+    if (Status != CRYPTO_SUCCESS) {
+        free(pool);
+        return Status;
+    }
+    pLatticeCrypto->KeypairPool = pool;
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void LatticeCrypto_disable_keypair_pool(PLatticeCryptoStruct pLatticeCrypto)
+{ // Stop the refill thread of the key pair pool of pLatticeCrypto, if any, and remove the pool, wiping the key pairs it still holds
+    struct LatticeCryptoKeypairPool* pool;
+
+    if (pLatticeCrypto == NULL || pLatticeCrypto->KeypairPool == NULL) {
+        return;
+    }
+    pool = pLatticeCrypto->KeypairPool;
+    pLatticeCrypto->KeypairPool = NULL;
+    pool_stop(&pool->ring);
+    free(pool);
+}
+
+
+CRYPTO_STATUS LatticeCrypto_take_keypair(PLatticeCryptoStruct pLatticeCrypto, int32_t* SecretKeyA, unsigned char* PublicKeyA)
+{ // Output a ready key pair of Alice from the pool of pLatticeCrypto, removing it from the pool, or one from KeyGeneration_A if the pool is empty or disabled
+    struct LatticeCryptoKeypairPool* pool;
+    keypair_pool_slot* keypair = NULL;
+    uint64_t pos;
+
+    if (pLatticeCrypto == NULL || SecretKeyA == NULL || PublicKeyA == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    pool = pLatticeCrypto->KeypairPool;
+    if (pool != NULL) {
+        keypair = (keypair_pool_slot*)pool_claim(&pool->ring, &pos);
+    }
+    if (keypair == NULL) {
+        return KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+    }
+
+    memcpy(SecretKeyA, keypair->SecretKeyA, PARAMETER_N*sizeof(int32_t));
+    memcpy(PublicKeyA, keypair->PublicKeyA, PKA_BYTES);
+    pool_release(&pool->ring, pos);
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void LatticeCrypto_get_keypair_pool_stats(PLatticeCryptoStruct pLatticeCrypto, unsigned int* nready, uint64_t* produced, uint64_t* hits, uint64_t* misses)
+{ // Output the pool depth (ready key pairs), and the number of key pairs generated by the refill thread, taken from the pool and generated on 
+  // request because it was empty, since it was enabled, 0 without a pool
+    struct LatticeCryptoKeypairPool* pool = (pLatticeCrypto != NULL) ? pLatticeCrypto->KeypairPool : NULL;
+
+    *nready = 0;
+    *produced = 0;
+    *hits = 0;
+    *misses = 0;
+    if (pool != NULL) {
+        pool_stats(&pool->ring, nready, produced, hits, misses);
+    }
+}
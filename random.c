@@ -1,51 +1,71 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: wrappers for user-provided functions
-*
-*****************************************************************************************/
-
-
-#include "LatticeCrypto_priv.h"
-
-
-CRYPTO_STATUS random_bytes(unsigned int nbytes, unsigned char* random_array, RandomBytes RandomBytesFunction)
-{ // Output "nbytes" of random values.
-  // It makes requests of random values to RandomBytesFunction. If successful, the output is given in "random_array".
-  // The caller is responsible for providing the "RandomBytesFunction" function passing random values as octets.
-
-    if (random_array == NULL || RandomBytesFunction == NULL || nbytes == 0) {
-        return CRYPTO_ERROR_INVALID_PARAMETER;
-    }    
-    
-    return (RandomBytesFunction)(nbytes, random_array);
-}
-
-
-CRYPTO_STATUS extended_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array, ExtendableOutput ExtendableOutputFunction)
-{ // Output "array_ndigits" of values in [0, q-1] using an extendable-output function and a seed of size "seed_nbytes".
-  // It makes requests of values to ExtendableOutputFunction. If successful, the output is given in "extended_array".
-  // The caller is responsible for providing the "ExtendableOutputFunction" function passing values as 32-bit digits.
-
-    if (seed == NULL || extended_array == NULL || ExtendableOutputFunction == NULL || seed_nbytes == 0 || array_ndigits == 0) {
-        return CRYPTO_ERROR_INVALID_PARAMETER;
-    }    
-    
-    return (ExtendableOutputFunction)(seed, seed_nbytes, array_ndigits, extended_array);
-}
-
-
-CRYPTO_STATUS stream_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array, StreamOutput StreamOutputFunction)
-{ // Output "array_nbytes" of values using a stream cipher, a seed of size "seed_nbytes" and a nonce of size "nonce_nbytes".  
-  // It makes requests of values to StreamOutputFunction. If successful, the output is given in "stream_array".
-  // The caller is responsible for providing the "StreamOutputFunction" function passing values as octets.
-
-    if (seed == NULL || stream_array == NULL || StreamOutputFunction == NULL || seed_nbytes == 0 || nonce_nbytes == 0 || array_nbytes == 0) {
-        return CRYPTO_ERROR_INVALID_PARAMETER;
-    }    
-    
-    return (StreamOutputFunction)(seed, seed_nbytes, nonce, nonce_nbytes, array_nbytes, stream_array);
-}
\ No newline at end of file
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: wrappers for user-provided functions
+*
+*****************************************************************************************/
+
+
+#include "LatticeCrypto_priv.h"
+
+
+CRYPTO_STATUS random_bytes(unsigned int nbytes, unsigned char* random_array, RandomBytes RandomBytesFunction)
+{ // Output "nbytes" of random values.
+  // It makes requests of random values to RandomBytesFunction. If successful, the output is given in "random_array".
+  // The caller is responsible for providing the "RandomBytesFunction" function passing random values as octets.
+
+    if (random_array == NULL || RandomBytesFunction == NULL || nbytes == 0) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }    
+    
+    return (RandomBytesFunction)(nbytes, random_array);
+}
+
+
+CRYPTO_STATUS extended_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array, ExtendableOutput ExtendableOutputFunction)
+{ // Output "array_ndigits" of values in [0, q-1] using an extendable-output function and a seed of size "seed_nbytes".
+  // It makes requests of values to ExtendableOutputFunction. If successful, the output is given in "extended_array".
+  // The caller is responsible for providing the "ExtendableOutputFunction" function passing values as 32-bit digits.
+
+    if (seed == NULL || extended_array == NULL || ExtendableOutputFunction == NULL || seed_nbytes == 0 || array_ndigits == 0) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }    
+    
+    return (ExtendableOutputFunction)(seed, seed_nbytes, array_ndigits, extended_array);
+}
+
+
+CRYPTO_STATUS stream_output(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array, StreamOutput StreamOutputFunction)
+{ // Output "array_nbytes" of values using a stream cipher, a seed of size "seed_nbytes" and a nonce of size "nonce_nbytes".  
+  // It makes requests of values to StreamOutputFunction. If successful, the output is given in "stream_array".
+  // The caller is responsible for providing the "StreamOutputFunction" function passing values as octets.
+
+    if (seed == NULL || stream_array == NULL || StreamOutputFunction == NULL || seed_nbytes == 0 || nonce_nbytes == 0 || array_nbytes == 0) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }    
+    
+    return (StreamOutputFunction)(seed, seed_nbytes, nonce, nonce_nbytes, array_nbytes, stream_array);
+}
+
+CRYPTO_STATUS stream_output_multi(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonces, unsigned int nonce_nbytes, unsigned int nnonces, const unsigned int* array_nbytes, unsigned char* stream_array, StreamOutputMulti StreamOutputMultiFunction, StreamOutput StreamOutputFunction)
+{ // Output the streams for "nnonces" nonces of size "nonce_nbytes", the one for nonces[nonce_nbytes*i] with array_nbytes[i] values, one after the other.  
+  // It makes one request to StreamOutputMultiFunction if provided, else one request per nonce to StreamOutputFunction. If successful, the output is given in "stream_array".
+    unsigned int i;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    if (seed == NULL || nonces == NULL || array_nbytes == NULL || stream_array == NULL || seed_nbytes == 0 || nonce_nbytes == 0 || nnonces == 0) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }    
+    if (StreamOutputMultiFunction != NULL) {
+        return (StreamOutputMultiFunction)(seed, seed_nbytes, nonces, nonce_nbytes, nnonces, array_nbytes, stream_array);
+    }
+
+    for (i = 0; i < nnonces && Status == CRYPTO_SUCCESS; i++) {
+        Status = stream_output(seed, seed_nbytes, &nonces[nonce_nbytes*i], nonce_nbytes, array_nbytes[i], stream_array, StreamOutputFunction);
+        stream_array += array_nbytes[i];
+    }
+    return Status;
+}
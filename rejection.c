@@ -0,0 +1,75 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: rejection sampling of uniform values in [0, q-1] from the output of an extendable-output function
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+
+#define REJECTION_BLOCK_BYTES    16       // Input of the rejection sampling kernels per block, 8 candidates of 16 bits
+
+
+unsigned int rejection_sampling_generic(uint32_t* a, const unsigned char* buf, unsigned int nblocks)
+{ // Output the 14 low bits of the 16-bit little-endian words of nblocks 16-byte blocks of buf that are in [0, q-1], returns their number (portable version)
+    unsigned int i, count = 0;
+    uint32_t digit;
+
+    for (i = 0; i < 8*nblocks; i++) {
+        digit = ((uint32_t)buf[2*i] | ((uint32_t)buf[2*i+1] << 8)) & 0x3FFF;
+        a[count] = digit;
+        count += (digit < PARAMETER_Q);                   // Take it if it is in [0, q-1], the next value overwrites it otherwise
+    }
+    return count;
+}
+
+
+static __inline unsigned int rejection_sampling_blocks(uint32_t* a, const unsigned char* buf, unsigned int nblocks)
+{
+#if defined(DISPATCH_SUPPORT)
+    return backend_load()->rejection_sampling(a, buf, nblocks);
+#elif defined(ASM_SUPPORT)
+    return rejection_sampling_asm(a, buf, nblocks);
+#else
+    return rejection_sampling_generic(a, buf, nblocks);
+#endif
+}
+
+
+unsigned int LatticeCrypto_rejection_sample(uint32_t* a, unsigned int ndigits, const unsigned char* buf, unsigned int buf_nbytes)
+{ // Output up to "ndigits" values in [0, q-1] to a, the 14 low bits of the 16-bit little-endian words of buf that are below q, in order
+  // Returns the number of values written: if it is less than ndigits, all of buf was used
+  // The kernels take whole blocks and write 8 values per block at most, so they only get the blocks that cannot fill a past ndigits
+    unsigned int nblocks, count = 0;
+    uint32_t digit;
+
+    if (a == NULL || buf == NULL) {
+        return 0;
+    }
+
+    while (1) {
+        nblocks = (ndigits - count)/8;
+        if (nblocks > buf_nbytes/REJECTION_BLOCK_BYTES) {
+            nblocks = buf_nbytes/REJECTION_BLOCK_BYTES;
+        }
+        if (nblocks == 0) {
+            break;
+        }
+        count += rejection_sampling_blocks(&a[count], buf, nblocks);
+        buf += REJECTION_BLOCK_BYTES*nblocks;
+        buf_nbytes -= REJECTION_BLOCK_BYTES*nblocks;
+    }
+
+    while (buf_nbytes >= 2 && count < ndigits) {             // Last candidates one by one
+        digit = ((uint32_t)buf[0] | ((uint32_t)buf[1] << 8)) & 0x3FFF;
+        if (digit < PARAMETER_Q) {
+            a[count++] = digit;
+        }
+        buf += 2;
+        buf_nbytes -= 2;
+    }
+    return count;
+}
@@ -0,0 +1,221 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: built-in extendable-output function based on SHAKE128 (FIPS 202)
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#include <string.h>
+
+#define SHAKE128_RATE       168       // Rate of SHAKE128 in bytes
+#define SHAKE128_LANES      21        // Rate of SHAKE128 in 64-bit lanes
+
+// Round constants of Keccak-f[1600], also read by the assembly implementation
+const uint64_t KECCAK_RC[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000, 0x000000000000808B, 0x0000000080000001,
+    0x8000000080008081, 0x8000000000008009, 0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+    0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+    0x000000000000800A, 0x800000008000000A, 0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+};
+
+#define ROL64(a, n)    (((a) << (n)) | ((a) >> ((64-(n)) & 63)))
+
+// Step rho of lane i, rotated by r, and its move to position p by step pi
+#define RHO_PI(i, r, p)     B[p] = ROL64(A[i] ^ D[(i) % 5], r)
+
+// Step chi of the row starting at lane y
+#define CHI(y)                                                                              \
+    A[(y)]   = B[(y)]   ^ (~B[(y)+1] & B[(y)+2]);  A[(y)+1] = B[(y)+1] ^ (~B[(y)+2] & B[(y)+3]); \
+    A[(y)+2] = B[(y)+2] ^ (~B[(y)+3] & B[(y)+4]);  A[(y)+3] = B[(y)+3] ^ (~B[(y)+4] & B[(y)]);   \
+    A[(y)+4] = B[(y)+4] ^ (~B[(y)]   & B[(y)+1])
+
+
+void KeccakF1600_StatePermute(uint64_t* A)
+{ // Keccak-f[1600] permutation, lane x+5y of the state at A[x+5y]
+  // The steps are unrolled with constant lane indices, so that the compiler keeps B, C and D in registers
+    unsigned int round;
+    uint64_t B[25], C[5], D[5];
+
+    for (round = 0; round < 24; round++) {
+        C[0] = A[0] ^ A[5] ^ A[10] ^ A[15] ^ A[20];                    // Theta
+        C[1] = A[1] ^ A[6] ^ A[11] ^ A[16] ^ A[21];
+        C[2] = A[2] ^ A[7] ^ A[12] ^ A[17] ^ A[22];
+        C[3] = A[3] ^ A[8] ^ A[13] ^ A[18] ^ A[23];
+        C[4] = A[4] ^ A[9] ^ A[14] ^ A[19] ^ A[24];
+        D[0] = C[4] ^ ROL64(C[1], 1);
+        D[1] = C[0] ^ ROL64(C[2], 1);
+        D[2] = C[1] ^ ROL64(C[3], 1);
+        D[3] = C[2] ^ ROL64(C[4], 1);
+        D[4] = C[3] ^ ROL64(C[0], 1);
+
+        RHO_PI( 0,  0,  0); RHO_PI( 1,  1, 10); RHO_PI( 2, 62, 20); RHO_PI( 3, 28,  5); RHO_PI( 4, 27, 15);
+        RHO_PI( 5, 36, 16); RHO_PI( 6, 44,  1); RHO_PI( 7,  6, 11); RHO_PI( 8, 55, 21); RHO_PI( 9, 20,  6);
+        RHO_PI(10,  3,  7); RHO_PI(11, 10, 17); RHO_PI(12, 43,  2); RHO_PI(13, 25, 12); RHO_PI(14, 39, 22);
+        RHO_PI(15, 41, 23); RHO_PI(16, 45,  8); RHO_PI(17, 15, 18); RHO_PI(18, 21,  3); RHO_PI(19,  8, 13);
+        RHO_PI(20, 18, 14); RHO_PI(21,  2, 24); RHO_PI(22, 61,  9); RHO_PI(23, 56, 19); RHO_PI(24, 14,  4);
+
+        CHI(0); CHI(5); CHI(10); CHI(15); CHI(20);
+        A[0] ^= KECCAK_RC[round];                                       // Iota
+    }
+}
+
+
+void KeccakF1600_StatePermute4x_generic(uint64_t* state)
+{ // Keccak-f[1600] permutation of 4 interleaved states, lane i of state j at state[4*i+j] (portable version)
+    unsigned int i, j;
+    uint64_t A[25];
+
+    for (j = 0; j < 4; j++) {
+        for (i = 0; i < 25; i++) {
+            A[i] = state[4*i+j];
+        }
+        KeccakF1600_StatePermute(A);
+        for (i = 0; i < 25; i++) {
+            state[4*i+j] = A[i];
+        }
+    }
+}
+
+
+static __inline void KeccakF1600_StatePermute4x(uint64_t* state)
+{
+#if defined(DISPATCH_SUPPORT)
+    backend_load()->KeccakF1600x4(state);
+#elif defined(ASM_SUPPORT)
+    KeccakF1600_StatePermute4x_asm(state);
+#else
+    KeccakF1600_StatePermute4x_generic(state);
+#endif
+}
+
+
+static __inline uint64_t load64(const unsigned char* x)
+{ // Little-endian load of a lane
+    unsigned int i;
+    uint64_t r = 0;
+
+    for (i = 0; i < 8; i++) {
+        r |= (uint64_t)x[i] << (8*i);
+    }
+    return r;
+}
+
+
+static void shake128_absorb4x(uint64_t* state, const unsigned char* input, unsigned int input_nbytes)
+{ // Absorbs input||j and the SHAKE padding into state j, j = 0,...,3
+    unsigned int i, j;
+    unsigned char block[SHAKE128_RATE];
+
+    memset(state, 0, 25*4*sizeof(uint64_t));
+    while (input_nbytes >= SHAKE128_RATE) {                              // Full blocks, the same for the 4 instances
+        for (i = 0; i < SHAKE128_LANES; i++) {
+            state[4*i] ^= load64(&input[8*i]);
+            state[4*i+1] = state[4*i+2] = state[4*i+3] = state[4*i];
+        }
+        KeccakF1600_StatePermute4x(state);
+        input += SHAKE128_RATE;
+        input_nbytes -= SHAKE128_RATE;
+    }
+
+    memset(block, 0, SHAKE128_RATE);
+    memcpy(block, input, input_nbytes);
+    if (input_nbytes+1 < SHAKE128_RATE) {
+        block[input_nbytes+1] = 0x1F;                                    // Domain separation and first padding bit
+        block[SHAKE128_RATE-1] |= 0x80;                                  // Last padding bit
+    }
+    for (j = 0; j < 4; j++) {
+        block[input_nbytes] = (unsigned char)j;                          // Instance index
+        for (i = 0; i < SHAKE128_LANES; i++) {
+            state[4*i+j] ^= load64(&block[8*i]);
+        }
+    }
+    if (input_nbytes+1 == SHAKE128_RATE) {                               // The index filled the block, the padding takes another one
+        KeccakF1600_StatePermute4x(state);
+        for (j = 0; j < 4; j++) {
+            state[j] ^= 0x1F;
+            state[4*(SHAKE128_LANES-1)+j] ^= (uint64_t)0x80 << 56;
+        }
+    }
+    KeccakF1600_StatePermute4x(state);
+}
+
+
+void shake128(unsigned char* output, unsigned int output_nbytes, const unsigned char* input, unsigned int input_nbytes)
+{ // SHAKE128 of one message, reference for the 4-way instances
+    unsigned int i;
+    uint64_t A[25];
+    unsigned char block[SHAKE128_RATE];
+
+    memset(A, 0, sizeof(A));
+    while (input_nbytes >= SHAKE128_RATE) {
+        for (i = 0; i < SHAKE128_LANES; i++) {
+            A[i] ^= load64(&input[8*i]);
+        }
+        KeccakF1600_StatePermute(A);
+        input += SHAKE128_RATE;
+        input_nbytes -= SHAKE128_RATE;
+    }
+    memset(block, 0, SHAKE128_RATE);
+    memcpy(block, input, input_nbytes);
+    block[input_nbytes] = 0x1F;
+    block[SHAKE128_RATE-1] |= 0x80;
+    for (i = 0; i < SHAKE128_LANES; i++) {
+        A[i] ^= load64(&block[8*i]);
+    }
+
+    while (output_nbytes > 0) {
+        KeccakF1600_StatePermute(A);
+        for (i = 0; i < SHAKE128_RATE && output_nbytes > 0; i++, output_nbytes--) {
+            *output++ = (unsigned char)(A[i/8] >> (8*(i%8)));
+        }
+    }
+}
+
+
+CRYPTO_STATUS LatticeCrypto_shake128(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array)
+{ // Output "array_ndigits" of values in [0, q-1] using 4 SHAKE128 instances on seed||0, ..., seed||3
+  // Instance j fills the j-th quarter of extended_array by rejection sampling of the 14 low bits of each 16-bit little-endian word
+    unsigned int i, j, k, count[4], first[4], last[4], done = 0, chunk = (array_ndigits+3)/4;
+    uint64_t state[25*4], lane;
+    unsigned char block[SHAKE128_RATE];
+
+    if (seed == NULL || extended_array == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+
+    for (j = 0; j < 4; j++) {
+        first[j] = (j*chunk < array_ndigits) ? j*chunk : array_ndigits;
+        last[j] = (first[j]+chunk < array_ndigits) ? first[j]+chunk : array_ndigits;
+        count[j] = first[j];
+        if (count[j] == last[j]) done++;
+    }
+
+    shake128_absorb4x(state, seed, seed_nbytes);
+    while (done < 4) {
+        for (j = 0; j < 4; j++) {
+            if (count[j] == last[j]) {
+                continue;
+            }
+            for (i = 0; i < SHAKE128_LANES; i++) {                       // Output block of instance j
+                lane = state[4*i+j];
+                for (k = 0; k < 8; k++) {
+                    block[8*i+k] = (unsigned char)(lane >> (8*k));
+                }
+            }
+            count[j] += LatticeCrypto_rejection_sample(&extended_array[count[j]], last[j]-count[j], block, SHAKE128_RATE);
+            if (count[j] == last[j]) {
+                done++;
+            }
+        }
+        if (done < 4) {
+            KeccakF1600_StatePermute4x(state);
+        }
+    }
+    clear_words((void*)state, NBYTES_TO_NWORDS(sizeof(state)));
+
+    return CRYPTO_SUCCESS;
+}
@@ -1,168 +1,400 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: additional functions for testing
-*
-*****************************************************************************************/
-
-
-#include "../LatticeCrypto_priv.h"
-#include "test_extras.h"
-#if (OS_TARGET == OS_WIN)
-    #include <windows.h>
-    #include <intrin.h>
-#endif
-#if (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM)
-    #include <time.h>
-#endif
-#include <stdlib.h> 
-
-
-int64_t cpucycles(void)
-{ // Access system counter for benchmarking
-#if (OS_TARGET == OS_WIN) && (TARGET == TARGET_AMD64 || TARGET == TARGET_x86)
-    return __rdtsc();
-#elif (OS_TARGET == OS_WIN) && (TARGET == TARGET_ARM)
-    return __rdpmccntr64();
-#elif (OS_TARGET == OS_LINUX) && (TARGET == TARGET_AMD64 || TARGET == TARGET_x86)
-    unsigned int hi, lo;
-
-    asm volatile ("rdtsc\n\t" : "=a" (lo), "=d"(hi));
-    return ((int64_t)lo) | (((int64_t)hi) << 32);
-#elif (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM)
-    struct timespec time;
-
-    clock_gettime(CLOCK_REALTIME, &time);
-    return (int64_t)(time.tv_sec*1e9 + time.tv_nsec);
-#else
-    return 0;            
-#endif
-}
-
-
-CRYPTO_STATUS random_bytes_test(unsigned int nbytes, unsigned char* random_array)
-{ // Generate "nbytes" of random values and output the result to random_array.
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-    unsigned int i;
-
-    for (i = 0; i < nbytes; i++) {
-        *(random_array + i) = (unsigned char)rand();    // nbytes of random values
-    }
-
-    return CRYPTO_SUCCESS;
-}
-
-
-CRYPTO_STATUS extendable_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array)
-{ // Generate "array_ndigits" of 32-bit values and output the result to extended_array.
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-    unsigned int count = 0;
-    uint32_t digit;
-
-    UNREFERENCED_PARAMETER(seed);
-    UNREFERENCED_PARAMETER(seed_nbytes);
-    UNREFERENCED_PARAMETER(array_ndigits);
-
-    srand((unsigned int)seed[0]);
-
-    while (count < array_ndigits) {
-        random_bytes_test(2, (unsigned char*)&digit);   // Pull 2 bytes to get a 14-bit value
-        digit &= 0x3FFF;
-        if (digit < PARAMETER_Q) {                      // Take it if it is in [0, q-1]
-            extended_array[count] = digit;
-            count++;
-        }
-    }
-
-    return CRYPTO_SUCCESS;
-}
-
-
-CRYPTO_STATUS stream_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array)
-{ // Generate "array_nbytes" of values and output the result to stream_array.
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-    
-    UNREFERENCED_PARAMETER(seed);
-    UNREFERENCED_PARAMETER(seed_nbytes);
-    UNREFERENCED_PARAMETER(nonce);
-    UNREFERENCED_PARAMETER(nonce_nbytes);
-
-    random_bytes_test(array_nbytes, stream_array); 
-
-    return CRYPTO_SUCCESS;
-}
-
-
-void random_poly_test(int32_t* a, unsigned int p, unsigned int pbits, unsigned int N)
-{ // Generating a pseudo-random polynomial a[x] over GF(p) 
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-    unsigned int i, mask = ((unsigned int)1 << pbits) - 1;
-    unsigned char* string = (unsigned char*)a;
-
-    for (i = 0; i < N; i++) {
-        do {
-            *(string + 4*i)     = (unsigned char)rand();      // Obtain GF(p) coefficient
-            *(string + 4*i + 1) = (unsigned char)rand();
-            a[i] &= mask;
-        } while (a[i] >= (int32_t)p);
-    }
-}
-
-
-int compare_poly(int32_t* a, int32_t* b, unsigned int N)
-{ // Comparing two polynomials over GF(p), a[x]=b[x]? : (0) a=b, (1) a!=b
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-    unsigned int i;
-
-    for (i = 0; i < N; i++)
-    {
-        if (a[i] != b[i]) 
-            return 1;
-    }
-
-    return 0; 
-}
-
-
-int reduce(int a, int p)
-{ // Modular reduction
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-    a %= p;
-    if (a < 0) a += p;
-
-    return a;
-}
-
-
-void mul_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N)                  
-{ // Polynomial multiplication using the schoolbook method, c[x] = a[x]*b[x] 
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.  
-    unsigned int i, j, index, mask = N - 1;
-
-     for (i = 0; i < N; i++) c[i] = 0;
-
-     for (i = 0; i < N; i++) {
-          for (j = 0; j < N; j++) {
-              index = (i+j) & mask;
-              if (i+j >= N) {
-                  c[index] = reduce(c[index] - (a[i]*b[j]), p);                
-              } else {
-                  c[index] = reduce(c[index] + (a[i]*b[j]), p); 
-              }
-          }
-     }
-}
-
-
-void add_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N)                  
-{ // Polynomial addition, c[x] = a[x] + b[x] 
-  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.    
-    unsigned int i;
-
-     for (i = 0; i < N; i++) {
-          c[i] = reduce(a[i] + b[i], p); 
-     }
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: additional functions for testing
+*
+*****************************************************************************************/
+
+
+#include "../LatticeCrypto_priv.h"
+#include "test_extras.h"
+#if (OS_TARGET == OS_WIN)
+    #include <windows.h>
+    #include <intrin.h>
+#endif
+#if (OS_TARGET == OS_LINUX)
+    #include <time.h>
+    #include <unistd.h>
+#endif
+#include <stdlib.h> 
+
+#if (OS_TARGET == OS_WIN)
+    #define THREAD_LOCAL __declspec(thread)
+#else
+    #define THREAD_LOCAL __thread
+#endif
+
+#define KARATSUBA_CUTOFF    32       // Size below which karatsuba_mul_test uses the schoolbook method
+
+static THREAD_LOCAL uint64_t prng_state = 0x9E3779B97F4A7C15;
+
+
+int64_t cpucycles(void)
+{ // Access system counter for benchmarking
+#if (OS_TARGET == OS_WIN) && (TARGET == TARGET_AMD64 || TARGET == TARGET_x86)
+    return __rdtsc();
+#elif (OS_TARGET == OS_WIN) && (TARGET == TARGET_ARM)
+    return __rdpmccntr64();
+#elif (OS_TARGET == OS_LINUX) && (TARGET == TARGET_AMD64 || TARGET == TARGET_x86)
+    unsigned int hi, lo;
+
+    asm volatile ("rdtsc\n\t" : "=a" (lo), "=d"(hi));
+    return ((int64_t)lo) | (((int64_t)hi) << 32);
+#elif (OS_TARGET == OS_LINUX) && (TARGET == TARGET_ARM)
+    struct timespec time;
+
+    clock_gettime(CLOCK_REALTIME, &time);
+    return (int64_t)(time.tv_sec*1e9 + time.tv_nsec);
+#else
+    return 0;            
+#endif
+}
+
+
+void sleep_ms_test(unsigned int ms)
+{ // Suspend the calling thread for about "ms" milliseconds
+#if (OS_TARGET == OS_WIN)
+    Sleep(ms);
+#else
+    struct timespec time;
+
+    time.tv_sec = ms/1000;
+    time.tv_nsec = (long)(ms%1000)*1000000;
+    nanosleep(&time, NULL);
+#endif
+}
+
+
+int64_t time_ns_test(void)
+{ // Wall-clock time in nanoseconds from a monotonic clock, for benchmarks across threads
+#if (OS_TARGET == OS_WIN)
+    LARGE_INTEGER count, frequency;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (int64_t)((double)count.QuadPart*1e9/(double)frequency.QuadPart);
+#else
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (int64_t)time.tv_sec*1000000000 + time.tv_nsec;
+#endif
+}
+
+
+unsigned int cpu_count_test(void)
+{ // Number of online logical processors, at least 1
+#if (OS_TARGET == OS_WIN)
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (info.dwNumberOfProcessors > 0) ? (unsigned int)info.dwNumberOfProcessors : 1;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (count > 0) ? (unsigned int)count : 1;
+#endif
+}
+
+
+CRYPTO_STATUS random_bytes_test(unsigned int nbytes, unsigned char* random_array)
+{ // Generate "nbytes" of random values and output the result to random_array.
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i;
+
+    for (i = 0; i < nbytes; i++) {
+        *(random_array + i) = (unsigned char)rand();    // nbytes of random values
+    }
+
+    return CRYPTO_SUCCESS;
+}
+
+
+CRYPTO_STATUS extendable_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array)
+{ // Generate "array_ndigits" of 32-bit values and output the result to extended_array.
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int count = 0;
+    unsigned char candidates[256];
+
+    UNREFERENCED_PARAMETER(seed_nbytes);
+
+    srand((unsigned int)seed[0]);
+
+    while (count < array_ndigits) {
+        random_bytes_test(sizeof(candidates), candidates);   // 2 bytes per 14-bit candidate, taken if it is in [0, q-1]
+        count += LatticeCrypto_rejection_sample(&extended_array[count], array_ndigits - count, candidates, sizeof(candidates));
+    }
+
+    return CRYPTO_SUCCESS;
+}
+
+
+CRYPTO_STATUS stream_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array)
+{ // Generate "array_nbytes" of values and output the result to stream_array.
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    
+    UNREFERENCED_PARAMETER(seed);
+    UNREFERENCED_PARAMETER(seed_nbytes);
+    UNREFERENCED_PARAMETER(nonce);
+    UNREFERENCED_PARAMETER(nonce_nbytes);
+
+    random_bytes_test(array_nbytes, stream_array); 
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void random_poly_test(int32_t* a, unsigned int p, unsigned int pbits, unsigned int N)
+{ // Generating a pseudo-random polynomial a[x] over GF(p) 
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i, mask = ((unsigned int)1 << pbits) - 1;
+    unsigned char* string = (unsigned char*)a;
+
+    for (i = 0; i < N; i++) {
+        do {
+            *(string + 4*i)     = (unsigned char)rand();      // Obtain GF(p) coefficient
+            *(string + 4*i + 1) = (unsigned char)rand();
+            a[i] &= mask;
+        } while (a[i] >= (int32_t)p);
+    }
+}
+
+
+static uint64_t xorshift64star(uint64_t* state)
+{ // One step of the xorshift64* generator
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1D;
+}
+
+
+void prng_seed_test(uint64_t seed)
+{ // Seed the pseudo-random generator of the calling thread
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    prng_state = seed ^ 0x9E3779B97F4A7C15;
+    if (prng_state == 0) prng_state = 1;
+}
+
+
+CRYPTO_STATUS random_bytes_prng_test(unsigned int nbytes, unsigned char* random_array)
+{ // Generate "nbytes" of random values from the generator of the calling thread
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i;
+    uint64_t digit = 0;
+
+    for (i = 0; i < nbytes; i++) {
+        if ((i & 7) == 0) digit = xorshift64star(&prng_state);
+        random_array[i] = (unsigned char)digit;
+        digit >>= 8;
+    }
+
+    return CRYPTO_SUCCESS;
+}
+
+
+CRYPTO_STATUS extendable_output_prng_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array)
+{ // Generate "array_ndigits" of 32-bit values in [0, q-1] from a generator seeded with all the bytes of the seed
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i, count = 0;
+    uint64_t state = 0xCBF29CE484222325, digit;
+
+    for (i = 0; i < seed_nbytes; i++) {
+        state = (state ^ seed[i]) * 0x100000001B3;      // FNV-1a hash of the seed
+    }
+    if (state == 0) state = 1;
+
+    while (count < array_ndigits) {
+        digit = xorshift64star(&state);
+        for (i = 0; i < 4 && count < array_ndigits; i++) {
+            if ((digit & 0x3FFF) < PARAMETER_Q) {       // Take 14-bit values in [0, q-1]
+                extended_array[count] = (uint32_t)(digit & 0x3FFF);
+                count++;
+            }
+            digit >>= 16;
+        }
+    }
+
+    return CRYPTO_SUCCESS;
+}
+
+
+CRYPTO_STATUS stream_output_prng_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array)
+{ // Generate "array_nbytes" of values from the generator of the calling thread
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    
+    UNREFERENCED_PARAMETER(seed);
+    UNREFERENCED_PARAMETER(seed_nbytes);
+    UNREFERENCED_PARAMETER(nonce);
+    UNREFERENCED_PARAMETER(nonce_nbytes);
+
+    return random_bytes_prng_test(array_nbytes, stream_array); 
+}
+
+
+void random_poly_prng_test(int32_t* a, unsigned int p, unsigned int N)
+{ // Generating a pseudo-random polynomial a[x] over GF(p), p < 2^16, from the generator of the calling thread
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i, bits = 1;
+    uint32_t digit;
+
+    while (((unsigned int)1 << bits) < p) bits++;
+    for (i = 0; i < N; i++) {
+        do {
+            digit = (uint32_t)(xorshift64star(&prng_state) >> 32) & (((uint32_t)1 << bits) - 1);
+        } while (digit >= p);
+        a[i] = (int32_t)digit;
+    }
+}
+
+
+int compare_poly(int32_t* a, int32_t* b, unsigned int N)
+{ // Comparing two polynomials over GF(p), a[x]=b[x]? : (0) a=b, (1) a!=b
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i;
+
+    for (i = 0; i < N; i++)
+    {
+        if (a[i] != b[i]) 
+            return 1;
+    }
+
+    return 0; 
+}
+
+
+int compare_poly16(int16_t* a, int16_t* b, unsigned int N)
+{ // Comparing two polynomials with 16-bit coefficients, a[x]=b[x]? : (0) a=b, (1) a!=b
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i;
+
+    for (i = 0; i < N; i++)
+    {
+        if (a[i] != b[i]) 
+            return 1;
+    }
+
+    return 0; 
+}
+
+
+int compare_poly16_32(int16_t* a, int32_t* b, unsigned int N)
+{ // Comparing a polynomial with 16-bit coefficients and one with 32-bit coefficients over GF(q), a[x]=b[x] mod q? : (0) a=b, (1) a!=b
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    unsigned int i;
+
+    for (i = 0; i < N; i++)
+    {
+        if (reduce((int)a[i], PARAMETER_Q) != reduce((int)b[i], PARAMETER_Q)) 
+            return 1;
+    }
+
+    return 0; 
+}
+
+
+int reduce(int a, int p)
+{ // Modular reduction
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+    a %= p;
+    if (a < 0) a += p;
+
+    return a;
+}
+
+
+void mul_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N)                  
+{ // Polynomial multiplication using the schoolbook method, c[x] = a[x]*b[x] 
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.  
+    unsigned int i, j, index, mask = N - 1;
+
+     for (i = 0; i < N; i++) c[i] = 0;
+
+     for (i = 0; i < N; i++) {
+          for (j = 0; j < N; j++) {
+              index = (i+j) & mask;
+              if (i+j >= N) {
+                  c[index] = reduce(c[index] - (a[i]*b[j]), p);                
+              } else {
+                  c[index] = reduce(c[index] + (a[i]*b[j]), p); 
+              }
+          }
+     }
+}
+
+
+static void karatsuba(const int64_t* a, const int64_t* b, int64_t* c, unsigned int n, int64_t* work)
+{ // Full product c[0..2n-2] = a[0..n-1]*b[0..n-1], with c[2n-1] = 0. The workspace holds 4n values
+    unsigned int i, j, h = n/2;
+    int64_t *sa = work, *sb = work + h, *m = work + n;
+
+    if (n <= KARATSUBA_CUTOFF) {
+        for (i = 0; i < 2*n; i++) c[i] = 0;
+        for (i = 0; i < n; i++) {
+            for (j = 0; j < n; j++) {
+                c[i+j] += a[i]*b[j];
+            }
+        }
+        return;
+    }
+
+    for (i = 0; i < h; i++) {
+        sa[i] = a[i] + a[i+h];
+        sb[i] = b[i] + b[i+h];
+    }
+    karatsuba(sa, sb, m, h, work + 2*n);            // m = (a0+a1)*(b0+b1)
+    karatsuba(a, b, c, h, work + 2*n);              // c[0..n-1] = a0*b0
+    karatsuba(a+h, b+h, c+n, h, work + 2*n);        // c[n..2n-1] = a1*b1
+    for (i = 0; i < n; i++) {
+        m[i] -= c[i] + c[i+n];
+    }
+    for (i = 0; i < n; i++) {
+        c[i+h] += m[i];
+    }
+}
+
+
+void karatsuba_mul_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N)                  
+{ // Polynomial multiplication using the Karatsuba method, c[x] = a[x]*b[x] mod (x^N + 1), N a power of 2
+  // The coefficients are accumulated in 64 bits and only reduced at the end
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.  
+    unsigned int i;
+    int64_t *aa, *bb, *cc, *work, t;
+    
+    aa = (int64_t*)calloc(N, sizeof(int64_t));
+    bb = (int64_t*)calloc(N, sizeof(int64_t));
+    cc = (int64_t*)calloc(2*N, sizeof(int64_t));
+    work = (int64_t*)calloc(4*N, sizeof(int64_t));                 // Workspace of karatsuba
+    if (aa != NULL && bb != NULL && cc != NULL && work != NULL) {
+        for (i = 0; i < N; i++) {
+            aa[i] = reduce(a[i], p);
+            bb[i] = reduce(b[i], p);
+        }
+        karatsuba(aa, bb, cc, N, work);
+        for (i = 0; i < N; i++) {
+            t = (cc[i] - cc[i+N]) % (int64_t)p;     // x^N = -1
+            c[i] = (int32_t)(t < 0 ? t + p : t);
+        }
+    } else {
+        mul_test(a, b, c, p, N);
+    }
+
+    free(aa);
+    free(bb);
+    free(cc);
+    free(work);
+}
+
+
+void add_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N)                  
+{ // Polynomial addition, c[x] = a[x] + b[x] 
+  // SECURITY NOTE: TO BE USED FOR TESTING ONLY.    
+    unsigned int i;
+
+     for (i = 0; i < N; i++) {
+          c[i] = reduce(a[i] + b[i], p); 
+     }
 }
\ No newline at end of file
@@ -1,65 +1,95 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: utility header file for tests
-*
-*****************************************************************************************/  
-
-#ifndef __TEST_EXTRAS_H__
-#define __TEST_EXTRAS_H__
-
-
-// For C++
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-
-#include "../LatticeCrypto_priv.h"
-
-    
-// Access system counter for benchmarking
-int64_t cpucycles(void);
-
-// Generate "nbytes" of random values and output the result to random_array.
-// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-CRYPTO_STATUS random_bytes_test(unsigned int nbytes, unsigned char* random_array); 
-
-// Generate "array_ndigits" of 32-bit values and output the result to extended_array.
-// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-CRYPTO_STATUS extendable_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array);
-    
-// Generate "array_nbytes" of values and output the result to stream_array.
-// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-CRYPTO_STATUS stream_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
-
-// Generating a pseudo-random polynomial a[x] over GF(p) 
-// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
-void random_poly_test(int32_t* a, unsigned int p, unsigned int pbits, unsigned int N);
-
-// Comparing two polynomials over GF(p), a[x]=b[x]? : (0) a=b, (1) a!=b
-// NOTE: TO BE USED FOR TESTING ONLY.
-int compare_poly(int32_t* a, int32_t* b, unsigned int N); 
-    
-// Modular reduction
-// NOTE: TO BE USED FOR TESTING ONLY.
-int reduce(int a, int p);
-
-// Polynomial multiplication using the schoolbook method, c[x] = a[x]*b[x]
-// NOTE: TO BE USED FOR TESTING ONLY.
-void mul_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N);                  
-
-// Polynomial addition, c[x] = a[x] + b[x]  
-// NOTE: TO BE USED FOR TESTING ONLY.
-void add_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N);
-
-
-#ifdef __cplusplus
-}
-#endif
-
-
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: utility header file for tests
+*
+*****************************************************************************************/  
+
+#ifndef __TEST_EXTRAS_H__
+#define __TEST_EXTRAS_H__
+
+
+// For C++
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include "../LatticeCrypto_priv.h"
+
+    
+// Access system counter for benchmarking
+int64_t cpucycles(void);
+
+// Suspend the calling thread for about "ms" milliseconds
+void sleep_ms_test(unsigned int ms);
+
+// Wall-clock time in nanoseconds from a monotonic clock
+int64_t time_ns_test(void);
+
+// Number of online logical processors, at least 1
+unsigned int cpu_count_test(void);
+
+// Generate "nbytes" of random values and output the result to random_array.
+// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+CRYPTO_STATUS random_bytes_test(unsigned int nbytes, unsigned char* random_array); 
+
+// Generate "array_ndigits" of 32-bit values and output the result to extended_array.
+// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+CRYPTO_STATUS extendable_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array);
+    
+// Generate "array_nbytes" of values and output the result to stream_array.
+// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+CRYPTO_STATUS stream_output_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
+
+// Generating a pseudo-random polynomial a[x] over GF(p) 
+// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+void random_poly_test(int32_t* a, unsigned int p, unsigned int pbits, unsigned int N);
+
+// Thread-safe variants of the functions above. Each thread draws from its own pseudo-random generator, seeded with prng_seed_test().
+// The extendable output only depends on the seed, so that both parties of a key exchange get the same values in any thread.
+// SECURITY NOTE: TO BE USED FOR TESTING ONLY.
+void prng_seed_test(uint64_t seed);
+CRYPTO_STATUS random_bytes_prng_test(unsigned int nbytes, unsigned char* random_array);
+CRYPTO_STATUS extendable_output_prng_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned int array_ndigits, uint32_t* extended_array);
+CRYPTO_STATUS stream_output_prng_test(const unsigned char* seed, unsigned int seed_nbytes, unsigned char* nonce, unsigned int nonce_nbytes, unsigned int array_nbytes, unsigned char* stream_array);
+void random_poly_prng_test(int32_t* a, unsigned int p, unsigned int N);
+
+// Comparing two polynomials over GF(p), a[x]=b[x]? : (0) a=b, (1) a!=b
+// NOTE: TO BE USED FOR TESTING ONLY.
+int compare_poly(int32_t* a, int32_t* b, unsigned int N); 
+    
+// Comparing two polynomials with 16-bit coefficients, a[x]=b[x]? : (0) a=b, (1) a!=b
+// NOTE: TO BE USED FOR TESTING ONLY.
+int compare_poly16(int16_t* a, int16_t* b, unsigned int N); 
+
+// Comparing polynomials with 16-bit and 32-bit coefficients over GF(q), a[x]=b[x] mod q? : (0) a=b, (1) a!=b
+// NOTE: TO BE USED FOR TESTING ONLY.
+int compare_poly16_32(int16_t* a, int32_t* b, unsigned int N); 
+    
+// Modular reduction
+// NOTE: TO BE USED FOR TESTING ONLY.
+int reduce(int a, int p);
+
+// Polynomial multiplication using the schoolbook method, c[x] = a[x]*b[x]
+// NOTE: TO BE USED FOR TESTING ONLY.
+void mul_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N);                  
+
+// Polynomial multiplication using the Karatsuba method, c[x] = a[x]*b[x]. Same output as mul_test for N a power of 2
+// NOTE: TO BE USED FOR TESTING ONLY.
+void karatsuba_mul_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N);
+
+// Polynomial addition, c[x] = a[x] + b[x]  
+// NOTE: TO BE USED FOR TESTING ONLY.
+void add_test(int32_t* a, int32_t* b, int32_t* c, uint32_t p, unsigned int N);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
 #endif
\ No newline at end of file
@@ -1,275 +1,3519 @@
-/****************************************************************************************
-* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
-*
-*    Copyright (c) Microsoft Corporation. All rights reserved.
-*
-*
-* Abstract: testing code
-*
-*****************************************************************************************/
-
-#include "../LatticeCrypto_priv.h"
-#include "test_extras.h"
-#include <stdio.h>
-#include <malloc.h>
-
-extern const int32_t psi_rev_ntt1024_12289[PARAMETER_N];
-extern const int32_t omegainv_rev_ntt1024_12289[PARAMETER_N];
-extern const int32_t omegainv7N_rev_ntt1024_12289;
-extern const int32_t omegainv10N_rev_ntt1024_12289;
-extern const int32_t Ninv8_ntt1024_12289;
-extern const int32_t Ninv11_ntt1024_12289;
-
-// Benchmark and test parameters  
-#define BENCH_LOOPS       1000       // Number of iterations per bench
-#define TEST_LOOPS        100        // Number of iterations per test
-
-
-bool ntt_test()
-{ // Tests for the NTT functions
-    bool OK = true;
-    int n, passed;
-    int32_t a[PARAMETER_N], b[PARAMETER_N], c[PARAMETER_N], d[PARAMETER_N], e[PARAMETER_N], f[PARAMETER_N], g[PARAMETER_N], ff[PARAMETER_N];
-    unsigned int pbits = 14;
-
-    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
-    printf("Testing NTT functions: \n\n"); 
-
-    passed = 1;
-    for (n=0; n<TEST_LOOPS; n++)
-    {   
-        // Testing NTT-based polynomial multiplication
-        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N); 
-
-        mul_test(a, b, c, PARAMETER_Q, PARAMETER_N);
-        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
-        NTT_CT_std2rev_12289(b, psi_rev_ntt1024_12289, PARAMETER_N);
-        pmul(a, b, d, PARAMETER_N);
-        correction(d, PARAMETER_Q, PARAMETER_N);
-        INTT_GS_rev2std_12289(d, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
-        two_reduce12289(d, PARAMETER_N);
-        correction(d, PARAMETER_Q, PARAMETER_N);
-        if (compare_poly(c, d, PARAMETER_N)!=0) { passed = 0; break; }
-                
-        // Emulating NTT operations in the key exchange                
-        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N); 
-        random_poly_test(c, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(d, PARAMETER_Q, pbits, PARAMETER_N); 
-        random_poly_test(e, PARAMETER_Q, pbits, PARAMETER_N); 
-
-        mul_test(a, b, f, PARAMETER_Q, PARAMETER_N);
-        add_test(f, c, f, PARAMETER_Q, PARAMETER_N);
-        mul_test(f, d, ff, PARAMETER_Q, PARAMETER_N);
-        add_test(ff, e, f, PARAMETER_Q, PARAMETER_N);
-        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
-        NTT_CT_std2rev_12289(b, psi_rev_ntt1024_12289, PARAMETER_N);
-        NTT_CT_std2rev_12289(c, psi_rev_ntt1024_12289, PARAMETER_N);
-        smul(c, 3, PARAMETER_N);
-        pmuladd(a, b, c, g, PARAMETER_N);
-        correction(g, PARAMETER_Q, PARAMETER_N);
-        NTT_CT_std2rev_12289(d, psi_rev_ntt1024_12289, PARAMETER_N);
-        NTT_CT_std2rev_12289(e, psi_rev_ntt1024_12289, PARAMETER_N);
-        smul(e, 81, PARAMETER_N);
-        pmuladd(g, d, e, g, PARAMETER_N);
-        correction(g, PARAMETER_Q, PARAMETER_N);
-        INTT_GS_rev2std_12289(g, omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PARAMETER_N);
-        two_reduce12289(g, PARAMETER_N);
-        correction(g, PARAMETER_Q, PARAMETER_N);
-        if (compare_poly(f, g, PARAMETER_N)!=0) { passed = 0; break; }
-    } 
-    if (passed==1) printf("  INTT/NTT tests................................................................. PASSED");
-    else { printf("  NTT/INTT tests... FAILED"); printf("\n"); return false; }
-    printf("\n");
-    
-    return OK;
-}
-
-
-bool ntt_run()
-{
-    bool OK = true;
-    int n;
-    unsigned long long cycles, cycles1, cycles2;
-    int32_t a[PARAMETER_N];
-
-    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
-    printf("Benchmarking NTT functions: \n\n");
-    
-    cycles = 0;
-    for (n=0; n<BENCH_LOOPS; n++)
-    {
-        cycles1 = cpucycles(); 
-        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
-        cycles2 = cpucycles();
-        cycles = cycles+(cycles2-cycles1);
-    }
-    printf("  NTT runs in ................................................................... %8lld cycles", cycles/BENCH_LOOPS);
-    printf("\n"); 
-    
-    cycles = 0;
-    for (n=0; n<BENCH_LOOPS; n++)
-    {
-        cycles1 = cpucycles(); 
-        INTT_GS_rev2std_12289(a, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
-        cycles2 = cpucycles();
-        cycles = cycles+(cycles2-cycles1);
-    }
-    printf("  INTT runs in .................................................................. %8lld cycles", cycles/BENCH_LOOPS);
-    printf("\n"); 
-    
-    return OK;
-}
-
-
-CRYPTO_STATUS kex_test()
-{ // Tests for the key exchange
-    int n, passed;
-    int32_t SecretKeyA[PARAMETER_N];
-    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
-    PLatticeCryptoStruct pLatticeCrypto;
-    RandomBytes RandomBytesFunction = random_bytes_test;
-    ExtendableOutput ExtendableOutputFunction = extendable_output_test;
-    StreamOutput StreamOutputFunction = stream_output_test;
-    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
-
-    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
-    printf("Testing the key exchange: \n\n"); 
-
-    pLatticeCrypto = LatticeCrypto_allocate();
-    Status = LatticeCrypto_initialize(pLatticeCrypto, RandomBytesFunction, ExtendableOutputFunction, StreamOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-
-    passed = 1;
-    for (n=0; n<TEST_LOOPS; n++)
-    {   
-        Status = KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
-        if (Status != CRYPTO_SUCCESS) {
-            goto cleanup;
-        }    
-        Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
-        if (Status != CRYPTO_SUCCESS) {
-            goto cleanup;
-        }    
-        Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
-        if (Status != CRYPTO_SUCCESS) {
-            goto cleanup;
-        }    
-
-        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
-    } 
-    if (passed==1) printf("  Key exchange tests............................................................. PASSED");
-    else { printf("  Key exchange tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
-    printf("\n");
-    
-cleanup:
-    free(pLatticeCrypto);
-    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)PublicKeyA, NBYTES_TO_NWORDS(PKA_BYTES));
-    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
-    clear_words((void*)PublicKeyB, NBYTES_TO_NWORDS(PKB_BYTES));
-    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
-    
-    return Status;
-}
-
-
-CRYPTO_STATUS kex_run()
-{
-    int n;
-    unsigned long long cycles, cycles1, cycles2;
-    int32_t SecretKeyA[PARAMETER_N];
-    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
-    PLatticeCryptoStruct pLatticeCrypto;
-    RandomBytes RandomBytesFunction = random_bytes_test;
-    ExtendableOutput ExtendableOutputFunction = extendable_output_test;
-    StreamOutput StreamOutputFunction = stream_output_test;
-    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
-
-    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
-    printf("Benchmarking key exchange functions: \n\n");  
-    
-    pLatticeCrypto = LatticeCrypto_allocate();
-    Status = LatticeCrypto_initialize(pLatticeCrypto, RandomBytesFunction, ExtendableOutputFunction, StreamOutputFunction);
-    if (Status != CRYPTO_SUCCESS) {
-        goto cleanup;
-    }
-    
-    cycles = 0;
-    for (n=0; n<BENCH_LOOPS; n++)
-    {
-        cycles1 = cpucycles(); 
-        Status = KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
-        if (Status != CRYPTO_SUCCESS) {
-            goto cleanup;
-        }    
-        cycles2 = cpucycles();
-        cycles = cycles+(cycles2-cycles1);
-    }
-    printf("  Alice's key generation runs in ................................................ %8lld cycles", cycles/BENCH_LOOPS);
-    printf("\n");   
-    
-    cycles = 0;
-    for (n=0; n<BENCH_LOOPS; n++)
-    {
-        cycles1 = cpucycles(); 
-        Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
-        if (Status != CRYPTO_SUCCESS) {
-            goto cleanup;
-        }    
-        cycles2 = cpucycles();
-        cycles = cycles+(cycles2-cycles1);
-    }
-    printf("  Bob's shared key computation runs in .......................................... %8lld cycles", cycles/BENCH_LOOPS);
-    printf("\n");   
-    
-    cycles = 0;
-    for (n=0; n<BENCH_LOOPS; n++)
-    {
-        cycles1 = cpucycles(); 
-        Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
-        if (Status != CRYPTO_SUCCESS) {
-            goto cleanup;
-        }    
-        cycles2 = cpucycles();
-        cycles = cycles+(cycles2-cycles1);
-    }
-    printf("  Alice's shared key computation runs in ........................................ %8lld cycles", cycles/BENCH_LOOPS);
-    printf("\n");
-    
-cleanup:
-    free(pLatticeCrypto);
-    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
-    clear_words((void*)PublicKeyA, NBYTES_TO_NWORDS(PKA_BYTES));
-    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
-    clear_words((void*)PublicKeyB, NBYTES_TO_NWORDS(PKB_BYTES));
-    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES)); 
-    
-    return Status;
-}
-
-
-int main()
-{
-    bool OK = true;
-    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
-
-    OK = OK && ntt_test();   // Test NTT functions
-    OK = OK && ntt_run();    // Benchmark NTT functions
-    if (OK == false) {
-        return true;
-    }
-
-    Status = kex_test();     // Test key exchange 
-    if (Status != CRYPTO_SUCCESS) {
-        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
-        return false;
-    }
-    Status = kex_run();      // Benchmark key exchange
-    if (Status != CRYPTO_SUCCESS) {
-        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
-        return false;
-    }
-
-    return true;
-}
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: testing code
+*
+*****************************************************************************************/
+
+#include "../LatticeCrypto_priv.h"
+#include "test_extras.h"
+#include <stdio.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+#if (OS_TARGET == OS_LINUX)
+    #include <pthread.h>
+#endif
+
+extern const int32_t psi_rev_ntt1024_12289[PARAMETER_N];
+extern const int32_t psi_rev3_ntt1024_12289[PARAMETER_N];
+extern const int32_t psi_rev81_ntt1024_12289[PARAMETER_N];
+extern const int32_t omegainv_rev_ntt1024_12289[PARAMETER_N];
+extern const int32_t omegainv7N_rev_ntt1024_12289;
+extern const int32_t omegainv10N_rev_ntt1024_12289;
+extern const int32_t Ninv8_ntt1024_12289;
+extern const int32_t Ninv11_ntt1024_12289;
+extern const int16_t psi_rev_ntt1024_12289_int16[PARAMETER_N];
+extern const int16_t psi_rev3_ntt1024_12289_int16[PARAMETER_N];
+extern const int16_t psi_rev81_ntt1024_12289_int16[PARAMETER_N];
+extern const int16_t omegainv_rev_ntt1024_12289_int16[PARAMETER_N];
+extern const int16_t omegainv10N_rev_ntt1024_12289_int16;
+extern const int16_t Ninv11_ntt1024_12289_int16;
+
+// Benchmark and test parameters  
+#define BENCH_LOOPS       1000       // Number of iterations per bench
+#define TEST_LOOPS        100        // Number of iterations per test
+#define NTT_BATCH         4          // Number of polynomials per batched NTT
+#define DIFF_THREADS      4          // Number of threads of the differential tests
+#define WORKER_THREADS    4          // Number of threads of the worker pool tests
+#define WORKER_HANDSHAKES 64         // Number of handshakes of the worker pool tests
+#define WORKER_BENCH      256        // Number of handshakes per thread count of the worker pool benchmark
+#if !defined(DIFF_LOOPS)
+    #define DIFF_LOOPS    1000       // Number of products and key exchanges of the differential tests, set with DIFF_LOOPS=n in the makefile
+#endif
+
+
+bool ntt_test()
+{ // Tests for the NTT functions
+    bool OK = true;
+    int n, passed;
+    int32_t a[PARAMETER_N], b[PARAMETER_N], c[PARAMETER_N], d[PARAMETER_N], e[PARAMETER_N], f[PARAMETER_N], g[PARAMETER_N], ff[PARAMETER_N];
+    int32_t batch[NTT_BATCH][PARAMETER_N], single[NTT_BATCH][PARAMETER_N], *pbatch[NTT_BATCH];
+    unsigned int i, j, pbits = 14;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing NTT functions: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        // Testing NTT-based polynomial multiplication
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N); 
+
+        mul_test(a, b, c, PARAMETER_Q, PARAMETER_N);
+        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289(b, psi_rev_ntt1024_12289, PARAMETER_N);
+        pmul(a, b, d, PARAMETER_N);
+        correction(d, PARAMETER_Q, PARAMETER_N);
+        INTT_GS_rev2std_12289(d, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        two_reduce12289(d, PARAMETER_N);
+        correction(d, PARAMETER_Q, PARAMETER_N);
+        if (compare_poly(c, d, PARAMETER_N)!=0) { passed = 0; break; }
+                
+        // Emulating NTT operations in the key exchange                
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N); 
+        random_poly_test(c, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(d, PARAMETER_Q, pbits, PARAMETER_N); 
+        random_poly_test(e, PARAMETER_Q, pbits, PARAMETER_N); 
+
+        mul_test(a, b, f, PARAMETER_Q, PARAMETER_N);
+        add_test(f, c, f, PARAMETER_Q, PARAMETER_N);
+        mul_test(f, d, ff, PARAMETER_Q, PARAMETER_N);
+        add_test(ff, e, f, PARAMETER_Q, PARAMETER_N);
+        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289(b, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289(c, psi_rev_ntt1024_12289, PARAMETER_N);
+        smul(c, 3, PARAMETER_N);
+        pmuladd(a, b, c, g, PARAMETER_N);
+        correction(g, PARAMETER_Q, PARAMETER_N);
+        NTT_CT_std2rev_12289(d, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289(e, psi_rev_ntt1024_12289, PARAMETER_N);
+        smul(e, 81, PARAMETER_N);
+        pmuladd(g, d, e, g, PARAMETER_N);
+        correction(g, PARAMETER_Q, PARAMETER_N);
+        INTT_GS_rev2std_12289(g, omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PARAMETER_N);
+        two_reduce12289(g, PARAMETER_N);
+        correction(g, PARAMETER_Q, PARAMETER_N);
+        if (compare_poly(f, g, PARAMETER_N)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  INTT/NTT tests................................................................. PASSED");
+    else { printf("  NTT/INTT tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        // Testing batched NTT/INTT against one-at-a-time transforms
+        for (i=0; i<NTT_BATCH; i++) {
+            random_poly_test(batch[i], PARAMETER_Q, pbits, PARAMETER_N);
+            for (j=0; j<PARAMETER_N; j++) single[i][j] = batch[i][j];
+            pbatch[i] = batch[i];
+        }
+
+        NTT_CT_std2rev_12289_xN(pbatch, NTT_BATCH, psi_rev_ntt1024_12289, PARAMETER_N);
+        for (i=0; i<NTT_BATCH; i++) {
+            NTT_CT_std2rev_12289(single[i], psi_rev_ntt1024_12289, PARAMETER_N);
+            if (compare_poly(batch[i], single[i], PARAMETER_N)!=0) { passed = 0; break; }
+        }
+        if (passed==0) break;
+
+        INTT_GS_rev2std_12289_xN(pbatch, NTT_BATCH, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        for (i=0; i<NTT_BATCH; i++) {
+            INTT_GS_rev2std_12289(single[i], omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+            if (compare_poly(batch[i], single[i], PARAMETER_N)!=0) { passed = 0; break; }
+        }
+        if (passed==0) break;
+    } 
+    if (passed==1) printf("  Batched INTT/NTT tests......................................................... PASSED");
+    else { printf("  Batched NTT/INTT tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        // Testing the NTT with scaled tables against NTT followed by smul
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N);
+        for (j=0; j<PARAMETER_N; j++) { b[j] = a[j]; c[j] = a[j]; d[j] = a[j]; }
+        pbatch[0] = c; pbatch[1] = d;
+
+        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289(b, psi_rev3_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289_xN(pbatch, 2, psi_rev81_ntt1024_12289, PARAMETER_N);
+        for (j=0; j<PARAMETER_N; j++) {
+            if (reduce(3*a[j], PARAMETER_Q) != reduce(b[j], PARAMETER_Q) || reduce(81*a[j], PARAMETER_Q) != reduce(c[j], PARAMETER_Q) || 
+                reduce(81*a[j], PARAMETER_Q) != reduce(d[j], PARAMETER_Q)) { passed = 0; break; }
+        }
+        if (passed==0) break;
+    } 
+    if (passed==1) printf("  Scaled NTT tests............................................................... PASSED");
+    else { printf("  Scaled NTT tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+    
+    return OK;
+}
+
+
+bool ntt_run()
+{
+    bool OK = true;
+    int n;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t a[PARAMETER_N];
+    int32_t batch[NTT_BATCH][PARAMETER_N] = {{0}}, *pbatch[NTT_BATCH];
+    unsigned int i;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Benchmarking NTT functions: \n\n");
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  NTT runs in ................................................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n"); 
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        INTT_GS_rev2std_12289(a, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  INTT runs in .................................................................. %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n"); 
+    
+    for (i=0; i<NTT_BATCH; i++) {
+        pbatch[i] = batch[i];
+    }
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        NTT_CT_std2rev_12289_xN(pbatch, NTT_BATCH, psi_rev_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  NTT (4-way batch, per polynomial) runs in ..................................... %8lld cycles", cycles/(BENCH_LOOPS*NTT_BATCH));
+    printf("\n"); 
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        INTT_GS_rev2std_12289_xN(pbatch, NTT_BATCH, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  INTT (4-way batch, per polynomial) runs in .................................... %8lld cycles", cycles/(BENCH_LOOPS*NTT_BATCH));
+    printf("\n"); 
+    
+    return OK;
+}
+
+
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+
+bool avx512_test()
+{ // Tests for the AVX-512 kernels against the AVX2 kernels
+    int n, passed;
+    int32_t a[PARAMETER_N], b[PARAMETER_N], c[PARAMETER_N], d[PARAMETER_N], e[PARAMETER_N], f[PARAMETER_N];
+    unsigned char m1[PKB_BYTES], m2[PKB_BYTES], key1[SHAREDKEY_BYTES], key2[SHAREDKEY_BYTES];
+    uint32_t rvec[PARAMETER_N];
+    unsigned int i, pbits = 14;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing AVX-512 kernels against AVX2 kernels: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N);
+        random_poly_test(c, PARAMETER_Q, pbits, PARAMETER_N);
+        for (i=0; i<PARAMETER_N; i++) { d[i] = a[i]; e[i] = b[i]; }
+
+        NTT_CT_std2rev_12289_avx512_asm(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289_asm(d, psi_rev_ntt1024_12289, PARAMETER_N);
+        if (compare_poly(a, d, PARAMETER_N)!=0) { passed = 0; break; }
+        NTT_CT_std2rev_12289_avx512_asm(b, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289_asm(e, psi_rev_ntt1024_12289, PARAMETER_N);
+
+        pmul_avx512_asm(a, b, d, PARAMETER_N);
+        pmul_asm(a, b, f, PARAMETER_N);
+        if (compare_poly(d, f, PARAMETER_N)!=0) { passed = 0; break; }
+        pmuladd_avx512_asm(a, b, c, d, PARAMETER_N);
+        pmuladd_asm(a, b, c, f, PARAMETER_N);
+        if (compare_poly(d, f, PARAMETER_N)!=0) { passed = 0; break; }
+
+        for (i=0; i<PARAMETER_N; i++) e[i] = d[i];
+        INTT_GS_rev2std_12289_avx512_asm(d, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        two_reduce12289_avx512_asm(d, PARAMETER_N);
+        correction(d, PARAMETER_Q, PARAMETER_N);
+        INTT_GS_rev2std_12289_asm(e, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        two_reduce12289_asm(e, PARAMETER_N);
+        correction(e, PARAMETER_Q, PARAMETER_N);
+        if (compare_poly(d, e, PARAMETER_N)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  AVX-512 NTT/INTT and pointwise tests........................................... PASSED");
+    else { printf("  AVX-512 NTT/INTT and pointwise tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N);
+        random_bytes_test(PKB_BYTES, m1);
+        for (i=0; i<PKB_BYTES; i++) m2[i] = m1[i];
+
+        encode_avx512_asm((uint32_t*)a, m1);
+        encode_asm((uint32_t*)a, m2);
+        for (i=0; i<PKB_BYTES; i++) { if (m1[i] != m2[i]) { passed = 0; break; } }
+        if (passed==0) break;
+        decode_avx512_asm(m1, (uint32_t*)b);
+        if (compare_poly(a, b, PARAMETER_N)!=0) { passed = 0; break; }
+
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N);
+        for (i=0; i<PARAMETER_N; i++) rvec[i] = (uint32_t)(rand() & 0x03);
+        rec_avx512_asm((uint32_t*)a, rvec, key1);
+        rec_asm((uint32_t*)a, rvec, key2);
+        for (i=0; i<SHAREDKEY_BYTES; i++) { if (key1[i] != key2[i]) { passed = 0; break; } }
+        if (passed==0) break;
+    } 
+    if (passed==1) printf("  AVX-512 encoding and reconciliation tests...................................... PASSED");
+    else { printf("  AVX-512 encoding and reconciliation tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+    
+    return true;
+}
+
+
+bool avx512_run()
+{ // Benchmark the AVX-512 kernels against the AVX2 kernels
+    int n;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t a[PARAMETER_N] = {0};
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Benchmarking AVX-512 kernels against AVX2 kernels: \n\n");
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        NTT_CT_std2rev_12289_asm(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  NTT (AVX2) runs in ............................................................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n"); 
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        NTT_CT_std2rev_12289_avx512_asm(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  NTT (AVX-512) runs in ......................................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n"); 
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        INTT_GS_rev2std_12289_asm(a, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  INTT (AVX2) runs in ........................................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n"); 
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        INTT_GS_rev2std_12289_avx512_asm(a, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  INTT (AVX-512) runs in ........................................................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n"); 
+    
+    return true;
+}
+
+#endif
+
+#if defined(VECTOR_SUPPORT)
+
+bool vector_test()
+{ // Tests for the vectorized kernels against the scalar kernels
+    int n, passed;
+    int32_t a[PARAMETER_N_MAX], b[PARAMETER_N_MAX], c[PARAMETER_N_MAX], d[PARAMETER_N_MAX], e[PARAMETER_N_MAX], f[PARAMETER_N_MAX];
+    const LatticeCryptoParams* params[3] = {&params_ntt512_12289, &params_ntt1024_12289, &params_ntt2048_12289};
+    unsigned char m1[PKB_BYTES], m2[PKB_BYTES], key1[SHAREDKEY_BYTES], key2[SHAREDKEY_BYTES], random_bits[PARAMETER_N/32], stream[3*PARAMETER_N];
+    uint32_t rvec1[PARAMETER_N], rvec2[PARAMETER_N];
+    unsigned int i, N, pbits = 14;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing vectorized kernels against scalar kernels: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS && passed==1; n++)
+    {   
+        for (i=0; i<3; i++) {
+            N = params[i]->N;
+            random_poly_test(a, PARAMETER_Q, pbits, N); random_poly_test(b, PARAMETER_Q, pbits, N);
+            random_poly_test(c, PARAMETER_Q, pbits, N);
+            memcpy(d, a, N*sizeof(int32_t)); memcpy(e, b, N*sizeof(int32_t));
+
+            NTT_CT_std2rev_12289_vector(a, params[i]->psi_rev81, N);
+            NTT_CT_std2rev_12289_generic(d, params[i]->psi_rev81, N);
+            if (compare_poly(a, d, N)!=0) { passed = 0; break; }
+            NTT_CT_std2rev_12289_vector(b, params[i]->psi_rev, N);
+            NTT_CT_std2rev_12289_generic(e, params[i]->psi_rev, N);
+            if (compare_poly(b, e, N)!=0) { passed = 0; break; }
+
+            pmul_vector(a, b, d, N);
+            pmul_generic(a, b, f, N);
+            if (compare_poly(d, f, N)!=0) { passed = 0; break; }
+            pmuladd_vector(a, b, c, d, N);
+            pmuladd_generic(a, b, c, f, N);
+            if (compare_poly(d, f, N)!=0) { passed = 0; break; }
+
+            INTT_GS_rev2std_12289_vector(d, params[i]->omegainv_rev, params[i]->omegainv1N_rev, params[i]->Ninv, N);
+            INTT_GS_rev2std_12289_generic(f, params[i]->omegainv_rev, params[i]->omegainv1N_rev, params[i]->Ninv, N);
+            if (compare_poly(d, f, N)!=0) { passed = 0; break; }
+            two_reduce12289_vector(d, N);
+            two_reduce12289_generic(f, N);
+            if (compare_poly(d, f, N)!=0) { passed = 0; break; }
+        }
+    } 
+    if (passed==1) printf("  Vectorized NTT/INTT and pointwise tests........................................ PASSED");
+    else { printf("  Vectorized NTT/INTT and pointwise tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N);
+        random_bytes_test(PKB_BYTES, m1);
+        memcpy(m2, m1, PKB_BYTES);
+        encode_vector((uint32_t*)a, m1);
+        encode_generic((uint32_t*)a, m2);
+        if (memcmp(m1, m2, PKB_BYTES) != 0) { passed = 0; break; }
+        decode_vector(m1, (uint32_t*)b);
+        if (compare_poly(a, b, PARAMETER_N)!=0) { passed = 0; break; }
+
+        random_bytes_test(PARAMETER_N/32, random_bits);
+        helprec_vector((uint32_t*)a, rvec1, random_bits);
+        helprec_generic((uint32_t*)a, rvec2, random_bits);
+        if (compare_poly((int32_t*)rvec1, (int32_t*)rvec2, PARAMETER_N)!=0) { passed = 0; break; }
+        random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N);
+        rec_vector((uint32_t*)b, rvec1, key1);
+        rec_generic((uint32_t*)b, rvec1, key2);
+        if (memcmp(key1, key2, SHAREDKEY_BYTES) != 0) { passed = 0; break; }
+        rec_vector((uint32_t*)a, rvec1, key1);
+        rec_generic((uint32_t*)a, rvec1, key2);
+        if (memcmp(key1, key2, SHAREDKEY_BYTES) != 0) { passed = 0; break; }
+
+        random_bytes_test(3*PARAMETER_N, stream);
+        error_sampling_vector(stream, a);
+        error_sampling_generic(stream, b);
+        if (compare_poly(a, b, PARAMETER_N)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  Vectorized encoding, reconciliation and sampling tests......................... PASSED");
+    else { printf("  Vectorized encoding, reconciliation and sampling tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+    
+    return true;
+}
+
+
+bool vector_run()
+{ // Benchmark the vectorized kernels against the scalar kernels
+    int n;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t a[PARAMETER_N] = {0};
+    uint32_t rvec[PARAMETER_N] = {0};
+    unsigned char random_bits[PARAMETER_N/32] = {0}, stream[3*PARAMETER_N] = {0};
+    void (*ntt[2])(int32_t*, const int32_t*, unsigned int) = {NTT_CT_std2rev_12289_generic, NTT_CT_std2rev_12289_vector};
+    void (*intt[2])(int32_t*, const int32_t*, const int32_t, const int32_t, unsigned int) = {INTT_GS_rev2std_12289_generic, INTT_GS_rev2std_12289_vector};
+    void (*helprec[2])(const uint32_t*, uint32_t*, unsigned char*) = {helprec_generic, helprec_vector};
+    void (*sampling[2])(unsigned char*, int32_t*) = {error_sampling_generic, error_sampling_vector};
+    const char* name[2] = {"scalar", "vector"};
+    unsigned int k;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Benchmarking vectorized kernels against scalar kernels: \n\n");
+    
+    for (k = 0; k < 2; k++) {
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            ntt[k](a, psi_rev_ntt1024_12289, PARAMETER_N);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  NTT (%s) runs in .......................................................... %8lld cycles", name[k], cycles/BENCH_LOOPS);
+        printf("\n"); 
+    }
+    
+    for (k = 0; k < 2; k++) {
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            intt[k](a, omegainv_rev_ntt1024_12289, omegainv7N_rev_ntt1024_12289, Ninv8_ntt1024_12289, PARAMETER_N);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  INTT (%s) runs in ......................................................... %8lld cycles", name[k], cycles/BENCH_LOOPS);
+        printf("\n"); 
+    }
+    
+    for (k = 0; k < 2; k++) {
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            helprec[k]((uint32_t*)a, rvec, random_bits);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  HelpRec (%s) runs in ...................................................... %8lld cycles", name[k], cycles/BENCH_LOOPS);
+        printf("\n"); 
+    }
+    
+    for (k = 0; k < 2; k++) {
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            sampling[k](stream, a);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  Error sampling (%s) runs in ............................................... %8lld cycles", name[k], cycles/BENCH_LOOPS);
+        printf("\n"); 
+    }
+    
+    return true;
+}
+
+#endif
+
+static void error_sampling_reference(unsigned char* stream, int32_t* e)
+{ // Error sampling bit by bit of 32-bit words, reference for the portable kernels
+    unsigned int i, j;
+    uint32_t acc1, acc2, temp;  
+    uint8_t *pacc1 = (uint8_t*)&acc1, *pacc2 = (uint8_t*)&acc2;
+    uint32_t* pstream = (uint32_t*)stream;
+
+    for (i = 0; i < PARAMETER_N/4; i++)
+    {
+        acc1 = 0;
+        acc2 = 0;
+        for (j = 0; j < 8; j++) {
+            acc1 += (pstream[i] >> j) & 0x01010101;
+            acc2 += (pstream[i+PARAMETER_N/4] >> j) & 0x01010101;
+        }
+        for (j = 0; j < 4; j++) {
+            temp = pstream[i+2*PARAMETER_N/4] >> j;
+            acc1 += temp & 0x01010101;
+            acc2 += (temp >> 4) & 0x01010101;
+        }
+        e[2*i]   = pacc1[0] - pacc1[1];
+        e[2*i+1] = pacc1[2] - pacc1[3];
+        e[2*i+PARAMETER_N/2]   = pacc2[0] - pacc2[1];
+        e[2*i+PARAMETER_N/2+1] = pacc2[2] - pacc2[3];
+    }
+}
+
+
+static void error_sampling_width_reference(unsigned char* stream, int32_t* e, unsigned int N, unsigned int noise_k)
+{ // Error sampling of width noise_k bit by bit, reference for error_sampling_poly
+  // Coefficients c and c+N/2 count the bits of bytes 2c and 2c+1 of the first and second N-byte parts, if noise_k >= 8, and of the low and
+  // high nibbles of the same bytes of the last part, if noise_k is not a multiple of 8
+    unsigned int c, h, j;
+    unsigned char* last = &stream[(noise_k/8)*2*N];
+    int32_t pos, neg;
+
+    for (c = 0; c < N/2; c++) {
+        for (h = 0; h < 2; h++) {
+            pos = 0;
+            neg = 0;
+            for (j = 0; j < 8; j++) {
+                if (noise_k >= 8) {
+                    pos += (stream[h*N+2*c] >> j) & 1;
+                    neg += (stream[h*N+2*c+1] >> j) & 1;
+                }
+                if (noise_k % 8 != 0 && j/4 == h) {
+                    pos += (last[2*c] >> j) & 1;
+                    neg += (last[2*c+1] >> j) & 1;
+                }
+            }
+            e[c+h*N/2] = pos - neg;
+        }
+    }
+}
+
+
+bool sampling_test()
+{ // Tests for the error sampling kernel in use against the portable one
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    unsigned char stream[3*PARAMETER_N];
+    int32_t e1[PARAMETER_N], e2[PARAMETER_N];
+    int16_t e3[PARAMETER_N];
+    unsigned int i;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing error sampling: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        random_bytes_test(3*PARAMETER_N, stream);
+        error_sampling_reference(stream, e1);
+        error_sampling_generic(stream, e2);
+        if (compare_poly(e1, e2, PARAMETER_N)!=0) { passed = 0; break; }
+        error_sampling_int16_generic(stream, e3);
+        for (i = 0; i < PARAMETER_N; i++) {
+            if ((int32_t)e3[i] != e1[i]) { passed = 0; break; }
+        }
+        if (passed==0) break;
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->error_sampling(stream, e2);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX512_SUPPORT)
+        error_sampling_avx512_asm(stream, e2);
+#elif defined(ASM_SUPPORT) && (SIMD_SUPPORT == AVX2_SUPPORT)
+        error_sampling_asm(stream, e2);
+#elif defined(VECTOR_SUPPORT)
+        error_sampling_vector(stream, e2);
+#else
+        error_sampling_generic(stream, e2);
+#endif
+        if (compare_poly(e1, e2, PARAMETER_N)!=0) { passed = 0; break; }
+        for (i = 4; i <= NOISE_K; i += 4) {
+            error_sampling_width_reference(stream, e1, PARAMETER_N, i);
+            error_sampling_poly(stream, e2, PARAMETER_N, i);
+            if (compare_poly(e1, e2, PARAMETER_N)!=0) { passed = 0; break; }
+        }
+        if (passed==0) break;
+    } 
+    if (passed==1) printf("  Error sampling tests........................................................... PASSED");
+    else { printf("  Error sampling tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        error_sampling_reference(stream, e1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Error sampling bit by bit of 32-bit words runs in ............................. %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        error_sampling_generic(stream, e2);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Error sampling with the 64-bit SWAR portable kernel runs in ................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+    return true;
+}
+
+
+static unsigned int rejection_sample_reference(uint32_t* a, unsigned int ndigits, const unsigned char* buf, unsigned int buf_nbytes)
+{ // Rejection sampling one candidate at a time, reference for LatticeCrypto_rejection_sample
+    unsigned int i, count = 0;
+    uint32_t digit;
+
+    for (i = 0; i+1 < buf_nbytes && count < ndigits; i += 2) {
+        digit = ((uint32_t)buf[i] | ((uint32_t)buf[i+1] << 8)) & 0x3FFF;
+        if (digit < PARAMETER_Q) {
+            a[count++] = digit;
+        }
+    }
+    return count;
+}
+
+
+bool rejection_test()
+{ // Tests and benchmarks for the rejection sampling helper
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    unsigned char buf[3*PARAMETER_N];
+    uint32_t a1[PARAMETER_N+8], a2[PARAMETER_N+8];
+    unsigned int i, ndigits, nbytes, count1, count2;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing rejection sampling: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS && passed==1; n++)
+    {   
+        // Testing the kernel in use against the portable one, and the helper against the reference for any output and input sizes
+        random_bytes_test(sizeof(buf), buf);
+        for (i = 0; i < 32; i++) {
+            buf[2*(rand() % (sizeof(buf)/2))+1] |= 0x30;        // More candidates in [q, 2^14-1] than by chance
+        }
+        count1 = rejection_sampling_generic(a1, buf, PARAMETER_N/8);
+#if defined(DISPATCH_SUPPORT)
+        count2 = backend_load()->rejection_sampling(a2, buf, PARAMETER_N/8);
+#elif defined(ASM_SUPPORT)
+        count2 = rejection_sampling_asm(a2, buf, PARAMETER_N/8);
+#else
+        count2 = rejection_sampling_generic(a2, buf, PARAMETER_N/8);
+#endif
+        if (count1 != count2 || compare_poly((int32_t*)a1, (int32_t*)a2, count1)!=0) { passed = 0; break; }
+
+        ndigits = (unsigned int)rand() % (PARAMETER_N+1);
+        nbytes = (unsigned int)rand() % (sizeof(buf)+1);
+        a2[ndigits] = 0xFFFFFFFF;
+        count1 = rejection_sample_reference(a1, ndigits, buf, nbytes);
+        count2 = LatticeCrypto_rejection_sample(a2, ndigits, buf, nbytes);
+        if (count1 != count2 || compare_poly((int32_t*)a1, (int32_t*)a2, count1)!=0 || a2[ndigits] != 0xFFFFFFFF) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  Rejection sampling tests....................................................... PASSED");
+    else { printf("  Rejection sampling tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        rejection_sample_reference(a1, PARAMETER_N, buf, sizeof(buf));
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Rejection sampling of 1024 values one by one runs in .......................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        LatticeCrypto_rejection_sample(a2, PARAMETER_N, buf, sizeof(buf));
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Rejection sampling of 1024 values with LatticeCrypto_rejection_sample runs in . %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+    return true;
+}
+
+
+static unsigned int shake128_reference(const unsigned char* seed, unsigned int seed_nbytes, unsigned int index, unsigned int ndigits, uint32_t* a)
+{ // Rejection sampling from SHAKE128(seed||index) with the one-message SHAKE128, reference for LatticeCrypto_shake128
+    unsigned char input[200], output[4*PARAMETER_N_MAX];
+    unsigned int i, count = 0;
+    uint32_t digit;
+
+    memcpy(input, seed, seed_nbytes);
+    input[seed_nbytes] = (unsigned char)index;
+    shake128(output, sizeof(output), input, seed_nbytes+1);
+    for (i = 0; i < sizeof(output) && count < ndigits; i += 2) {
+        digit = (output[i] | ((uint32_t)output[i+1] << 8)) & 0x3FFF;
+        if (digit < PARAMETER_Q) {
+            a[count++] = digit;
+        }
+    }
+    return count;
+}
+
+
+bool shake128_test()
+{ // Tests and benchmarks for the built-in SHAKE128 extendable-output function
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    unsigned char seed[199], output[32];
+    uint32_t a[PARAMETER_N_MAX], b[PARAMETER_N_MAX];
+    uint64_t state1[25*4], state2[25*4];
+    unsigned int i, j, ndigits, chunk, seed_nbytes;
+    static const unsigned int sizes[5] = { 512, 1024, 2048, 1001, 3 };
+    static const unsigned char kat_empty[32] = { 0x7f,0x9c,0x2b,0xa4,0xe8,0x8f,0x82,0x7d,0x61,0x60,0x45,0x50,0x76,0x05,0x85,0x3e,
+                                                 0xd7,0x3b,0x80,0x93,0xf6,0xef,0xbc,0x88,0xeb,0x1a,0x6e,0xac,0xfa,0x66,0xef,0x26 };
+    static const unsigned char kat_abc[32]   = { 0x58,0x81,0x09,0x2d,0xd8,0x18,0xbf,0x5c,0xf8,0xa3,0xdd,0xb7,0x93,0xfb,0xcb,0xa7,
+                                                 0x40,0x97,0xd5,0xc5,0x26,0xa6,0xd3,0x5f,0x97,0xb8,0x33,0x51,0x94,0x0f,0x2c,0xc8 };
+    static const unsigned char kat_200[32]   = { 0x0c,0x42,0x34,0xca,0x1e,0x31,0x80,0x1a,0xe6,0x06,0xf8,0xb8,0xd8,0xe0,0x66,0x5c,
+                                                 0x66,0xf4,0x2a,0x21,0xd6,0x01,0xc2,0x68,0x18,0x58,0xa9,0x2c,0x79,0xad,0x5d,0x69 };
+    unsigned char input[200];
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the SHAKE128 extendable-output function: \n\n"); 
+
+    // Known answers of SHAKE128 for "", "abc" and the bytes 0, 1, ..., 199
+    for (i = 0; i < 200; i++) input[i] = (unsigned char)i;
+    passed = 1;
+    shake128(output, 32, input, 0);
+    if (memcmp(output, kat_empty, 32) != 0) passed = 0;
+    shake128(output, 32, (const unsigned char*)"abc", 3);
+    if (memcmp(output, kat_abc, 32) != 0) passed = 0;
+    shake128(output, 32, input, 200);
+    if (memcmp(output, kat_200, 32) != 0) passed = 0;
+    if (passed==1) printf("  SHAKE128 known answer tests.................................................... PASSED");
+    else { printf("  SHAKE128 known answer tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS && passed==1; n++)
+    {   
+        // Testing the 4-way permutation in use against the portable one
+        random_bytes_test(sizeof(state1), (unsigned char*)state1);
+        memcpy(state2, state1, sizeof(state1));
+        KeccakF1600_StatePermute4x_generic(state1);
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->KeccakF1600x4(state2);
+#elif defined(ASM_SUPPORT)
+        KeccakF1600_StatePermute4x_asm(state2);
+#else
+        KeccakF1600_StatePermute4x_generic(state2);
+#endif
+        if (memcmp(state1, state2, sizeof(state1)) != 0) { passed = 0; break; }
+
+        // Testing the extendable output against SHAKE128 of seed||j, including seeds that end at the edge of a block
+        seed_nbytes = (n % 4 == 0) ? 167 : ((n % 4 == 1) ? 168 : SEED_BYTES);
+        random_bytes_test(seed_nbytes, seed);
+        ndigits = sizes[n % 5];
+        chunk = (ndigits+3)/4;
+        LatticeCrypto_shake128(seed, seed_nbytes, ndigits, a);
+        for (j = 0; j < 4 && j*chunk < ndigits; j++) {
+            i = (ndigits - j*chunk < chunk) ? ndigits - j*chunk : chunk;
+            if (shake128_reference(seed, seed_nbytes, j, i, b) != i || memcmp(&a[j*chunk], b, i*sizeof(uint32_t)) != 0) { passed = 0; break; }
+        }
+    } 
+    if (passed==1) printf("  SHAKE128 extendable output tests............................................... PASSED");
+    else { printf("  SHAKE128 extendable output tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    // Key exchange with the built-in extendable-output function, selected by passing NULL
+    pLatticeCrypto = LatticeCrypto_allocate();
+    if (pLatticeCrypto == NULL || LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, stream_output_test) != CRYPTO_SUCCESS || 
+        pLatticeCrypto->ExtendableOutputFunction != LatticeCrypto_shake128) {
+        free(pLatticeCrypto);
+        return false;
+    }
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10 && passed==1; n++)
+    {   
+        if (KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto) != CRYPTO_SUCCESS || SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto) != CRYPTO_SUCCESS || 
+            SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA) != CRYPTO_SUCCESS) { passed = 0; break; }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+    }
+    free(pLatticeCrypto);
+    if (passed==1) printf("  Key exchange tests with LatticeCrypto_shake128................................. PASSED");
+    else { printf("  Key exchange tests with LatticeCrypto_shake128... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        extendable_output_test(seed, SEED_BYTES, PARAMETER_N, a);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Generation of a with extendable_output_test runs in ........................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        LatticeCrypto_shake128(seed, SEED_BYTES, PARAMETER_N, a);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Generation of a with LatticeCrypto_shake128 runs in ........................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+    return true;
+}
+
+
+bool chacha20_test()
+{ // Tests and benchmarks for the built-in ChaCha20 stream cipher
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    unsigned char seed[32], nonce[8] = {0}, stream1[3*PARAMETER_N], stream2[3*PARAMETER_N];
+    uint32_t state[16];
+    unsigned int i, nbytes;
+    static const unsigned char kat_zero[32]    = { 0x76,0xb8,0xe0,0xad,0xa0,0xf1,0x3d,0x90,0x40,0x5d,0x6a,0xe5,0x53,0x86,0xbd,0x28,
+                                                   0xbd,0xd2,0x19,0xb8,0xa0,0x8d,0xed,0x1a,0xa8,0x36,0xef,0xcc,0x8b,0x77,0x0d,0xc7 };
+    static const unsigned char kat_error[32]   = { 0x4f,0x00,0x19,0x4a,0x55,0x49,0xc1,0xbb,0xb8,0xfc,0x9a,0xec,0x27,0x1f,0x99,0x2f,      // First and last 16 bytes
+                                                   0x42,0x8a,0xe5,0xdb,0x95,0x2e,0x6d,0xe8,0x70,0xce,0x5d,0x1d,0x66,0xfe,0x9e,0xd3 };
+    static const unsigned char kat_helprec[32] = { 0x4d,0xe3,0x34,0x66,0x88,0xeb,0xb3,0x29,0xa8,0x85,0x05,0xdd,0xb6,0x74,0x20,0x6e,
+                                                   0x5f,0x11,0x20,0xeb,0x95,0xdb,0xe9,0x88,0xec,0x34,0x96,0xa1,0xd0,0x61,0x0a,0x29 };
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the ChaCha20 stream cipher: \n\n"); 
+
+    // Known answers for a zero key and nonce, and for the key 0, 1, ..., 31 with the nonces of get_error (nce[0] = 5, 3*N bytes) and 
+    // HelpRec (nce[1] = 7, N/32 bytes)
+    passed = 1;
+    memset(seed, 0, 32);
+    LatticeCrypto_chacha20(seed, 32, nonce, 8, 32, stream1);
+    if (memcmp(stream1, kat_zero, 32) != 0) passed = 0;
+    for (i = 0; i < 32; i++) seed[i] = (unsigned char)i;
+    nonce[0] = 5;
+    LatticeCrypto_chacha20(seed, 32, nonce, 8, 3*PARAMETER_N, stream1);
+    if (memcmp(stream1, kat_error, 16) != 0 || memcmp(&stream1[3*PARAMETER_N-16], &kat_error[16], 16) != 0) passed = 0;
+    nonce[0] = 0; nonce[1] = 7;
+    LatticeCrypto_chacha20(seed, 32, nonce, 8, PARAMETER_N/32, stream1);
+    if (memcmp(stream1, kat_helprec, 32) != 0) passed = 0;
+    if (passed==1) printf("  ChaCha20 known answer tests.................................................... PASSED");
+    else { printf("  ChaCha20 known answer tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS && passed==1; n++)
+    {   
+        // Testing the 8-block kernel in use against the portable one
+        random_bytes_test(sizeof(state), (unsigned char*)state);
+        state[12] &= 0x7FFFFFFF;
+        chacha20_8blocks_generic(stream1, state);
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->chacha20_x8(stream2, state);
+#elif defined(ASM_SUPPORT)
+        chacha20_8blocks_asm(stream2, state);
+#else
+        chacha20_8blocks_generic(stream2, state);
+#endif
+        if (memcmp(stream1, stream2, 512) != 0) { passed = 0; break; }
+
+        // Testing that shorter streams are prefixes of the longer ones
+        random_bytes_test(32, seed);
+        random_bytes_test(8, nonce);
+        nbytes = 1 + (unsigned int)rand() % (3*PARAMETER_N);
+        LatticeCrypto_chacha20(seed, 32, nonce, 8, 3*PARAMETER_N, stream1);
+        LatticeCrypto_chacha20(seed, 32, nonce, 8, nbytes, stream2);
+        if (memcmp(stream1, stream2, nbytes) != 0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  ChaCha20 stream tests.......................................................... PASSED");
+    else { printf("  ChaCha20 stream tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    // Key exchange with the built-in extendable-output function and stream cipher
+    pLatticeCrypto = LatticeCrypto_allocate();
+    if (pLatticeCrypto == NULL || LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, NULL) != CRYPTO_SUCCESS || 
+        pLatticeCrypto->StreamOutputFunction != LatticeCrypto_chacha20) {
+        free(pLatticeCrypto);
+        return false;
+    }
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10 && passed==1; n++)
+    {   
+        if (KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto) != CRYPTO_SUCCESS || SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto) != CRYPTO_SUCCESS || 
+            SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA) != CRYPTO_SUCCESS) { passed = 0; break; }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+    }
+    free(pLatticeCrypto);
+    if (passed==1) printf("  Key exchange tests with LatticeCrypto_chacha20................................. PASSED");
+    else { printf("  Key exchange tests with LatticeCrypto_chacha20... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        LatticeCrypto_chacha20(seed, 32, nonce, 8, 3*PARAMETER_N, stream1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  ChaCha20 stream for get_error (3072 bytes) runs in ............................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        LatticeCrypto_chacha20(seed, 32, nonce, 8, PARAMETER_N/32, stream1);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  ChaCha20 stream for HelpRec (32 bytes) runs in ................................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+    return true;
+}
+
+bool aes256ctr_test()
+{ // Tests for the AES-256-CTR stream cipher, and benchmarks of SecretAgreement_B with the different stream ciphers
+    int n;
+    unsigned long long cycles, cycles1, cycles2;
+    unsigned char seed[32], nonce[8] = {0}, stream1[3*PARAMETER_N];
+    unsigned int i;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    const char* names[3] = { "stream_output_test", "LatticeCrypto_chacha20", "LatticeCrypto_aes256ctr" };
+    StreamOutput streams[3] = { stream_output_test, LatticeCrypto_chacha20, LatticeCrypto_aes256ctr };
+    unsigned int nstreams = 2;
+#if defined(ASM_SUPPORT) || defined(DISPATCH_SUPPORT)
+    int passed;
+    unsigned int nbytes;
+    unsigned char stream2[3*PARAMETER_N], SharedSecretA[SHAREDKEY_BYTES];
+    unsigned char round_keys[240];
+    static const unsigned char kat_sp800_key[32] = { 0x60,0x3d,0xeb,0x10,0x15,0xca,0x71,0xbe,0x2b,0x73,0xae,0xf0,0x85,0x7d,0x77,0x81,
+                                                     0x1f,0x35,0x2c,0x07,0x3b,0x61,0x08,0xd7,0x2d,0x98,0x10,0xa3,0x09,0x14,0xdf,0xf4 };
+    static const unsigned char kat_sp800_nonce[8] = { 0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7 };
+    static const unsigned char kat_sp800[64]   = { 0x60,0x1e,0xc3,0x13,0x77,0x57,0x89,0xa5,0xb7,0xa7,0xf5,0x04,0xbb,0xf3,0xd2,0x28,      // Ciphertext of F.5.5 
+                                                   0xf4,0x43,0xe3,0xca,0x4d,0x62,0xb5,0x9a,0xca,0x84,0xe9,0x90,0xca,0xca,0xf5,0xc5,
+                                                   0x2b,0x09,0x30,0xda,0xa2,0x3d,0xe9,0x4c,0xe8,0x70,0x17,0xba,0x2d,0x84,0x98,0x8d,
+                                                   0xdf,0xc9,0xc5,0x8d,0xb6,0x7a,0xad,0xa6,0x13,0xc2,0xdd,0x08,0x45,0x79,0x41,0xa6 };
+    static const unsigned char kat_sp800_pt[64] = { 0x6b,0xc1,0xbe,0xe2,0x2e,0x40,0x9f,0x96,0xe9,0x3d,0x7e,0x11,0x73,0x93,0x17,0x2a,
+                                                   0xae,0x2d,0x8a,0x57,0x1e,0x03,0xac,0x9c,0x9e,0xb7,0x6f,0xac,0x45,0xaf,0x8e,0x51,
+                                                   0x30,0xc8,0x1c,0x46,0xa3,0x5c,0xe4,0x11,0xe5,0xfb,0xc1,0x19,0x1a,0x0a,0x52,0xef,
+                                                   0xf6,0x9f,0x24,0x45,0xdf,0x4f,0x9b,0x17,0xad,0x2b,0x41,0x7b,0xe6,0x6c,0x37,0x10 };
+    static const unsigned char kat_error[32]   = { 0x99,0xeb,0xcc,0xc0,0x11,0x79,0x49,0xcd,0x66,0x3c,0x44,0xc0,0x6a,0x1c,0x58,0xb0,      // First and last 16 bytes
+                                                   0x01,0xe8,0x59,0xfa,0x69,0x14,0x2f,0x7d,0x29,0x42,0x83,0x08,0x50,0xd6,0x37,0xf8 };
+    static const unsigned char kat_helprec[32] = { 0x4d,0xef,0xf8,0xad,0xaa,0x01,0x6e,0x4b,0x2f,0xae,0x68,0xfc,0x42,0x0c,0x32,0x7d,
+                                                   0x46,0xd8,0xef,0x9a,0xc9,0x71,0x74,0xa9,0x4f,0xcd,0x25,0x3e,0x2c,0x69,0xd8,0x87 };
+#endif
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the AES-256-CTR stream cipher: \n\n"); 
+
+#if defined(ASM_SUPPORT) || defined(DISPATCH_SUPPORT)
+    if (cpu_supports_aesni() == true) {
+        // Known answers for the AES-256 CTR example of NIST SP 800-38A (the counter block f0f1...ff is nonce||counter), and for the key 
+        // 0, 1, ..., 31 with the nonces of get_error (nce[0] = 5, 3*N bytes) and HelpRec (nce[1] = 7, N/32 bytes)
+        passed = 1;
+        aes256_key_expansion_asm(kat_sp800_key, round_keys);
+        aes256_ctr_8blocks_asm(stream1, round_keys, kat_sp800_nonce, 0xf8f9fafbfcfdfeffULL);
+        for (i = 0; i < 64; i++) {
+            if ((stream1[i] ^ kat_sp800_pt[i]) != kat_sp800[i]) passed = 0;
+        }
+        for (i = 0; i < 32; i++) seed[i] = (unsigned char)i;
+        nonce[0] = 5;
+        LatticeCrypto_aes256ctr(seed, 32, nonce, 8, 3*PARAMETER_N, stream1);
+        if (memcmp(stream1, kat_error, 16) != 0 || memcmp(&stream1[3*PARAMETER_N-16], &kat_error[16], 16) != 0) passed = 0;
+        nonce[0] = 0; nonce[1] = 7;
+        LatticeCrypto_aes256ctr(seed, 32, nonce, 8, PARAMETER_N/32, stream1);
+        if (memcmp(stream1, kat_helprec, 32) != 0) passed = 0;
+        if (passed==1) printf("  AES-256-CTR known answer tests................................................. PASSED");
+        else { printf("  AES-256-CTR known answer tests... FAILED"); printf("\n"); return false; }
+        printf("\n");
+
+        passed = 1;
+        for (n=0; n<TEST_LOOPS && passed==1; n++)
+        {   
+            // Testing that shorter streams are prefixes of the longer ones, and that a short nonce is zero-padded
+            random_bytes_test(32, seed);
+            random_bytes_test(8, nonce);
+            nbytes = 1 + (unsigned int)rand() % (3*PARAMETER_N);
+            LatticeCrypto_aes256ctr(seed, 32, nonce, 8, 3*PARAMETER_N, stream1);
+            LatticeCrypto_aes256ctr(seed, 32, nonce, 8, nbytes, stream2);
+            if (memcmp(stream1, stream2, nbytes) != 0) { passed = 0; break; }
+            memset(&nonce[1], 0, 7);
+            LatticeCrypto_aes256ctr(seed, 32, nonce, 8, nbytes, stream1);
+            LatticeCrypto_aes256ctr(seed, 32, nonce, 1, nbytes, stream2);
+            if (memcmp(stream1, stream2, nbytes) != 0) { passed = 0; break; }
+        } 
+        if (passed==1) printf("  AES-256-CTR stream tests....................................................... PASSED");
+        else { printf("  AES-256-CTR stream tests... FAILED"); printf("\n"); return false; }
+        printf("\n");
+
+        // Key exchange with the AES-256-CTR stream cipher
+        pLatticeCrypto = LatticeCrypto_allocate();
+        if (pLatticeCrypto == NULL || LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, LatticeCrypto_aes256ctr) != CRYPTO_SUCCESS) {
+            free(pLatticeCrypto);
+            return false;
+        }
+        passed = 1;
+        for (n=0; n<TEST_LOOPS/10 && passed==1; n++)
+        {   
+            if (KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto) != CRYPTO_SUCCESS || SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto) != CRYPTO_SUCCESS || 
+                SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA) != CRYPTO_SUCCESS) { passed = 0; break; }
+            if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+        }
+        free(pLatticeCrypto);
+        if (passed==1) printf("  Key exchange tests with LatticeCrypto_aes256ctr................................ PASSED");
+        else { printf("  Key exchange tests with LatticeCrypto_aes256ctr... FAILED"); printf("\n"); return false; }
+        printf("\n");
+        nstreams = 3;
+    } else 
+#endif
+    {
+        // Without AES-NI there is no AES-256-CTR stream
+        memset(seed, 0, 32);
+        if (LatticeCrypto_aes256ctr(seed, 32, nonce, 8, 32, stream1) != CRYPTO_ERROR_NOT_IMPLEMENTED) {
+            printf("  AES-256-CTR unavailable tests... FAILED"); printf("\n"); return false;
+        }
+        printf("  AES-256-CTR is not available in this build or on this CPU, tests skipped");
+        printf("\n");
+    }
+
+    // Benchmarking SecretAgreement_B with each stream cipher, with the built-in extendable-output function
+    pLatticeCrypto = LatticeCrypto_allocate();
+    if (pLatticeCrypto == NULL) {
+        return false;
+    }
+    for (i = 0; i < nstreams; i++) {
+        if (LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, streams[i]) != CRYPTO_SUCCESS || KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto) != CRYPTO_SUCCESS) {
+            free(pLatticeCrypto);
+            return false;
+        }
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  SecretAgreement_B with %-23s runs in ........................ %8lld cycles", names[i], cycles/BENCH_LOOPS);
+        printf("\n");
+    }
+    free(pLatticeCrypto);
+    
+    return true;
+}
+
+bool noise_test()
+{ // Tests for the sampling of all the noise of a party, from one request per nonce and from one stream request, against get_error and HelpRec
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    unsigned char seed[ERROR_SEED_BYTES], nonces[4*NONCE_SEED_BYTES] = {0}, bits1[PARAMETER_N_MAX/32], bits2[PARAMETER_N_MAX/32];
+    unsigned char stream1[3*3*PARAMETER_N_MAX + PARAMETER_N_MAX/32], stream2[3*3*PARAMETER_N_MAX + PARAMETER_N_MAX/32];
+    int32_t e1[3][PARAMETER_N_MAX], e2[3][PARAMETER_N_MAX], *noise[3] = { e2[0], e2[1], e2[2] };
+    int16_t f1[3][PARAMETER_N], f2[3][PARAMETER_N], *noise16[3] = { f2[0], f2[1], f2[2] };
+    unsigned int i, p, N, nstreams = 2, array_nbytes[4];
+    static const unsigned int Ns[3] = { 512, 1024, 2048 };
+    StreamOutput streams[3] = { stream_output_test, LatticeCrypto_chacha20, LatticeCrypto_aes256ctr };
+    StreamOutputMulti streams_multi[3] = { NULL, LatticeCrypto_chacha20_multi, LatticeCrypto_aes256ctr_multi };
+    StreamOutputMulti selected_multi[3] = { NULL, NULL, LatticeCrypto_aes256ctr_multi };     // Only AES-256-CTR gains from one request
+    PLatticeCryptoStruct pLatticeCrypto;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the sampling of the noise of a party: \n\n"); 
+
+#if defined(ASM_SUPPORT) || defined(DISPATCH_SUPPORT)
+    if (cpu_supports_aesni() == true) {
+        nstreams = 3;
+    }
+#endif
+    pLatticeCrypto = LatticeCrypto_allocate();
+    if (pLatticeCrypto == NULL) {
+        return false;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS && passed==1; n++)
+    {   
+        // The multi-nonce stream ciphers output the streams of their single-nonce versions one after the other
+        random_bytes_test(ERROR_SEED_BYTES, seed);
+        random_bytes_test(4*NONCE_SEED_BYTES, nonces);
+        for (p = 0; p < 4; p++) {
+            array_nbytes[p] = (unsigned int)rand() % (3*PARAMETER_N);
+        }
+        for (i = 1; i < nstreams && passed==1; i++) {
+            for (p = 0, N = 0; p < 4; N += array_nbytes[p], p++) {
+                if (array_nbytes[p] > 0) streams[i](seed, 32, &nonces[NONCE_SEED_BYTES*p], NONCE_SEED_BYTES, array_nbytes[p], &stream1[N]);
+            }
+            streams_multi[i](seed, 32, nonces, NONCE_SEED_BYTES, 4, array_nbytes, stream2);
+            if (memcmp(stream1, stream2, N) != 0) passed = 0;
+        }
+
+        // get_noise and get_noise_int16 output the same as get_error, get_error_int16 and the random bits of HelpRec, from one request per nonce 
+        // (even i) and from one request to the multi-nonce version of the stream cipher (odd i)
+        for (i = 0; i < 2*nstreams && passed==1; i++) {
+            LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, streams[i/2]);
+            if (pLatticeCrypto->StreamOutputMultiFunction != selected_multi[i/2]) { passed = 0; break; }
+            pLatticeCrypto->StreamOutputMultiFunction = (i % 2 == 1) ? streams_multi[i/2] : NULL;
+            N = Ns[n % 3];
+            memset(nonces, 0, NONCE_SEED_BYTES);
+            nonces[1] = 3;
+            srand(n);                 // stream_output_test ignores the nonce, it only outputs the same values in the same order
+            for (p = 0; p < 3; p++) {
+                get_error(e1[p], seed, p, N, streams[i/2]);
+            }
+            streams[i/2](seed, ERROR_SEED_BYTES, nonces, NONCE_SEED_BYTES, N/32, bits1);
+            srand(n);
+            if (get_noise(noise, 3, bits2, seed, N, NOISE_K, pLatticeCrypto) != CRYPTO_SUCCESS) { passed = 0; break; }
+            for (p = 0; p < 3; p++) {
+                if (compare_poly(e1[p], e2[p], N)!=0) passed = 0;
+            }
+            if (memcmp(bits1, bits2, N/32) != 0) passed = 0;
+            srand(n);
+            for (p = 0; p < 3; p++) {
+                get_error_int16(f1[p], seed, p, streams[i/2]);
+            }
+            streams[i/2](seed, ERROR_SEED_BYTES, nonces, NONCE_SEED_BYTES, PARAMETER_N/32, bits1);
+            srand(n);
+            if (get_noise_int16(noise16, 3, bits2, seed, pLatticeCrypto) != CRYPTO_SUCCESS) { passed = 0; break; }
+            for (p = 0; p < 3; p++) {
+                if (compare_poly16(f1[p], f2[p], PARAMETER_N)!=0) passed = 0;
+            }
+            if (memcmp(bits1, bits2, PARAMETER_N/32) != 0) passed = 0;
+        }
+    } 
+    if (passed==1) printf("  Noise sampling tests........................................................... PASSED");
+    else { printf("  Noise sampling tests... FAILED"); printf("\n"); free(pLatticeCrypto); return false; }
+    printf("\n");
+
+    // Benchmarking the noise of SecretAgreement_B with LatticeCrypto_chacha20, from one request per nonce (the default) and from one request
+    LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, NULL);
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        get_noise(noise, 3, bits2, seed, PARAMETER_N, NOISE_K, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Noise of SecretAgreement_B from 4 stream requests runs in ..................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    pLatticeCrypto->StreamOutputMultiFunction = LatticeCrypto_chacha20_multi;
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        get_noise(noise, 3, bits2, seed, PARAMETER_N, NOISE_K, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Noise of SecretAgreement_B from 1 stream request runs in ...................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    free(pLatticeCrypto);
+    
+    return true;
+}
+
+bool int16_test()
+{ // Tests for the 16-bit pipeline against the 32-bit one
+    int n, passed;
+    int32_t a[PARAMETER_N], b[PARAMETER_N], c[PARAMETER_N], d[PARAMETER_N], e[PARAMETER_N];
+    int16_t a16[PARAMETER_N], b16[PARAMETER_N], c16[PARAMETER_N], d16[PARAMETER_N];
+    unsigned char m1[PKA_BYTES], m2[PKA_BYTES], stream[3*PARAMETER_N];
+    unsigned int i, pbits = 14;
+#if defined(DISPATCH_SUPPORT)
+    int16_t r16[PARAMETER_N];
+#endif
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing 16-bit functions: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        // The 16-bit results must be congruent mod q to the 32-bit ones (equal after correction)
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N); 
+        random_poly_test(c, PARAMETER_Q, pbits, PARAMETER_N);
+        for (i=0; i<PARAMETER_N; i++) { a16[i] = (int16_t)a[i]; b16[i] = (int16_t)b[i]; c16[i] = (int16_t)c[i]; }
+
+        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289(b, psi_rev_ntt1024_12289, PARAMETER_N);
+        NTT_CT_std2rev_12289_int16(a16, psi_rev_ntt1024_12289_int16, PARAMETER_N);
+        NTT_CT_std2rev_12289_int16(b16, psi_rev_ntt1024_12289_int16, PARAMETER_N);
+#if defined(DISPATCH_SUPPORT)
+        for (i=0; i<PARAMETER_N; i++) r16[i] = (int16_t)c[i];
+        NTT_CT_std2rev_12289_int16_generic(r16, psi_rev_ntt1024_12289_int16, PARAMETER_N);
+#endif
+        NTT_CT_std2rev_12289_int16(c16, psi_rev_ntt1024_12289_int16, PARAMETER_N);
+#if defined(DISPATCH_SUPPORT)
+        if (compare_poly16(c16, r16, PARAMETER_N)!=0) { passed = 0; break; }
+#endif
+        NTT_CT_std2rev_12289(c, psi_rev_ntt1024_12289, PARAMETER_N);
+        if (compare_poly16_32(a16, a, PARAMETER_N)!=0) { passed = 0; break; }
+
+        pmul(a, b, d, PARAMETER_N);
+        pmul_int16(a16, b16, d16, PARAMETER_N);
+#if defined(DISPATCH_SUPPORT)
+        pmul_int16_generic(a16, b16, r16, PARAMETER_N);
+        if (compare_poly16(d16, r16, PARAMETER_N)!=0) { passed = 0; break; }
+#endif
+        if (compare_poly16_32(d16, d, PARAMETER_N)!=0) { passed = 0; break; }
+
+        pmuladd(a, b, c, e, PARAMETER_N);
+        pmuladd_int16(a16, b16, c16, d16, PARAMETER_N);
+#if defined(DISPATCH_SUPPORT)
+        pmuladd_int16_generic(a16, b16, c16, r16, PARAMETER_N);
+        if (compare_poly16(d16, r16, PARAMETER_N)!=0) { passed = 0; break; }
+#endif
+        if (compare_poly16_32(d16, e, PARAMETER_N)!=0) { passed = 0; break; }
+
+        correction(e, PARAMETER_Q, PARAMETER_N);
+        INTT_GS_rev2std_12289(e, omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289, PARAMETER_N);
+        two_reduce12289(e, PARAMETER_N);
+#if defined(DISPATCH_SUPPORT)
+        for (i=0; i<PARAMETER_N; i++) r16[i] = d16[i];
+        INTT_GS_rev2std_12289_int16_generic(r16, omegainv_rev_ntt1024_12289_int16, omegainv10N_rev_ntt1024_12289_int16, Ninv11_ntt1024_12289_int16, PARAMETER_N);
+        two_reduce12289_int16_generic(r16, PARAMETER_N);
+#endif
+        INTT_GS_rev2std_12289_int16(d16, omegainv_rev_ntt1024_12289_int16, omegainv10N_rev_ntt1024_12289_int16, Ninv11_ntt1024_12289_int16, PARAMETER_N);
+        two_reduce12289_int16(d16, PARAMETER_N);
+#if defined(DISPATCH_SUPPORT)
+        if (compare_poly16(d16, r16, PARAMETER_N)!=0) { passed = 0; break; }
+#endif
+        if (compare_poly16_32(d16, e, PARAMETER_N)!=0) { passed = 0; break; }
+
+        // Scaled tables
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N);
+        for (i=0; i<PARAMETER_N; i++) { a16[i] = (int16_t)a[i]; b16[i] = (int16_t)a[i]; }
+        NTT_CT_std2rev_12289_int16(a16, psi_rev3_ntt1024_12289_int16, PARAMETER_N);
+        NTT_CT_std2rev_12289_int16(b16, psi_rev81_ntt1024_12289_int16, PARAMETER_N);
+        NTT_CT_std2rev_12289(a, psi_rev_ntt1024_12289, PARAMETER_N);
+        for (i=0; i<PARAMETER_N; i++) b[i] = a[i];
+        smul(a, 3, PARAMETER_N);
+        smul(b, 81, PARAMETER_N);
+        if (compare_poly16_32(a16, a, PARAMETER_N)!=0 || compare_poly16_32(b16, b, PARAMETER_N)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  16-bit INTT/NTT and pointwise tests............................................ PASSED");
+    else { printf("  16-bit INTT/NTT and pointwise tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        // Encoding and error sampling must match the 32-bit versions bit for bit
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N);
+        for (i=0; i<PARAMETER_N; i++) a16[i] = (int16_t)a[i];
+        random_bytes_test(PKA_BYTES, m1);
+        for (i=0; i<PKA_BYTES; i++) m2[i] = m1[i];
+
+        encode_generic((uint32_t*)a, m1);
+        random_bytes_test(3*PARAMETER_N, stream);
+        error_sampling_generic(stream, e);
+#if defined(DISPATCH_SUPPORT)
+        backend_load()->encode_int16(a16, m2);
+        backend_load()->decode_int16(m2, b16);
+        backend_load()->error_sampling_int16(stream, c16);
+#elif defined(ASM_SUPPORT)
+        encode_int16_asm(a16, m2);
+        decode_int16_asm(m2, b16);
+        error_sampling_int16_asm(stream, c16);
+#else
+        encode_int16_generic(a16, m2);
+        decode_int16_generic(m2, b16);
+        error_sampling_int16_generic(stream, c16);
+#endif
+        for (i=0; i<PKA_BYTES; i++) { if (m1[i] != m2[i]) { passed = 0; break; } }
+        if (passed==0) break;
+        if (compare_poly16(a16, b16, PARAMETER_N)!=0) { passed = 0; break; }
+        for (i=0; i<PARAMETER_N; i++) { if ((int32_t)c16[i] != e[i]) { passed = 0; break; } }
+        if (passed==0) break;
+    } 
+    if (passed==1) printf("  16-bit encoding and error sampling tests....................................... PASSED");
+    else { printf("  16-bit encoding and error sampling tests... FAILED"); printf("\n"); return false; }
+    printf("\n");
+    
+    return true;
+}
+
+
+CRYPTO_STATUS int16_kex_test()
+{ // Tests for the key exchange between parties that run the 16-bit and the 32-bit pipelines
+    int n, passed, i;
+    int32_t SecretKeyA[PARAMETER_N], SecretKeyA16[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyA16[PKA_BYTES], PublicKeyB[PKB_BYTES], PublicKeyB16[PKB_BYTES];
+    unsigned char SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES], SharedSecretA16[SHAREDKEY_BYTES], SharedSecretB16[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the key exchange between the 16-bit and 32-bit pipelines: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, extendable_output_test, stream_output_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10; n++)
+    {   
+        // With the same randomness both pipelines output the same keys
+        srand(n);
+        Status = KeyGeneration_A_int32(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n);
+        Status = KeyGeneration_A_int16(SecretKeyA16, PublicKeyA16, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        for (i=0; i<PARAMETER_N; i++) { if (reduce(SecretKeyA[i], PARAMETER_Q) != SecretKeyA16[i]) { passed = 0; break; } }
+        if (passed==0) break;
+        for (i=0; i<PKA_BYTES; i++) { if (PublicKeyA[i] != PublicKeyA16[i]) { passed = 0; break; } }
+        if (passed==0) break;
+
+        srand(n+TEST_LOOPS);
+        Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n+TEST_LOOPS);
+        Status = SecretAgreement_B_int16(PublicKeyA, SharedSecretB16, PublicKeyB16, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        for (i=0; i<PKB_BYTES; i++) { if (PublicKeyB[i] != PublicKeyB16[i]) { passed = 0; break; } }
+        if (passed==0) break;
+
+        Status = SecretAgreement_A_int32(PublicKeyB, SecretKeyA16, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        Status = SecretAgreement_A_int16(PublicKeyB, SecretKeyA, SharedSecretA16);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+        if (compare_poly((int32_t*)SharedSecretA16, (int32_t*)SharedSecretB16, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretA16, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  16-bit/32-bit key exchange tests............................................... PASSED");
+    else { printf("  16-bit/32-bit key exchange tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)SecretKeyA16, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretA16, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB16, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    
+    return Status;
+}
+
+
+CRYPTO_STATUS kex_test()
+{ // Tests for the key exchange
+    int n, passed;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    RandomBytes RandomBytesFunction = random_bytes_test;
+    ExtendableOutput ExtendableOutputFunction = extendable_output_test;
+    StreamOutput StreamOutputFunction = stream_output_test;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the key exchange: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, RandomBytesFunction, ExtendableOutputFunction, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        Status = KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  Key exchange tests............................................................. PASSED");
+    else { printf("  Key exchange tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)PublicKeyA, NBYTES_TO_NWORDS(PKA_BYTES));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)PublicKeyB, NBYTES_TO_NWORDS(PKB_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    
+    return Status;
+}
+
+
+#define BATCH_CLIENTS     7          // Number of clients of the batch tests, not a multiple of KEX_BATCH_LANES
+#define BATCH_BENCH       8          // Number of clients of the batch benchmarks
+
+CRYPTO_STATUS batch_test()
+{ // Tests and benchmarks for the batched key generation of Alice and shared secret computation of Bob
+    int n, passed, i;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[BATCH_BENCH][PARAMETER_N], SecretKeyA1[PARAMETER_N];
+    unsigned char PublicKeyA[BATCH_BENCH][PKA_BYTES], PublicKeyA1[PKA_BYTES], PublicKeyB[BATCH_BENCH][PKB_BYTES], PublicKeyB1[PKB_BYTES];
+    unsigned char SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[BATCH_BENCH][SHAREDKEY_BYTES], SharedSecretB1[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    PLatticeCryptoWorkspace workspace;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the batched key exchange: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    workspace = LatticeCrypto_allocate_workspace();
+    if (pLatticeCrypto == NULL || workspace == NULL) {
+        Status = CRYPTO_ERROR_NO_MEMORY;
+        goto cleanup;
+    }
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, extendable_output_test, stream_output_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10; n++)
+    {   
+        // With the same randomness the batch outputs the same keys as one call per client
+        srand(n);
+        Status = KeyGeneration_A_batch(BATCH_CLIENTS, SecretKeyA[0], PublicKeyA[0], pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n);
+        for (i=0; i<BATCH_CLIENTS && passed==1; i++) {
+            Status = KeyGeneration_A_int32(SecretKeyA1, PublicKeyA1, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+            if (compare_poly(SecretKeyA[i], SecretKeyA1, PARAMETER_N)!=0 || memcmp(PublicKeyA[i], PublicKeyA1, PKA_BYTES)!=0) { passed = 0; }
+        }
+        if (passed==0) break;
+
+        srand(n+TEST_LOOPS);
+        Status = SecretAgreement_B_batch(BATCH_CLIENTS, PublicKeyA[0], SharedSecretB[0], PublicKeyB[0], pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n+TEST_LOOPS);
+        for (i=0; i<BATCH_CLIENTS && passed==1; i++) {
+            Status = SecretAgreement_B_int32(PublicKeyA[i], SharedSecretB1, PublicKeyB1, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+            if (memcmp(PublicKeyB[i], PublicKeyB1, PKB_BYTES)!=0 || memcmp(SharedSecretB[i], SharedSecretB1, SHAREDKEY_BYTES)!=0) { passed = 0; }
+        }
+        if (passed==0) break;
+
+        for (i=0; i<BATCH_CLIENTS && passed==1; i++) {
+            Status = SecretAgreement_A(PublicKeyB[i], SecretKeyA[i], SharedSecretA);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+            if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB[i], SHAREDKEY_BYTES/4)!=0) { passed = 0; }
+        }
+        if (passed==0) break;
+    } 
+    if (passed==1) printf("  Batched key exchange tests..................................................... PASSED");
+    else { printf("  Batched key exchange tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    // Benchmarking with the built-in extendable-output function and stream cipher, per client
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    Status = KeyGeneration_A_batch(BATCH_BENCH, SecretKeyA[0], PublicKeyA[0], pLatticeCrypto, workspace);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles(); 
+        for (i=0; i<BATCH_BENCH; i++) {
+            Status = SecretAgreement_B_int32(PublicKeyA[i], SharedSecretB[i], PublicKeyB[i], pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B per client, one call each, runs in .......................... %8lld cycles", cycles/(BATCH_BENCH*(BENCH_LOOPS/10)));
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_B_batch(BATCH_BENCH, PublicKeyA[0], SharedSecretB[0], PublicKeyB[0], pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B per client, batches of %d, runs in ........................... %8lld cycles", BATCH_BENCH, cycles/(BATCH_BENCH*(BENCH_LOOPS/10)));
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles(); 
+        for (i=0; i<BATCH_BENCH; i++) {
+            Status = KeyGeneration_A_int32(SecretKeyA[i], PublicKeyA[i], pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  KeyGeneration_A per client, one call each, runs in ............................ %8lld cycles", cycles/(BATCH_BENCH*(BENCH_LOOPS/10)));
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS/10; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = KeyGeneration_A_batch(BATCH_BENCH, SecretKeyA[0], PublicKeyA[0], pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  KeyGeneration_A per client, batches of %d, runs in ............................. %8lld cycles", BATCH_BENCH, cycles/(BATCH_BENCH*(BENCH_LOOPS/10)));
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    LatticeCrypto_free_workspace(workspace);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(sizeof(SecretKeyA)));
+    clear_words((void*)SecretKeyA1, NBYTES_TO_NWORDS(sizeof(SecretKeyA1)));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(sizeof(SharedSecretB)));
+    clear_words((void*)SharedSecretB1, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    
+    return Status;
+}
+
+
+CRYPTO_STATUS workspace_test()
+{ // Tests and benchmarks for the key exchange with a preallocated workspace
+    int n, passed, i;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N], SecretKeyA1[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyA1[PKA_BYTES], PublicKeyB[PKB_BYTES], PublicKeyB1[PKB_BYTES];
+    unsigned char SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES], SharedSecretB1[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    PLatticeCryptoWorkspace workspace;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the key exchange with a workspace: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    workspace = LatticeCrypto_allocate_workspace();
+    if (pLatticeCrypto == NULL || workspace == NULL) {
+        Status = CRYPTO_ERROR_NO_MEMORY;
+        goto cleanup;
+    }
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, extendable_output_test, stream_output_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    if (((uintptr_t)workspace->pk | (uintptr_t)workspace->a | (uintptr_t)workspace->v | (uintptr_t)workspace->r | (uintptr_t)workspace->s | 
+         (uintptr_t)workspace->e | (uintptr_t)workspace->stream) % WORKSPACE_ALIGN != 0) {
+        passed = 0;
+    }
+    for (n=0; n<TEST_LOOPS/10 && passed==1; n++)
+    {   
+        // With the same randomness the workspace versions output the same keys as the versions on the stack
+        srand(n);
+        Status = KeyGeneration_A_ws(SecretKeyA, PublicKeyA, pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n);
+        Status = KeyGeneration_A_int32(SecretKeyA1, PublicKeyA1, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (compare_poly(SecretKeyA, SecretKeyA1, PARAMETER_N)!=0 || memcmp(PublicKeyA, PublicKeyA1, PKA_BYTES)!=0) { passed = 0; break; }
+
+        srand(n+TEST_LOOPS);
+        Status = SecretAgreement_B_ws(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n+TEST_LOOPS);
+        Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB1, PublicKeyB1, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (memcmp(PublicKeyB, PublicKeyB1, PKB_BYTES)!=0 || memcmp(SharedSecretB, SharedSecretB1, SHAREDKEY_BYTES)!=0) { passed = 0; break; }
+
+        Status = SecretAgreement_A_ws(PublicKeyB, SecretKeyA, SharedSecretA, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+
+        // The secret values are wiped between uses
+        for (i=0; i<PARAMETER_N; i++) { if (workspace->s[i] != 0 || workspace->e[i] != 0 || workspace->v[i] != 0 || workspace->r[i] != 0) { passed = 0; break; } }
+    } 
+    if (passed==1) printf("  Key exchange tests with a workspace............................................ PASSED");
+    else { printf("  Key exchange tests with a workspace... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_B_ws(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto, workspace);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B with a workspace runs in .................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B with its buffers on the stack runs in ....................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    LatticeCrypto_free_workspace(workspace);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)SecretKeyA1, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB1, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    
+    return Status;
+}
+
+
+CRYPTO_STATUS kex_run()
+{
+    int n;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    RandomBytes RandomBytesFunction = random_bytes_test;
+    ExtendableOutput ExtendableOutputFunction = extendable_output_test;
+    StreamOutput StreamOutputFunction = stream_output_test;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Benchmarking key exchange functions: \n\n");  
+    
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, RandomBytesFunction, ExtendableOutputFunction, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's key generation runs in ................................................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");   
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Bob's shared key computation runs in .......................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");   
+    
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's shared key computation runs in ........................................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)PublicKeyA, NBYTES_TO_NWORDS(PKA_BYTES));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)PublicKeyB, NBYTES_TO_NWORDS(PKB_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES)); 
+    
+    return Status;
+}
+
+
+bool params_ntt_test(const LatticeCryptoParams* params)
+{ // Tests for the NTT functions with the tables of a given parameter set
+    int n, passed;
+    int32_t a[PARAMETER_N_MAX], b[PARAMETER_N_MAX], c[PARAMETER_N_MAX], d[PARAMETER_N_MAX], e[PARAMETER_N_MAX], f[PARAMETER_N_MAX], g[PARAMETER_N_MAX], ff[PARAMETER_N_MAX];
+    unsigned int N = params->N, pbits = 14;
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10; n++)
+    {   
+        // Emulating NTT operations in the key exchange, with the scaled tables in place of smul
+        random_poly_test(a, PARAMETER_Q, pbits, N); random_poly_test(b, PARAMETER_Q, pbits, N); 
+        random_poly_test(c, PARAMETER_Q, pbits, N); random_poly_test(d, PARAMETER_Q, pbits, N); 
+        random_poly_test(e, PARAMETER_Q, pbits, N); 
+
+        karatsuba_mul_test(a, b, f, PARAMETER_Q, N);
+        add_test(f, c, f, PARAMETER_Q, N);
+        karatsuba_mul_test(f, d, ff, PARAMETER_Q, N);
+        add_test(ff, e, f, PARAMETER_Q, N);
+        NTT_CT_std2rev_12289(a, params->psi_rev, N);
+        NTT_CT_std2rev_12289(b, params->psi_rev, N);
+        NTT_CT_std2rev_12289(c, params->psi_rev3, N);
+        pmuladd(a, b, c, g, N);
+        NTT_CT_std2rev_12289(d, params->psi_rev, N);
+        NTT_CT_std2rev_12289(e, params->psi_rev81, N);
+        pmuladd(g, d, e, g, N);
+        INTT_GS_rev2std_12289(g, params->omegainv_rev, params->omegainv1N_rev, params->Ninv, N);
+        two_reduce12289(g, N);
+        correction(g, PARAMETER_Q, N);
+        if (compare_poly(f, g, N)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  INTT/NTT tests, N = %4d....................................................... PASSED", N);
+    else { printf("  NTT/INTT tests, N = %4d... FAILED", N); printf("\n"); return false; }
+    printf("\n");
+    
+    return true;
+}
+
+
+typedef CRYPTO_STATUS (*KeyGenerationA)(int32_t* SecretKeyA, unsigned char* PublicKeyA, PLatticeCryptoStruct pLatticeCrypto);
+typedef CRYPTO_STATUS (*SecretAgreementB)(unsigned char* PublicKeyA, unsigned char* SharedSecretB, unsigned char* PublicKeyB, PLatticeCryptoStruct pLatticeCrypto);
+typedef CRYPTO_STATUS (*SecretAgreementA)(unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA);
+
+CRYPTO_STATUS params_kex_test(const LatticeCryptoParams* params, KeyGenerationA KeyGenerationFunction_A, SecretAgreementB SecretAgreementFunction_B, SecretAgreementA SecretAgreementFunction_A)
+{ // Tests and benchmarks for the key exchange of a given parameter set
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N_MAX];
+    unsigned char PublicKeyA[PKA_BYTES_2048], PublicKeyB[PKB_BYTES_2048], SharedSecretA[SHAREDKEY_BYTES_2048], SharedSecretB[SHAREDKEY_BYTES_2048];
+    PLatticeCryptoStruct pLatticeCrypto;
+    RandomBytes RandomBytesFunction = random_bytes_test;
+    ExtendableOutput ExtendableOutputFunction = extendable_output_test;
+    StreamOutput StreamOutputFunction = stream_output_test;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, RandomBytesFunction, ExtendableOutputFunction, StreamOutputFunction);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        Status = KeyGenerationFunction_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreementFunction_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreementFunction_A(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, params->sharedkey_bytes/4)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  Key exchange tests, N = %4d................................................... PASSED", params->N);
+    else { printf("  Key exchange tests, N = %4d... FAILED", params->N); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = KeyGenerationFunction_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreementFunction_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreementFunction_A(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Full key exchange, N = %4d, runs in .......................................... %8lld cycles", params->N, cycles/BENCH_LOOPS);
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N_MAX));
+    clear_words((void*)PublicKeyA, NBYTES_TO_NWORDS(PKA_BYTES_2048));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+    clear_words((void*)PublicKeyB, NBYTES_TO_NWORDS(PKB_BYTES_2048));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+    
+    return Status;
+}
+
+
+CRYPTO_STATUS params_test()
+{ // Tests for the N = 512 and N = 2048 parameter sets
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the N = 512 and N = 2048 parameter sets: \n\n"); 
+
+    if (params_ntt_test(&params_ntt512_12289) == false || params_ntt_test(&params_ntt2048_12289) == false) {
+        return CRYPTO_ERROR;
+    }
+    Status = params_kex_test(&params_ntt512_12289, KeyGeneration_A_512, SecretAgreement_B_512, SecretAgreement_A_512);
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }
+    return params_kex_test(&params_ntt2048_12289, KeyGeneration_A_2048, SecretAgreement_B_2048, SecretAgreement_A_2048);
+}
+
+
+CRYPTO_STATUS noise_width_test()
+{ // Tests and benchmarks for the noise widths 12, 8 and 4 with the built-in extendable-output function and stream cipher
+    int n, w, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    const unsigned int widths[3] = { NOISE_K, 8, 4 };
+    KeyGenerationA KeyGenerationFunctions_A[3] = { KeyGeneration_A, KeyGeneration_A_psi8, KeyGeneration_A_psi4 };
+    SecretAgreementB SecretAgreementFunctions_B[3] = { SecretAgreement_B, SecretAgreement_B_psi8, SecretAgreement_B_psi4 };
+    int32_t SecretKeyA[PARAMETER_N], s[PARAMETER_N], e[PARAMETER_N], v[PARAMETER_N], *noise[3] = { s, e, v };
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned char seed[ERROR_SEED_BYTES], random_bits[PARAMETER_N/32];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the noise widths 12, 8 and 4: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    for (w = 0; w < 3; w++) {
+        passed = 1;
+        for (n=0; n<TEST_LOOPS; n++)
+        {   
+            Status = KeyGenerationFunctions_A[w](SecretKeyA, PublicKeyA, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+            Status = SecretAgreementFunctions_B[w](PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+            Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+
+            if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+        } 
+        if (passed==1) printf("  Key exchange tests, noise width %2d............................................. PASSED", widths[w]);
+        else { printf("  Key exchange tests, noise width %2d... FAILED", widths[w]); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+        printf("\n");
+    }
+
+    for (w = 0; w < 3; w++) {
+        random_bytes_test(ERROR_SEED_BYTES, seed);
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            Status = get_noise(noise, 3, random_bits, seed, PARAMETER_N, widths[w], pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  Noise of SecretAgreement_B, width %2d, runs in ................................. %8lld cycles", widths[w], cycles/BENCH_LOOPS);
+        printf("\n");
+    }
+
+    for (w = 0; w < 3; w++) {
+        cycles = 0;
+        for (n=0; n<BENCH_LOOPS; n++)
+        {
+            cycles1 = cpucycles(); 
+            Status = KeyGenerationFunctions_A[w](SecretKeyA, PublicKeyA, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+            Status = SecretAgreementFunctions_B[w](PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+            Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
+            if (Status != CRYPTO_SUCCESS) {
+                goto cleanup;
+            }    
+            cycles2 = cpucycles();
+            cycles = cycles+(cycles2-cycles1);
+        }
+        printf("  Full key exchange, noise width %2d, runs in .................................... %8lld cycles", widths[w], cycles/BENCH_LOOPS);
+        printf("\n");
+    }
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)s, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)e, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)v, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    
+    return Status;
+}
+
+
+CRYPTO_STATUS packed_key_test()
+{ // Tests and benchmarks for the key exchange with Alice's packed secret key
+    int n, passed, i;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N];
+    uint32_t unpacked[PARAMETER_N];
+    unsigned char PackedKeyA[SKA_PACKED_BYTES], PackedKeyA1[SKA_PACKED_BYTES], PublicKeyA[PKA_BYTES], PublicKeyA1[PKA_BYTES], PublicKeyB[PKB_BYTES];
+    unsigned char SharedSecretA[SHAREDKEY_BYTES], SharedSecretA1[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the key exchange with Alice's packed secret key: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, extendable_output_test, stream_output_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10 && passed==1; n++)
+    {   
+        // With the same randomness KeyGeneration_A_packed outputs the same public key as KeyGeneration_A_int32, and the packed key holds its secret key mod q
+        srand(n);
+        Status = KeyGeneration_A_packed(PackedKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        srand(n);
+        Status = KeyGeneration_A_int32(SecretKeyA, PublicKeyA1, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (memcmp(PublicKeyA, PublicKeyA1, PKA_BYTES)!=0) { passed = 0; break; }
+        LatticeCrypto_pack_secret_key(SecretKeyA, PackedKeyA1);
+        if (memcmp(PackedKeyA, PackedKeyA1, SKA_PACKED_BYTES)!=0) { passed = 0; break; }
+        decode_generic(PackedKeyA, unpacked);
+        for (i=0; i<PARAMETER_N; i++) { if ((int)unpacked[i] != reduce(SecretKeyA[i], PARAMETER_Q)) { passed = 0; break; } }
+
+        // SecretAgreement_A_packed computes the same shared key as SecretAgreement_A_int32
+        Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        Status = SecretAgreement_A_packed(PublicKeyB, PackedKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        Status = SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA1);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (memcmp(SharedSecretA, SharedSecretB, SHAREDKEY_BYTES)!=0 || memcmp(SharedSecretA, SharedSecretA1, SHAREDKEY_BYTES)!=0) { passed = 0; break; }
+
+        // A secret key from KeyGeneration_A, on 16-bit or 32-bit coefficients, can be packed after the fact
+        Status = KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        LatticeCrypto_pack_secret_key(SecretKeyA, PackedKeyA);
+        Status = SecretAgreement_A_packed(PublicKeyB, PackedKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (memcmp(SharedSecretA, SharedSecretB, SHAREDKEY_BYTES)!=0) { passed = 0; break; }
+    } 
+    if (SecretAgreement_A_packed(PublicKeyB, NULL, SharedSecretA) != CRYPTO_ERROR_INVALID_PARAMETER) passed = 0;
+    if (LatticeCrypto_pack_secret_key(NULL, PackedKeyA) != CRYPTO_ERROR_INVALID_PARAMETER) passed = 0;
+    if (passed==1) printf("  Key exchange tests with a packed secret key.................................... PASSED");
+    else { printf("  Key exchange tests with a packed secret key... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_A_packed(PublicKeyB, PackedKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_A with a packed secret key (%d bytes) runs in ............... %8lld cycles", SKA_PACKED_BYTES, cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        Status = SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_A with a 32-bit secret key (%d bytes) runs in ............... %8lld cycles", 4*PARAMETER_N, cycles/BENCH_LOOPS);
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)unpacked, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)PackedKeyA, NBYTES_TO_NWORDS(SKA_PACKED_BYTES));
+    clear_words((void*)PackedKeyA1, NBYTES_TO_NWORDS(SKA_PACKED_BYTES));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretA1, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+
+    return Status;
+}
+
+
+static void secret_agreement_a_reference(const LatticeCryptoParams* params, unsigned char* PublicKeyB, int32_t* SecretKeyA, unsigned char* SharedSecretA)
+{ // Alice's shared secret computation with PublicKeyB fully decoded by decode_B before the kernels run
+    uint32_t u[PARAMETER_N_MAX], r[PARAMETER_N_MAX];
+    unsigned int N = params->N;
+
+    decode_B(PublicKeyB, u, r, N);
+    pmul(SecretKeyA, (int32_t*)u, (int32_t*)u, N);
+    INTT_GS_rev2std_12289((int32_t*)u, params->omegainv_rev, params->omegainv1N_rev, params->Ninv, N);
+    two_reduce12289((int32_t*)u, N);
+    Rec(u, r, SharedSecretA, N);
+}
+
+
+CRYPTO_STATUS fused_decode_test()
+{ // Tests and benchmarks for SecretAgreement_A decoding PublicKeyB by blocks fused with pmul and reading rvec packed
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N_MAX];
+    unsigned char PackedKeyA[SKA_PACKED_BYTES], PublicKeyA[PKA_BYTES_2048], PublicKeyB[PKB_BYTES_2048];
+    unsigned char SharedSecretA[SHAREDKEY_BYTES_2048], SharedSecretA1[SHAREDKEY_BYTES_2048], SharedSecretB[SHAREDKEY_BYTES_2048];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the fused decoding of SecretAgreement_A: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS && passed==1; n++)
+    {   
+        // Key exchanges, and Bob's public keys of random bytes whose coefficients may exceed q, give the same keys as the full decoding
+        Status = KeyGeneration_A_int32(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        if (n % 2 == 1) {
+            random_bytes_test(PKB_BYTES, PublicKeyB);
+        }
+        SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA);
+        secret_agreement_a_reference(&params_ntt1024_12289, PublicKeyB, SecretKeyA, SharedSecretA1);
+        if (memcmp(SharedSecretA, SharedSecretA1, SHAREDKEY_BYTES)!=0) { passed = 0; break; }
+        if (n % 2 == 0 && memcmp(SharedSecretA, SharedSecretB, SHAREDKEY_BYTES)!=0) { passed = 0; break; }
+        LatticeCrypto_pack_secret_key(SecretKeyA, PackedKeyA);
+        SecretAgreement_A_packed(PublicKeyB, PackedKeyA, SharedSecretA);
+        if (memcmp(SharedSecretA, SharedSecretA1, SHAREDKEY_BYTES)!=0) { passed = 0; break; }
+
+        // N = 512 and N = 2048, whose reconciliation also reads rvec packed in the vectorized builds for N = 512
+        if (n % 10 == 0) {
+            KeyGeneration_A_512(SecretKeyA, PublicKeyA, pLatticeCrypto);
+            random_bytes_test(PKB_BYTES_512, PublicKeyB);
+            SecretAgreement_A_512(PublicKeyB, SecretKeyA, SharedSecretA);
+            secret_agreement_a_reference(&params_ntt512_12289, PublicKeyB, SecretKeyA, SharedSecretA1);
+            if (memcmp(SharedSecretA, SharedSecretA1, SHAREDKEY_BYTES_512)!=0) { passed = 0; break; }
+            KeyGeneration_A_2048(SecretKeyA, PublicKeyA, pLatticeCrypto);
+            random_bytes_test(PKB_BYTES_2048, PublicKeyB);
+            SecretAgreement_A_2048(PublicKeyB, SecretKeyA, SharedSecretA);
+            secret_agreement_a_reference(&params_ntt2048_12289, PublicKeyB, SecretKeyA, SharedSecretA1);
+            if (memcmp(SharedSecretA, SharedSecretA1, SHAREDKEY_BYTES_2048)!=0) { passed = 0; break; }
+        }
+    } 
+    if (passed==1) printf("  Fused decoding tests........................................................... PASSED");
+    else { printf("  Fused decoding tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    Status = KeyGeneration_A_int32(SecretKeyA, PublicKeyA, pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_A with the fused decoding runs in ............................. %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        secret_agreement_a_reference(&params_ntt1024_12289, PublicKeyB, SecretKeyA, SharedSecretA);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_A with PublicKeyB decoded first runs in ....................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N_MAX));
+    clear_words((void*)PackedKeyA, NBYTES_TO_NWORDS(SKA_PACKED_BYTES));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+    clear_words((void*)SharedSecretA1, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+
+    return Status;
+}
+
+
+typedef void* (*test_worker)(void* job);
+
+static void run_test_threads(test_worker worker, void* jobs, size_t job_size)
+{ // Run worker on each of the DIFF_THREADS jobs of job_size bytes at jobs, one thread each, and wait for them
+  // The bound tracker keeps global statistics, so its builds run the jobs one after the other
+    unsigned char* job = (unsigned char*)jobs;
+    unsigned int i;
+#if (OS_TARGET == OS_LINUX) && !defined(BOUND_TRACKING)
+    pthread_t threads[DIFF_THREADS];
+    bool started[DIFF_THREADS];
+
+    for (i = 0; i < DIFF_THREADS; i++) {
+        started[i] = (pthread_create(&threads[i], NULL, worker, &job[i*job_size]) == 0);
+    }
+    for (i = 0; i < DIFF_THREADS; i++) {
+        if (started[i] == true) {
+            pthread_join(threads[i], NULL);
+        } else {
+            worker(&job[i*job_size]);       // Run the job of a thread that could not be created
+        }
+    }
+#else
+    for (i = 0; i < DIFF_THREADS; i++) {
+        worker(&job[i*job_size]);
+    }
+#endif
+}
+
+
+#define CACHE_KEYS        3          // Number of public keys of Alice shared by the threads of the cache tests, one more than the cache holds
+
+typedef struct {
+    uint64_t seed;                      // Seed of the pseudo-random generator of the thread
+    PLatticeCryptoStruct pLatticeCrypto;
+    int32_t (*SecretKeyA)[PARAMETER_N];
+    unsigned char (*PublicKeyA)[PKA_BYTES];
+    unsigned int lookups, kex_failed;
+    CRYPTO_STATUS Status;
+} a_cache_job;
+
+static void* a_cache_worker(void* arg)
+{ // Run key exchanges against the public keys of Alice in turn, with the cache shared by all the threads
+    a_cache_job* job = (a_cache_job*)arg;
+    unsigned char PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned int n, k;
+
+    prng_seed_test(job->seed);
+    for (n = 0; n < TEST_LOOPS/10; n++) {
+        k = (unsigned int)(job->seed + n) % CACHE_KEYS;
+        job->Status = SecretAgreement_B(job->PublicKeyA[k], SharedSecretB, PublicKeyB, job->pLatticeCrypto);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        job->lookups++;
+        job->Status = SecretAgreement_A(PublicKeyB, job->SecretKeyA[k], SharedSecretA);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) job->kex_failed++;
+    }
+    return NULL;
+}
+
+
+CRYPTO_STATUS a_cache_test()
+{ // Tests and benchmarks for the cache of the expanded parameter a
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[CACHE_KEYS][PARAMETER_N];
+    unsigned char PublicKeyA[CACHE_KEYS][PKA_BYTES], PublicKeyB1[PKB_BYTES], PublicKeyB2[PKB_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned int i, lookups = 0, kex_failed = 0;
+    uint64_t hits, misses;
+    a_cache_job jobs[DIFF_THREADS];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the cache of the expanded parameter a: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_prng_test, NULL, stream_output_prng_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    Status = LatticeCrypto_enable_a_cache(pLatticeCrypto, CACHE_KEYS-1);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    // A hit outputs the same keys as the expansion of a, and the least recently used entry is replaced: Alice's 3 key generations miss 
+    // and leave the 2 last seeds, Bob hits them and misses the first seed, which replaces the third one, and then hits the second seed
+    passed = 1;
+    prng_seed_test(1);
+    for (i = 0; i < CACHE_KEYS && passed==1; i++) {
+        if (KeyGeneration_A(SecretKeyA[i], PublicKeyA[i], pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+    }
+    for (i = CACHE_KEYS; i > 0 && passed==1; i--) {
+        prng_seed_test(2);
+        if (SecretAgreement_B(PublicKeyA[i-1], SharedSecretB, PublicKeyB1, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+    }
+    prng_seed_test(2);
+    if (SecretAgreement_B(PublicKeyA[1], SharedSecretB, PublicKeyB1, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+    LatticeCrypto_get_a_cache_stats(pLatticeCrypto, &hits, &misses);
+    if (hits != CACHE_KEYS || misses != CACHE_KEYS+1) passed = 0;
+    LatticeCrypto_disable_a_cache(pLatticeCrypto);
+    prng_seed_test(2);
+    if (SecretAgreement_B(PublicKeyA[1], SharedSecretB, PublicKeyB2, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+    if (memcmp(PublicKeyB1, PublicKeyB2, PKB_BYTES) != 0) passed = 0;
+    LatticeCrypto_get_a_cache_stats(pLatticeCrypto, &hits, &misses);
+    if (hits != 0 || misses != 0) passed = 0;
+    if (passed==1) printf("  Cache of a tests............................................................... PASSED");
+    else { printf("  Cache of a tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR; goto cleanup; }
+    printf("\n");
+
+    // Threads share the cache, with more seeds than entries so that they replace each other's entries
+    Status = LatticeCrypto_enable_a_cache(pLatticeCrypto, CACHE_KEYS-1);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    for (i = 0; i < DIFF_THREADS; i++) {
+        jobs[i].seed = 0xCAC4E000 + i;
+        jobs[i].pLatticeCrypto = pLatticeCrypto;
+        jobs[i].SecretKeyA = SecretKeyA;
+        jobs[i].PublicKeyA = PublicKeyA;
+        jobs[i].lookups = 0;
+        jobs[i].kex_failed = 0;
+        jobs[i].Status = CRYPTO_SUCCESS;
+    }
+    run_test_threads(a_cache_worker, jobs, sizeof(a_cache_job));
+    for (i = 0; i < DIFF_THREADS; i++) {
+        lookups += jobs[i].lookups;
+        kex_failed += jobs[i].kex_failed;
+        if (jobs[i].Status != CRYPTO_SUCCESS) {
+            Status = jobs[i].Status;
+        }
+    }
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    LatticeCrypto_get_a_cache_stats(pLatticeCrypto, &hits, &misses);
+    if (kex_failed==0 && hits+misses == lookups) printf("  Cache of a tests with %d threads................................................ PASSED", DIFF_THREADS);
+    else { printf("  Cache of a tests with %d threads... FAILED (%u failed key exchanges)", DIFF_THREADS, kex_failed); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    // Benchmarking SecretAgreement_B with a cache hit and without the cache, with the built-in extendable-output function
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        SecretAgreement_B(PublicKeyA[0], SharedSecretB, PublicKeyB1, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B with a cache hit runs in .................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    LatticeCrypto_disable_a_cache(pLatticeCrypto);
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        SecretAgreement_B(PublicKeyA[0], SharedSecretB, PublicKeyB1, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B without the cache runs in ................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+cleanup:
+    LatticeCrypto_free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(sizeof(SecretKeyA)));
+    
+    return Status;
+}
+
+
+#define POOL_SLOTS        8          // Number of slots of the noise pool in the pool tests
+#define POOL_BENCH_SLOTS  64         // Number of slots of the noise pool in the pool benchmark
+
+static bool pool_wait(PLatticeCryptoStruct pLatticeCrypto, unsigned int nslots, bool keypairs)
+{ // Wait up to about 10 seconds for "nslots" ready slots in the noise pool, or in the key pair pool if keypairs = true
+    unsigned int i, nready;
+    uint64_t produced, hits, misses;
+
+    for (i = 0; i < 10000; i++) {
+        if (keypairs == true) {
+            LatticeCrypto_get_keypair_pool_stats(pLatticeCrypto, &nready, &produced, &hits, &misses);
+        } else {
+            LatticeCrypto_get_noise_pool_stats(pLatticeCrypto, &nready, &hits, &misses);
+        }
+        if (nready >= nslots) {
+            return true;
+        }
+        sleep_ms_test(1);
+    }
+    return false;
+}
+
+typedef struct {
+    uint64_t seed;                      // Seed of the pseudo-random generator of the thread
+    PLatticeCryptoStruct pLatticeCrypto;
+    unsigned int requests, kex_failed;
+    CRYPTO_STATUS Status;
+} noise_pool_job;
+
+static void* noise_pool_worker(void* arg)
+{ // Run key exchanges with the noise pool shared by all the threads
+    noise_pool_job* job = (noise_pool_job*)arg;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned int n;
+
+    prng_seed_test(job->seed);
+    for (n = 0; n < TEST_LOOPS/10; n++) {
+        job->Status = KeyGeneration_A_int32(SecretKeyA, PublicKeyA, job->pLatticeCrypto);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        job->Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, job->pLatticeCrypto);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        job->requests += 2;
+        job->Status = SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) job->kex_failed++;
+    }
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    return NULL;
+}
+
+
+CRYPTO_STATUS noise_pool_test()
+{ // Tests and benchmarks for the background pool of noise in NTT form
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned int i, nready, requests = 0, kex_failed = 0;
+    uint64_t hits, misses;
+    noise_pool_job jobs[DIFF_THREADS];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the noise pool: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_prng_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    Status = LatticeCrypto_enable_noise_pool(pLatticeCrypto, POOL_SLOTS);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    // Key exchanges with noise from a full pool and then from the pool or the request path, as the producer keeps up
+    passed = 1;
+    prng_seed_test(3);
+    if (pool_wait(pLatticeCrypto, POOL_SLOTS, false) == false) passed = 0;
+    for (n=0; n<2*POOL_SLOTS && passed==1; n++)
+    {
+        if (KeyGeneration_A_int32(SecretKeyA, PublicKeyA, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+        if (SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+        if (SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA) != CRYPTO_SUCCESS) passed = 0;
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) passed = 0;
+    }
+    LatticeCrypto_get_noise_pool_stats(pLatticeCrypto, &nready, &hits, &misses);
+    if (hits < POOL_SLOTS || hits+misses != 4*POOL_SLOTS || nready > POOL_SLOTS) passed = 0;
+
+    // The N = 512 parameter set does not use the pool
+    if (KeyGeneration_A_512(SecretKeyA, PublicKeyA, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+    LatticeCrypto_get_noise_pool_stats(pLatticeCrypto, &nready, &hits, &misses);
+    if (hits+misses != 4*POOL_SLOTS) passed = 0;
+    LatticeCrypto_disable_noise_pool(pLatticeCrypto);
+    LatticeCrypto_get_noise_pool_stats(pLatticeCrypto, &nready, &hits, &misses);
+    if (nready != 0 || hits != 0 || misses != 0) passed = 0;
+    if (LatticeCrypto_enable_noise_pool(pLatticeCrypto, NOISE_POOL_MAX_SLOTS+1) != CRYPTO_ERROR_INVALID_PARAMETER) passed = 0;
+    if (passed==1) printf("  Noise pool tests............................................................... PASSED");
+    else { printf("  Noise pool tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR; goto cleanup; }
+    printf("\n");
+
+    // Threads take slots from the pool while it is being filled
+    Status = LatticeCrypto_enable_noise_pool(pLatticeCrypto, POOL_SLOTS);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    pool_wait(pLatticeCrypto, POOL_SLOTS, false);
+    for (i = 0; i < DIFF_THREADS; i++) {
+        jobs[i].seed = 0x9001E000 + i;
+        jobs[i].pLatticeCrypto = pLatticeCrypto;
+        jobs[i].requests = 0;
+        jobs[i].kex_failed = 0;
+        jobs[i].Status = CRYPTO_SUCCESS;
+    }
+    run_test_threads(noise_pool_worker, jobs, sizeof(noise_pool_job));
+    for (i = 0; i < DIFF_THREADS; i++) {
+        requests += jobs[i].requests;
+        kex_failed += jobs[i].kex_failed;
+        if (jobs[i].Status != CRYPTO_SUCCESS) {
+            Status = jobs[i].Status;
+        }
+    }
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    LatticeCrypto_get_noise_pool_stats(pLatticeCrypto, &nready, &hits, &misses);
+    if (kex_failed==0 && hits >= POOL_SLOTS && hits+misses == requests) printf("  Noise pool tests with %d threads................................................ PASSED", DIFF_THREADS);
+    else { printf("  Noise pool tests with %d threads... FAILED (%u failed key exchanges)", DIFF_THREADS, kex_failed); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    // Benchmarking SecretAgreement_B with the noise from a full pool and without the pool
+    Status = LatticeCrypto_enable_noise_pool(pLatticeCrypto, POOL_BENCH_SLOTS);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        if (n % POOL_BENCH_SLOTS == 0) {
+            pool_wait(pLatticeCrypto, POOL_BENCH_SLOTS, false);
+        }
+        cycles1 = cpucycles(); 
+        SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B with the noise from the pool runs in ........................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    LatticeCrypto_disable_noise_pool(pLatticeCrypto);
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  SecretAgreement_B without the pool runs in .................................... %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+cleanup:
+    LatticeCrypto_free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    
+    return Status;
+}
+
+
+typedef struct {
+    uint64_t seed;                      // Seed of the pseudo-random generator of the thread
+    PLatticeCryptoStruct pLatticeCrypto;
+    unsigned int takes, kex_failed;
+    CRYPTO_STATUS Status;
+} keypair_pool_job;
+
+static void* keypair_pool_worker(void* arg)
+{ // Run key exchanges with Alice's key pairs taken from the pool shared by all the threads
+    keypair_pool_job* job = (keypair_pool_job*)arg;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned int n;
+
+    prng_seed_test(job->seed);
+    for (n = 0; n < TEST_LOOPS/10; n++) {
+        job->Status = LatticeCrypto_take_keypair(job->pLatticeCrypto, SecretKeyA, PublicKeyA);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        job->takes++;
+        job->Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, job->pLatticeCrypto);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        job->Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (job->Status != CRYPTO_SUCCESS) {
+            return NULL;
+        }
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) job->kex_failed++;
+    }
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    return NULL;
+}
+
+
+CRYPTO_STATUS keypair_pool_test()
+{ // Tests and benchmarks for the pool of Alice's key pairs
+    int n, passed;
+    unsigned long long cycles, cycles1, cycles2;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PreviousKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    unsigned int i, nready, takes = 0, kex_failed = 0;
+    uint64_t produced, hits, misses;
+    keypair_pool_job jobs[DIFF_THREADS];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the pool of Alice's key pairs: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_prng_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    Status = LatticeCrypto_enable_keypair_pool(pLatticeCrypto, POOL_SLOTS);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    // Key exchanges with key pairs from a full pool and then from the pool or KeyGeneration_A, as the refill thread keeps up. No key pair is output twice
+    passed = 1;
+    prng_seed_test(4);
+    memset(PreviousKeyA, 0, PKA_BYTES);
+    if (pool_wait(pLatticeCrypto, POOL_SLOTS, true) == false) passed = 0;
+    for (n=0; n<2*POOL_SLOTS && passed==1; n++)
+    {
+        if (LatticeCrypto_take_keypair(pLatticeCrypto, SecretKeyA, PublicKeyA) != CRYPTO_SUCCESS) passed = 0;
+        if (memcmp(PublicKeyA, PreviousKeyA, PKA_BYTES) == 0) passed = 0;
+        memcpy(PreviousKeyA, PublicKeyA, PKA_BYTES);
+        if (SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+        if (SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA) != CRYPTO_SUCCESS) passed = 0;
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) passed = 0;
+    }
+    LatticeCrypto_get_keypair_pool_stats(pLatticeCrypto, &nready, &produced, &hits, &misses);
+    if (hits < POOL_SLOTS || hits+misses != 2*POOL_SLOTS || produced < hits || nready > POOL_SLOTS) passed = 0;
+
+    // Without a pool, a key pair is generated on request
+    LatticeCrypto_disable_keypair_pool(pLatticeCrypto);
+    LatticeCrypto_get_keypair_pool_stats(pLatticeCrypto, &nready, &produced, &hits, &misses);
+    if (nready != 0 || produced != 0 || hits != 0 || misses != 0) passed = 0;
+    if (LatticeCrypto_take_keypair(pLatticeCrypto, SecretKeyA, PublicKeyA) != CRYPTO_SUCCESS) passed = 0;
+    if (SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto) != CRYPTO_SUCCESS) passed = 0;
+    if (SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA) != CRYPTO_SUCCESS) passed = 0;
+    if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) passed = 0;
+    if (LatticeCrypto_enable_keypair_pool(pLatticeCrypto, KEYPAIR_POOL_MAX_KEYPAIRS+1) != CRYPTO_ERROR_INVALID_PARAMETER) passed = 0;
+    if (passed==1) printf("  Key pair pool tests............................................................ PASSED");
+    else { printf("  Key pair pool tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR; goto cleanup; }
+    printf("\n");
+
+    // Threads take key pairs from the pool while it is being refilled
+    Status = LatticeCrypto_enable_keypair_pool(pLatticeCrypto, POOL_SLOTS);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    pool_wait(pLatticeCrypto, POOL_SLOTS, true);
+    for (i = 0; i < DIFF_THREADS; i++) {
+        jobs[i].seed = 0x4E1B0000 + i;
+        jobs[i].pLatticeCrypto = pLatticeCrypto;
+        jobs[i].takes = 0;
+        jobs[i].kex_failed = 0;
+        jobs[i].Status = CRYPTO_SUCCESS;
+    }
+    run_test_threads(keypair_pool_worker, jobs, sizeof(keypair_pool_job));
+    for (i = 0; i < DIFF_THREADS; i++) {
+        takes += jobs[i].takes;
+        kex_failed += jobs[i].kex_failed;
+        if (jobs[i].Status != CRYPTO_SUCCESS) {
+            Status = jobs[i].Status;
+        }
+    }
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    LatticeCrypto_get_keypair_pool_stats(pLatticeCrypto, &nready, &produced, &hits, &misses);
+    if (kex_failed==0 && hits >= POOL_SLOTS && hits+misses == takes) printf("  Key pair pool tests with %d threads............................................. PASSED", DIFF_THREADS);
+    else { printf("  Key pair pool tests with %d threads... FAILED (%u failed key exchanges)", DIFF_THREADS, kex_failed); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    // Benchmarking Alice's key pair from a full pool and from KeyGeneration_A
+    Status = LatticeCrypto_enable_keypair_pool(pLatticeCrypto, POOL_BENCH_SLOTS);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        if (n % POOL_BENCH_SLOTS == 0) {
+            pool_wait(pLatticeCrypto, POOL_BENCH_SLOTS, true);
+        }
+        cycles1 = cpucycles(); 
+        LatticeCrypto_take_keypair(pLatticeCrypto, SecretKeyA, PublicKeyA);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's key pair from the pool runs in ........................................ %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+    LatticeCrypto_disable_keypair_pool(pLatticeCrypto);
+    cycles = 0;
+    for (n=0; n<BENCH_LOOPS; n++)
+    {
+        cycles1 = cpucycles(); 
+        KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        cycles2 = cpucycles();
+        cycles = cycles+(cycles2-cycles1);
+    }
+    printf("  Alice's key pair from KeyGeneration_A runs in ................................. %8lld cycles", cycles/BENCH_LOOPS);
+    printf("\n");
+
+cleanup:
+    LatticeCrypto_free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    
+    return Status;
+}
+
+
+#if (OS_TARGET == OS_LINUX) && !defined(BOUND_TRACKING)
+typedef struct {
+    uint64_t done, failed;              // Completed and failed handshakes, updated by the worker threads
+} workers_round;
+
+typedef struct {
+    LatticeCryptoHandshakeJob job;
+    PLatticeCryptoStruct pLatticeCrypto;
+    workers_round* round;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+} workers_handshake;
+
+static void workers_start(unsigned int index)
+{ // Seed the pseudo-random generator of each worker thread differently
+    prng_seed_test(0x3C0B0000 + index);
+}
+
+
+static void workers_completion(PLatticeCryptoHandshakeJob job)
+{ // Chain the steps of a handshake: Alice's key generation, Bob's shared key and Alice's shared key, then compare the shared keys
+    workers_handshake* handshake = (workers_handshake*)job->Context;
+    bool failed = (job->Status != CRYPTO_SUCCESS);
+
+    if (failed == false && job->Step == HANDSHAKE_KEYGENERATION_A) {
+        job->Step = HANDSHAKE_AGREEMENT_B;
+        job->SharedSecret = handshake->SharedSecretB;
+        if (LatticeCrypto_submit_handshake(handshake->pLatticeCrypto, job) == CRYPTO_SUCCESS) {
+            return;
+        }
+        failed = true;
+    } else if (failed == false && job->Step == HANDSHAKE_AGREEMENT_B) {
+        job->Step = HANDSHAKE_AGREEMENT_A;
+        job->SharedSecret = handshake->SharedSecretA;
+        if (LatticeCrypto_submit_handshake(handshake->pLatticeCrypto, job) == CRYPTO_SUCCESS) {
+            return;
+        }
+        failed = true;
+    } else if (failed == false && memcmp(handshake->SharedSecretA, handshake->SharedSecretB, SHAREDKEY_BYTES) != 0) {
+        failed = true;
+    }
+    if (failed == true) {
+        __atomic_fetch_add(&handshake->round->failed, 1, __ATOMIC_ACQ_REL);
+    }
+    __atomic_fetch_add(&handshake->round->done, 1, __ATOMIC_ACQ_REL);
+}
+
+
+static CRYPTO_STATUS workers_submit(PLatticeCryptoStruct pLatticeCrypto, workers_handshake* handshakes, unsigned int count, workers_round* round)
+{ // Submit the first step of "count" handshakes to the worker pool
+    unsigned int i;
+    CRYPTO_STATUS Status;
+
+    round->done = 0;
+    round->failed = 0;
+    for (i = 0; i < count; i++) {
+        handshakes[i].pLatticeCrypto = pLatticeCrypto;
+        handshakes[i].round = round;
+        handshakes[i].job.Step = HANDSHAKE_KEYGENERATION_A;
+        handshakes[i].job.SecretKeyA = handshakes[i].SecretKeyA;
+        handshakes[i].job.PublicKeyA = handshakes[i].PublicKeyA;
+        handshakes[i].job.PublicKeyB = handshakes[i].PublicKeyB;
+        handshakes[i].job.SharedSecret = NULL;
+        handshakes[i].job.Completion = workers_completion;
+        handshakes[i].job.Context = &handshakes[i];
+        Status = LatticeCrypto_submit_handshake(pLatticeCrypto, &handshakes[i].job);
+        if (Status != CRYPTO_SUCCESS) {
+            return Status;
+        }
+    }
+    return CRYPTO_SUCCESS;
+}
+
+
+static void workers_wait(workers_round* round, unsigned int count)
+{ // Wait for the completion of "count" handshakes
+    while (__atomic_load_n(&round->done, __ATOMIC_ACQUIRE) < count) {
+        sleep_ms_test(1);
+    }
+}
+
+
+CRYPTO_STATUS workers_test()
+{ // Tests and benchmarks for the worker pool running handshakes
+    int passed;
+    unsigned int i, j, nthreads, ncores;
+    uint64_t completed, stolen;
+    int64_t time, time1, time2;
+    workers_handshake* handshakes;
+    workers_round round;
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the worker pool: \n\n"); 
+
+    handshakes = (workers_handshake*)calloc(WORKER_BENCH, sizeof(workers_handshake));
+    pLatticeCrypto = LatticeCrypto_allocate();
+    if (handshakes == NULL) {
+        Status = CRYPTO_ERROR_NO_MEMORY;
+        goto cleanup;
+    }
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_prng_test, NULL, NULL);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    // Handshakes chained by the completion callbacks. The threads draw different randomness, so that no public key is output twice
+    passed = 1;
+    if (LatticeCrypto_submit_handshake(pLatticeCrypto, &handshakes[0].job) != CRYPTO_ERROR_INVALID_PARAMETER) passed = 0;
+    if (LatticeCrypto_enable_workers(pLatticeCrypto, HANDSHAKE_WORKERS_MAX+1, NULL) != CRYPTO_ERROR_INVALID_PARAMETER) passed = 0;
+    Status = LatticeCrypto_enable_workers(pLatticeCrypto, WORKER_THREADS, workers_start);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    Status = workers_submit(pLatticeCrypto, handshakes, WORKER_HANDSHAKES, &round);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    workers_wait(&round, WORKER_HANDSHAKES);
+    if (round.failed != 0) passed = 0;
+    for (i = 0; i < WORKER_HANDSHAKES; i++) {
+        for (j = i+1; j < WORKER_HANDSHAKES; j++) {
+            if (memcmp(handshakes[i].PublicKeyA, handshakes[j].PublicKeyA, PKA_BYTES) == 0) passed = 0;
+        }
+    }
+    LatticeCrypto_get_worker_stats(pLatticeCrypto, &nthreads, &completed, &stolen);
+    if (nthreads != WORKER_THREADS || completed != 3*WORKER_HANDSHAKES) passed = 0;
+
+    // Removing the pool completes the pending handshakes, including the steps submitted by the callbacks in the meantime
+    Status = workers_submit(pLatticeCrypto, handshakes, WORKER_HANDSHAKES, &round);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+    LatticeCrypto_disable_workers(pLatticeCrypto);
+    if (round.done != WORKER_HANDSHAKES || round.failed != 0) passed = 0;
+    LatticeCrypto_get_worker_stats(pLatticeCrypto, &nthreads, &completed, &stolen);
+    if (nthreads != 0 || completed != 0 || stolen != 0) passed = 0;
+    if (passed==1) printf("  Worker pool tests with %d threads............................................... PASSED", WORKER_THREADS);
+    else { printf("  Worker pool tests with %d threads... FAILED", WORKER_THREADS); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+
+    // Benchmarking the handshakes per second from 1 thread up to one per core
+    ncores = cpu_count_test();
+    if (ncores > HANDSHAKE_WORKERS_MAX) {
+        ncores = HANDSHAKE_WORKERS_MAX;
+    }
+    for (nthreads = 1; ; nthreads = (2*nthreads < ncores) ? 2*nthreads : ncores) {
+        Status = LatticeCrypto_enable_workers(pLatticeCrypto, nthreads, workers_start);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        time1 = time_ns_test();
+        Status = workers_submit(pLatticeCrypto, handshakes, WORKER_BENCH, &round);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }
+        workers_wait(&round, WORKER_BENCH);
+        time2 = time_ns_test();
+        time = (time2 > time1) ? time2-time1 : 1;
+        LatticeCrypto_disable_workers(pLatticeCrypto);
+        if (round.failed != 0) {
+            Status = CRYPTO_ERROR_SHARED_KEY;
+            goto cleanup;
+        }
+        printf("  Full handshakes with a pool of %3u thread(s) run at ........................... %8lld per second", nthreads, (long long)((int64_t)WORKER_BENCH*1000000000/time));
+        printf("\n");
+        if (nthreads == ncores) {
+            break;
+        }
+    }
+
+cleanup:
+    LatticeCrypto_free(pLatticeCrypto);
+    if (handshakes != NULL) {
+        for (i = 0; i < WORKER_BENCH; i++) {
+            clear_words((void*)handshakes[i].SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+        }
+        free(handshakes);
+    }
+    
+    return Status;
+}
+#endif
+
+
+typedef struct {
+    uint64_t seed;                      // Seed of the pseudo-random generator of the thread
+    unsigned int first, loops;          // Range of iterations of the thread
+    PLatticeCryptoStruct pLatticeCrypto;
+    unsigned int products_failed, kex_failed;
+    CRYPTO_STATUS Status;
+} differential_job;
+
+static void* differential_worker(void* arg)
+{ // Check NTT-based products against the Karatsuba reference and run full key exchanges, cycling through the parameter sets
+    differential_job* job = (differential_job*)arg;
+    static const LatticeCryptoParams* const params[3] = { &params_ntt512_12289, &params_ntt1024_12289, &params_ntt2048_12289 };
+    static const KeyGenerationA KeyGenerationFunction_A[3] = { KeyGeneration_A_512, KeyGeneration_A, KeyGeneration_A_2048 };
+    static const SecretAgreementB SecretAgreementFunction_B[3] = { SecretAgreement_B_512, SecretAgreement_B, SecretAgreement_B_2048 };
+    static const SecretAgreementA SecretAgreementFunction_A[3] = { SecretAgreement_A_512, SecretAgreement_A, SecretAgreement_A_2048 };
+    int32_t a[PARAMETER_N_MAX], b[PARAMETER_N_MAX], c[PARAMETER_N_MAX], d[PARAMETER_N_MAX], e[PARAMETER_N_MAX], f[PARAMETER_N_MAX], g[PARAMETER_N_MAX];
+    int32_t SecretKeyA[PARAMETER_N_MAX];
+    unsigned char PublicKeyA[PKA_BYTES_2048], PublicKeyB[PKB_BYTES_2048], SharedSecretA[SHAREDKEY_BYTES_2048], SharedSecretB[SHAREDKEY_BYTES_2048];
+    const LatticeCryptoParams* set;
+    unsigned int n, k, N;
+
+    prng_seed_test(job->seed);
+    for (n = job->first; n < job->first + job->loops; n++)
+    {
+        k = n % 3;
+        set = params[k];
+        N = set->N;
+
+        // Emulating NTT operations in the key exchange: ((a*b + c)*d + e) with the scaled tables, as in params_ntt_test
+        random_poly_prng_test(a, PARAMETER_Q, N); random_poly_prng_test(b, PARAMETER_Q, N); 
+        random_poly_prng_test(c, PARAMETER_Q, N); random_poly_prng_test(d, PARAMETER_Q, N); 
+        random_poly_prng_test(e, PARAMETER_Q, N); 
+
+        karatsuba_mul_test(a, b, f, PARAMETER_Q, N);
+        add_test(f, c, f, PARAMETER_Q, N);
+        karatsuba_mul_test(f, d, f, PARAMETER_Q, N);
+        add_test(f, e, f, PARAMETER_Q, N);
+        NTT_CT_std2rev_12289(a, set->psi_rev, N);
+        NTT_CT_std2rev_12289(b, set->psi_rev, N);
+        NTT_CT_std2rev_12289(c, set->psi_rev3, N);
+        pmuladd(a, b, c, g, N);
+        NTT_CT_std2rev_12289(d, set->psi_rev, N);
+        NTT_CT_std2rev_12289(e, set->psi_rev81, N);
+        pmuladd(g, d, e, g, N);
+        INTT_GS_rev2std_12289(g, set->omegainv_rev, set->omegainv1N_rev, set->Ninv, N);
+        two_reduce12289(g, N);
+        correction(g, PARAMETER_Q, N);
+        if (compare_poly(f, g, N)!=0) job->products_failed++;
+
+        // Full key exchange
+        job->Status = KeyGenerationFunction_A[k](SecretKeyA, PublicKeyA, job->pLatticeCrypto);
+        if (job->Status != CRYPTO_SUCCESS) {
+            break;
+        }    
+        job->Status = SecretAgreementFunction_B[k](PublicKeyA, SharedSecretB, PublicKeyB, job->pLatticeCrypto);
+        if (job->Status != CRYPTO_SUCCESS) {
+            break;
+        }    
+        job->Status = SecretAgreementFunction_A[k](PublicKeyB, SecretKeyA, SharedSecretA);
+        if (job->Status != CRYPTO_SUCCESS) {
+            break;
+        }    
+        if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, set->sharedkey_bytes/4)!=0) job->kex_failed++;
+    }
+
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N_MAX));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES_2048));
+    return NULL;
+}
+
+
+CRYPTO_STATUS differential_test()
+{ // Differential tests of the backend in use against the Karatsuba reference, run by DIFF_THREADS threads
+    int n, passed;
+    int32_t a[PARAMETER_N], b[PARAMETER_N], c[PARAMETER_N], d[PARAMETER_N];
+    unsigned int i, products_failed = 0, kex_failed = 0, pbits = 14;
+    differential_job jobs[DIFF_THREADS];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Differential tests against the Karatsuba reference: \n\n"); 
+
+    passed = 1;
+    for (n=0; n<TEST_LOOPS/10; n++)
+    {   
+        // Testing the Karatsuba reference against the schoolbook method
+        random_poly_test(a, PARAMETER_Q, pbits, PARAMETER_N); random_poly_test(b, PARAMETER_Q, pbits, PARAMETER_N); 
+        mul_test(a, b, c, PARAMETER_Q, PARAMETER_N);
+        karatsuba_mul_test(a, b, d, PARAMETER_Q, PARAMETER_N);
+        if (compare_poly(c, d, PARAMETER_N)!=0) { passed = 0; break; }
+    } 
+    if (passed==1) printf("  Karatsuba reference tests...................................................... PASSED");
+    else { printf("  Karatsuba reference tests... FAILED"); printf("\n"); return CRYPTO_ERROR; }
+    printf("\n");
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_prng_test, extendable_output_prng_test, stream_output_prng_test);
+    if (Status != CRYPTO_SUCCESS) {
+        free(pLatticeCrypto);
+        return Status;
+    }
+
+    for (i = 0; i < DIFF_THREADS; i++) {
+        jobs[i].seed = 0x5EED0000 + i;
+        jobs[i].first = i*(DIFF_LOOPS/DIFF_THREADS);
+        jobs[i].loops = (i == DIFF_THREADS-1) ? DIFF_LOOPS - jobs[i].first : DIFF_LOOPS/DIFF_THREADS;
+        jobs[i].pLatticeCrypto = pLatticeCrypto;
+        jobs[i].products_failed = 0;
+        jobs[i].kex_failed = 0;
+        jobs[i].Status = CRYPTO_SUCCESS;
+    }
+    run_test_threads(differential_worker, jobs, sizeof(differential_job));
+    for (i = 0; i < DIFF_THREADS; i++) {
+        products_failed += jobs[i].products_failed;
+        kex_failed += jobs[i].kex_failed;
+        if (jobs[i].Status != CRYPTO_SUCCESS) {
+            Status = jobs[i].Status;
+        }
+    }
+    free(pLatticeCrypto);
+    if (Status != CRYPTO_SUCCESS) {
+        return Status;
+    }
+
+    if (products_failed == 0) printf("  NTT-based products, %8d products.......................................... PASSED", DIFF_LOOPS);
+    else { printf("  NTT-based products... FAILED (%d of %d)", products_failed, DIFF_LOOPS); printf("\n"); return CRYPTO_ERROR; }
+    printf("\n");
+    if (kex_failed == 0) printf("  Key exchanges, %8d exchanges.............................................. PASSED", DIFF_LOOPS);
+    else { printf("  Key exchanges... FAILED (%d of %d)", kex_failed, DIFF_LOOPS); printf("\n"); return CRYPTO_ERROR_SHARED_KEY; }
+    printf("\n");
+
+    return CRYPTO_SUCCESS;
+}
+
+
+#if defined(DISPATCH_SUPPORT)
+
+CRYPTO_STATUS dispatch_test()
+{ // Tests for runtime dispatch: key exchange between parties that run different backends
+    int n, passed, BackendA, BackendB;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    PLatticeCryptoStruct pLatticeCrypto;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the key exchange across backends: \n\n"); 
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, extendable_output_test, stream_output_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    passed = 1;
+    for (BackendA = CRYPTO_BACKEND_GENERIC; BackendA < CRYPTO_BACKEND_END_OF_LIST && passed == 1; BackendA++) {
+        for (BackendB = CRYPTO_BACKEND_GENERIC; BackendB < CRYPTO_BACKEND_END_OF_LIST && passed == 1; BackendB++) {
+            if (LatticeCrypto_set_backend((CRYPTO_BACKEND)BackendA) != CRYPTO_SUCCESS || LatticeCrypto_set_backend((CRYPTO_BACKEND)BackendB) != CRYPTO_SUCCESS) {
+                continue;                                         // Backend not supported by this CPU
+            }
+            for (n=0; n<TEST_LOOPS/10; n++)
+            {
+                LatticeCrypto_set_backend((CRYPTO_BACKEND)BackendA);
+                Status = KeyGeneration_A(SecretKeyA, PublicKeyA, pLatticeCrypto);
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }    
+                LatticeCrypto_set_backend((CRYPTO_BACKEND)BackendB);
+                Status = SecretAgreement_B(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }    
+                LatticeCrypto_set_backend((CRYPTO_BACKEND)BackendA);
+                Status = SecretAgreement_A(PublicKeyB, SecretKeyA, SharedSecretA);
+                if (Status != CRYPTO_SUCCESS) {
+                    goto cleanup;
+                }    
+
+                if (compare_poly((int32_t*)SharedSecretA, (int32_t*)SharedSecretB, SHAREDKEY_BYTES/4)!=0) { passed = 0; break; }
+            }
+        }
+    }
+    if (passed==1) printf("  Cross-backend key exchange tests............................................... PASSED");
+    else { printf("  Cross-backend key exchange tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_SHARED_KEY; goto cleanup; }
+    printf("\n");
+    
+cleanup:
+    LatticeCrypto_set_backend(CRYPTO_BACKEND_AUTO);
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    clear_words((void*)SharedSecretA, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    clear_words((void*)SharedSecretB, NBYTES_TO_NWORDS(SHAREDKEY_BYTES));
+    
+    return Status;
+}
+
+#endif
+
+
+#if defined(BOUND_TRACKING)
+
+typedef struct {
+    int64_t lo, hi;
+} interval;
+
+static bool interval_fits;    // Cleared when a modeled value does not fit where the generic kernels store it
+
+
+static void iv_check_int32(int64_t lo, int64_t hi)
+{ // Clear interval_fits if a value in [lo, hi] does not fit in 32 bits
+    if (lo < INT32_MIN || hi > INT32_MAX) {    
+        interval_fits = false;
+    }
+}
+
+
+static interval iv_make(int64_t lo, int64_t hi)
+{ // Interval [lo, hi] of values stored in 32 bits
+    interval r;
+
+    r.lo = lo;
+    r.hi = hi;
+    iv_check_int32(lo, hi);
+    return r;
+}
+
+
+static interval iv_hull(interval x, interval y)
+{ // Smallest interval that contains x and y
+    return iv_make((x.lo < y.lo) ? x.lo : y.lo, (x.hi > y.hi) ? x.hi : y.hi);
+}
+
+
+static interval iv_butterfly(interval u, interval v)
+{ // Range of u+v and u-v
+    return iv_hull(iv_make(u.lo + v.lo, u.hi + v.hi), iv_make(u.lo - v.hi, u.hi - v.lo));
+}
+
+
+static interval iv_add(interval x, interval y)
+{ // Range of x+y, computed on 64 bits by the kernels
+    interval r = { x.lo + y.lo, x.hi + y.hi };
+
+    return r;
+}
+
+
+static interval iv_mul(interval x, interval y)
+{ // Range of x*y, computed on 64 bits by the kernels
+    int64_t p[4] = { x.lo*y.lo, x.lo*y.hi, x.hi*y.lo, x.hi*y.hi };
+    interval r = { p[0], p[0] };
+    int i;
+
+    for (i = 1; i < 4; i++) {
+        if (p[i] < r.lo) r.lo = p[i];
+        if (p[i] > r.hi) r.hi = p[i];
+    }
+    return r;
+}
+
+
+static interval iv_reduce(interval x)
+{ // Range of reduce12289(a) = 3*c0 - c1, with c0 = a & 0xfff in [0, 4095] and c1 = a >> 12 truncated to 32 bits
+    iv_check_int32(x.lo >> 12, x.hi >> 12);                                // c1 is truncated to 32 bits
+    return iv_make(-(x.hi >> 12), 3*4095 - (x.lo >> 12));
+}
+
+
+static interval iv_reduce_2x(interval x)
+{ // Range of reduce12289_2x(a) = 9*c0 - 3*c1 + c2, with c0, c1 in [0, 4095] and c2 = a >> 24
+    return iv_make(-3*4095 + (x.lo >> 24), 9*4095 + (x.hi >> 24));
+}
+
+
+static interval iv_corrected(interval x)
+{ // Range after the correction fused into two_reduce12289 and pmuladd, which needs inputs in [-q, 2q)
+    if (x.lo < -PARAMETER_Q || x.hi >= 2*PARAMETER_Q) {
+        interval_fits = false;
+    }
+    return iv_make(0, PARAMETER_Q-1);
+}
+
+
+static interval iv_table(const int32_t* table, unsigned int first, unsigned int N)
+{ // Range of the entries of a twiddle factor table
+    interval r = { table[first], table[first] };
+    unsigned int i;
+
+    for (i = first+1; i < N; i++) {
+        if (table[i] < r.lo) r.lo = table[i];
+        if (table[i] > r.hi) r.hi = table[i];
+    }
+    return r;
+}
+
+
+static interval iv_ntt(interval x, const int32_t* psi_rev)
+{ // Output range of NTT_CT_std2rev_12289_generic, following its reduction schedule
+    interval S = iv_table(psi_rev, 1, PARAMETER_N), T = iv_make(psi_rev[0], psi_rev[0]);
+    unsigned int m;
+
+    for (m = 1; m < 128; m = 2*m) {
+        x = iv_butterfly(x, iv_reduce(iv_mul(x, S)));
+    }
+    x = iv_butterfly(iv_reduce(iv_mul(x, T)), iv_reduce_2x(iv_mul(x, S)));
+    for (m = 256; m < PARAMETER_N; m = 2*m) {
+        x = iv_butterfly(x, iv_reduce(iv_mul(x, S)));
+    }
+    return x;
+}
+
+
+static interval iv_intt(interval x, const int32_t* omegainv_rev, const int32_t omegainv1N_rev, const int32_t Ninv)
+{ // Output range of INTT_GS_rev2std_12289_generic, following its reduction schedule
+    interval S = iv_table(omegainv_rev, 1, PARAMETER_N), sum, diff;
+    unsigned int m;
+
+    for (m = PARAMETER_N; m > 2; m >>= 1) {
+        sum = iv_make(2*x.lo, 2*x.hi);
+        diff = iv_make(x.lo - x.hi, x.hi - x.lo);
+        if (m == 32) {
+            x = iv_hull(iv_reduce(sum), iv_reduce_2x(iv_mul(diff, S)));
+        } else {
+            x = iv_hull(sum, iv_reduce(iv_mul(diff, S)));
+        }
+    }
+    sum = iv_make(2*x.lo, 2*x.hi);
+    diff = iv_make(x.lo - x.hi, x.hi - x.lo);
+    return iv_hull(iv_reduce(iv_mul(sum, iv_make(Ninv, Ninv))), iv_reduce(iv_mul(diff, iv_make(omegainv1N_rev, omegainv1N_rev))));
+}
+
+
+CRYPTO_STATUS bounds_test()
+{ // Tests that the coefficient ranges seen in the key exchange stay within the static bounds of the reduction schedule
+    int n, stage;
+    int32_t SecretKeyA[PARAMETER_N];
+    unsigned char PublicKeyA[PKA_BYTES], PublicKeyB[PKB_BYTES], SharedSecretA[SHAREDKEY_BYTES], SharedSecretB[SHAREDKEY_BYTES];
+    interval bound[BOUND_END_OF_LIST], error = { -12, 12 }, poly = { 0, PARAMETER_Q-1 };
+    const char* name[BOUND_END_OF_LIST] = { "NTT", "NTT x3", "NTT x81", "pmuladd", "pmul", "INTT (Bob)", "INTT (Alice)", "two_reduce" };
+    PLatticeCryptoStruct pLatticeCrypto;
+    bool passed = true;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    printf("\n--------------------------------------------------------------------------------------------------------\n\n"); 
+    printf("Testing the reduction bounds of the key exchange: \n\n"); 
+
+    // Static bounds: errors are in [-12, 12], a and the decoded public keys are in [0, q-1]
+    interval_fits = true;
+    bound[BOUND_NTT] = iv_ntt(error, psi_rev_ntt1024_12289);
+    bound[BOUND_NTT_X3] = iv_ntt(error, psi_rev3_ntt1024_12289);
+    bound[BOUND_NTT_X81] = iv_ntt(error, psi_rev81_ntt1024_12289);
+    bound[BOUND_PMULADD] = iv_hull(iv_corrected(iv_reduce(iv_reduce(iv_add(iv_mul(poly, bound[BOUND_NTT]), bound[BOUND_NTT_X3])))), 
+                                   iv_corrected(iv_reduce(iv_reduce(iv_add(iv_mul(poly, bound[BOUND_NTT]), bound[BOUND_NTT_X81])))));
+    bound[BOUND_PMUL] = iv_reduce(iv_reduce(iv_mul(bound[BOUND_NTT], poly)));
+    bound[BOUND_INTT_B] = iv_intt(bound[BOUND_PMULADD], omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289);
+    bound[BOUND_INTT_A] = iv_intt(bound[BOUND_PMUL], omegainv_rev_ntt1024_12289, omegainv10N_rev_ntt1024_12289, Ninv11_ntt1024_12289);
+    bound[BOUND_TWO_REDUCE] = iv_hull(iv_corrected(iv_reduce(iv_reduce(bound[BOUND_INTT_B]))), iv_corrected(iv_reduce(iv_reduce(bound[BOUND_INTT_A]))));
+
+    pLatticeCrypto = LatticeCrypto_allocate();
+    Status = LatticeCrypto_initialize(pLatticeCrypto, random_bytes_test, extendable_output_test, stream_output_test);
+    if (Status != CRYPTO_SUCCESS) {
+        goto cleanup;
+    }
+
+    reset_bounds();
+    for (n=0; n<TEST_LOOPS; n++)
+    {   
+        Status = KeyGeneration_A_int32(SecretKeyA, PublicKeyA, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreement_B_int32(PublicKeyA, SharedSecretB, PublicKeyB, pLatticeCrypto);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+        Status = SecretAgreement_A_int32(PublicKeyB, SecretKeyA, SharedSecretA);
+        if (Status != CRYPTO_SUCCESS) {
+            goto cleanup;
+        }    
+    } 
+
+    for (stage = 0; stage < BOUND_END_OF_LIST; stage++) {
+        printf("  %-14s observed [%7d, %7d]   static [%10lld, %10lld] \n", name[stage], bound_min[stage], bound_max[stage], (long long)bound[stage].lo, (long long)bound[stage].hi);
+        if (bound_min[stage] < bound[stage].lo || bound_max[stage] > bound[stage].hi) {
+            passed = false;
+        }
+    }
+    printf("\n");
+    if (passed == true && interval_fits == true) printf("  Reduction bound tests.......................................................... PASSED");
+    else { printf("  Reduction bound tests... FAILED"); printf("\n"); Status = CRYPTO_ERROR_UNKNOWN; goto cleanup; }
+    printf("\n");
+    
+cleanup:
+    free(pLatticeCrypto);
+    clear_words((void*)SecretKeyA, NBYTES_TO_NWORDS(4*PARAMETER_N));
+    
+    return Status;
+}
+
+#endif
+
+
+bool backend_tests()
+{ // Tests and benchmarks for the backend in use
+    bool OK = true;
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+
+    OK = OK && ntt_test();   // Test NTT functions
+    OK = OK && ntt_run();    // Benchmark NTT functions
+    OK = OK && sampling_test();   // Test error sampling
+    OK = OK && rejection_test();  // Test and benchmark rejection sampling
+    OK = OK && shake128_test();   // Test and benchmark the built-in extendable-output function
+    OK = OK && chacha20_test();   // Test and benchmark the built-in stream cipher
+    OK = OK && aes256ctr_test();  // Test the AES-256-CTR stream cipher and compare the stream ciphers in SecretAgreement_B
+    OK = OK && noise_test();      // Test and benchmark the sampling of the noise of a party
+    OK = OK && int16_test();      // Test 16-bit functions
+#if (SIMD_SUPPORT == AVX512_SUPPORT)
+    OK = OK && avx512_test();   // Test AVX-512 kernels
+    OK = OK && avx512_run();    // Benchmark AVX-512 kernels
+#endif
+#if defined(VECTOR_SUPPORT)
+    OK = OK && vector_test();   // Test vectorized kernels
+    OK = OK && vector_run();    // Benchmark vectorized kernels
+#endif
+    if (OK == false) {
+        return false;
+    }
+
+    Status = kex_test();     // Test key exchange 
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = kex_run();      // Benchmark key exchange
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = int16_kex_test();    // Test key exchange between the 16-bit and 32-bit pipelines
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = batch_test();    // Test and benchmark the batched key exchange
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = workspace_test();    // Test and benchmark the key exchange with a workspace
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = packed_key_test();    // Test and benchmark the key exchange with Alice's packed secret key
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = fused_decode_test();    // Test and benchmark the fused decoding of SecretAgreement_A
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = a_cache_test();    // Test and benchmark the cache of the expanded parameter a
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = noise_pool_test();    // Test and benchmark the background pool of noise
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = keypair_pool_test();    // Test and benchmark the pool of Alice's key pairs
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+#if (OS_TARGET == OS_LINUX) && !defined(BOUND_TRACKING)
+    Status = workers_test();    // Test and benchmark the worker pool running handshakes
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+#endif
+    Status = params_test();    // Test and benchmark the N = 512 and N = 2048 parameter sets
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = noise_width_test();    // Test and benchmark the key exchange with the noise widths 12, 8 and 4
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+    Status = differential_test();    // Test products and key exchanges at volume against the Karatsuba reference
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+#if defined(BOUND_TRACKING)
+    Status = bounds_test();    // Test the reduction bounds of the key exchange
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+
+int main()
+{
+#if defined(DISPATCH_SUPPORT)
+    CRYPTO_STATUS Status = CRYPTO_SUCCESS;
+    int Backend;
+
+    for (Backend = CRYPTO_BACKEND_GENERIC; Backend < CRYPTO_BACKEND_END_OF_LIST; Backend++) {
+        if (LatticeCrypto_set_backend((CRYPTO_BACKEND)Backend) != CRYPTO_SUCCESS) {
+            continue;        // Backend not supported by this CPU
+        }
+        printf("\n========================================================================================================\n\n"); 
+        printf("Backend: %s \n", LatticeCrypto_get_backend_name()); 
+        if (backend_tests() == false) {
+            return false;
+        }
+    }
+
+    Status = dispatch_test();  // Test key exchange across backends
+    if (Status != CRYPTO_SUCCESS) {
+        printf("\n\n   Error detected: %s \n\n", LatticeCrypto_get_error_message(Status));
+        return false;
+    }
+
+    return true;
+#else
+    return backend_tests();
+#endif
+}
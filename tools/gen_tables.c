@@ -0,0 +1,498 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: build-time generator for the NTT tables and constants of ntt_constants.c
+*
+*   usage: gen_tables N q [-psi root] [-k scale] [-stage m] [-istage m] [-scale t1,t2,...] [-ninv e1,e2,...] [-int16]
+*          gen_tables -check
+*
+*   N       ring dimension (a power of 2)
+*   q       prime modulus with q = 1 mod 2N
+*   -psi    primitive 2N-th root of unity (default: g^((q-1)/2N) for the smallest generator g of Z_q^*)
+*   -k      factor left by each K-RED reduction, q = k*2^m + 1 (default: the odd part of q-1)
+*   -stage  forward NTT stage m whose reduction is merged, i.e., whose twiddles carry the scale factor (default 128)
+*   -istage inverse NTT stage m that applies one extra reduction, for the 16-bit tables (default 32)
+*   -scale  factors of the pre-scaled copies of psi_rev (default k and k^4, i.e., 3 and 81 for q = 12289)
+*   -ninv   exponents e of the constants N^-1*k^-e and N^-1*k^-(e-1)*omegainv_rev[1] of the last INTT stage (default 8,11)
+*   -int16  also output the 16-bit tables and constants for the Montgomery arithmetic (q < 2^15)
+*   -check  regenerate the tables of the library and compare them against ntt_constants.c
+*
+*****************************************************************************************/
+
+#include "../LatticeCrypto_priv.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern const int32_t Ninv8_ntt1024_12289;
+extern const int32_t omegainv7N_rev_ntt1024_12289;
+extern const int16_t psi_rev_ntt1024_12289_int16[1024];
+extern const int16_t psi_rev3_ntt1024_12289_int16[1024];
+extern const int16_t psi_rev81_ntt1024_12289_int16[1024];
+extern const int16_t omegainv_rev_ntt1024_12289_int16[1024];
+extern const int16_t Ninv8_ntt1024_12289_int16;
+extern const int16_t omegainv7N_rev_ntt1024_12289_int16;
+extern const int16_t Ninv11_ntt1024_12289_int16;
+extern const int16_t omegainv10N_rev_ntt1024_12289_int16;
+
+#define MAX_LIST      8         // Maximum number of scale factors and of Ninv exponents
+#define PER_LINE      28        // Table entries per output line, as in ntt_constants.c
+
+
+typedef struct
+{ // Description of the tables to generate
+    uint32_t N;
+    uint32_t q;
+    uint32_t psi;
+    uint32_t k;
+    uint32_t stage;
+    uint32_t istage;
+    uint32_t scale[MAX_LIST];
+    unsigned int nscales;
+    uint32_t ninv[MAX_LIST];
+    unsigned int nninv;
+    bool int16;
+} table_spec;
+
+
+typedef struct
+{ // Generated tables and constants, with entries in [0, q-1] (32-bit) or in [-q/2, q/2] (16-bit)
+    int32_t* psi_rev;
+    int32_t* psi_rev_scaled[MAX_LIST];
+    int32_t* omegainv_rev;
+    int32_t Ninv[MAX_LIST];
+    int32_t omegainvN_rev[MAX_LIST];
+    int16_t* psi_rev_int16;
+    int16_t* psi_rev_scaled_int16[MAX_LIST];
+    int16_t* omegainv_rev_int16;
+    int16_t Ninv_int16[MAX_LIST];
+    int16_t omegainvN_rev_int16[MAX_LIST];
+} table_set;
+
+
+static uint32_t mulmod(uint32_t a, uint32_t b, uint32_t q)
+{
+    return (uint32_t)(((uint64_t)a * b) % q);
+}
+
+
+static uint32_t powmod(uint32_t a, uint64_t e, uint32_t q)
+{ // a^e mod q, by square-and-multiply
+    uint32_t r = 1 % q;
+
+    a %= q;
+    while (e != 0) {
+        if (e & 1) r = mulmod(r, a, q);
+        a = mulmod(a, a, q);
+        e >>= 1;
+    }
+    return r;
+}
+
+
+static uint32_t invmod(uint32_t a, uint32_t q)
+{ // a^-1 mod q for prime q
+    return powmod(a, q-2, q);
+}
+
+
+static int16_t invmod16(uint32_t q)
+{ // q^-1 mod 2^16 for odd q, by Newton iteration
+    uint16_t x = (uint16_t)q;
+    unsigned int i;
+
+    for (i = 0; i < 4; i++) {
+        x = (uint16_t)(x * (2 - (uint16_t)q * x));
+    }
+    return (int16_t)x;
+}
+
+
+static bool is_prime(uint32_t q)
+{
+    uint32_t d;
+
+    if (q < 2) return false;
+    for (d = 2; (uint64_t)d*d <= q; d++) {
+        if (q % d == 0) return false;
+    }
+    return true;
+}
+
+
+static uint32_t default_psi(uint32_t N, uint32_t q)
+{ // g^((q-1)/2N) for the smallest generator g of Z_q^*
+    uint32_t g, p, r, factors[32];
+    unsigned int i, nfactors = 0;
+    bool generator;
+
+    r = q - 1;
+    for (p = 2; (uint64_t)p*p <= r; p++) {
+        if (r % p == 0) {
+            factors[nfactors++] = p;
+            while (r % p == 0) r /= p;
+        }
+    }
+    if (r > 1) factors[nfactors++] = r;
+
+    for (g = 2; g < q; g++) {
+        generator = true;
+        for (i = 0; i < nfactors; i++) {
+            if (powmod(g, (q-1)/factors[i], q) == 1) { generator = false; break; }
+        }
+        if (generator) return powmod(g, (q-1)/(2*N), q);
+    }
+    return 0;
+}
+
+
+static uint32_t bitrev(uint32_t i, uint32_t N)
+{ // Reverses the log2(N) low bits of i
+    uint32_t r = 0, n;
+
+    for (n = 1; n < N; n <<= 1) {
+        r = (r << 1) | (i & 1);
+        i >>= 1;
+    }
+    return r;
+}
+
+
+static int16_t centered(uint32_t a, uint32_t q)
+{ // Representative of a mod q in [-q/2, q/2]
+    a %= q;
+    return (int16_t)(a > q/2 ? (int32_t)a - (int32_t)q : (int32_t)a);
+}
+
+
+static bool parse_list(const char* s, uint32_t* list, unsigned int* n)
+{ // Parses a comma-separated list of positive integers
+    char* end;
+
+    *n = 0;
+    do {
+        if (*n == MAX_LIST) return false;
+        list[*n] = (uint32_t)strtoul(s, &end, 10);
+        if (end == s || list[*n] == 0) return false;
+        (*n)++;
+        s = end + 1;
+    } while (*end == ',');
+    return (*end == '\0');
+}
+
+
+static bool check_spec(table_spec* spec)
+{ // Fills in the defaults and validates the parameters
+    uint32_t i;
+
+    if (spec->N < 2 || (spec->N & (spec->N - 1)) != 0) {
+        fprintf(stderr, "N must be a power of 2\n"); return false;
+    }
+    if (!is_prime(spec->q) || (spec->q - 1) % (2*spec->N) != 0) {
+        fprintf(stderr, "q must be a prime with q = 1 mod 2N\n"); return false;
+    }
+    if (spec->k == 0) {
+        for (spec->k = spec->q - 1; (spec->k & 1) == 0; spec->k >>= 1);
+    }
+    if (spec->k % spec->q == 0) {
+        fprintf(stderr, "k must be invertible mod q\n"); return false;
+    }
+    if (spec->psi == 0) {
+        spec->psi = default_psi(spec->N, spec->q);
+    }
+    if (powmod(spec->psi, spec->N, spec->q) != spec->q - 1) {
+        fprintf(stderr, "psi must be a primitive 2N-th root of unity mod q\n"); return false;
+    }
+    if (spec->stage >= spec->N || spec->istage > spec->N || (spec->stage & (spec->stage - 1)) != 0 || (spec->istage & (spec->istage - 1)) != 0) {
+        fprintf(stderr, "stage and istage must be powers of 2, with stage < N and istage <= N\n"); return false;
+    }
+    if (spec->nscales == 0) {
+        spec->scale[0] = spec->k;
+        spec->scale[1] = (uint32_t)powmod(spec->k, 4, spec->q);
+        spec->nscales = 2;
+        if (spec->k == 1) spec->nscales = 0;
+    }
+    if (spec->nninv == 0) {
+        spec->ninv[0] = 8;
+        spec->ninv[1] = 11;
+        spec->nninv = 2;
+    }
+    if (spec->int16 && spec->q >= (1 << 15)) {
+        fprintf(stderr, "the 16-bit tables need q < 2^15\n"); return false;
+    }
+    for (i = 0; i < spec->nscales; i++) {
+        if (spec->scale[i] % spec->q == 0) {
+            fprintf(stderr, "scale factors must be nonzero mod q\n"); return false;
+        }
+    }
+    return true;
+}
+
+
+static void scaled_psi_rev(const table_spec* spec, const int32_t* psi_rev, uint32_t scale, int32_t* out)
+{ // Copy of psi_rev that also scales the transform: entry 0 holds the factor and the twiddles of the merged stage are multiplied by it
+    uint32_t i;
+
+    for (i = 0; i < spec->N; i++) out[i] = psi_rev[i];
+    out[0] = (int32_t)(scale % spec->q);
+    for (i = spec->stage; i < 2*spec->stage; i++) {
+        out[i] = (int32_t)mulmod((uint32_t)psi_rev[i], scale, spec->q);
+    }
+}
+
+
+static bool generate(const table_spec* spec, table_set* set)
+{ // Generates all the tables and constants described by spec
+    uint32_t N = spec->N, q = spec->q, kinv = invmod(spec->k, q), psiinv = invmod(spec->psi, q), Ninv = invmod(N, q), R = (1 << 16) % q;
+    uint32_t i, j, scale;
+
+    memset(set, 0, sizeof(table_set));
+    set->psi_rev = (int32_t*)malloc(N*sizeof(int32_t));
+    set->omegainv_rev = (int32_t*)malloc(N*sizeof(int32_t));
+    if (set->psi_rev == NULL || set->omegainv_rev == NULL) return false;
+
+    // psi^brv(i) and psi^-brv(i), divided by the factor k that the K-RED reduction of each butterfly introduces
+    for (i = 0; i < N; i++) {
+        set->psi_rev[i] = (int32_t)mulmod(powmod(spec->psi, bitrev(i, N), q), kinv, q);
+        set->omegainv_rev[i] = (int32_t)mulmod(powmod(psiinv, bitrev(i, N), q), kinv, q);
+    }
+    set->psi_rev[0] = 1;
+    for (j = 0; j < spec->nscales; j++) {
+        set->psi_rev_scaled[j] = (int32_t*)malloc(N*sizeof(int32_t));
+        if (set->psi_rev_scaled[j] == NULL) return false;
+        scaled_psi_rev(spec, set->psi_rev, spec->scale[j], set->psi_rev_scaled[j]);
+    }
+    for (j = 0; j < spec->nninv; j++) {
+        set->Ninv[j] = (int32_t)mulmod(Ninv, powmod(kinv, spec->ninv[j], q), q);
+        set->omegainvN_rev[j] = (int32_t)mulmod(mulmod(Ninv, powmod(kinv, spec->ninv[j] - 1, q), q), (uint32_t)set->omegainv_rev[1], q);
+    }
+    if (!spec->int16) return true;
+
+    // 16-bit versions: each constant is multiplied by k and by the Montgomery factor 2^16. Only entry 0 of the scaled copies
+    // differs, since stage m=1 applies it to all coefficients; the twiddles of stage istage of the INTT carry an extra k
+    set->psi_rev_int16 = (int16_t*)malloc(N*sizeof(int16_t));
+    set->omegainv_rev_int16 = (int16_t*)malloc(N*sizeof(int16_t));
+    if (set->psi_rev_int16 == NULL || set->omegainv_rev_int16 == NULL) return false;
+    for (i = 0; i < N; i++) {
+        scale = (i >= spec->istage/2 && i < spec->istage) ? mulmod(spec->k, spec->k, q) : spec->k;
+        set->psi_rev_int16[i] = centered(mulmod(mulmod(spec->k, (uint32_t)set->psi_rev[i], q), R, q), q);
+        set->omegainv_rev_int16[i] = centered(mulmod(mulmod(scale, (uint32_t)set->omegainv_rev[i], q), R, q), q);
+    }
+    for (j = 0; j < spec->nscales; j++) {
+        set->psi_rev_scaled_int16[j] = (int16_t*)malloc(N*sizeof(int16_t));
+        if (set->psi_rev_scaled_int16[j] == NULL) return false;
+        memcpy(set->psi_rev_scaled_int16[j], set->psi_rev_int16, N*sizeof(int16_t));
+        set->psi_rev_scaled_int16[j][0] = centered(mulmod(mulmod(spec->k, spec->scale[j] % q, q), R, q), q);
+    }
+    for (j = 0; j < spec->nninv; j++) {
+        set->Ninv_int16[j] = centered(mulmod(mulmod(spec->k, (uint32_t)set->Ninv[j], q), R, q), q);
+        set->omegainvN_rev_int16[j] = centered(mulmod(mulmod(spec->k, (uint32_t)set->omegainvN_rev[j], q), R, q), q);
+    }
+    return true;
+}
+
+
+static void free_tables(table_set* set)
+{
+    unsigned int j;
+
+    free(set->psi_rev);
+    free(set->omegainv_rev);
+    free(set->psi_rev_int16);
+    free(set->omegainv_rev_int16);
+    for (j = 0; j < MAX_LIST; j++) {
+        free(set->psi_rev_scaled[j]);
+        free(set->psi_rev_scaled_int16[j]);
+    }
+}
+
+
+static void print_table(const char* type, const char* name, const int32_t* t32, const int16_t* t16, uint32_t N)
+{ // Prints a table in the layout of ntt_constants.c
+    uint32_t i;
+
+    printf("const %s %s[%u] = {\n", type, name, N);
+    for (i = 0; i < N; i++) {
+        printf("%d", (t32 != NULL) ? t32[i] : t16[i]);
+        if (i != N-1) printf(", ");
+        if (i % PER_LINE == PER_LINE-1 || i == N-1) printf("\n");
+    }
+    printf("};\n\n\n");
+}
+
+
+static void print_tables(const table_spec* spec, const table_set* set)
+{
+    char name[64];
+    uint32_t N = spec->N, q = spec->q, R = (1 << 16) % q;
+    unsigned int j;
+
+    printf("// Generated by gen_tables for N = %u, q = %u, psi = %u, k = %u, merged NTT stage m=%u\n\n", N, q, spec->psi, spec->k, spec->stage);
+    for (j = 0; j < spec->nninv; j++) {
+        printf("// N^-1 * prime_scale^-%u\n", spec->ninv[j]);
+        printf("const int32_t Ninv%u_ntt%u_%u = %d;\n", spec->ninv[j], N, q, set->Ninv[j]);
+        printf("// N^-1 * prime_scale^-%u * omegainv_rev_ntt%u_%u[1]\n", spec->ninv[j] - 1, N, q);
+        printf("const int32_t omegainv%uN_rev_ntt%u_%u = %d;\n", spec->ninv[j] - 1, N, q, set->omegainvN_rev[j]);
+    }
+    printf("\n\n");
+    sprintf(name, "psi_rev_ntt%u_%u", N, q);
+    print_table("int32_t", name, set->psi_rev, NULL, N);
+    for (j = 0; j < spec->nscales; j++) {
+        sprintf(name, "psi_rev%u_ntt%u_%u", spec->scale[j], N, q);
+        print_table("int32_t", name, set->psi_rev_scaled[j], NULL, N);
+    }
+    sprintf(name, "omegainv_rev_ntt%u_%u", N, q);
+    print_table("int32_t", name, set->omegainv_rev, NULL, N);
+    if (!spec->int16) return;
+
+    printf("// Parameters of the 16-bit arithmetic, for LatticeCrypto_priv.h:\n");
+    printf("//   PARAMETER_QINV = %d, PARAMETER_MONT = %u, PARAMETER_BARRETT = %u, PARAMETER_MONT3 = %d, PARAMETER_MONT9 = %d, PARAMETER_MONT9_2 = %d\n\n",
+           invmod16(q), R, (uint32_t)(((1 << 26) + q/2) / q), centered(mulmod(spec->k, R, q), q),
+           centered(mulmod(mulmod(spec->k, spec->k, q), R, q), q), centered(mulmod(mulmod(mulmod(spec->k, spec->k, q), R, q), R, q), q));
+    for (j = 0; j < spec->nninv; j++) {
+        printf("const int16_t Ninv%u_ntt%u_%u_int16 = %d;\n", spec->ninv[j], N, q, set->Ninv_int16[j]);
+        printf("const int16_t omegainv%uN_rev_ntt%u_%u_int16 = %d;\n", spec->ninv[j] - 1, N, q, set->omegainvN_rev_int16[j]);
+    }
+    printf("\n\n");
+    sprintf(name, "psi_rev_ntt%u_%u_int16", N, q);
+    print_table("int16_t", name, NULL, set->psi_rev_int16, N);
+    for (j = 0; j < spec->nscales; j++) {
+        sprintf(name, "psi_rev%u_ntt%u_%u_int16", spec->scale[j], N, q);
+        print_table("int16_t", name, NULL, set->psi_rev_scaled_int16[j], N);
+    }
+    sprintf(name, "omegainv_rev_ntt%u_%u_int16", N, q);
+    print_table("int16_t", name, NULL, set->omegainv_rev_int16, N);
+}
+
+
+static bool compare32(const char* name, const int32_t* generated, const int32_t* library, uint32_t N)
+{
+    if (memcmp(generated, library, N*sizeof(int32_t)) != 0) {
+        printf("  %s differs from ntt_constants.c\n", name); return false;
+    }
+    return true;
+}
+
+
+static bool compare16(const char* name, const int16_t* generated, const int16_t* library, uint32_t N)
+{
+    if (memcmp(generated, library, N*sizeof(int16_t)) != 0) {
+        printf("  %s differs from ntt_constants.c\n", name); return false;
+    }
+    return true;
+}
+
+
+static bool check_tables()
+{ // Regenerates the tables of the parameter sets and compares them against the ones in ntt_constants.c
+    const LatticeCryptoParams* params[3] = {&params_ntt512_12289, &params_ntt1024_12289, &params_ntt2048_12289};
+    const uint32_t psi[3] = {1987, 1945, 1331};    // The N = 512 tables use another root than the default one
+    table_spec spec;
+    table_set set;
+    int32_t c32[4];
+    int16_t c16[8];
+    unsigned int i;
+    bool OK = true;
+
+    for (i = 0; i < 3; i++) {
+        memset(&spec, 0, sizeof(table_spec));
+        spec.N = params[i]->N;
+        spec.q = PARAMETER_Q;
+        spec.psi = psi[i];
+        spec.stage = 128;
+        spec.istage = 32;
+        spec.int16 = (spec.N == PARAMETER_N);
+        if (!check_spec(&spec) || !generate(&spec, &set)) return false;
+
+        OK = OK && compare32("psi_rev", set.psi_rev, params[i]->psi_rev, spec.N);
+        OK = OK && compare32("psi_rev3", set.psi_rev_scaled[0], params[i]->psi_rev3, spec.N);
+        OK = OK && compare32("psi_rev81", set.psi_rev_scaled[1], params[i]->psi_rev81, spec.N);
+        OK = OK && compare32("omegainv_rev", set.omegainv_rev, params[i]->omegainv_rev, spec.N);
+        c32[0] = params[i]->Ninv; c32[1] = params[i]->omegainv1N_rev;
+        OK = OK && compare32("Ninv11", &set.Ninv[1], &c32[0], 1) && compare32("omegainv10N_rev", &set.omegainvN_rev[1], &c32[1], 1);
+        if (spec.int16) {
+            c32[0] = Ninv8_ntt1024_12289; c32[1] = omegainv7N_rev_ntt1024_12289;
+            OK = OK && compare32("Ninv8", &set.Ninv[0], &c32[0], 1) && compare32("omegainv7N_rev", &set.omegainvN_rev[0], &c32[1], 1);
+            OK = OK && compare16("psi_rev_int16", set.psi_rev_int16, psi_rev_ntt1024_12289_int16, spec.N);
+            OK = OK && compare16("psi_rev3_int16", set.psi_rev_scaled_int16[0], psi_rev3_ntt1024_12289_int16, spec.N);
+            OK = OK && compare16("psi_rev81_int16", set.psi_rev_scaled_int16[1], psi_rev81_ntt1024_12289_int16, spec.N);
+            OK = OK && compare16("omegainv_rev_int16", set.omegainv_rev_int16, omegainv_rev_ntt1024_12289_int16, spec.N);
+            c16[0] = Ninv8_ntt1024_12289_int16; c16[1] = omegainv7N_rev_ntt1024_12289_int16;
+            c16[2] = Ninv11_ntt1024_12289_int16; c16[3] = omegainv10N_rev_ntt1024_12289_int16;
+            OK = OK && compare16("Ninv8_int16", &set.Ninv_int16[0], &c16[0], 1) && compare16("omegainv7N_rev_int16", &set.omegainvN_rev_int16[0], &c16[1], 1);
+            OK = OK && compare16("Ninv11_int16", &set.Ninv_int16[1], &c16[2], 1) && compare16("omegainv10N_rev_int16", &set.omegainvN_rev_int16[1], &c16[3], 1);
+            c16[4] = invmod16(PARAMETER_Q); c16[5] = centered(3*PARAMETER_MONT, PARAMETER_Q);
+            OK = OK && (c16[4] == PARAMETER_QINV) && (c16[5] == PARAMETER_MONT3);
+        }
+        free_tables(&set);
+        if (!OK) {
+            printf("  Tables for N = %u... FAILED\n", spec.N);
+            return false;
+        }
+        printf("  Tables for N = %4u........................................................... PASSED\n", spec.N);
+    }
+    return true;
+}
+
+
+int main(int argc, char** argv)
+{
+    table_spec spec;
+    table_set set;
+    int i;
+    bool OK = true;
+
+    if (argc == 2 && strcmp(argv[1], "-check") == 0) {
+        return check_tables() ? 0 : 1;
+    }
+    if (argc < 3) {
+        fprintf(stderr, "usage: gen_tables N q [-psi root] [-k scale] [-stage m] [-istage m] [-scale t1,t2,...] [-ninv e1,e2,...] [-int16]\n");
+        fprintf(stderr, "       gen_tables -check\n");
+        return 1;
+    }
+
+    memset(&spec, 0, sizeof(table_spec));
+    spec.N = (uint32_t)strtoul(argv[1], NULL, 10);
+    spec.q = (uint32_t)strtoul(argv[2], NULL, 10);
+    spec.stage = 128;
+    spec.istage = 32;
+    for (i = 3; i < argc && OK; i++) {
+        if (strcmp(argv[i], "-int16") == 0) {
+            spec.int16 = true;
+        } else if (i+1 == argc) {
+            OK = false;
+        } else if (strcmp(argv[i], "-psi") == 0) {
+            spec.psi = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-k") == 0) {
+            spec.k = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-stage") == 0) {
+            spec.stage = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-istage") == 0) {
+            spec.istage = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-scale") == 0) {
+            OK = parse_list(argv[++i], spec.scale, &spec.nscales);
+        } else if (strcmp(argv[i], "-ninv") == 0) {
+            OK = parse_list(argv[++i], spec.ninv, &spec.nninv);
+        } else {
+            OK = false;
+        }
+    }
+    if (!OK) {
+        fprintf(stderr, "invalid option %s\n", argv[i-1]);
+        return 1;
+    }
+    if (!check_spec(&spec)) {
+        return 1;
+    }
+    if (!generate(&spec, &set)) {
+        fprintf(stderr, "out of memory\n");
+        free_tables(&set);
+        return 1;
+    }
+    print_tables(&spec, &set);
+    free_tables(&set);
+    return 0;
+}
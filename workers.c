@@ -0,0 +1,320 @@
+/****************************************************************************************
+* LatticeCrypto: an efficient post-quantum Ring-Learning With Errors cryptography library
+*
+*    Copyright (c) Microsoft Corporation. All rights reserved.
+*
+*
+* Abstract: optional pool of worker threads running handshake jobs, with work stealing
+*
+*****************************************************************************************/
+
+#include "LatticeCrypto_priv.h"
+#include <stdlib.h>
+#include <string.h>
+#if (OS_TARGET == OS_WIN)
+    #include <windows.h>
+    #define workers_load(p)          ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(p), 0, 0))
+    #define workers_add(p, x)        InterlockedExchangeAdd64((volatile LONG64*)(p), (LONG64)(x))
+    typedef HANDLE workers_thread_t;
+    typedef CRITICAL_SECTION workers_mutex_t;
+    typedef CONDITION_VARIABLE workers_cond_t;
+    #define workers_mutex_init(m)    InitializeCriticalSection(m)
+    #define workers_mutex_destroy(m) DeleteCriticalSection(m)
+    #define workers_lock(m)          EnterCriticalSection(m)
+    #define workers_unlock(m)        LeaveCriticalSection(m)
+    #define workers_cond_init(c)     InitializeConditionVariable(c)
+    #define workers_cond_destroy(c)
+    #define workers_wait(c, m)       SleepConditionVariableCS(c, m, INFINITE)
+    #define workers_signal(c)        WakeConditionVariable(c)
+    #define workers_broadcast(c)     WakeAllConditionVariable(c)
+#else
+    #include <pthread.h>
+    #define workers_load(p)          __atomic_load_n(p, __ATOMIC_ACQUIRE)
+    #define workers_add(p, x)        __atomic_fetch_add(p, x, __ATOMIC_ACQ_REL)
+    typedef pthread_t workers_thread_t;
+    typedef pthread_mutex_t workers_mutex_t;
+    typedef pthread_cond_t workers_cond_t;
+    #define workers_mutex_init(m)    pthread_mutex_init(m, NULL)
+    #define workers_mutex_destroy(m) pthread_mutex_destroy(m)
+    #define workers_lock(m)          pthread_mutex_lock(m)
+    #define workers_unlock(m)        pthread_mutex_unlock(m)
+    #define workers_cond_init(c)     pthread_cond_init(c, NULL)
+    #define workers_cond_destroy(c)  pthread_cond_destroy(c)
+    #define workers_wait(c, m)       pthread_cond_wait(c, m)
+    #define workers_signal(c)        pthread_cond_signal(c)
+    #define workers_broadcast(c)     pthread_cond_broadcast(c)
+#endif
+
+
+typedef struct
+{
+    struct LatticeCryptoWorkers* workers;
+    unsigned int     index;
+    workers_mutex_t  lock;                      // Protects the queue
+    PLatticeCryptoHandshakeJob head, tail;      // Own queue, linked through the Next field of the jobs, taken from the head by the worker and the thieves
+    PLatticeCryptoWorkspace workspace;
+    uint64_t         completed, stolen;
+    workers_thread_t thread;
+} handshake_worker;
+
+struct LatticeCryptoWorkers
+{
+    PLatticeCryptoStruct owner;                 // Functions used by the jobs
+    WorkerStart      start;
+    unsigned int     nthreads, nstarted;
+    handshake_worker* worker;
+    workers_mutex_t  idle_lock;                 // The workers with empty queues wait on idle for pending > 0
+    workers_cond_t   idle;
+    uint64_t         pending;                   // Jobs submitted and not yet taken
+    uint64_t         next;                      // Queue of the next submission, round robin
+    uint64_t         stop;
+};
+
+
+static void worker_push(handshake_worker* worker, PLatticeCryptoHandshakeJob job)
+{ // Append job to the queue of worker
+    job->Next = NULL;
+    workers_lock(&worker->lock);
+    if (worker->tail == NULL) {
+        worker->head = job;
+    } else {
+        worker->tail->Next = job;
+    }
+    worker->tail = job;
+    workers_unlock(&worker->lock);
+}
+
+
+static PLatticeCryptoHandshakeJob worker_pop(handshake_worker* worker)
+{ // Take the oldest job of the queue of worker, NULL if the queue is empty
+  // Thieves also take the oldest job, so that the jobs run about in the order of submission
+    PLatticeCryptoHandshakeJob job;
+
+    workers_lock(&worker->lock);
+    job = worker->head;
+    if (job != NULL) {
+        worker->head = job->Next;
+        if (worker->head == NULL) {
+            worker->tail = NULL;
+        }
+    }
+    workers_unlock(&worker->lock);
+
+    return job;
+}
+
+
+static PLatticeCryptoHandshakeJob worker_next(handshake_worker* worker)
+{ // Take a job from the queue of worker, else steal one from the other queues in turn, else wait for a submission
+  // Returns NULL when the pool is stopped and no job is pending
+    struct LatticeCryptoWorkers* workers = worker->workers;
+    PLatticeCryptoHandshakeJob job;
+    unsigned int i;
+
+    for (;;) {
+        job = worker_pop(worker);
+        for (i = 1; job == NULL && i < workers->nthreads; i++) {
+            job = worker_pop(&workers->worker[(worker->index + i) % workers->nthreads]);
+            if (job != NULL) {
+                workers_add(&worker->stolen, 1);
+            }
+        }
+        if (job != NULL) {
+            workers_add(&workers->pending, (uint64_t)-1);
+            return job;
+        }
+
+        workers_lock(&workers->idle_lock);
+        while (workers_load(&workers->pending) == 0 && workers_load(&workers->stop) == 0) {
+            workers_wait(&workers->idle, &workers->idle_lock);
+        }
+        if (workers_load(&workers->pending) == 0) {                         // Stopped and drained
+            workers_unlock(&workers->idle_lock);
+            return NULL;
+        }
+        workers_unlock(&workers->idle_lock);
+    }
+}
+
+
+#if (OS_TARGET == OS_WIN)
+static DWORD WINAPI worker_main(LPVOID arg)
+#else
+static void* worker_main(void* arg)
+#endif
+{ // Run the jobs of the pool with the workspace of the thread until the pool is stopped and drained
+    handshake_worker* worker = (handshake_worker*)arg;
+    PLatticeCryptoStruct owner = worker->workers->owner;
+    PLatticeCryptoHandshakeJob job;
+
+    if (worker->workers->start != NULL) {
+        worker->workers->start(worker->index);
+    }
+    while ((job = worker_next(worker)) != NULL) {
+        switch (job->Step) {
+        case HANDSHAKE_KEYGENERATION_A:
+            job->Status = KeyGeneration_A_ws(job->SecretKeyA, job->PublicKeyA, owner, worker->workspace);
+            break;
+        case HANDSHAKE_AGREEMENT_B:
+            job->Status = SecretAgreement_B_ws(job->PublicKeyA, job->SharedSecret, job->PublicKeyB, owner, worker->workspace);
+            break;
+        case HANDSHAKE_AGREEMENT_A:
+            job->Status = SecretAgreement_A_ws(job->PublicKeyB, job->SecretKeyA, job->SharedSecret, worker->workspace);
+            break;
+        default:
+            job->Status = CRYPTO_ERROR_INVALID_PARAMETER;
+        }
+        workers_add(&worker->completed, 1);
+        if (job->Completion != NULL) {
+            job->Completion(job);                                           // The job belongs to the caller again
+        }
+    }
+    return 0;
+}
+
+
+static void workers_stop(struct LatticeCryptoWorkers* workers)
+{ // Let the started threads finish the pending jobs and join them
+    unsigned int i;
+
+    workers_lock(&workers->idle_lock);
+    workers_add(&workers->stop, 1);
+    workers_broadcast(&workers->idle);
+    workers_unlock(&workers->idle_lock);
+    for (i = 0; i < workers->nstarted; i++) {
+#if (OS_TARGET == OS_WIN)
+        WaitForSingleObject(workers->worker[i].thread, INFINITE);
+        CloseHandle(workers->worker[i].thread);
+#else
+        pthread_join(workers->worker[i].thread, NULL);
+#endif
+    }
+}
+
+
+static void workers_free(struct LatticeCryptoWorkers* workers)
+{ // Release the pool of stopped threads, wiping the workspaces
+    unsigned int i;
+
+    for (i = 0; i < workers->nthreads; i++) {
+        LatticeCrypto_free_workspace(workers->worker[i].workspace);
+        workers_mutex_destroy(&workers->worker[i].lock);
+    }
+    workers_cond_destroy(&workers->idle);
+    workers_mutex_destroy(&workers->idle_lock);
+    free(workers->worker);
+    free(workers);
+}
+
+
+CRYPTO_STATUS LatticeCrypto_enable_workers(PLatticeCryptoStruct pLatticeCrypto, unsigned int nthreads, WorkerStart start)
+{ // Start "nthreads" worker threads for the handshake jobs of pLatticeCrypto, each with its own workspace, replacing any previous pool. nthreads = 0 removes the pool
+    struct LatticeCryptoWorkers* workers;
+    unsigned int i;
+    bool started = true;
+
+    if (pLatticeCrypto == NULL || nthreads > HANDSHAKE_WORKERS_MAX) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    LatticeCrypto_disable_workers(pLatticeCrypto);
+    if (nthreads == 0) {
+        return CRYPTO_SUCCESS;
+    }
+
+    workers = (struct LatticeCryptoWorkers*)calloc(1, sizeof(struct LatticeCryptoWorkers));
+    if (workers == NULL) {
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    workers->worker = (handshake_worker*)calloc(nthreads, sizeof(handshake_worker));
+    if (workers->worker == NULL) {
+        free(workers);
+        return CRYPTO_ERROR_NO_MEMORY;
+    }
+    workers->owner = pLatticeCrypto;
+    workers->start = start;
+    workers->nthreads = nthreads;
+    workers_mutex_init(&workers->idle_lock);
+    workers_cond_init(&workers->idle);
+    for (i = 0; i < nthreads; i++) {
+        workers->worker[i].workers = workers;
+        workers->worker[i].index = i;
+        workers_mutex_init(&workers->worker[i].lock);
+        workers->worker[i].workspace = LatticeCrypto_allocate_workspace();
+        if (workers->worker[i].workspace == NULL) {
+            started = false;
+        }
+    }
+
+    for (i = 0; i < nthreads && started == true; i++) {
+#if (OS_TARGET == OS_WIN)
+        workers->worker[i].thread = CreateThread(NULL, 0, worker_main, &workers->worker[i], 0, NULL);
+        started = (workers->worker[i].thread != NULL);
+#else
+        started = (pthread_create(&workers->worker[i].thread, NULL, worker_main, &workers->worker[i]) == 0);
+#endif
+        if (started == true) {
+            workers->nstarted++;
+        }
+    }
+    if (started == false) {
+        workers_stop(workers);
+        workers_free(workers);
+        return CRYPTO_ERROR;
+    }
+    pLatticeCrypto->Workers = workers;
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void LatticeCrypto_disable_workers(PLatticeCryptoStruct pLatticeCrypto)
+{ // Complete the pending jobs of the worker pool of pLatticeCrypto, if any, stop its threads and remove the pool, wiping the workspaces
+    struct LatticeCryptoWorkers* workers;
+
+    if (pLatticeCrypto == NULL || pLatticeCrypto->Workers == NULL) {
+        return;
+    }
+    workers = pLatticeCrypto->Workers;
+    workers_stop(workers);                                                  // The completion callbacks may still submit jobs until it returns
+    pLatticeCrypto->Workers = NULL;
+    workers_free(workers);
+}
+
+
+CRYPTO_STATUS LatticeCrypto_submit_handshake(PLatticeCryptoStruct pLatticeCrypto, PLatticeCryptoHandshakeJob job)
+{ // Queue job to a worker of the pool of pLatticeCrypto, in turn, and wake up a waiting worker
+    struct LatticeCryptoWorkers* workers;
+    uint64_t next;
+
+    if (pLatticeCrypto == NULL || pLatticeCrypto->Workers == NULL || job == NULL) {
+        return CRYPTO_ERROR_INVALID_PARAMETER;
+    }
+    workers = pLatticeCrypto->Workers;
+    next = workers_add(&workers->next, 1);
+    workers_add(&workers->pending, 1);                                      // Before the push, so that a worker never takes a job not counted yet
+    worker_push(&workers->worker[next % workers->nthreads], job);
+
+    workers_lock(&workers->idle_lock);                                      // The workers check pending under idle_lock before they wait
+    workers_signal(&workers->idle);
+    workers_unlock(&workers->idle_lock);
+
+    return CRYPTO_SUCCESS;
+}
+
+
+void LatticeCrypto_get_worker_stats(PLatticeCryptoStruct pLatticeCrypto, unsigned int* nthreads, uint64_t* completed, uint64_t* stolen)
+{ // Output the number of threads of the worker pool of pLatticeCrypto, and the number of jobs they completed and stole from other queues, 0 without a pool
+    struct LatticeCryptoWorkers* workers = (pLatticeCrypto != NULL) ? pLatticeCrypto->Workers : NULL;
+    unsigned int i;
+
+    *nthreads = 0;
+    *completed = 0;
+    *stolen = 0;
+    if (workers != NULL) {
+        *nthreads = workers->nthreads;
+        for (i = 0; i < workers->nthreads; i++) {
+            *completed += workers_load(&workers->worker[i].completed);
+            *stolen += workers_load(&workers->worker[i].stolen);
+        }
+    }
+}